@@ -0,0 +1,172 @@
+/**
+ ********************************************************************************
+ * @file    benchmark.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Timing and reporting helpers shared by the benchmark programs.
+ ********************************************************************************
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include <sys/resource.h>
+
+/************************************
+ * FUNCTION DEFINITIONS
+ ************************************/
+
+/*!
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ * @return The current time in nanoseconds
+ */
+static inline uint64_t now_ns(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+/*!
+ * @brief Comparison function used to sort latency samples.
+ * @param a Pointer to the first sample
+ * @param b Pointer to the second sample
+ * @return Negative, zero or positive as a is less than, equal to or greater than b
+ */
+static inline int compare_samples(const void *a, const void *b)
+{
+    uint64_t sample_a = *(const uint64_t *)a;
+    uint64_t sample_b = *(const uint64_t *)b;
+
+    return (sample_a > sample_b) - (sample_a < sample_b);
+}
+
+/*!
+ * @brief Returns a percentile of a sorted array of samples.
+ * @param samples Sorted array of samples
+ * @param count Number of samples
+ * @param percentile Percentile to return, between 0 and 100
+ * @return The sample at the percentile
+ */
+static inline uint64_t percentile(const uint64_t *samples, size_t count, double percentile)
+{
+    size_t index = (size_t)((percentile / 100.0) * (double)(count - 1));
+
+    return samples[index];
+}
+
+/*!
+ * @brief Sorts latency samples and prints their distribution on one line.
+ * @param label Name of the measured configuration
+ * @param samples Array of samples in nanoseconds, sorted in place
+ * @param count Number of samples
+ * @return None
+ */
+static inline void report_latencies(const char *label, uint64_t *samples, size_t count)
+{
+    qsort(samples, count, sizeof(uint64_t), &compare_samples);
+
+    printf("%-28s p50 %6llu ns  p99 %7llu ns  p99.9 %8llu ns  max %10llu ns\n", label,
+           (unsigned long long)percentile(samples, count, 50),
+           (unsigned long long)percentile(samples, count, 99),
+           (unsigned long long)percentile(samples, count, 99.9),
+           (unsigned long long)samples[count - 1]);
+}
+
+/*!
+ * @brief Returns the next value of a xorshift pseudo random generator.
+ * @param state Pointer to the generator state, which must not be 0
+ * @return A pseudo random 64 bit integer
+ */
+static inline uint64_t next_random(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+
+    return x;
+}
+
+/*!
+ * @brief Builds the cumulative distribution of a Zipfian distribution over the key ranks.
+ * @param num_keys Number of distinct keys
+ * @param exponent Skew of the distribution, larger values favour popular keys more
+ * @return Array of num_keys cumulative probabilities, the last equal to 1
+ */
+static inline double *zipf_distribution(size_t num_keys, double exponent)
+{
+    double *cdf = (double *)malloc(num_keys * sizeof(double));
+    double total = 0;
+
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        total += 1.0 / pow((double)(i + 1), exponent);
+        cdf[i] = total;
+    }
+
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        cdf[i] /= total;
+    }
+
+    return cdf;
+}
+
+/*!
+ * @brief Draws a key rank from a Zipfian distribution by binary search of its distribution.
+ * @param cdf Cumulative distribution from zipf_distribution()
+ * @param num_keys Number of distinct keys
+ * @param state Pointer to the generator state
+ * @return A key rank, 0 being the most popular
+ */
+static inline size_t next_zipf(const double *cdf, size_t num_keys, uint64_t *state)
+{
+    double u = (double)(next_random(state) >> 11) / (double)(1ULL << 53);
+    size_t low = 0;
+    size_t high = num_keys - 1;
+
+    while (low < high)
+    {
+        size_t mid = (low + high) / 2;
+
+        if (cdf[mid] < u)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+
+    return low;
+}
+
+/*!
+ * @brief Returns the largest resident set size the process has reached.
+ * @return Peak resident memory in kilobytes
+ */
+static inline long peak_rss_kb(void)
+{
+    struct rusage usage;
+
+    getrusage(RUSAGE_SELF, &usage);
+
+    return usage.ru_maxrss;
+}
+
+#endif // BENCHMARK_H
@@ -0,0 +1,170 @@
+/**
+ ********************************************************************************
+ * @file    concurrent_hash_table_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Measures the throughput of the sharded concurrent hash table from 1 to
+ *          64 threads for several read/write mixes, against a single hash table
+ *          wrapped in a global mutex.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define KEY_SPACE (1 << 20)
+#define OPS_PER_THREAD 200000
+#define NUM_SHARDS 64
+#define LOAD_FACTOR 0.75
+#define MAX_THREADS 64
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/concurrent_hash_table/concurrent_hash_table.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct holding the arguments of a worker thread.
+ */
+typedef struct
+{
+    // Seed for the thread's random generator
+    uint64_t seed;
+    // Percentage of operations which are reads
+    int read_percent;
+    // True to use the global mutex table instead of the concurrent table
+    bool use_mutex;
+} worker_arguments;
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+// Sharded table under test
+concurrent_hash_table sharded_table;
+// Baseline table, guarded by global_lock
+hash_table locked_table;
+pthread_mutex_t global_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/*!
+ * @brief Runs a mix of gets and puts on random keys.
+ * @param argument Pointer to the thread's worker arguments
+ * @return NULL
+ */
+void *worker(void *argument)
+{
+    worker_arguments *arguments = (worker_arguments *)argument;
+    uint64_t state = arguments->seed;
+    uintptr_t checksum = 0;
+
+    for (int i = 0; i < OPS_PER_THREAD; i++)
+    {
+        uint64_t random = next_random(&state);
+        void *key = (void *)(uintptr_t)((random >> 8) % KEY_SPACE + 1);
+        bool is_read = (int)(random % 100) < arguments->read_percent;
+
+        if (arguments->use_mutex)
+        {
+            pthread_mutex_lock(&global_lock);
+
+            if (is_read)
+            {
+                checksum += (uintptr_t)get(&locked_table, key);
+            }
+            else
+            {
+                put(&locked_table, key, key);
+            }
+
+            pthread_mutex_unlock(&global_lock);
+        }
+        else if (is_read)
+        {
+            checksum += (uintptr_t)concurrent_get(&sharded_table, key);
+        }
+        else
+        {
+            concurrent_put(&sharded_table, key, key);
+        }
+    }
+
+    return (void *)checksum;
+}
+
+/*!
+ * @brief Measures the throughput of one configuration.
+ * @param num_threads Number of worker threads
+ * @param read_percent Percentage of operations which are reads
+ * @param use_mutex True to measure the global mutex baseline
+ * @return Throughput in millions of operations per second
+ */
+double measure(int num_threads, int read_percent, bool use_mutex)
+{
+    pthread_t threads[MAX_THREADS];
+    worker_arguments arguments[MAX_THREADS];
+    uint64_t start = now_ns();
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        arguments[i].seed = 0x9e3779b97f4a7c15ULL * (uint64_t)(i + 1);
+        arguments[i].read_percent = read_percent;
+        arguments[i].use_mutex = use_mutex;
+        pthread_create(&threads[i], NULL, &worker, &arguments[i]);
+    }
+
+    for (int i = 0; i < num_threads; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    double seconds = (double)(now_ns() - start) / 1e9;
+
+    return ((double)num_threads * OPS_PER_THREAD) / seconds / 1e6;
+}
+
+/*!
+ * @brief Runs the benchmark.
+ */
+int main(void)
+{
+    int read_percents[] = {99, 90, 50};
+
+    printf("Throughput in Mops/s, %d ops per thread over %d keys\n\n", OPS_PER_THREAD, KEY_SPACE);
+
+    for (int r = 0; r < 3; r++)
+    {
+        printf("%d%% reads / %d%% writes\n", read_percents[r], 100 - read_percents[r]);
+        printf("%8s %12s %12s\n", "threads", "sharded", "global lock");
+
+        for (int num_threads = 1; num_threads <= MAX_THREADS; num_threads *= 2)
+        {
+            initialize_concurrent_hash_table(&sharded_table, NUM_SHARDS, KEY_SPACE, LOAD_FACTOR, HASH_FIBONACCI);
+            initialize_hash_table_mode(&locked_table, KEY_SPACE, LOAD_FACTOR, HASH_FIBONACCI, HASH_SWISS);
+
+            // Half of the key space is present before measuring
+            for (uintptr_t key = 1; key <= KEY_SPACE; key += 2)
+            {
+                concurrent_put(&sharded_table, (void *)key, (void *)key);
+                put(&locked_table, (void *)key, (void *)key);
+            }
+
+            double sharded = measure(num_threads, read_percents[r], false);
+            double locked = measure(num_threads, read_percents[r], true);
+
+            printf("%8d %12.2f %12.2f\n", num_threads, sharded, locked);
+
+            free_concurrent_hash_table(&sharded_table);
+            free_hash_table(&locked_table);
+        }
+
+        printf("\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+/**
+ ********************************************************************************
+ * @file    hash_set_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Compares the memory per key and insert throughput of a hash set
+ *          against a hash table used as a set, with every value left NULL.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 2000000
+#define INIT_SIZE 16
+#define LOAD_FACTOR 0.875
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_set/hash_set.h"
+
+/*!
+ * @brief Prints one line of results.
+ * @param label Name of the configuration
+ * @param num_keys Number of keys inserted
+ * @param elapsed Nanoseconds taken to insert every key
+ * @param bytes Bytes held by the structure once every key is inserted
+ * @return None
+ */
+void report(const char *label, size_t num_keys, uint64_t elapsed, size_t bytes)
+{
+    printf("%-24s %7.1f ns/insert  %6.1f bytes/key\n", label, (double)elapsed / num_keys,
+           (double)bytes / num_keys);
+}
+
+/*!
+ * @brief Inserts keys into a hash table in the given mode, storing no values.
+ * @param label Name of the configuration
+ * @param keys Array of keys to insert
+ * @param num_keys Number of keys
+ * @param mode Collision resolution mode of the table
+ * @return None
+ */
+void run_table(const char *label, void **keys, size_t num_keys, hash_table_mode mode)
+{
+    hash_table table;
+    hash_table_statistics stats;
+
+    initialize_hash_table_mode(&table, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        put(&table, keys[i], NULL);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    hash_table_stats(&table, &stats);
+    report(label, num_keys, elapsed, stats.bucket_bytes + stats.node_bytes);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Inserts keys into a hash set.
+ * @param keys Array of keys to insert
+ * @param num_keys Number of keys
+ * @return None
+ */
+void run_set(void **keys, size_t num_keys)
+{
+    hash_set set;
+
+    initialize_hash_set(&set, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI);
+
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        set_add(&set, keys[i]);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    report("hash set", num_keys, elapsed, hash_set_bytes(&set));
+
+    free_hash_set(&set);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_keys = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_KEYS;
+    void **keys = (void **)malloc(num_keys * sizeof(void *));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    // Random keys, so neither structure benefits from sequential hashes
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        keys[i] = (void *)(uintptr_t)(next_random(&state) | 1);
+    }
+
+    printf("Inserting %zu keys from an initial size of %d\n\n", num_keys, INIT_SIZE);
+
+    run_table("hash table, chaining", keys, num_keys, HASH_CHAINING);
+    run_table("hash table, swiss", keys, num_keys, HASH_SWISS);
+    run_set(keys, num_keys);
+
+    free(keys);
+
+    return 0;
+}
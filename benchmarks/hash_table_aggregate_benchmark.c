@@ -0,0 +1,132 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_aggregate_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Compares summing rows into groups with aggregate_batch() and
+ *          aggregate_batch_partitioned() against calling get() and put() on each
+ *          row, for a small and a large number of groups.
+ *
+ *          Usage: hash_table_aggregate_benchmark [num_rows] [threads]
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_ROWS 10000000
+#define DEFAULT_THREADS 4
+#define BATCH_SIZE 4096
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Adds up the values of every group, so the three paths can be compared.
+ * @param key Key of the group
+ * @param value Sum held by the group
+ * @param context Pointer to the running total
+ * @return None
+ */
+void add_group(void *key, void *value, void *context)
+{
+    *(int64_t *)context += (intptr_t)value;
+}
+
+/*!
+ * @brief Measures the three aggregation paths on one table configuration.
+ * @param label Name of the configuration
+ * @param mode Collision resolution strategy
+ * @param num_rows Number of rows aggregated
+ * @param num_groups Number of distinct group keys
+ * @param threads Number of workers given to the partitioned path
+ * @return None
+ */
+void run(const char *label, hash_table_mode mode, size_t num_rows, size_t num_groups, int threads)
+{
+    void **keys = (void **)malloc(num_rows * sizeof(void *));
+    int64_t *deltas = (int64_t *)malloc(num_rows * sizeof(int64_t));
+    uint64_t state = 88172645463325252ULL;
+    int64_t totals[3] = {0, 0, 0};
+    double ns[3];
+
+    for (size_t i = 0; i < num_rows; i++)
+    {
+        keys[i] = (void *)(uintptr_t)(next_random(&state) % num_groups + 1);
+        deltas[i] = (int64_t)(next_random(&state) % 100);
+    }
+
+    for (int path = 0; path < 3; path++)
+    {
+        hash_table table;
+
+        initialize_hash_table_mode(&table, 16, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+        uint64_t start = now_ns();
+
+        for (size_t done = 0; done < num_rows; done += BATCH_SIZE)
+        {
+            int count = (num_rows - done < BATCH_SIZE) ? (int)(num_rows - done) : BATCH_SIZE;
+
+            if (path == 0)
+            {
+                // The get then put pattern hashes and probes every row twice
+                for (int i = 0; i < count; i++)
+                {
+                    void *key = keys[done + i];
+
+                    put(&table, key, (void *)((intptr_t)get(&table, key) + deltas[done + i]));
+                }
+            }
+            else if (path == 1)
+            {
+                aggregate_batch(&table, keys + done, deltas + done, count, HASH_AGGREGATE_SUM);
+            }
+            else
+            {
+                aggregate_batch_partitioned(&table, keys + done, deltas + done, count, HASH_AGGREGATE_SUM, threads);
+            }
+        }
+
+        ns[path] = (double)(now_ns() - start) / num_rows;
+
+        hash_table_for_each(&table, &add_group, &(totals[path]));
+        free_hash_table(&table);
+    }
+
+    printf("%-10s %8zu groups   get+put %6.1f ns/row   batch %6.1f ns/row   partitioned %6.1f ns/row%s\n", label,
+           num_groups, ns[0], ns[1], ns[2], (totals[0] == totals[1] && totals[1] == totals[2]) ? "" : "  (mismatch)");
+
+    free(keys);
+    free(deltas);
+}
+
+/*!
+ * @brief Runs the benchmark. Optional arguments set the number of rows and the number
+ *        of workers given to the partitioned path.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_rows = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_ROWS;
+    int threads = (argc > 2) ? atoi(argv[2]) : DEFAULT_THREADS;
+
+    printf("Summing %zu rows in batches of %d, %d workers when partitioned\n\n", num_rows, BATCH_SIZE, threads);
+
+    run("chaining", HASH_CHAINING, num_rows, 1000, threads);
+    run("swiss", HASH_SWISS, num_rows, 1000, threads);
+    run("robin_hood", HASH_ROBIN_HOOD, num_rows, 1000, threads);
+    run("chaining", HASH_CHAINING, num_rows, 1000000, threads);
+    run("swiss", HASH_SWISS, num_rows, 1000000, threads);
+    run("robin_hood", HASH_ROBIN_HOOD, num_rows, 1000000, threads);
+
+    return 0;
+}
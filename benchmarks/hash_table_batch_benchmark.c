@@ -0,0 +1,105 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_batch_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Compares looking up batches of keys with get_many() against calling
+ *          get() on each key, on tables larger than the last level cache.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 4000000
+#define BATCH_SIZE 256
+#define NUM_LOOKUPS 4000000
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/*!
+ * @brief Measures both lookup paths on one table configuration.
+ * @param label Name of the configuration
+ * @param mode Collision resolution strategy
+ * @param num_keys Number of keys stored in the table
+ * @return None
+ */
+void run(const char *label, hash_table_mode mode, size_t num_keys)
+{
+    hash_table table;
+    void *keys[BATCH_SIZE];
+    void *values[BATCH_SIZE];
+    uint64_t state = 88172645463325252ULL;
+    uintptr_t checksum = 0;
+
+    initialize_hash_table_mode(&table, (int)num_keys, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+    for (size_t i = 1; i <= num_keys; i++)
+    {
+        put(&table, (void *)(uintptr_t)i, (void *)(uintptr_t)i);
+    }
+
+    // Each batch mixes hits with misses on keys above num_keys
+    uint64_t start = now_ns();
+
+    for (size_t done = 0; done < NUM_LOOKUPS; done += BATCH_SIZE)
+    {
+        for (int i = 0; i < BATCH_SIZE; i++)
+        {
+            keys[i] = (void *)(uintptr_t)(next_random(&state) % (num_keys * 2) + 1);
+        }
+
+        for (int i = 0; i < BATCH_SIZE; i++)
+        {
+            checksum += (uintptr_t)get(&table, keys[i]);
+        }
+    }
+
+    double single_ns = (double)(now_ns() - start) / NUM_LOOKUPS;
+
+    state = 88172645463325252ULL;
+    start = now_ns();
+
+    for (size_t done = 0; done < NUM_LOOKUPS; done += BATCH_SIZE)
+    {
+        for (int i = 0; i < BATCH_SIZE; i++)
+        {
+            keys[i] = (void *)(uintptr_t)(next_random(&state) % (num_keys * 2) + 1);
+        }
+
+        get_many(&table, keys, BATCH_SIZE, values);
+
+        for (int i = 0; i < BATCH_SIZE; i++)
+        {
+            checksum -= (uintptr_t)values[i];
+        }
+    }
+
+    double batch_ns = (double)(now_ns() - start) / NUM_LOOKUPS;
+
+    printf("%-10s get() %6.1f ns/key   get_many() %6.1f ns/key   speedup %.2fx%s\n", label, single_ns, batch_ns,
+           single_ns / batch_ns, (checksum == 0) ? "" : "  (mismatch)");
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys in the table.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_keys = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_KEYS;
+
+    printf("Random lookups in batches of %d on %zu keys\n\n", BATCH_SIZE, num_keys);
+
+    run("chaining", HASH_CHAINING, num_keys);
+    run("swiss", HASH_SWISS, num_keys);
+
+    return 0;
+}
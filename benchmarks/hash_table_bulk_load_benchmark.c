@@ -0,0 +1,132 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_bulk_load_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Measures the build throughput of hash_table_bulk_load() with 1 to 64
+ *          workers against put_many() in the chaining and swiss modes, and the
+ *          time to fill a table by put with resizes migrated by 1 to 64 workers.
+ *          Built with HASH_TABLE_THREADS defined, so workers run in parallel.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 4000000
+#define INIT_SIZE 16
+#define LOAD_FACTOR 0.75
+#define MAX_THREADS 64
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <unistd.h>
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Builds a table from every key, by put_many() when threads is 0, otherwise by
+ *        hash_table_bulk_load() with that many workers.
+ * @param mode Mode of the table
+ * @param keys Keys to add, also used as their values
+ * @param num_keys Number of keys
+ * @param threads Number of workers, or 0 for put_many()
+ * @return Build throughput in millions of keys per second
+ */
+double measure_build(hash_table_mode mode, void **keys, int num_keys, int threads)
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+    uint64_t start = now_ns();
+
+    if (threads == 0)
+    {
+        put_many(&table, keys, keys, num_keys);
+    }
+    else
+    {
+        hash_table_bulk_load(&table, keys, keys, num_keys, threads);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    free_hash_table(&table);
+
+    return (double)num_keys / ((double)elapsed / 1e9) / 1e6;
+}
+
+/*!
+ * @brief Fills a table by put, with each resize using a number of workers.
+ * @param mode Mode of the table
+ * @param keys Keys to add, also used as their values
+ * @param num_keys Number of keys
+ * @param threads Number of resize workers
+ * @return Total time in milliseconds
+ */
+double measure_resize(hash_table_mode mode, void **keys, int num_keys, int threads)
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI, mode);
+    set_resize_threads(&table, threads);
+
+    uint64_t start = now_ns();
+
+    for (int i = 0; i < num_keys; i++)
+    {
+        put(&table, keys[i], keys[i]);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    free_hash_table(&table);
+
+    return (double)elapsed / 1e6;
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys.
+ */
+int main(int argc, char **argv)
+{
+    int num_keys = (argc > 1) ? atoi(argv[1]) : DEFAULT_NUM_KEYS;
+    void **keys = (void **)malloc((size_t)num_keys * sizeof(void *));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (int i = 0; i < num_keys; i++)
+    {
+        keys[i] = (void *)(uintptr_t)(next_random(&state) | 1);
+    }
+
+    printf("Build throughput in Mkeys/s, %d keys, %ld cores\n\n", num_keys, sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%8s %12s %12s\n", "workers", "chaining", "swiss");
+    printf("%8s %12.2f %12.2f\n", "put_many", measure_build(HASH_CHAINING, keys, num_keys, 0),
+           measure_build(HASH_SWISS, keys, num_keys, 0));
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        printf("%8d %12.2f %12.2f\n", threads, measure_build(HASH_CHAINING, keys, num_keys, threads),
+               measure_build(HASH_SWISS, keys, num_keys, threads));
+    }
+
+    printf("\nTime in ms to put every key, resizing with each number of workers\n\n");
+    printf("%8s %12s %12s\n", "workers", "chaining", "swiss");
+
+    for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+        printf("%8d %12.1f %12.1f\n", threads, measure_resize(HASH_CHAINING, keys, num_keys, threads),
+               measure_resize(HASH_SWISS, keys, num_keys, threads));
+    }
+
+    free(keys);
+
+    return 0;
+}
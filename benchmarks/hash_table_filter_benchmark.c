@@ -0,0 +1,137 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_filter_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Looks up a mix of present and absent keys, most of them absent, in
+ *          a chaining and a swiss table, with no filter, a Bloom filter and a
+ *          cuckoo filter attached.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 4000000
+#define NUM_LOOKUPS 10000000
+#define MISS_PERCENT 80
+#define INIT_SIZE 16
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/filters/bloom_filter.h"
+#include "../data_structures/filters/cuckoo_filter.h"
+
+/*!
+ * @brief Looks up every key once and prints one line of results.
+ * @param label Name of the configuration
+ * @param table Pointer to a hash table holding the present keys
+ * @param lookups Keys to look up
+ * @param filter_bytes Bytes held by the attached filter, 0 if none
+ * @param num_keys Number of keys in the table
+ * @return Number of keys found, to check the configurations agree
+ */
+long run(const char *label, hash_table *table, void **lookups, size_t filter_bytes, size_t num_keys)
+{
+    long found = 0;
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < NUM_LOOKUPS; i++)
+    {
+        found += (get(table, lookups[i]) != NULL);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    printf("%-24s %6.1f ns/get  %5.2f filter bytes/key\n", label, (double)elapsed / NUM_LOOKUPS,
+           (double)filter_bytes / num_keys);
+
+    return found;
+}
+
+/*!
+ * @brief Builds a table in the given mode and runs the lookups with each filter.
+ * @param name Name of the mode
+ * @param mode Mode of the table
+ * @param keys Keys stored in the table
+ * @param num_keys Number of keys
+ * @param lookups Keys to look up
+ * @return None
+ */
+void run_mode(const char *name, hash_table_mode mode, void **keys, size_t num_keys, void **lookups)
+{
+    hash_table table;
+    bloom_filter bloom;
+    cuckoo_filter cuckoo;
+    char label[64];
+
+    initialize_hash_table_mode(&table, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        put(&table, keys[i], keys[i]);
+    }
+
+    snprintf(label, sizeof(label), "%s, no filter", name);
+    long plain = run(label, &table, lookups, 0, num_keys);
+
+    // Both filters are populated from the keys already in the table
+    initialize_bloom_filter(&bloom, (long)num_keys, 0.01);
+    set_hash_table_filter(&table, &bloom, &bloom_filter_ops);
+    snprintf(label, sizeof(label), "%s, Bloom 1%%", name);
+    long bloomed = run(label, &table, lookups, bloom_filter_bytes(&bloom), num_keys);
+
+    initialize_cuckoo_filter(&cuckoo, (long)num_keys, 0.001);
+    set_hash_table_filter(&table, &cuckoo, &cuckoo_filter_ops);
+    snprintf(label, sizeof(label), "%s, cuckoo 0.1%%", name);
+    long cuckooed = run(label, &table, lookups, cuckoo_filter_bytes(&cuckoo), num_keys);
+
+    if (plain != bloomed || plain != cuckooed)
+    {
+        printf("Keys found differ: %ld, %ld and %ld\n", plain, bloomed, cuckooed);
+    }
+
+    set_hash_table_filter(&table, NULL, NULL);
+    free_bloom_filter(&bloom);
+    free_cuckoo_filter(&cuckoo);
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys in the table.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_keys = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_KEYS;
+    void **keys = (void **)malloc(num_keys * sizeof(void *));
+    void **lookups = (void **)malloc(NUM_LOOKUPS * sizeof(void *));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    // Present keys are odd and absent keys even, so a random absent key is never stored
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        keys[i] = (void *)(uintptr_t)(next_random(&state) | 1);
+    }
+
+    for (size_t i = 0; i < NUM_LOOKUPS; i++)
+    {
+        bool miss = next_random(&state) % 100 < MISS_PERCENT;
+
+        lookups[i] = miss ? (void *)(uintptr_t)(next_random(&state) & ~(uint64_t)1)
+                          : keys[next_random(&state) % num_keys];
+    }
+
+    printf("%d lookups, %d%% of absent keys, in a table of %zu keys\n\n", NUM_LOOKUPS, MISS_PERCENT, num_keys);
+
+    run_mode("chaining", HASH_CHAINING, keys, num_keys, lookups);
+    run_mode("swiss", HASH_SWISS, keys, num_keys, lookups);
+
+    free(keys);
+    free(lookups);
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_inline_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Looks up 8 byte integer keys holding 16 byte records, comparing a
+ *          swiss table of pointers to heap allocated keys and records against
+ *          a HASH_INLINE table holding both by value.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 1000000
+#define NUM_LOOKUPS 10000000
+#define INIT_SIZE 16
+#define LOAD_FACTOR 0.875
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Record stored for each key.
+ */
+typedef struct
+{
+    long count;
+    double total;
+} record;
+
+/*!
+ * @brief Looks up every key once, summing the records found, and prints one line of results.
+ * @param label Name of the configuration
+ * @param table Pointer to a hash table holding every key
+ * @param lookups Keys to look up, as the table expects them
+ * @param heap_bytes Bytes allocated for keys and records outside the table
+ * @param num_keys Number of keys in the table
+ * @return Sum of the counts found, to check the configurations agree
+ */
+long run(const char *label, hash_table *table, void **lookups, size_t heap_bytes, size_t num_keys)
+{
+    hash_table_statistics stats;
+    long sum = 0;
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < NUM_LOOKUPS; i++)
+    {
+        sum += ((record *)get(table, lookups[i]))->count;
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    hash_table_stats(table, &stats);
+    printf("%-30s %6.1f ns/get  %5.1f bytes/key\n", label, (double)elapsed / NUM_LOOKUPS,
+           (double)(stats.bucket_bytes + heap_bytes) / num_keys);
+
+    return sum;
+}
+
+/*!
+ * @brief Frees a boxed key and the record stored with it.
+ * @param key Heap allocated key
+ * @param value Heap allocated record
+ * @param context Unused
+ * @return None
+ */
+void free_boxed(void *key, void *value, void *context)
+{
+    free(key);
+    free(value);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_keys = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_KEYS;
+    uint64_t *keys = (uint64_t *)malloc(num_keys * sizeof(uint64_t));
+    void **lookups = (void **)malloc(NUM_LOOKUPS * sizeof(void *));
+    void **key_lookups = (void **)malloc(NUM_LOOKUPS * sizeof(void *));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    hash_table pointers;
+    hash_table boxed;
+    hash_table inlined;
+
+    initialize_hash_table_mode(&pointers, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI, HASH_SWISS);
+    initialize_hash_table_keys(&boxed, INIT_SIZE, LOAD_FACTOR, HASH_SWISS, sizeof(uint64_t), &hash_bytes, NULL);
+    initialize_hash_table_inline(&inlined, INIT_SIZE, LOAD_FACTOR, sizeof(uint64_t), sizeof(record));
+
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        record *value = (record *)malloc(sizeof(record));
+        uint64_t *boxed_key = (uint64_t *)malloc(sizeof(uint64_t));
+
+        keys[i] = next_random(&state) | 1;
+        *boxed_key = keys[i];
+        value->count = (long)(i % 1000);
+        value->total = (double)i;
+
+        // Integer keys fit in the key pointer, but the record is always behind one
+        put(&pointers, (void *)(uintptr_t)keys[i], value);
+        put(&boxed, boxed_key, value);
+        put(&inlined, &keys[i], value);
+    }
+
+    for (size_t i = 0; i < NUM_LOOKUPS; i++)
+    {
+        size_t k = next_random(&state) % num_keys;
+
+        lookups[i] = (void *)(uintptr_t)keys[k];
+        key_lookups[i] = &keys[k];
+    }
+
+    printf("%d lookups in tables of %zu keys\n\n", NUM_LOOKUPS, num_keys);
+
+    long a = run("swiss, key in pointer", &pointers, lookups, num_keys * sizeof(record), num_keys);
+    long b = run("swiss, key and value boxed", &boxed, key_lookups, num_keys * (sizeof(record) + sizeof(uint64_t)), num_keys);
+    long c = run("inline", &inlined, key_lookups, 0, num_keys);
+
+    if (a != b || a != c)
+    {
+        printf("\nSums differ: %ld, %ld and %ld\n", a, b, c);
+    }
+
+    // Both pointer tables share the records, which are freed along with the boxed keys
+    hash_table_for_each(&boxed, &free_boxed, NULL);
+    free_hash_table(&pointers);
+    free_hash_table(&boxed);
+    free_hash_table(&inlined);
+    free(keys);
+    free(lookups);
+    free(key_lookups);
+
+    return 0;
+}
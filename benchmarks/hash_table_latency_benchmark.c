@@ -0,0 +1,105 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_latency_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Compares the latency distribution of single lookups between the
+ *          collision resolution strategies of the hash table, at a high load factor.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 1000000
+#define NUM_LOOKUPS 2000000
+#define LOAD_FACTOR 0.9
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/*!
+ * @brief Times random hits and misses on one table configuration.
+ * @param label Name of the configuration
+ * @param mode Collision resolution strategy
+ * @param num_keys Number of keys stored in the table
+ * @param samples Array receiving one latency sample per lookup
+ * @return None
+ */
+void run(const char *label, hash_table_mode mode, size_t num_keys, uint64_t *samples)
+{
+    hash_table table;
+    uint64_t state = 88172645463325252ULL;
+    uint64_t hit_state = state;
+    uint64_t miss_state = 2463534242ULL;
+    uintptr_t checksum = 0;
+
+    initialize_hash_table_mode(&table, (int)num_keys, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+    // Keys are scattered odd numbers, so chains and probe sequences form as they would in use
+    for (size_t i = 0; i < num_keys; i++)
+    {
+        uintptr_t key = (uintptr_t)(next_random(&state) | 1);
+
+        put(&table, (void *)key, (void *)key);
+    }
+
+    for (size_t i = 0; i < NUM_LOOKUPS; i++)
+    {
+        uintptr_t key;
+
+        // Hits replay the insertion sequence, misses are even numbers
+        if (i % 2 == 0)
+        {
+            if ((i / 2) % num_keys == 0)
+            {
+                hit_state = 88172645463325252ULL;
+            }
+
+            key = (uintptr_t)(next_random(&hit_state) | 1);
+        }
+        else
+        {
+            key = (uintptr_t)(next_random(&miss_state) & ~(uint64_t)1);
+        }
+
+        uint64_t start = now_ns();
+        checksum += (uintptr_t)get(&table, (void *)key);
+        samples[i] = now_ns() - start;
+    }
+
+    report_latencies(label, samples, NUM_LOOKUPS);
+
+    // Using the checksum keeps the lookups from being optimized away
+    if (checksum == 0)
+    {
+        printf("No lookups hit\n");
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys in the table.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_keys = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_KEYS;
+    uint64_t *samples = (uint64_t *)malloc(NUM_LOOKUPS * sizeof(uint64_t));
+
+    printf("Single get() latency on %zu keys at load factor %.2f, half hits and half misses\n\n", num_keys,
+           LOAD_FACTOR);
+
+    run("chaining", HASH_CHAINING, num_keys, samples);
+    run("swiss", HASH_SWISS, num_keys, samples);
+    run("robin hood", HASH_ROBIN_HOOD, num_keys, samples);
+    run("cuckoo", HASH_CUCKOO, num_keys, samples);
+
+    free(samples);
+
+    return 0;
+}
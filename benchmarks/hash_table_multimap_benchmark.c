@@ -0,0 +1,155 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_multimap_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Builds an inverted index of random postings, then walks every term's
+ *          posting list, comparing a HASH_MULTIMAP table against a chaining table
+ *          which holds one node for every posting.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_POSTINGS 4000000
+#define NUM_TERMS 100000
+#define INIT_SIZE 16
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/*!
+ * @brief Prints one line of results.
+ * @param label Name of the configuration
+ * @param num_postings Number of postings added
+ * @param append_ns Nanoseconds taken to add every posting
+ * @param walk_ns Nanoseconds taken to walk every term's postings
+ * @param bytes Bytes held by the table once every posting is added
+ * @return None
+ */
+void report(const char *label, size_t num_postings, uint64_t append_ns, uint64_t walk_ns, size_t bytes)
+{
+    printf("%-22s %6.1f ns/append  %5.2f ns/posting walked  %5.1f bytes/posting\n", label,
+           (double)append_ns / num_postings, (double)walk_ns / num_postings, (double)bytes / num_postings);
+}
+
+/*!
+ * @brief Sums the postings of a term in a chaining table by walking its position's chain,
+ *        skipping nodes of other terms.
+ * @param table Pointer to a chaining hash table with no resize in progress
+ * @param term Term to sum the postings of
+ * @return Sum of the term's postings
+ */
+long walk_chain(hash_table *table, void *term)
+{
+    uint64_t hash = (table->key_hash)(term, table->key_length);
+    long sum = 0;
+
+    for (hash_node *node = &((table->array)[hash % (uint64_t)table->table_size]); node != NULL; node = node->next)
+    {
+        if (node->key == term)
+        {
+            sum += (long)node->value;
+        }
+    }
+
+    return sum;
+}
+
+/*!
+ * @brief Sums the postings of a term in a multimap table.
+ * @param table Pointer to a HASH_MULTIMAP hash table
+ * @param term Term to sum the postings of
+ * @return Sum of the term's postings
+ */
+long walk_multimap(hash_table *table, void *term)
+{
+    int count;
+    void **values = get_all(table, term, &count);
+    long sum = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+        sum += (long)values[i];
+    }
+
+    return sum;
+}
+
+/*!
+ * @brief Adds every posting to a table in the given mode and walks every term.
+ * @param label Name of the configuration
+ * @param terms Term of each posting
+ * @param num_postings Number of postings
+ * @param mode HASH_CHAINING or HASH_MULTIMAP
+ * @return Sum of every posting walked, to check the modes agree
+ */
+long run(const char *label, void **terms, size_t num_postings, hash_table_mode mode)
+{
+    hash_table table;
+    hash_table_statistics stats;
+    long sum = 0;
+
+    initialize_hash_table_mode(&table, INIT_SIZE, LOAD_FACTOR, HASH_FIBONACCI, mode);
+
+    uint64_t start = now_ns();
+
+    // The document id of each posting is its index, so lists are built in id order
+    for (size_t i = 0; i < num_postings; i++)
+    {
+        append(&table, terms[i], (void *)(uintptr_t)(i + 1));
+    }
+
+    uint64_t append_ns = now_ns() - start;
+
+    start = now_ns();
+
+    for (long term = 1; term <= NUM_TERMS; term++)
+    {
+        sum += (mode == HASH_MULTIMAP) ? walk_multimap(&table, (void *)term) : walk_chain(&table, (void *)term);
+    }
+
+    uint64_t walk_ns = now_ns() - start;
+
+    hash_table_stats(&table, &stats);
+    report(label, num_postings, append_ns, walk_ns, stats.bucket_bytes + stats.node_bytes);
+
+    free_hash_table(&table);
+
+    return sum;
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of postings.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_postings = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_POSTINGS;
+    void **terms = (void **)malloc(num_postings * sizeof(void *));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    for (size_t i = 0; i < num_postings; i++)
+    {
+        terms[i] = (void *)(uintptr_t)(next_random(&state) % NUM_TERMS + 1);
+    }
+
+    printf("Indexing %zu postings over %d terms\n\n", num_postings, NUM_TERMS);
+
+    long chained = run("chaining, node each", terms, num_postings, HASH_CHAINING);
+    long multimap = run("multimap", terms, num_postings, HASH_MULTIMAP);
+
+    if (chained != multimap)
+    {
+        printf("\nPosting sums differ: %ld and %ld\n", chained, multimap);
+    }
+
+    free(terms);
+
+    return 0;
+}
@@ -0,0 +1,74 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_resize_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Measures the latency distribution of put() on a hash table which
+ *          resizes many times, comparing resizing within a single call against
+ *          incremental resizing.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_PUTS 4000000
+#define INIT_TABLE_SIZE 16
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/*!
+ * @brief Times every put into a table growing from INIT_TABLE_SIZE to hold num_puts keys.
+ * @param label Name of the configuration
+ * @param num_puts Number of keys to insert
+ * @param positions_per_step Positions migrated per operation, 0 for single call resizing
+ * @return None
+ */
+void run(const char *label, size_t num_puts, int positions_per_step)
+{
+    hash_table table;
+    uint64_t *samples = (uint64_t *)malloc(num_puts * sizeof(uint64_t));
+    uint64_t start = now_ns();
+
+    initialize_hash_table(&table, INIT_TABLE_SIZE, LOAD_FACTOR, HASH_FIBONACCI);
+    set_incremental_resize(&table, positions_per_step);
+
+    for (size_t i = 0; i < num_puts; i++)
+    {
+        uint64_t before = now_ns();
+
+        put(&table, (void *)(uintptr_t)(i + 1), (void *)(uintptr_t)i);
+        samples[i] = now_ns() - before;
+    }
+
+    double total_ms = (double)(now_ns() - start) / 1e6;
+
+    report_latencies(label, samples, num_puts);
+    printf("%-28s total %.1f ms, final table size %d\n\n", "", total_ms, table.table_size);
+
+    free_hash_table(&table);
+    free(samples);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of puts.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_puts = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_PUTS;
+
+    printf("put() latency across resizes, %zu keys\n\n", num_puts);
+
+    run("resize in one call", num_puts, 0);
+    run("incremental, 1 position/op", num_puts, 1);
+    run("incremental, 8 positions/op", num_puts, 8);
+    run("incremental, 64 positions/op", num_puts, 64);
+
+    return 0;
+}
@@ -0,0 +1,397 @@
+/**
+ ********************************************************************************
+ * @file    hash_table_workload_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Drives put, get and remove_hash through a set of workloads for every
+ *          combination of table mode and hash function, reporting ns/op,
+ *          throughput and peak resident memory. Each combination runs in its
+ *          own child process, so the peak memory reported is its own. Results
+ *          can also be written as CSV, or as JSON when the output file name
+ *          ends in .json, to compare hash functions and modes across releases.
+ *          The colliding workload is capped at MAX_COLLIDING_KEYS keys. Under
+ *          the division hash every one of its keys shares position 0, and
+ *          chaining tables count occupied positions towards their load factor,
+ *          so that table never resizes and every operation walks one chain.
+ *
+ *          Usage: hash_table_workload_benchmark [num_keys] [output file]
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_KEYS 1000000
+#define INIT_SIZE 16
+#define LOAD_FACTOR 0.75
+#define ZIPF_EXPONENT 0.99
+// Keys given to the colliding workload, whose chains make every operation linear
+#define MAX_COLLIDING_KEYS 20000
+// Largest number of results a single workload reports
+#define MAX_PHASES 2
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "benchmark.h"
+#include "../data_structures/hash_table/hash_table.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Workloads the benchmark runs.
+ */
+typedef enum
+{
+    // Random keys looked up uniformly
+    WORKLOAD_UNIFORM,
+    // Random keys looked up with Zipfian popularity
+    WORKLOAD_ZIPFIAN,
+    // Keys 1 to n added and looked up in order
+    WORKLOAD_SEQUENTIAL,
+    // Lookups of keys which were never added
+    WORKLOAD_ALL_MISS,
+    // Each step removes a random key and adds a new one
+    WORKLOAD_DELETE_HEAVY,
+    // Keys equal modulo every power of two table size, so division() places them together
+    WORKLOAD_COLLIDING,
+    NUM_WORKLOADS
+} workload;
+
+/*!
+ * @brief Result of one timed phase of a workload, sent from the child process.
+ */
+typedef struct
+{
+    // Name of the phase
+    char phase[16];
+    // Number of operations timed
+    size_t ops;
+    // Total time in nanoseconds
+    uint64_t elapsed;
+    // Peak resident memory of the child at the end of the phase, in kilobytes
+    long peak_rss_kb;
+} phase_result;
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+static const char *workload_names[NUM_WORKLOADS] = {"uniform", "zipfian", "sequential",
+                                                    "all_miss", "delete_heavy", "colliding"};
+static const hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO};
+static const char *mode_names[] = {"chaining", "swiss", "robin_hood", "cuckoo"};
+static const int hash_functions[] = {HASH_DIVISION, HASH_FIBONACCI};
+static const char *hash_names[] = {"division", "fibonacci"};
+
+// Sum of the values found, printed so the lookups cannot be optimized away
+static volatile uintptr_t sink;
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Records the time and memory of a finished phase.
+ * @param result Pointer to the result to fill
+ * @param phase Name of the phase
+ * @param ops Number of operations timed
+ * @param start Timestamp taken before the first operation
+ * @return None
+ */
+void finish_phase(phase_result *result, const char *phase, size_t ops, uint64_t start)
+{
+    result->elapsed = now_ns() - start;
+    result->ops = ops;
+    result->peak_rss_kb = peak_rss_kb();
+    snprintf(result->phase, sizeof(result->phase), "%s", phase);
+}
+
+/*!
+ * @brief Builds a table from the workload's keys, then times its operations. Every
+ *        array the timed loops read is filled before the clock starts.
+ * @param kind Workload to run
+ * @param mode Mode of the table
+ * @param function_select Hash function of the table
+ * @param n Number of keys
+ * @param results Array of MAX_PHASES results to fill
+ * @return Number of results filled
+ */
+int run_workload(workload kind, hash_table_mode mode, int function_select, size_t n, phase_result *results)
+{
+    hash_table table;
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    uintptr_t sum = 0;
+
+    if (kind == WORKLOAD_COLLIDING && n > MAX_COLLIDING_KEYS)
+    {
+        n = MAX_COLLIDING_KEYS;
+    }
+
+    void **keys = (void **)malloc(n * sizeof(void *));
+    void **lookups = (void **)malloc(n * sizeof(void *));
+
+    for (size_t i = 0; i < n; i++)
+    {
+        if (kind == WORKLOAD_SEQUENTIAL)
+        {
+            keys[i] = (void *)(uintptr_t)(i + 1);
+        }
+        else if (kind == WORKLOAD_COLLIDING)
+        {
+            keys[i] = (void *)(uintptr_t)((uint64_t)(i + 1) << 32);
+        }
+        else
+        {
+            // The generator never returns 0, which would read as no key
+            keys[i] = (void *)(uintptr_t)next_random(&state);
+        }
+    }
+
+    initialize_hash_table_mode(&table, INIT_SIZE, LOAD_FACTOR, function_select, mode);
+
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < n; i++)
+    {
+        put(&table, keys[i], keys[i]);
+    }
+
+    finish_phase(&(results[0]), "put", n, start);
+
+    if (kind == WORKLOAD_DELETE_HEAVY)
+    {
+        size_t *victims = (size_t *)malloc(n * sizeof(size_t));
+
+        // Each step replaces a random key with a fresh one, keeping the table's size
+        for (size_t i = 0; i < n; i++)
+        {
+            victims[i] = next_random(&state) % n;
+            lookups[i] = (void *)(uintptr_t)next_random(&state);
+        }
+
+        start = now_ns();
+
+        for (size_t i = 0; i < n; i++)
+        {
+            remove_hash(&table, keys[victims[i]]);
+            put(&table, lookups[i], lookups[i]);
+            keys[victims[i]] = lookups[i];
+        }
+
+        finish_phase(&(results[1]), "remove_put", 2 * n, start);
+        free(victims);
+    }
+    else
+    {
+        double *cdf = (kind == WORKLOAD_ZIPFIAN) ? zipf_distribution(n, ZIPF_EXPONENT) : NULL;
+        uint64_t miss_state = 0x2545F4914F6CDD1DULL;
+
+        for (size_t i = 0; i < n; i++)
+        {
+            if (kind == WORKLOAD_ZIPFIAN)
+            {
+                lookups[i] = keys[next_zipf(cdf, n, &state)];
+            }
+            else if (kind == WORKLOAD_SEQUENTIAL)
+            {
+                lookups[i] = keys[i];
+            }
+            else if (kind == WORKLOAD_ALL_MISS)
+            {
+                // A second generator draws keys which are, with near certainty, never added
+                lookups[i] = (void *)(uintptr_t)next_random(&miss_state);
+            }
+            else
+            {
+                lookups[i] = keys[next_random(&state) % n];
+            }
+        }
+
+        start = now_ns();
+
+        for (size_t i = 0; i < n; i++)
+        {
+            sum += (uintptr_t)get(&table, lookups[i]);
+        }
+
+        finish_phase(&(results[1]), "get", n, start);
+        free(cdf);
+    }
+
+    sink = sum;
+
+    free_hash_table(&table);
+    free(keys);
+    free(lookups);
+
+    return 2;
+}
+
+/*!
+ * @brief Runs a workload in a child process and collects the results it sends back.
+ * @param kind Workload to run
+ * @param mode Mode of the table
+ * @param function_select Hash function of the table
+ * @param n Number of keys
+ * @param results Array of MAX_PHASES results to fill
+ * @return Number of results received, 0 if the child failed
+ */
+int run_in_child(workload kind, hash_table_mode mode, int function_select, size_t n, phase_result *results)
+{
+    int pipe_ends[2];
+
+    if (pipe(pipe_ends) != 0)
+    {
+        return 0;
+    }
+
+    fflush(stdout);
+
+    pid_t child = fork();
+
+    if (child == 0)
+    {
+        int count = run_workload(kind, mode, function_select, n, results);
+
+        close(pipe_ends[0]);
+
+        if (write(pipe_ends[1], results, count * sizeof(phase_result)) < 0)
+        {
+            _exit(1);
+        }
+
+        _exit(0);
+    }
+
+    close(pipe_ends[1]);
+
+    int count = 0;
+    ssize_t bytes;
+
+    while (child > 0 && count < MAX_PHASES &&
+           (bytes = read(pipe_ends[0], &(results[count]), sizeof(phase_result))) == sizeof(phase_result))
+    {
+        count++;
+    }
+
+    close(pipe_ends[0]);
+
+    if (child > 0)
+    {
+        waitpid(child, NULL, 0);
+    }
+
+    return count;
+}
+
+/*!
+ * @brief Writes one result to the output file.
+ * @param output Output file, or NULL
+ * @param json True to write a JSON object, otherwise a CSV line
+ * @param first True for the first result written
+ * @param kind Workload the result belongs to
+ * @param m Index of the table mode
+ * @param h Index of the hash function
+ * @param result Result to write
+ * @return None
+ */
+void write_result(FILE *output, bool json, bool first, workload kind, int m, int h, phase_result *result)
+{
+    double ns_per_op = (double)result->elapsed / (double)result->ops;
+
+    if (output == NULL)
+    {
+        return;
+    }
+
+    if (json)
+    {
+        fprintf(output,
+                "%s\n  {\"workload\": \"%s\", \"mode\": \"%s\", \"hash\": \"%s\", \"phase\": \"%s\", "
+                "\"ops\": %zu, \"ns_per_op\": %.2f, \"mops_per_s\": %.3f, \"peak_rss_kb\": %ld}",
+                first ? "" : ",", workload_names[kind], mode_names[m], hash_names[h], result->phase,
+                result->ops, ns_per_op, 1e3 / ns_per_op, result->peak_rss_kb);
+    }
+    else
+    {
+        fprintf(output, "%s,%s,%s,%s,%zu,%.2f,%.3f,%ld\n", workload_names[kind], mode_names[m], hash_names[h],
+                result->phase, result->ops, ns_per_op, 1e3 / ns_per_op, result->peak_rss_kb);
+    }
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of keys, and a
+ *        second names the file results are written to.
+ */
+int main(int argc, char **argv)
+{
+    size_t n = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_KEYS;
+    const char *path = (argc > 2) ? argv[2] : NULL;
+    bool json = path != NULL && strlen(path) > 5 && strcmp(path + strlen(path) - 5, ".json") == 0;
+    FILE *output = (path != NULL) ? fopen(path, "w") : NULL;
+    bool first = true;
+
+    if (path != NULL && output == NULL)
+    {
+        fprintf(stderr, "Could not open %s\n", path);
+        return 1;
+    }
+
+    if (output != NULL)
+    {
+        fprintf(output, json ? "[" : "workload,mode,hash,phase,ops,ns_per_op,mops_per_s,peak_rss_kb\n");
+    }
+
+    printf("Hash table workloads, %zu keys, %d for the colliding workload\n\n", n,
+           (n < MAX_COLLIDING_KEYS) ? (int)n : MAX_COLLIDING_KEYS);
+    printf("%-13s %-11s %-10s %-11s %10s %10s %12s\n", "workload", "mode", "hash", "phase", "ns/op", "Mops/s",
+           "peak RSS MB");
+
+    for (int w = 0; w < NUM_WORKLOADS; w++)
+    {
+        for (int m = 0; m < (int)(sizeof(modes) / sizeof(modes[0])); m++)
+        {
+            for (int h = 0; h < (int)(sizeof(hash_functions) / sizeof(hash_functions[0])); h++)
+            {
+                phase_result results[MAX_PHASES];
+                int count = run_in_child((workload)w, modes[m], hash_functions[h], n, results);
+
+                if (count == 0)
+                {
+                    printf("%-13s %-11s %-10s failed\n", workload_names[w], mode_names[m], hash_names[h]);
+                }
+
+                for (int i = 0; i < count; i++)
+                {
+                    double ns_per_op = (double)results[i].elapsed / (double)results[i].ops;
+
+                    printf("%-13s %-11s %-10s %-11s %10.1f %10.2f %12.1f\n", workload_names[w], mode_names[m],
+                           hash_names[h], results[i].phase, ns_per_op, 1e3 / ns_per_op,
+                           results[i].peak_rss_kb / 1024.0);
+
+                    write_result(output, json, first, (workload)w, m, h, &(results[i]));
+                    first = false;
+                }
+            }
+        }
+    }
+
+    if (output != NULL && json)
+    {
+        fprintf(output, "\n]\n");
+    }
+
+    if (output != NULL)
+    {
+        fclose(output);
+    }
+
+    return 0;
+}
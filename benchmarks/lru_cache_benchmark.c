@@ -0,0 +1,89 @@
+/**
+ ********************************************************************************
+ * @file    lru_cache_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Measures the throughput and hit rate of an LRU cache under a
+ *          Zipfian workload, where a lookup which misses is followed by a put
+ *          of the key as a read through cache would do.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_OPS 10000000
+#define NUM_DISTINCT_KEYS 1000000
+#define ZIPF_EXPONENT 0.99
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/lru_cache/lru_cache.h"
+
+/*!
+ * @brief Runs the workload against a cache holding a given number of entries.
+ * @param ranks Array of key ranks to look up
+ * @param num_ops Number of lookups
+ * @param max_entries Capacity of the cache
+ * @return None
+ */
+void run(const size_t *ranks, size_t num_ops, size_t max_entries)
+{
+    lru_cache cache;
+
+    initialize_lru_cache(&cache, max_entries, 0, HASH_FIBONACCI);
+
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < num_ops; i++)
+    {
+        // Ranks are scrambled so popular keys are not also numerically adjacent
+        void *key = (void *)(uintptr_t)(hash_mix(ranks[i]) | 1);
+
+        if (lru_get(&cache, key) == NULL)
+        {
+            lru_put(&cache, key, key, 0);
+        }
+    }
+
+    uint64_t elapsed = now_ns() - start;
+    double hit_rate = (double)cache.counters.hits / (double)num_ops;
+
+    printf("capacity %8zu  %6.1f ns/op  hit rate %5.1f%%  evictions %llu\n", max_entries,
+           (double)elapsed / num_ops, hit_rate * 100, cache.counters.evictions);
+
+    free_lru_cache(&cache);
+}
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of lookups.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_ops = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_OPS;
+    double *cdf = zipf_distribution(NUM_DISTINCT_KEYS, ZIPF_EXPONENT);
+    size_t *ranks = (size_t *)malloc(num_ops * sizeof(size_t));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+
+    // Keys are drawn up front so the timed loop only measures the cache
+    for (size_t i = 0; i < num_ops; i++)
+    {
+        ranks[i] = next_zipf(cdf, NUM_DISTINCT_KEYS, &state);
+    }
+
+    printf("LRU cache, %zu lookups over %d keys, Zipf exponent %.2f\n\n", num_ops, NUM_DISTINCT_KEYS,
+           ZIPF_EXPONENT);
+
+    run(ranks, num_ops, NUM_DISTINCT_KEYS / 1000);
+    run(ranks, num_ops, NUM_DISTINCT_KEYS / 100);
+    run(ranks, num_ops, NUM_DISTINCT_KEYS / 10);
+    run(ranks, num_ops, NUM_DISTINCT_KEYS / 2);
+
+    free(cdf);
+    free(ranks);
+
+    return 0;
+}
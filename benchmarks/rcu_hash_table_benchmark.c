@@ -0,0 +1,200 @@
+/**
+ ********************************************************************************
+ * @file    rcu_hash_table_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Measures the read throughput of the read mostly hash table with one
+ *          writer and 1 to 64 reader threads, against a hash table guarded by a
+ *          reader writer lock. Lock free readers share no written cache lines,
+ *          so their throughput scales with the number of cores.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define KEY_SPACE (1 << 16)
+#define RUN_MS 200
+#define LOAD_FACTOR 0.75
+#define MAX_READERS 64
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <unistd.h>
+#include "benchmark.h"
+#include "../data_structures/rcu_hash_table/rcu_hash_table.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct holding the arguments and result of a reader thread.
+ */
+typedef struct
+{
+    // Seed for the thread's random generator
+    uint64_t seed;
+    // True to read the reader writer lock table instead of the RCU table
+    bool use_rwlock;
+    // Number of reads completed
+    uint64_t reads;
+    // Sum of values read, kept so reads are not optimized out
+    uintptr_t checksum;
+} reader_arguments;
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+// Table under test
+rcu_hash_table rcu_table;
+// Baseline table, guarded by table_lock
+hash_table locked_table;
+pthread_rwlock_t table_lock = PTHREAD_RWLOCK_INITIALIZER;
+// Set when the measured interval ends
+atomic_bool stop;
+
+/*!
+ * @brief Reads random keys until stopped.
+ * @param argument Pointer to the thread's reader arguments
+ * @return NULL
+ */
+void *reader(void *argument)
+{
+    reader_arguments *arguments = (reader_arguments *)argument;
+    rcu_reader *handle = rcu_register_reader(&rcu_table);
+    uint64_t state = arguments->seed;
+    uint64_t reads = 0;
+
+    while (!atomic_load_explicit(&stop, memory_order_relaxed))
+    {
+        void *key = (void *)(uintptr_t)(next_random(&state) % KEY_SPACE + 1);
+
+        if (arguments->use_rwlock)
+        {
+            pthread_rwlock_rdlock(&table_lock);
+            arguments->checksum += (uintptr_t)get(&locked_table, key);
+            pthread_rwlock_unlock(&table_lock);
+        }
+        else
+        {
+            arguments->checksum += (uintptr_t)rcu_get(&rcu_table, handle, key);
+        }
+
+        reads++;
+    }
+
+    arguments->reads = reads;
+    rcu_unregister_reader(handle);
+
+    return NULL;
+}
+
+/*!
+ * @brief Replaces and removes random keys until stopped, as a config reload would.
+ * @param argument Non NULL to write the reader writer lock table
+ * @return NULL
+ */
+void *writer(void *argument)
+{
+    uint64_t state = 0x2545F4914F6CDD1DULL;
+
+    while (!atomic_load_explicit(&stop, memory_order_relaxed))
+    {
+        uint64_t random = next_random(&state);
+        void *key = (void *)(uintptr_t)(random % KEY_SPACE + 1);
+
+        if (argument != NULL)
+        {
+            pthread_rwlock_wrlock(&table_lock);
+            ((random >> 32) % 4 == 0) ? remove_hash(&locked_table, key) : put(&locked_table, key, key);
+            pthread_rwlock_unlock(&table_lock);
+        }
+        else
+        {
+            ((random >> 32) % 4 == 0) ? rcu_remove(&rcu_table, key) : rcu_put(&rcu_table, key, key);
+        }
+
+        // Writes are occasional next to reads
+        usleep(10);
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Measures the read throughput of one configuration.
+ * @param num_readers Number of reader threads
+ * @param use_rwlock True to measure the reader writer lock baseline
+ * @return Read throughput in millions of reads per second
+ */
+double measure(int num_readers, bool use_rwlock)
+{
+    pthread_t writer_thread;
+    pthread_t threads[MAX_READERS];
+    reader_arguments arguments[MAX_READERS];
+    uint64_t total = 0;
+
+    atomic_store(&stop, false);
+    pthread_create(&writer_thread, NULL, &writer, use_rwlock ? (void *)1 : NULL);
+
+    for (int i = 0; i < num_readers; i++)
+    {
+        arguments[i].seed = 0x9e3779b97f4a7c15ULL * (uint64_t)(i + 1);
+        arguments[i].use_rwlock = use_rwlock;
+        arguments[i].checksum = 0;
+        pthread_create(&threads[i], NULL, &reader, &arguments[i]);
+    }
+
+    uint64_t start = now_ns();
+
+    usleep(RUN_MS * 1000);
+    atomic_store(&stop, true);
+
+    for (int i = 0; i < num_readers; i++)
+    {
+        pthread_join(threads[i], NULL);
+        total += arguments[i].reads;
+    }
+
+    double seconds = (double)(now_ns() - start) / 1e9;
+
+    pthread_join(writer_thread, NULL);
+
+    return (double)total / seconds / 1e6;
+}
+
+/*!
+ * @brief Runs the benchmark.
+ */
+int main(void)
+{
+    printf("Read throughput in Mreads/s with 1 writer, %d keys, %ld cores\n\n", KEY_SPACE,
+           sysconf(_SC_NPROCESSORS_ONLN));
+    printf("%8s %12s %12s\n", "readers", "rcu", "rwlock");
+
+    for (int num_readers = 1; num_readers <= MAX_READERS; num_readers *= 2)
+    {
+        initialize_rcu_hash_table(&rcu_table, KEY_SPACE, LOAD_FACTOR, HASH_FIBONACCI);
+        initialize_hash_table(&locked_table, KEY_SPACE, LOAD_FACTOR, HASH_FIBONACCI);
+
+        for (uintptr_t key = 1; key <= KEY_SPACE; key++)
+        {
+            rcu_put(&rcu_table, (void *)key, (void *)key);
+            put(&locked_table, (void *)key, (void *)key);
+        }
+
+        double rcu = measure(num_readers, false);
+        double locked = measure(num_readers, true);
+
+        printf("%8d %12.2f %12.2f\n", num_readers, rcu, locked);
+
+        free_rcu_hash_table(&rcu_table);
+        free_hash_table(&locked_table);
+    }
+
+    return 0;
+}
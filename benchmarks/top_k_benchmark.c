@@ -0,0 +1,110 @@
+/**
+ ********************************************************************************
+ * @file    top_k_benchmark.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Measures the cost of each update to a count-min sketch alone and to
+ *          a top-k tracker over a Zipfian stream, and how many of the true
+ *          most frequent keys the tracker reports.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define DEFAULT_NUM_EVENTS 20000000
+#define NUM_DISTINCT_KEYS 1000000
+#define ZIPF_EXPONENT 1.0
+#define EPSILON 0.0001
+#define DELTA 0.01
+#define K 100
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "benchmark.h"
+#include "../data_structures/sketches/top_k.h"
+
+/*!
+ * @brief Runs the benchmark. An optional argument sets the number of events.
+ */
+int main(int argc, char **argv)
+{
+    size_t num_events = (argc > 1) ? (size_t)atol(argv[1]) : DEFAULT_NUM_EVENTS;
+    double *cdf = zipf_distribution(NUM_DISTINCT_KEYS, ZIPF_EXPONENT);
+    void **events = (void **)malloc(num_events * sizeof(void *));
+    uint32_t *true_counts = (uint32_t *)calloc(NUM_DISTINCT_KEYS + 1, sizeof(uint32_t));
+    uint64_t state = 0x9E3779B97F4A7C15ULL;
+    count_min_sketch sketch;
+    top_k tracker;
+    void *keys[K];
+    int found = 0;
+
+    // Events are drawn up front so the timed loops only measure the updates. Rank r is
+    // key r + 1, so the most frequent keys are 1 to K
+    for (size_t i = 0; i < num_events; i++)
+    {
+        size_t rank = next_zipf(cdf, NUM_DISTINCT_KEYS, &state);
+
+        events[i] = (void *)(uintptr_t)(rank + 1);
+        true_counts[rank + 1]++;
+    }
+
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+
+    printf("%zu events over %d keys, Zipf exponent %.2f, sketch of %d x %d counters (%zu KB)\n\n", num_events,
+           NUM_DISTINCT_KEYS, ZIPF_EXPONENT, sketch.depth, sketch.width, count_min_sketch_bytes(&sketch) / 1024);
+
+    uint64_t start = now_ns();
+
+    for (size_t i = 0; i < num_events; i++)
+    {
+        count_min_add(&sketch, hash_fibonacci(events[i], HASH_KEY_POINTER), 1);
+    }
+
+    uint64_t elapsed = now_ns() - start;
+
+    printf("%-24s %6.1f ns/update\n", "count-min sketch", (double)elapsed / num_events);
+
+    count_min_clear(&sketch);
+    initialize_top_k(&tracker, K, &sketch, HASH_FIBONACCI);
+
+    start = now_ns();
+
+    for (size_t i = 0; i < num_events; i++)
+    {
+        top_k_add(&tracker, events[i], 1);
+    }
+
+    elapsed = now_ns() - start;
+
+    int count = top_k_items(&tracker, keys, NULL);
+
+    for (int i = 0; i < count; i++)
+    {
+        found += ((uintptr_t)keys[i] <= K);
+    }
+
+    printf("%-24s %6.1f ns/update  %d of the top %d keys found\n", "top-k tracker", (double)elapsed / num_events, found,
+           K);
+
+    uint64_t error = 0;
+
+    // Error of the sketch on the keys it was built from, against its bound
+    for (uintptr_t key = 1; key <= NUM_DISTINCT_KEYS; key++)
+    {
+        error += top_k_estimate(&tracker, (void *)key) - true_counts[key];
+    }
+
+    printf("%-24s %6.2f mean overestimate, bound %.0f\n", "", (double)error / NUM_DISTINCT_KEYS,
+           EPSILON * (double)sketch.total);
+
+    free_top_k(&tracker);
+    free_count_min_sketch(&sketch);
+    free(cdf);
+    free(events);
+    free(true_counts);
+
+    return 0;
+}
@@ -0,0 +1,420 @@
+/**
+ ********************************************************************************
+ * @file    concurrent_hash_table.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a sharded concurrent hash table.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <sched.h>
+#include "concurrent_hash_table.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Load factor of each shard's table
+#define SHARD_TABLE_LOAD_FACTOR 0.875f
+// Largest load factor at which a shard is allowed to grow. Keeping it below the shard
+// table's load factor leaves room for deleted markers between rebuilds
+#define MAX_SHARD_LOAD_FACTOR 0.75f
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Returns the shard responsible for a key.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key to locate
+ * @return Pointer to the shard
+ */
+static concurrent_shard *select_shard(concurrent_hash_table *table, void *hash_key)
+{
+    uint64_t hash = hash_mix((table->key_hash)(hash_key, table->key_length));
+
+    // The upper half of the hash is used so shard selection is independent of the
+    // low bits which choose a slot within the shard
+    return &((table->shards)[(int)(hash >> 32) & table->shard_mask]);
+}
+
+/*!
+ * @brief Allocates an empty open addressing table for a shard.
+ * @param table Pointer to a concurrent hash table
+ * @param capacity Number of slots in the table
+ * @return Pointer to the new shard table
+ */
+static shard_table *allocate_shard_table(concurrent_hash_table *table, int capacity)
+{
+    shard_table *new_table = (shard_table *)malloc(sizeof(shard_table));
+
+    initialize_hash_table_mode(&(new_table->table), capacity, SHARD_TABLE_LOAD_FACTOR, table->function_select,
+                               HASH_SWISS);
+    new_table->retired_next = NULL;
+
+    return new_table;
+}
+
+/*!
+ * @brief Copies a key value pair into a table, used when a shard is rebuilt.
+ * @param key Key to copy
+ * @param value Value to copy
+ * @param context Pointer to the destination hash table
+ * @return None
+ */
+static void copy_element(void *key, void *value, void *context)
+{
+    put((hash_table *)context, key, value);
+}
+
+/*!
+ * @brief Marks the start of a modification to a shard. The sequence becomes odd,
+ *        making readers which overlap the modification retry.
+ * @param shard Pointer to a shard whose lock is held
+ * @return None
+ */
+static void begin_write(concurrent_shard *shard)
+{
+    unsigned int sequence = atomic_load_explicit(&(shard->sequence), memory_order_relaxed);
+
+    atomic_store_explicit(&(shard->sequence), sequence + 1, memory_order_relaxed);
+    // Orders the odd sequence before any of the modifications
+    atomic_thread_fence(memory_order_release);
+}
+
+/*!
+ * @brief Marks the end of a modification to a shard.
+ * @param shard Pointer to a shard whose lock is held
+ * @return None
+ */
+static void end_write(concurrent_shard *shard)
+{
+    unsigned int sequence = atomic_load_explicit(&(shard->sequence), memory_order_relaxed);
+
+    atomic_store_explicit(&(shard->sequence), sequence + 1, memory_order_release);
+}
+
+/*!
+ * @brief Counts a reader into the current epoch of a shard.
+ * @param shard Pointer to a shard
+ * @return Epoch the reader entered in, to pass to exit_read()
+ */
+static unsigned int enter_read(concurrent_shard *shard)
+{
+    while (true)
+    {
+        unsigned int epoch = atomic_load(&(shard->epoch));
+
+        atomic_fetch_add(&((shard->readers)[epoch & 1]), 1);
+
+        // A writer may have advanced past the epoch before the reader was counted, in
+        // which case it could already be freeing tables the reader is about to load
+        if (atomic_load(&(shard->epoch)) == epoch)
+        {
+            return epoch;
+        }
+
+        atomic_fetch_sub(&((shard->readers)[epoch & 1]), 1);
+    }
+}
+
+/*!
+ * @brief Counts a reader out of the epoch it entered in.
+ * @param shard Pointer to a shard
+ * @param epoch Epoch returned by enter_read()
+ * @return None
+ */
+static void exit_read(concurrent_shard *shard, unsigned int epoch)
+{
+    // Orders the reader's loads from the table before a writer can see it leave
+    atomic_fetch_sub_explicit(&((shard->readers)[epoch & 1]), 1, memory_order_release);
+}
+
+/*!
+ * @brief Advances the epoch of a shard if no reader remains from the previous one, then
+ *        frees the replaced tables no reader can still hold. A table replaced in an
+ *        epoch is free once the epoch has advanced twice, as every reader which entered
+ *        before it was replaced has left by then.
+ * @param shard Pointer to a shard whose lock is held
+ * @return None
+ */
+static void reclaim_retired(concurrent_shard *shard)
+{
+    unsigned int epoch = atomic_load(&(shard->epoch));
+
+    if (atomic_load(&((shard->readers)[(epoch + 1) & 1])) == 0)
+    {
+        epoch++;
+        atomic_store(&(shard->epoch), epoch);
+    }
+
+    shard_table **link = &(shard->retired);
+
+    // The list is newest first, so every table after the first free one is also free
+    while (*link != NULL && epoch - (*link)->retired_epoch < 2)
+    {
+        link = &((*link)->retired_next);
+    }
+
+    while (*link != NULL)
+    {
+        shard_table *retired = *link;
+
+        *link = retired->retired_next;
+        free_hash_table(&(retired->table));
+        free(retired);
+    }
+}
+
+/*!
+ * @brief Rebuilds a shard into a new table, leaving its deleted markers behind. The new
+ *        table is filled before being published, so readers keep using the old one until
+ *        it is complete.
+ * @param table Pointer to a concurrent hash table
+ * @param shard Pointer to a shard whose lock is held
+ * @param current Table currently published by the shard
+ * @param capacity Number of slots in the new table
+ * @return Pointer to the newly published table
+ */
+static shard_table *rebuild_shard(concurrent_hash_table *table, concurrent_shard *shard, shard_table *current,
+                                  int capacity)
+{
+    hash_table *old_table = &(current->table);
+    shard_table *new_table = allocate_shard_table(table, capacity);
+
+    // Custom key functions are carried over from the old table
+    new_table->table.key_hash = old_table->key_hash;
+    new_table->table.key_equal = old_table->key_equal;
+    new_table->table.key_length = old_table->key_length;
+
+    hash_table_for_each(old_table, &copy_element, &(new_table->table));
+
+    atomic_store(&(shard->current), new_table);
+
+    // Readers may still hold the old table, so it is kept until a grace period has passed
+    current->retired_epoch = atomic_load(&(shard->epoch));
+    current->retired_next = shard->retired;
+    shard->retired = current;
+
+    reclaim_retired(shard);
+
+    return new_table;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes the concurrent hash table.
+ * @param table Pointer to a concurrent hash table
+ * @param num_shards Number of shards, rounded up to a power of two
+ * @param size Initial number of elements across all shards
+ * @param load_factor Percentage of a shard full at which it grows, capped at 0.75
+ * @param function_select Integer specifying which hash function to use
+ * @return None
+ */
+void initialize_concurrent_hash_table(concurrent_hash_table *table, int num_shards, int size, float load_factor,
+                                      int function_select)
+{
+    int shards = 1;
+
+    // Shards are selected by masking, so their number is a power of two
+    while (shards < num_shards)
+    {
+        shards *= 2;
+    }
+
+    table->num_shards = shards;
+    table->shard_mask = shards - 1;
+    table->load_factor = (load_factor > MAX_SHARD_LOAD_FACTOR) ? MAX_SHARD_LOAD_FACTOR : load_factor;
+    table->function_select = function_select;
+    table->shards = (concurrent_shard *)aligned_alloc(CONCURRENT_CACHE_LINE, shards * sizeof(concurrent_shard));
+
+    for (int i = 0; i < shards; i++)
+    {
+        concurrent_shard *shard = &((table->shards)[i]);
+        // Each shard is sized so the initial elements fit without growing
+        int capacity = (int)((size / shards + 1) / table->load_factor) + 1;
+
+        atomic_init(&(shard->sequence), 0);
+        atomic_init(&(shard->current), allocate_shard_table(table, capacity));
+        pthread_mutex_init(&(shard->lock), NULL);
+        shard->retired = NULL;
+        atomic_init(&(shard->epoch), 0);
+        atomic_init(&((shard->readers)[0]), 0);
+        atomic_init(&((shard->readers)[1]), 0);
+    }
+
+    // Every shard uses the same key functions, so the first one is used for shard selection
+    table->key_hash = (table->shards)[0].current->table.key_hash;
+    table->key_length = (table->shards)[0].current->table.key_length;
+}
+
+/*!
+ * @brief Adds or updates an element. Only writers to the same shard are blocked.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @return None
+ */
+void concurrent_put(concurrent_hash_table *table, void *hash_key, void *hash_value)
+{
+    concurrent_shard *shard = select_shard(table, hash_key);
+
+    pthread_mutex_lock(&(shard->lock));
+
+    shard_table *current = atomic_load_explicit(&(shard->current), memory_order_relaxed);
+    hash_table *shard_hash_table = &(current->table);
+    int capacity = 0;
+
+    // Every rebuild happens here, rather than within put(), so the arrays a reader may
+    // be probing are never freed in place. The shard doubles at its load factor, and
+    // otherwise is copied at the same size once deleted markers fill the shard table
+    if (shard_hash_table->num_elements + 1 > (int)(shard_hash_table->table_size * table->load_factor))
+    {
+        capacity = shard_hash_table->table_size * 2;
+    }
+    else if (shard_hash_table->num_elements + shard_hash_table->num_deleted + 1 >
+             (int)(shard_hash_table->table_size * SHARD_TABLE_LOAD_FACTOR))
+    {
+        capacity = shard_hash_table->table_size;
+    }
+
+    if (capacity != 0)
+    {
+        shard_hash_table = &(rebuild_shard(table, shard, current, capacity)->table);
+    }
+    else if (shard->retired != NULL)
+    {
+        // Tables left by earlier rebuilds are freed once the readers holding them have left
+        reclaim_retired(shard);
+    }
+
+    begin_write(shard);
+    put(shard_hash_table, hash_key, hash_value);
+    end_write(shard);
+
+    pthread_mutex_unlock(&(shard->lock));
+}
+
+/*!
+ * @brief Returns the element associated with a key without taking a lock. Keys which
+ *        point to memory, including removed keys, must stay valid while other threads
+ *        may be reading the table, as a reader may compare against a key being removed.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key associated with the element
+ * @return The value associated with the specified key, or NULL if it is not present
+ */
+void *concurrent_get(concurrent_hash_table *table, void *hash_key)
+{
+    concurrent_shard *shard = select_shard(table, hash_key);
+    // Tables this reader loads are not freed until it leaves
+    unsigned int epoch = enter_read(shard);
+
+    while (true)
+    {
+        unsigned int sequence = atomic_load_explicit(&(shard->sequence), memory_order_acquire);
+
+        // A writer is part way through modifying the shard
+        if (sequence & 1)
+        {
+            sched_yield();
+            continue;
+        }
+
+        shard_table *current = atomic_load_explicit(&(shard->current), memory_order_acquire);
+        void *value = get(&(current->table), hash_key);
+
+        // Orders the reads of the table before the sequence is checked again
+        atomic_thread_fence(memory_order_acquire);
+
+        // The value is only returned if no writer modified the shard in the meantime
+        if (atomic_load_explicit(&(shard->sequence), memory_order_relaxed) == sequence)
+        {
+            exit_read(shard, epoch);
+            return value;
+        }
+    }
+}
+
+/*!
+ * @brief Removes a key value pair. Only writers to the same shard are blocked.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key associated with the element
+ * @return None
+ */
+void concurrent_remove(concurrent_hash_table *table, void *hash_key)
+{
+    concurrent_shard *shard = select_shard(table, hash_key);
+
+    pthread_mutex_lock(&(shard->lock));
+
+    shard_table *current = atomic_load_explicit(&(shard->current), memory_order_relaxed);
+
+    begin_write(shard);
+    remove_hash(&(current->table), hash_key);
+    end_write(shard);
+
+    pthread_mutex_unlock(&(shard->lock));
+}
+
+/*!
+ * @brief Returns the number of elements across all shards. The result is only
+ *        exact when no writer is active.
+ * @param table Pointer to a concurrent hash table
+ * @return The number of elements stored
+ */
+int concurrent_num_elements(concurrent_hash_table *table)
+{
+    int num_elements = 0;
+
+    for (int i = 0; i < table->num_shards; i++)
+    {
+        shard_table *current = atomic_load_explicit(&((table->shards)[i].current), memory_order_acquire);
+
+        num_elements += current->table.num_elements;
+    }
+
+    return num_elements;
+}
+
+/*!
+ * @brief Frees the memory held by the concurrent hash table. No other thread may
+ *        be using the table.
+ * @param table Pointer to a concurrent hash table
+ * @return None
+ */
+void free_concurrent_hash_table(concurrent_hash_table *table)
+{
+    for (int i = 0; i < table->num_shards; i++)
+    {
+        concurrent_shard *shard = &((table->shards)[i]);
+        shard_table *current = atomic_load_explicit(&(shard->current), memory_order_relaxed);
+
+        free_hash_table(&(current->table));
+        free(current);
+
+        // Frees every table replaced by a rebuild
+        while (shard->retired != NULL)
+        {
+            shard_table *retired = shard->retired;
+
+            shard->retired = retired->retired_next;
+            free_hash_table(&(retired->table));
+            free(retired);
+        }
+
+        pthread_mutex_destroy(&(shard->lock));
+    }
+
+    free(table->shards);
+
+    // Avoid dangling pointer
+    table->shards = NULL;
+}
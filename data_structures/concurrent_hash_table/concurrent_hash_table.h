@@ -0,0 +1,150 @@
+/**
+ ********************************************************************************
+ * @file    concurrent_hash_table.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a hash table shared between
+ *          threads. The key space is split into shards, each an open addressing
+ *          hash table guarded by a sequence lock. Readers never take a lock, and
+ *          writers only contend with other writers to the same shard.
+ ********************************************************************************
+ */
+
+#ifndef CONCURRENT_HASH_TABLE_H
+#define CONCURRENT_HASH_TABLE_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdatomic.h>
+#include <pthread.h>
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Size of a cache line, used to keep shards from sharing one
+#define CONCURRENT_CACHE_LINE 64
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct holding a table published to readers of a shard.
+ */
+typedef struct shard_table
+{
+    // Open addressing table holding the shard's elements
+    hash_table table;
+    // Shard epoch in which the table was replaced by a rebuild
+    unsigned int retired_epoch;
+    // Next table in the list of tables replaced by a rebuild
+    struct shard_table *retired_next;
+} shard_table;
+
+/*!
+ * @brief Struct representing one shard of a concurrent hash table.
+ */
+typedef struct concurrent_shard
+{
+    // Sequence counter, odd while a writer is modifying the shard
+    atomic_uint sequence;
+    // Table currently published to readers
+    _Atomic(shard_table *) current;
+    // Serializes writers to the shard
+    pthread_mutex_t lock;
+    // Tables replaced by growth or by clearing deleted markers, newest first. Readers
+    // may still be probing them, so each is freed once the epoch has advanced twice
+    shard_table *retired;
+    // Grace period epoch, advanced by writers once every reader which entered in the
+    // previous epoch has left
+    atomic_uint epoch;
+    // Readers inside concurrent_get(), counted by the parity of the epoch they entered
+    // in. Every read updates them, so they are kept off the sequence's cache line
+    _Alignas(CONCURRENT_CACHE_LINE) atomic_int readers[2];
+} __attribute__((aligned(CONCURRENT_CACHE_LINE))) concurrent_shard;
+
+/*!
+ * @brief Struct which represents a concurrent hash table.
+ */
+typedef struct concurrent_hash_table
+{
+    // Number of shards, a power of two
+    int num_shards;
+    // Mask applied to the upper half of a key's mixed hash to select a shard
+    int shard_mask;
+    // Load factor at which a shard grows
+    float load_factor;
+    // Hash function selection used by every shard
+    int function_select;
+    // Function producing the hash of a key, shared by every shard
+    hash_key_function key_hash;
+    // Length of each key passed to the hash function
+    size_t key_length;
+    // Pointer to the array of shards
+    concurrent_shard *shards;
+} concurrent_hash_table;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes the concurrent hash table.
+ * @param table Pointer to a concurrent hash table
+ * @param num_shards Number of shards, rounded up to a power of two
+ * @param size Initial number of elements across all shards
+ * @param load_factor Percentage of a shard full at which it grows, capped at 0.75
+ * @param function_select Integer specifying which hash function to use
+ * @return None
+ */
+void initialize_concurrent_hash_table(concurrent_hash_table *table, int num_shards, int size, float load_factor,
+                                      int function_select);
+
+/*!
+ * @brief Adds or updates an element. Only writers to the same shard are blocked.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @return None
+ */
+void concurrent_put(concurrent_hash_table *table, void *hash_key, void *hash_value);
+
+/*!
+ * @brief Returns the element associated with a key without taking a lock. Keys which
+ *        point to memory, including removed keys, must stay valid while other threads
+ *        may be reading the table, as a reader may compare against a key being removed.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key associated with the element
+ * @return The value associated with the specified key, or NULL if it is not present
+ */
+void *concurrent_get(concurrent_hash_table *table, void *hash_key);
+
+/*!
+ * @brief Removes a key value pair. Only writers to the same shard are blocked.
+ * @param table Pointer to a concurrent hash table
+ * @param hash_key Key associated with the element
+ * @return None
+ */
+void concurrent_remove(concurrent_hash_table *table, void *hash_key);
+
+/*!
+ * @brief Returns the number of elements across all shards. The result is only
+ *        exact when no writer is active.
+ * @param table Pointer to a concurrent hash table
+ * @return The number of elements stored
+ */
+int concurrent_num_elements(concurrent_hash_table *table);
+
+/*!
+ * @brief Frees the memory held by the concurrent hash table. No other thread may
+ *        be using the table.
+ * @param table Pointer to a concurrent hash table
+ * @return None
+ */
+void free_concurrent_hash_table(concurrent_hash_table *table);
+
+#endif // CONCURRENT_HASH_TABLE_H
@@ -0,0 +1,403 @@
+/**
+ ********************************************************************************
+ * @file    expiring_map.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a map with expiring entries.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "expiring_map.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Load factor of the table mapping keys to entries
+#define EXPIRING_LOAD_FACTOR 0.875
+// Mask selecting a slot within a level
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+// Number of ticks spanned by one slot of a level
+#define LEVEL_SPAN(level) (1ULL << (TIMER_WHEEL_BITS * (level)))
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Links an entry into the slot of the wheel covering a tick. Ticks further
+ *        ahead than the wheel reaches are placed in the last slot the top level
+ *        reaches, and placed again when that slot is cascaded.
+ * @param map Pointer to a map
+ * @param entry Entry which is not linked into the wheel
+ * @param due Tick at which the entry should be visited, no earlier than the map's tick
+ * @return None
+ */
+static void link_entry(expiring_map *map, expiring_entry *entry, uint64_t due)
+{
+    uint64_t delta = due - map->now;
+    int level = 0;
+
+    // The level is the lowest whose whole span of slots reaches the due tick
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= LEVEL_SPAN(level + 1))
+    {
+        level++;
+    }
+
+    if (delta >= LEVEL_SPAN(TIMER_WHEEL_LEVELS))
+    {
+        due = map->now + LEVEL_SPAN(TIMER_WHEEL_LEVELS) - 1;
+    }
+
+    int slot = (int)(due >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+    expiring_entry **head = &(map->wheel)[level][slot];
+
+    entry->level = (unsigned char)level;
+    entry->slot = (unsigned char)slot;
+    entry->previous = NULL;
+    entry->next = *head;
+
+    if (*head != NULL)
+    {
+        (*head)->previous = entry;
+    }
+
+    *head = entry;
+    (map->level_counts)[level]++;
+}
+
+/*!
+ * @brief Unlinks an entry from its slot of the wheel.
+ * @param map Pointer to a map
+ * @param entry Entry linked into the wheel
+ * @return None
+ */
+static void unlink_entry(expiring_map *map, expiring_entry *entry)
+{
+    if (entry->previous != NULL)
+    {
+        (entry->previous)->next = entry->next;
+    }
+    else
+    {
+        (map->wheel)[entry->level][entry->slot] = entry->next;
+    }
+
+    if (entry->next != NULL)
+    {
+        (entry->next)->previous = entry->previous;
+    }
+
+    (map->level_counts)[entry->level]--;
+}
+
+/*!
+ * @brief Empties a slot of the wheel, returning its entries.
+ * @param map Pointer to a map
+ * @param level Level of the slot
+ * @param slot Slot within the level
+ * @return The first entry of the slot, linked to the rest through their next pointers
+ */
+static expiring_entry *take_slot(expiring_map *map, int level, int slot)
+{
+    expiring_entry *entries = (map->wheel)[level][slot];
+
+    (map->wheel)[level][slot] = NULL;
+
+    for (expiring_entry *entry = entries; entry != NULL; entry = entry->next)
+    {
+        (map->level_counts)[level]--;
+    }
+
+    return entries;
+}
+
+/*!
+ * @brief Moves the map to the next tick at which something may be due. Slots of
+ *        higher levels whose span begins at the tick are cascaded to lower levels
+ *        first, then every entry in the tick's slot of the first level expires.
+ * @param map Pointer to a map
+ * @param next_tick Tick to move to
+ * @return Number of entries expired
+ */
+static int tick(expiring_map *map, uint64_t next_tick)
+{
+    int expired = 0;
+
+    map->now = next_tick;
+
+    for (int level = TIMER_WHEEL_LEVELS - 1; level > 0; level--)
+    {
+        if ((next_tick & (LEVEL_SPAN(level) - 1)) == 0)
+        {
+            int slot = (int)(next_tick >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK;
+            expiring_entry *entry = take_slot(map, level, slot);
+
+            // Each entry lands in a lower level, or the first level slot handled below
+            while (entry != NULL)
+            {
+                expiring_entry *next = entry->next;
+
+                link_entry(map, entry, entry->expires_at);
+                entry = next;
+            }
+        }
+    }
+
+    expiring_entry *entry = take_slot(map, 0, (int)next_tick & TIMER_WHEEL_MASK);
+
+    while (entry != NULL)
+    {
+        expiring_entry *next = entry->next;
+
+        remove_hash(&map->table, entry->key);
+
+        if (map->on_expire != NULL)
+        {
+            (map->on_expire)(entry->key, entry->value, map->expire_context);
+        }
+
+        free(entry);
+        entry = next;
+        expired++;
+    }
+
+    return expired;
+}
+
+/*!
+ * @brief Sets the fields shared by both initializers.
+ * @param map Pointer to a map
+ * @param now Current tick
+ * @return None
+ */
+static void initialize_wheel(expiring_map *map, uint64_t now)
+{
+    memset(map->wheel, 0, sizeof(map->wheel));
+    memset(map->level_counts, 0, sizeof(map->level_counts));
+
+    map->now = now;
+    map->on_expire = NULL;
+    map->expire_context = NULL;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes the map
+ * @param map Pointer to a map
+ * @param size Initial size of the hash table
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @param now Current tick
+ * @return None
+ */
+void initialize_expiring_map(expiring_map *map, int size, int function_select, uint64_t now)
+{
+    initialize_hash_table_mode(&map->table, size, EXPIRING_LOAD_FACTOR, function_select, HASH_SWISS);
+    initialize_wheel(map, now);
+}
+
+/*!
+ * @brief Initializes the map with user defined key hashing and equality.
+ * @param map Pointer to a map
+ * @param size Initial size of the hash table
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @param now Current tick
+ * @return None
+ */
+void initialize_expiring_map_keys(expiring_map *map, int size, size_t key_length, hash_key_function key_hash,
+                                  hash_equal_function key_equal, uint64_t now)
+{
+    initialize_hash_table_keys(&map->table, size, EXPIRING_LOAD_FACTOR, HASH_SWISS, key_length, key_hash,
+                               key_equal);
+    initialize_wheel(map, now);
+}
+
+/*!
+ * @brief Sets the function called with each entry removed by expiring.
+ * @param map Pointer to a map
+ * @param on_expire Function called with each expired entry, or NULL
+ * @param context Pointer passed through to the function
+ * @return None
+ */
+void set_expiry_callback(expiring_map *map, expiry_function on_expire, void *context)
+{
+    map->on_expire = on_expire;
+    map->expire_context = context;
+}
+
+/*!
+ * @brief Adds or replaces an entry which expires ttl ticks after now. A ttl of 0
+ *        expires the entry at the next call to expiring_advance().
+ * @param map Pointer to a map
+ * @param key Key of the entry
+ * @param value Value of the entry
+ * @param now Current tick, taken as the map's tick if earlier
+ * @param ttl Number of ticks until the entry expires
+ * @return The value the key replaced, which is not passed to the expiry function,
+ *         or NULL if the key was not in the map
+ */
+void *expiring_put(expiring_map *map, void *key, void *value, uint64_t now, uint64_t ttl)
+{
+    expiring_entry *entry = (expiring_entry *)get(&map->table, key);
+    void *replaced = NULL;
+
+    if (entry != NULL)
+    {
+        // The entry keeps its place in the table and moves to its new slot of the wheel
+        replaced = entry->value;
+        unlink_entry(map, entry);
+    }
+    else
+    {
+        entry = (expiring_entry *)malloc(sizeof(expiring_entry));
+        entry->key = key;
+        put(&map->table, key, entry);
+    }
+
+    if (now < map->now)
+    {
+        now = map->now;
+    }
+
+    entry->value = value;
+    entry->expires_at = now + ttl;
+
+    // The slot for the map's own tick has already been visited
+    link_entry(map, entry, (entry->expires_at > map->now) ? entry->expires_at : map->now + 1);
+
+    return replaced;
+}
+
+/*!
+ * @brief Returns the value of a key, treating entries due at or before now as absent
+ *        even if expiring_advance() has not yet removed them.
+ * @param map Pointer to a map
+ * @param key Key to look up
+ * @param now Current tick
+ * @return The value of the key, or NULL if the key is absent or has expired
+ */
+void *expiring_get(expiring_map *map, void *key, uint64_t now)
+{
+    expiring_entry *entry = (expiring_entry *)get(&map->table, key);
+
+    if (entry == NULL || entry->expires_at <= now || entry->expires_at <= map->now)
+    {
+        return NULL;
+    }
+
+    return entry->value;
+}
+
+/*!
+ * @brief Removes an entry without calling the expiry function.
+ * @param map Pointer to a map
+ * @param key Key of the entry to remove
+ * @return The value of the removed entry, or NULL if the key was not in the map
+ */
+void *expiring_remove(expiring_map *map, void *key)
+{
+    expiring_entry *entry = (expiring_entry *)get(&map->table, key);
+
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+
+    void *value = entry->value;
+
+    unlink_entry(map, entry);
+    remove_hash(&map->table, key);
+    free(entry);
+
+    return value;
+}
+
+/*!
+ * @brief Advances the wheel to a tick, removing every entry due at or before it and
+ *        calling the expiry function for each. Each entry is moved between levels at
+ *        most TIMER_WHEEL_LEVELS times, and runs of ticks with nothing due are skipped.
+ * @param map Pointer to a map
+ * @param now Tick to advance to. Ticks at or before the map's tick are ignored
+ * @return Number of entries expired
+ */
+int expiring_advance(expiring_map *map, uint64_t now)
+{
+    int expired = 0;
+
+    while (map->now < now)
+    {
+        int level = 0;
+
+        // Only the lowest level holding entries can make anything due before it cascades
+        while (level < TIMER_WHEEL_LEVELS && (map->level_counts)[level] == 0)
+        {
+            level++;
+        }
+
+        if (level == TIMER_WHEEL_LEVELS)
+        {
+            map->now = now;
+            break;
+        }
+
+        // Next tick at which a slot of that level is visited
+        uint64_t next = (map->now / LEVEL_SPAN(level) + 1) * LEVEL_SPAN(level);
+
+        if (next > now)
+        {
+            map->now = now;
+            break;
+        }
+
+        expired += tick(map, next);
+    }
+
+    return expired;
+}
+
+/*!
+ * @brief Returns the number of entries in the map, including entries which are due
+ *        but not yet removed by expiring_advance().
+ * @param map Pointer to a map
+ * @return Number of entries
+ */
+int expiring_num_elements(expiring_map *map)
+{
+    return map->table.num_elements;
+}
+
+/*!
+ * @brief Frees the memory held by the map. The expiry function is not called for the
+ *        entries still held.
+ * @param map Pointer to a map
+ * @return None
+ */
+void free_expiring_map(expiring_map *map)
+{
+    for (int level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        for (int slot = 0; slot < TIMER_WHEEL_SLOTS; slot++)
+        {
+            expiring_entry *entry = take_slot(map, level, slot);
+
+            while (entry != NULL)
+            {
+                expiring_entry *next = entry->next;
+
+                free(entry);
+                entry = next;
+            }
+        }
+    }
+
+    free_hash_table(&map->table);
+}
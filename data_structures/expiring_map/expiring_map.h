@@ -0,0 +1,183 @@
+/**
+ ********************************************************************************
+ * @file    expiring_map.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a map whose entries expire
+ *          after a per key time to live. A hash table finds entries by key, and
+ *          a hierarchical timing wheel finds them by expiry time, so advancing
+ *          the clock only visits entries which are due instead of scanning the
+ *          whole table. Time is counted in caller defined ticks, such as
+ *          milliseconds.
+ ********************************************************************************
+ */
+
+#ifndef EXPIRING_MAP_H
+#define EXPIRING_MAP_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Number of bits of the expiry time resolved by each level of the wheel
+#define TIMER_WHEEL_BITS 6
+// Number of slots in each level of the wheel
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+// Number of levels. Expiry times further ahead than TIMER_WHEEL_SLOTS to the power of
+// TIMER_WHEEL_LEVELS ticks wait in the last slot of the top level and are placed again
+#define TIMER_WHEEL_LEVELS 4
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Function called with each entry removed from the map by expiring.
+ * @param key Key of the expired entry
+ * @param value Value of the expired entry
+ * @param context Pointer given to set_expiry_callback()
+ * @return None
+ */
+typedef void (*expiry_function)(void *key, void *value, void *context);
+
+/*!
+ * @brief Struct representing an entry of the map, linked into one slot of the wheel.
+ */
+typedef struct expiring_entry
+{
+    // Key of the entry
+    void *key;
+    // Value of the entry
+    void *value;
+    // Tick at which the entry expires
+    uint64_t expires_at;
+    // Previous entry in the same slot of the wheel
+    struct expiring_entry *previous;
+    // Next entry in the same slot of the wheel
+    struct expiring_entry *next;
+    // Level of the wheel holding the entry
+    unsigned char level;
+    // Slot within the level holding the entry
+    unsigned char slot;
+} expiring_entry;
+
+/*!
+ * @brief Struct which represents a map with expiring entries.
+ */
+typedef struct expiring_map
+{
+    // Maps each key to its entry
+    hash_table table;
+    // Lists of entries by level and slot. A slot of level L holds entries expiring
+    // within a span of TIMER_WHEEL_SLOTS to the power of L ticks
+    expiring_entry *wheel[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS];
+    // Number of entries held by each level
+    int level_counts[TIMER_WHEEL_LEVELS];
+    // Tick the wheel has been advanced to. Every entry due at or before it has expired
+    uint64_t now;
+    // Function called with each expired entry, or NULL
+    expiry_function on_expire;
+    // Pointer passed through to the expiry function
+    void *expire_context;
+} expiring_map;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes the map
+ * @param map Pointer to a map
+ * @param size Initial size of the hash table
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @param now Current tick
+ * @return None
+ */
+void initialize_expiring_map(expiring_map *map, int size, int function_select, uint64_t now);
+
+/*!
+ * @brief Initializes the map with user defined key hashing and equality.
+ * @param map Pointer to a map
+ * @param size Initial size of the hash table
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @param now Current tick
+ * @return None
+ */
+void initialize_expiring_map_keys(expiring_map *map, int size, size_t key_length, hash_key_function key_hash,
+                                  hash_equal_function key_equal, uint64_t now);
+
+/*!
+ * @brief Sets the function called with each entry removed by expiring.
+ * @param map Pointer to a map
+ * @param on_expire Function called with each expired entry, or NULL
+ * @param context Pointer passed through to the function
+ * @return None
+ */
+void set_expiry_callback(expiring_map *map, expiry_function on_expire, void *context);
+
+/*!
+ * @brief Adds or replaces an entry which expires ttl ticks after now. A ttl of 0
+ *        expires the entry at the next call to expiring_advance().
+ * @param map Pointer to a map
+ * @param key Key of the entry
+ * @param value Value of the entry
+ * @param now Current tick, taken as the map's tick if earlier
+ * @param ttl Number of ticks until the entry expires
+ * @return The value the key replaced, which is not passed to the expiry function,
+ *         or NULL if the key was not in the map
+ */
+void *expiring_put(expiring_map *map, void *key, void *value, uint64_t now, uint64_t ttl);
+
+/*!
+ * @brief Returns the value of a key, treating entries due at or before now as absent
+ *        even if expiring_advance() has not yet removed them.
+ * @param map Pointer to a map
+ * @param key Key to look up
+ * @param now Current tick
+ * @return The value of the key, or NULL if the key is absent or has expired
+ */
+void *expiring_get(expiring_map *map, void *key, uint64_t now);
+
+/*!
+ * @brief Removes an entry without calling the expiry function.
+ * @param map Pointer to a map
+ * @param key Key of the entry to remove
+ * @return The value of the removed entry, or NULL if the key was not in the map
+ */
+void *expiring_remove(expiring_map *map, void *key);
+
+/*!
+ * @brief Advances the wheel to a tick, removing every entry due at or before it and
+ *        calling the expiry function for each. Each entry is moved between levels at
+ *        most TIMER_WHEEL_LEVELS times, and runs of ticks with nothing due are skipped.
+ * @param map Pointer to a map
+ * @param now Tick to advance to. Ticks at or before the map's tick are ignored
+ * @return Number of entries expired
+ */
+int expiring_advance(expiring_map *map, uint64_t now);
+
+/*!
+ * @brief Returns the number of entries in the map, including entries which are due
+ *        but not yet removed by expiring_advance().
+ * @param map Pointer to a map
+ * @return Number of entries
+ */
+int expiring_num_elements(expiring_map *map);
+
+/*!
+ * @brief Frees the memory held by the map. The expiry function is not called for the
+ *        entries still held.
+ * @param map Pointer to a map
+ * @return None
+ */
+void free_expiring_map(expiring_map *map);
+
+#endif // EXPIRING_MAP_H
@@ -0,0 +1,672 @@
+/**
+ ********************************************************************************
+ * @file    extendible_hash_table.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on an extendible hash table kept in a file of
+ *          fixed size pages.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <fcntl.h>
+#include <unistd.h>
+#include "extendible_hash_table.h"
+
+/************************************
+ * PRIVATE TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct representing a page held by the buffer pool.
+ */
+typedef struct extendible_frame
+{
+    // Page number within the file
+    uint64_t page;
+    // True if the page has changed since it was read or last written
+    bool dirty;
+    // Contents of the page, aligned for the page header
+    _Alignas(uint64_t) unsigned char data[];
+} extendible_frame;
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Returns the directory entry for a hash, taken from its top global_depth bits.
+ * @param table Pointer to an extendible hash table
+ * @param hash Hash of a key
+ * @return Index into the directory
+ */
+static uint64_t directory_index(extendible_hash_table *table, uint64_t hash)
+{
+    // Shifting a 64 bit value by 64 is undefined, and a depth of 0 has a single entry
+    return (table->header.global_depth == 0) ? 0 : hash >> (64 - table->header.global_depth);
+}
+
+/*!
+ * @brief Returns the header at the start of a bucket page.
+ * @param frame Pointer to a frame holding a bucket page
+ * @return Pointer to the page header
+ */
+static extendible_page_header *page_header(extendible_frame *frame)
+{
+    return (extendible_page_header *)frame->data;
+}
+
+/*!
+ * @brief Returns a record of a bucket page.
+ * @param table Pointer to an extendible hash table
+ * @param frame Pointer to a frame holding a bucket page
+ * @param index Index of the record
+ * @return Pointer to the record's key, which its value follows
+ */
+static unsigned char *record_at(extendible_hash_table *table, extendible_frame *frame, int index)
+{
+    return frame->data + sizeof(extendible_page_header) + (size_t)index * table->record_size;
+}
+
+/*!
+ * @brief Finds the record holding a key in a bucket page.
+ * @param table Pointer to an extendible hash table
+ * @param frame Pointer to a frame holding the key's bucket page
+ * @param key Pointer to the key bytes
+ * @return Index of the record, or -1 if the key is not present
+ */
+static int find_record(extendible_hash_table *table, extendible_frame *frame, const void *key)
+{
+    for (int i = 0; i < (int)page_header(frame)->count; i++)
+    {
+        if (memcmp(record_at(table, frame, i), key, table->header.key_size) == 0)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief Writes a page to its place in the file.
+ * @param table Pointer to an extendible hash table
+ * @param page Page number
+ * @param data Pointer to EXTENDIBLE_PAGE_SIZE bytes
+ * @return True if the page was written
+ */
+static bool write_page(extendible_hash_table *table, uint64_t page, const unsigned char *data)
+{
+    off_t offset = (off_t)(page * EXTENDIBLE_PAGE_SIZE);
+
+    if (pwrite(table->fd, data, EXTENDIBLE_PAGE_SIZE, offset) != EXTENDIBLE_PAGE_SIZE)
+    {
+        table->io_error = true;
+        return false;
+    }
+
+    table->counters.page_writes++;
+
+    return true;
+}
+
+/*!
+ * @brief Writes back a page leaving the buffer pool if it has changed, then frees it.
+ *        Pages are written back by make_room() before the pool evicts them, so only
+ *        pages a failed checkpoint left changed are written here, when the table closes.
+ * @param key Page number
+ * @param value Pointer to the page's frame
+ * @param context Pointer to the extendible hash table
+ * @return None
+ */
+static void evict_frame(void *key, void *value, void *context)
+{
+    (void)key;
+
+    extendible_frame *frame = (extendible_frame *)value;
+
+    if (frame->dirty)
+    {
+        write_page((extendible_hash_table *)context, frame->page, frame->data);
+    }
+
+    free(frame);
+}
+
+/*!
+ * @brief Evicts the least recently used page if the buffer pool is full, writing it
+ *        back first if it has changed. A page which cannot be written stays in the pool
+ *        with its changes, so nothing is lost.
+ * @param table Pointer to an extendible hash table
+ * @return True if the pool has room for another page
+ */
+static bool make_room(extendible_hash_table *table)
+{
+    if ((size_t)lru_num_elements(&(table->pool)) < table->pool.max_entries)
+    {
+        return true;
+    }
+
+    extendible_frame *frame = (extendible_frame *)((lru_entry *)table->pool.list.tail->value)->value;
+
+    if (frame->dirty)
+    {
+        if (!write_page(table, frame->page, frame->data))
+        {
+            return false;
+        }
+
+        frame->dirty = false;
+    }
+
+    return lru_evict(&(table->pool));
+}
+
+/*!
+ * @brief Returns a page from the buffer pool, reading it from the file if it is not
+ *        held. The page becomes the most recently used.
+ * @param table Pointer to an extendible hash table
+ * @param page Page number of a bucket
+ * @return Pointer to the page's frame, or NULL if it could not be read, or the page it
+ *         would replace in the pool could not be written back
+ */
+static extendible_frame *fetch_page(extendible_hash_table *table, uint64_t page)
+{
+    extendible_frame *frame = (extendible_frame *)lru_get(&table->pool, (void *)(uintptr_t)page);
+
+    if (frame != NULL)
+    {
+        return frame;
+    }
+
+    if (!make_room(table))
+    {
+        return NULL;
+    }
+
+    frame = (extendible_frame *)malloc(sizeof(extendible_frame) + EXTENDIBLE_PAGE_SIZE);
+
+    if (pread(table->fd, frame->data, EXTENDIBLE_PAGE_SIZE, (off_t)(page * EXTENDIBLE_PAGE_SIZE)) !=
+        EXTENDIBLE_PAGE_SIZE)
+    {
+        free(frame);
+        table->io_error = true;
+        return NULL;
+    }
+
+    frame->page = page;
+    frame->dirty = false;
+    table->counters.page_reads++;
+
+    lru_put(&table->pool, (void *)(uintptr_t)page, frame, 1);
+
+    return frame;
+}
+
+/*!
+ * @brief Allocates an empty bucket page at the end of the file. The page is only held
+ *        by the buffer pool until it is first written back.
+ * @param table Pointer to an extendible hash table
+ * @return Pointer to the page's frame, or NULL if the page it would replace in the
+ *         pool could not be written back
+ */
+static extendible_frame *allocate_page(extendible_hash_table *table)
+{
+    if (!make_room(table))
+    {
+        return NULL;
+    }
+
+    extendible_frame *frame = (extendible_frame *)calloc(1, sizeof(extendible_frame) + EXTENDIBLE_PAGE_SIZE);
+
+    frame->page = table->header.num_pages++;
+    frame->dirty = true;
+
+    lru_put(&table->pool, (void *)(uintptr_t)frame->page, frame, 1);
+
+    return frame;
+}
+
+/*!
+ * @brief Doubles the directory, each entry becoming two adjacent entries for the same
+ *        page. Only the in memory directory changes.
+ * @param table Pointer to an extendible hash table
+ * @return None
+ */
+static void double_directory(extendible_hash_table *table)
+{
+    uint64_t size = (uint64_t)1 << (table->header.global_depth + 1);
+
+    table->directory = (uint64_t *)realloc(table->directory, size * sizeof(uint64_t));
+
+    // Filling from the end reads each old entry before it is overwritten
+    for (uint64_t i = size; i-- > 0;)
+    {
+        (table->directory)[i] = (table->directory)[i >> 1];
+    }
+
+    table->header.global_depth++;
+    table->counters.doublings++;
+}
+
+/*!
+ * @brief Splits a full bucket on the next bit of its keys' hashes. Keys with the bit
+ *        set move to a new page, and the upper half of the directory entries which led
+ *        to the bucket are pointed at it. No other bucket is touched.
+ * @param table Pointer to an extendible hash table
+ * @param frame Pointer to the frame of the full bucket, the most recently used page
+ * @param hash Hash of a key which maps to the bucket
+ * @return True if the bucket was split, false if the directory is already at
+ *         EXTENDIBLE_MAX_DEPTH bits or the new page could not be allocated
+ */
+static bool split_bucket(extendible_hash_table *table, extendible_frame *frame, uint64_t hash)
+{
+    uint32_t depth = page_header(frame)->local_depth;
+
+    if (depth == EXTENDIBLE_MAX_DEPTH)
+    {
+        return false;
+    }
+
+    // The full bucket was used last, so adding the new page never evicts it
+    extendible_frame *sibling = allocate_page(table);
+
+    // Nothing has changed yet when the new page cannot be allocated
+    if (sibling == NULL)
+    {
+        return false;
+    }
+
+    if (depth == table->header.global_depth)
+    {
+        double_directory(table);
+    }
+
+    uint64_t bit = (uint64_t)1 << (63 - depth);
+    int kept = 0;
+
+    for (int i = 0; i < (int)page_header(frame)->count; i++)
+    {
+        unsigned char *record = record_at(table, frame, i);
+
+        if ((hash_bytes(record, table->header.key_size) & bit) != 0)
+        {
+            memcpy(record_at(table, sibling, (int)page_header(sibling)->count++), record, table->record_size);
+        }
+        else
+        {
+            // Kept records are packed towards the start of the page
+            if (kept != i)
+            {
+                memcpy(record_at(table, frame, kept), record, table->record_size);
+            }
+
+            kept++;
+        }
+    }
+
+    page_header(frame)->count = (uint32_t)kept;
+    page_header(frame)->local_depth = depth + 1;
+    page_header(sibling)->local_depth = depth + 1;
+    frame->dirty = true;
+
+    // The entries sharing the bucket's depth bits form one run of the directory
+    uint32_t shift = table->header.global_depth - depth;
+    uint64_t first = (directory_index(table, hash) >> shift) << shift;
+    uint64_t span = (uint64_t)1 << shift;
+
+    for (uint64_t i = first + span / 2; i < first + span; i++)
+    {
+        (table->directory)[i] = sibling->page;
+    }
+
+    table->counters.splits++;
+
+    return true;
+}
+
+/*!
+ * @brief Sets up the fields of a table shared by creating and opening its file.
+ * @param table Pointer to an extendible hash table with its header read
+ * @param pool_pages Number of pages the buffer pool holds
+ * @return None
+ */
+static void initialize_table(extendible_hash_table *table, int pool_pages)
+{
+    table->record_size = (size_t)table->header.key_size + table->header.value_size;
+    table->bucket_capacity = (int)((EXTENDIBLE_PAGE_SIZE - sizeof(extendible_page_header)) / table->record_size);
+    table->io_error = false;
+
+    memset(&(table->counters), 0, sizeof(extendible_counters));
+
+    // Page numbers are stored in the key pointer, and page 0 is never cached
+    initialize_lru_cache(&(table->pool), (pool_pages < EXTENDIBLE_MIN_POOL_PAGES) ? EXTENDIBLE_MIN_POOL_PAGES : pool_pages,
+                         0, HASH_FIBONACCI);
+    set_lru_eviction_callback(&(table->pool), &evict_frame, table);
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Creates a new extendible hash table file, replacing any existing file, and
+ *        opens it. Every key and every value has a fixed size.
+ * @param table Pointer to an extendible hash table
+ * @param path Path of the file
+ * @param key_size Number of bytes in each key
+ * @param value_size Number of bytes in each value
+ * @param pool_pages Number of pages the buffer pool holds, at least EXTENDIBLE_MIN_POOL_PAGES
+ * @return True if the file was created, false if it could not be or a page cannot hold
+ *         two records
+ */
+bool create_extendible_hash_table(extendible_hash_table *table, const char *path, size_t key_size, size_t value_size,
+                                  int pool_pages)
+{
+    table->fd = -1;
+    table->directory = NULL;
+
+    // A bucket which cannot hold two records could never be split
+    if (key_size == 0 || (key_size + value_size) * 2 > EXTENDIBLE_PAGE_SIZE - sizeof(extendible_page_header))
+    {
+        return false;
+    }
+
+    table->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+    if (table->fd < 0)
+    {
+        return false;
+    }
+
+    memset(&(table->header), 0, sizeof(extendible_header));
+    memcpy(table->header.magic, EXTENDIBLE_MAGIC, sizeof(EXTENDIBLE_MAGIC));
+    table->header.version = EXTENDIBLE_VERSION;
+    table->header.page_size = EXTENDIBLE_PAGE_SIZE;
+    table->header.key_size = (uint32_t)key_size;
+    table->header.value_size = (uint32_t)value_size;
+    // Page 0 holds the header
+    table->header.num_pages = 1;
+
+    initialize_table(table, pool_pages);
+
+    // A single bucket serves the empty prefix of a directory with one entry
+    table->directory = (uint64_t *)malloc(sizeof(uint64_t));
+    (table->directory)[0] = allocate_page(table)->page;
+
+    // The file is readable by open_extendible_hash_table() from the start
+    if (!extendible_checkpoint(table))
+    {
+        close_extendible_hash_table(table);
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Opens an existing extendible hash table file, reading its header and directory.
+ *        Bucket pages are read as lookups reach them.
+ * @param table Pointer to an extendible hash table
+ * @param path Path of the file
+ * @param pool_pages Number of pages the buffer pool holds, at least EXTENDIBLE_MIN_POOL_PAGES
+ * @return True if the file was opened and holds a table of this version
+ */
+bool open_extendible_hash_table(extendible_hash_table *table, const char *path, int pool_pages)
+{
+    extendible_header *header = &(table->header);
+
+    table->directory = NULL;
+    table->fd = open(path, O_RDWR);
+
+    if (table->fd < 0)
+    {
+        return false;
+    }
+
+    if (pread(table->fd, header, sizeof(extendible_header), 0) != sizeof(extendible_header) ||
+        memcmp(header->magic, EXTENDIBLE_MAGIC, sizeof(EXTENDIBLE_MAGIC)) != 0 ||
+        header->version != EXTENDIBLE_VERSION || header->page_size != EXTENDIBLE_PAGE_SIZE ||
+        header->global_depth > EXTENDIBLE_MAX_DEPTH || header->directory_pages == 0)
+    {
+        close(table->fd);
+        table->fd = -1;
+        return false;
+    }
+
+    size_t directory_bytes = sizeof(uint64_t) << header->global_depth;
+
+    table->directory = (uint64_t *)malloc(directory_bytes);
+
+    if (pread(table->fd, table->directory, directory_bytes, (off_t)(header->directory_page * EXTENDIBLE_PAGE_SIZE)) !=
+        (ssize_t)directory_bytes)
+    {
+        free(table->directory);
+        table->directory = NULL;
+        close(table->fd);
+        table->fd = -1;
+        return false;
+    }
+
+    initialize_table(table, pool_pages);
+
+    return true;
+}
+
+/*!
+ * @brief Adds or updates an element, copying the key and value into its bucket. A full
+ *        bucket is split, doubling the directory if needed, until the key's bucket has
+ *        room.
+ * @param table Pointer to an extendible hash table
+ * @param key Pointer to the key_size key bytes
+ * @param value Pointer to the value_size value bytes
+ * @return True if the element was stored, false if a page could not be read or
+ *         written back, or the directory would grow past EXTENDIBLE_MAX_DEPTH bits
+ */
+bool extendible_put(extendible_hash_table *table, const void *key, const void *value)
+{
+    uint64_t hash = hash_bytes(key, table->header.key_size);
+
+    // Each split leaves the key's bucket in the pool, so only the first pass may read a page
+    while (true)
+    {
+        extendible_frame *frame = fetch_page(table, (table->directory)[directory_index(table, hash)]);
+
+        if (frame == NULL)
+        {
+            return false;
+        }
+
+        int index = find_record(table, frame, key);
+
+        if (index >= 0)
+        {
+            memcpy(record_at(table, frame, index) + table->header.key_size, value, table->header.value_size);
+            frame->dirty = true;
+            return true;
+        }
+
+        if ((int)page_header(frame)->count < table->bucket_capacity)
+        {
+            unsigned char *record = record_at(table, frame, (int)page_header(frame)->count++);
+
+            memcpy(record, key, table->header.key_size);
+            memcpy(record + table->header.key_size, value, table->header.value_size);
+            frame->dirty = true;
+            table->header.num_elements++;
+            return true;
+        }
+
+        if (!split_bucket(table, frame, hash))
+        {
+            return false;
+        }
+    }
+}
+
+/*!
+ * @brief Finds the value associated with a key, reading at most one page.
+ * @param table Pointer to an extendible hash table
+ * @param key Pointer to the key_size key bytes
+ * @param value Receives the value_size value bytes, may be NULL
+ * @return True if the key is present
+ */
+bool extendible_get(extendible_hash_table *table, const void *key, void *value)
+{
+    uint64_t hash = hash_bytes(key, table->header.key_size);
+    extendible_frame *frame = fetch_page(table, (table->directory)[directory_index(table, hash)]);
+
+    if (frame == NULL)
+    {
+        return false;
+    }
+
+    int index = find_record(table, frame, key);
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    // The value is copied out, as the page may be evicted by a later call
+    if (value != NULL)
+    {
+        memcpy(value, record_at(table, frame, index) + table->header.key_size, table->header.value_size);
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Removes a key value pair. Buckets are never merged, so a bucket emptied by
+ *        removals keeps its page.
+ * @param table Pointer to an extendible hash table
+ * @param key Pointer to the key_size key bytes
+ * @return True if the key was present and removed
+ */
+bool extendible_remove(extendible_hash_table *table, const void *key)
+{
+    uint64_t hash = hash_bytes(key, table->header.key_size);
+    extendible_frame *frame = fetch_page(table, (table->directory)[directory_index(table, hash)]);
+
+    if (frame == NULL)
+    {
+        return false;
+    }
+
+    int index = find_record(table, frame, key);
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    int last = (int)page_header(frame)->count - 1;
+
+    // The last record fills the hole, keeping the records packed
+    if (index != last)
+    {
+        memcpy(record_at(table, frame, index), record_at(table, frame, last), table->record_size);
+    }
+
+    page_header(frame)->count--;
+    frame->dirty = true;
+    table->header.num_elements--;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the number of elements stored.
+ * @param table Pointer to an extendible hash table
+ * @return The number of elements
+ */
+long extendible_num_elements(extendible_hash_table *table)
+{
+    return (long)table->header.num_elements;
+}
+
+/*!
+ * @brief Writes every changed page, the directory and the header to the file and waits
+ *        for them to reach the disk.
+ * @param table Pointer to an extendible hash table
+ * @return True if every change has been written
+ */
+bool extendible_checkpoint(extendible_hash_table *table)
+{
+    extendible_header *header = &(table->header);
+    unsigned char page[EXTENDIBLE_PAGE_SIZE] = {0};
+
+    // Changed pages are written in place and stay in the pool
+    for (doubly_linked_list_node *node = table->pool.list.head; node != NULL; node = node->next)
+    {
+        extendible_frame *frame = (extendible_frame *)((lru_entry *)node->value)->value;
+
+        if (frame->dirty && write_page(table, frame->page, frame->data))
+        {
+            frame->dirty = false;
+        }
+    }
+
+    size_t directory_bytes = sizeof(uint64_t) << header->global_depth;
+    uint64_t directory_pages = (directory_bytes + EXTENDIBLE_PAGE_SIZE - 1) / EXTENDIBLE_PAGE_SIZE;
+
+    // A directory which outgrew its extent moves to a new one at the end of the file
+    if (directory_pages > header->directory_pages)
+    {
+        header->directory_page = header->num_pages;
+        header->directory_pages = directory_pages;
+        header->num_pages += directory_pages;
+    }
+
+    if (pwrite(table->fd, table->directory, directory_bytes, (off_t)(header->directory_page * EXTENDIBLE_PAGE_SIZE)) !=
+        (ssize_t)directory_bytes)
+    {
+        table->io_error = true;
+    }
+
+    table->counters.page_writes += directory_pages;
+
+    // The header is written last, once everything it refers to is on disk
+    if (fsync(table->fd) != 0)
+    {
+        table->io_error = true;
+    }
+
+    memcpy(page, header, sizeof(extendible_header));
+
+    if (!write_page(table, 0, page) || fsync(table->fd) != 0)
+    {
+        table->io_error = true;
+    }
+
+    return !table->io_error;
+}
+
+/*!
+ * @brief Checkpoints the table, then frees the buffer pool and closes the file.
+ * @param table Pointer to an extendible hash table
+ * @return True if every change was written before the file was closed
+ */
+bool close_extendible_hash_table(extendible_hash_table *table)
+{
+    bool written = extendible_checkpoint(table);
+
+    // Every page is clean after the checkpoint, so evicting them only frees their frames
+    while (lru_evict(&(table->pool)))
+    {
+    }
+
+    free_lru_cache(&(table->pool));
+    free(table->directory);
+    close(table->fd);
+
+    // Avoid a dangling pointer to the directory
+    table->directory = NULL;
+    table->fd = -1;
+
+    return written;
+}
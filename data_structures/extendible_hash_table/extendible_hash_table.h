@@ -0,0 +1,216 @@
+/**
+ ********************************************************************************
+ * @file    extendible_hash_table.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of an extendible hash table kept
+ *          in a file of fixed size pages, for key sets larger than memory. Each
+ *          bucket is one page. A directory indexed by the top global_depth bits
+ *          of a key's hash maps every prefix to the page of its bucket, so a
+ *          lookup reads at most one page. A full bucket is split into itself and
+ *          one new page, and the directory doubles in memory when the bucket
+ *          already uses every bit of it, so growth never rewrites other pages.
+ *          A buffer pool keeps recently used pages in memory, writing changed
+ *          pages back when they are evicted.
+ *
+ *          File layout, in pages:
+ *              header | buckets and directory extents in order of allocation
+ *          A bucket page starts with its local depth and number of records,
+ *          followed by the records, each being the key bytes then the value
+ *          bytes. The directory is written at checkpoints to an extent of
+ *          whole pages, which moves to the end of the file when it outgrows
+ *          the last one. Pages are written in place, so the file is only
+ *          consistent once extendible_checkpoint() or the close returns.
+ ********************************************************************************
+ */
+
+#ifndef EXTENDIBLE_HASH_TABLE_H
+#define EXTENDIBLE_HASH_TABLE_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "../lru_cache/lru_cache.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Identifies an extendible hash table file
+#define EXTENDIBLE_MAGIC "CDSEXTH"
+// Version of the file layout
+#define EXTENDIBLE_VERSION 1
+// Number of bytes in every page of the file
+#define EXTENDIBLE_PAGE_SIZE 4096
+// Largest number of hash bits the directory is indexed by
+#define EXTENDIBLE_MAX_DEPTH 24
+// Fewest pages the buffer pool holds, enough for both halves of a split
+#define EXTENDIBLE_MIN_POOL_PAGES 2
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Header at the start of the first page of an extendible hash table file.
+ */
+typedef struct extendible_header
+{
+    // EXTENDIBLE_MAGIC followed by a NUL byte
+    char magic[8];
+    // Layout version, EXTENDIBLE_VERSION
+    uint32_t version;
+    // Number of bytes in each page, EXTENDIBLE_PAGE_SIZE
+    uint32_t page_size;
+    // Number of bytes in each key and each value
+    uint32_t key_size;
+    uint32_t value_size;
+    // Number of hash bits the directory is indexed by
+    uint32_t global_depth;
+    // Unused, keeps the following fields 8 byte aligned
+    uint32_t reserved;
+    // Number of pages allocated, including the header and directory extents
+    uint64_t num_pages;
+    // Number of elements stored
+    uint64_t num_elements;
+    // First page and number of pages of the directory extent, 0 before the first checkpoint
+    uint64_t directory_page;
+    uint64_t directory_pages;
+} extendible_header;
+
+/*!
+ * @brief Header at the start of each bucket page.
+ */
+typedef struct extendible_page_header
+{
+    // Number of hash bits shared by every key in the bucket
+    uint32_t local_depth;
+    // Number of records in the bucket
+    uint32_t count;
+} extendible_page_header;
+
+/*!
+ * @brief Struct holding the running counters of an extendible hash table.
+ */
+typedef struct extendible_counters
+{
+    // Pages read from the file because they were not in the buffer pool
+    unsigned long long page_reads;
+    // Pages written to the file, on eviction or at a checkpoint
+    unsigned long long page_writes;
+    // Buckets split into two pages
+    unsigned long long splits;
+    // Times the directory doubled
+    unsigned long long doublings;
+} extendible_counters;
+
+/*!
+ * @brief Struct which represents an open extendible hash table.
+ */
+typedef struct extendible_hash_table
+{
+    // File descriptor of the open file
+    int fd;
+    // Copy of the file's header, written back at checkpoints
+    extendible_header header;
+    // Page of the bucket for each prefix, 2 to the power of global_depth entries
+    uint64_t *directory;
+    // Number of bytes in each record, the key followed by the value
+    size_t record_size;
+    // Number of records a bucket page holds
+    int bucket_capacity;
+    // Recently used pages, keyed by page number
+    lru_cache pool;
+    // Set when a page could not be read or written back
+    bool io_error;
+    // Page read, page write, split and doubling counts
+    extendible_counters counters;
+} extendible_hash_table;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Creates a new extendible hash table file, replacing any existing file, and
+ *        opens it. Every key and every value has a fixed size.
+ * @param table Pointer to an extendible hash table
+ * @param path Path of the file
+ * @param key_size Number of bytes in each key
+ * @param value_size Number of bytes in each value
+ * @param pool_pages Number of pages the buffer pool holds, at least EXTENDIBLE_MIN_POOL_PAGES
+ * @return True if the file was created, false if it could not be or a page cannot hold
+ *         two records
+ */
+bool create_extendible_hash_table(extendible_hash_table *table, const char *path, size_t key_size, size_t value_size,
+                                  int pool_pages);
+
+/*!
+ * @brief Opens an existing extendible hash table file, reading its header and directory.
+ *        Bucket pages are read as lookups reach them.
+ * @param table Pointer to an extendible hash table
+ * @param path Path of the file
+ * @param pool_pages Number of pages the buffer pool holds, at least EXTENDIBLE_MIN_POOL_PAGES
+ * @return True if the file was opened and holds a table of this version
+ */
+bool open_extendible_hash_table(extendible_hash_table *table, const char *path, int pool_pages);
+
+/*!
+ * @brief Adds or updates an element, copying the key and value into its bucket. A full
+ *        bucket is split, doubling the directory if needed, until the key's bucket has
+ *        room.
+ * @param table Pointer to an extendible hash table
+ * @param key Pointer to the key_size key bytes
+ * @param value Pointer to the value_size value bytes
+ * @return True if the element was stored, false if a page could not be read or
+ *         written back, or the directory would grow past EXTENDIBLE_MAX_DEPTH bits
+ */
+bool extendible_put(extendible_hash_table *table, const void *key, const void *value);
+
+/*!
+ * @brief Finds the value associated with a key, reading at most one page.
+ * @param table Pointer to an extendible hash table
+ * @param key Pointer to the key_size key bytes
+ * @param value Receives the value_size value bytes, may be NULL
+ * @return True if the key is present
+ */
+bool extendible_get(extendible_hash_table *table, const void *key, void *value);
+
+/*!
+ * @brief Removes a key value pair. Buckets are never merged, so a bucket emptied by
+ *        removals keeps its page.
+ * @param table Pointer to an extendible hash table
+ * @param key Pointer to the key_size key bytes
+ * @return True if the key was present and removed
+ */
+bool extendible_remove(extendible_hash_table *table, const void *key);
+
+/*!
+ * @brief Returns the number of elements stored.
+ * @param table Pointer to an extendible hash table
+ * @return The number of elements
+ */
+long extendible_num_elements(extendible_hash_table *table);
+
+/*!
+ * @brief Writes every changed page, the directory and the header to the file and waits
+ *        for them to reach the disk.
+ * @param table Pointer to an extendible hash table
+ * @return True if every change has been written
+ */
+bool extendible_checkpoint(extendible_hash_table *table);
+
+/*!
+ * @brief Checkpoints the table, then frees the buffer pool and closes the file.
+ * @param table Pointer to an extendible hash table
+ * @return True if every change was written before the file was closed
+ */
+bool close_extendible_hash_table(extendible_hash_table *table);
+
+#endif // EXTENDIBLE_HASH_TABLE_H
@@ -0,0 +1,225 @@
+/**
+ ********************************************************************************
+ * @file    bloom_filter.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a blocked Bloom filter.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <math.h>
+#include "bloom_filter.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Number of 64 bit words in a block
+#define BLOOM_BLOCK_WORDS (BLOOM_BLOCK_BITS / 64)
+// Alignment of the blocks, so that each block fills exactly one cache line
+#define BLOOM_BLOCK_ALIGNMENT 64
+// Bits of an unblocked filter over which one extra bit per key is given, making up for
+// the accuracy lost by confining a key's bits to one block, which grows with the bits set
+#define BLOOM_BLOCKING_BITS 96.0
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Returns the block a key's bits are set in.
+ * @param filter Pointer to a Bloom filter
+ * @param mixed Mixed hash of the key
+ * @return Pointer to the first word of the block
+ */
+static uint64_t *bloom_block(bloom_filter *filter, uint64_t mixed)
+{
+    // Multiplying the high half by the block count maps it onto the blocks without a division
+    uint64_t block = ((mixed >> 32) * (uint64_t)filter->num_blocks) >> 32;
+
+    return filter->blocks + block * BLOOM_BLOCK_WORDS;
+}
+
+/*!
+ * @brief Returns the next bit position of a key within its block. Positions are taken
+ *        9 bits at a time from the low 54 bits of a mixed hash, which is remixed after
+ *        every 6 positions, as the high half of the first hash selects the block.
+ * @param bits Mixed hash of the key, updated as positions are used
+ * @param i Number of positions already taken
+ * @return Bit position within the block
+ */
+static uint32_t bloom_next_bit(uint64_t *bits, int i)
+{
+    int field = i % 6;
+
+    if (field == 0)
+    {
+        *bits = hash_mix(*bits + (uint64_t)i);
+    }
+
+    return (uint32_t)(*bits >> (field * 9)) % BLOOM_BLOCK_BITS;
+}
+
+/*!
+ * @brief Wraps bloom_add() for use through hash_filter_ops.
+ * @param filter Pointer to a Bloom filter
+ * @param hash 64 bit hash of the key
+ * @return None
+ */
+static void bloom_ops_add(void *filter, uint64_t hash)
+{
+    bloom_add((bloom_filter *)filter, hash);
+}
+
+/*!
+ * @brief Wraps bloom_contains() for use through hash_filter_ops.
+ * @param filter Pointer to a Bloom filter
+ * @param hash 64 bit hash of the key
+ * @return False if the key was never added
+ */
+static bool bloom_ops_contains(void *filter, uint64_t hash)
+{
+    return bloom_contains((bloom_filter *)filter, hash);
+}
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+// Bloom filters cannot forget a key, so removed keys remain as false positives
+const hash_filter_ops bloom_filter_ops = {&bloom_ops_add, NULL, &bloom_ops_contains};
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes a Bloom filter sized to give a false positive rate once a number
+ *        of keys are added.
+ * @param filter Pointer to a Bloom filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param false_positive_rate Fraction of absent keys which may be reported present
+ * @return None
+ */
+void initialize_bloom_filter(bloom_filter *filter, long expected_keys, double false_positive_rate)
+{
+    // An unblocked filter with the best number of hashes needs -log2(p) / ln(2) bits per key
+    double bits_per_key = -log2(false_positive_rate) / log(2);
+
+    bits_per_key += bits_per_key * bits_per_key / BLOOM_BLOCKING_BITS;
+
+    initialize_bloom_filter_bits(filter, expected_keys, bits_per_key);
+}
+
+/*!
+ * @brief Initializes a Bloom filter with a number of bits for each expected key. The
+ *        number of bits set per key is chosen to minimize false positives.
+ * @param filter Pointer to a Bloom filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param bits_per_key Bits of filter for each expected key
+ * @return None
+ */
+void initialize_bloom_filter_bits(bloom_filter *filter, long expected_keys, double bits_per_key)
+{
+    double total_bits = (double)expected_keys * bits_per_key;
+    int num_hashes = (int)lround(bits_per_key * log(2));
+
+    filter->num_blocks = (int)ceil(total_bits / BLOOM_BLOCK_BITS);
+
+    if (filter->num_blocks < 1)
+    {
+        filter->num_blocks = 1;
+    }
+
+    filter->num_hashes = (num_hashes < 1) ? 1 : (num_hashes > BLOOM_MAX_HASHES) ? BLOOM_MAX_HASHES : num_hashes;
+    filter->num_keys = 0;
+    filter->blocks = (uint64_t *)aligned_alloc(BLOOM_BLOCK_ALIGNMENT, (size_t)filter->num_blocks * BLOOM_BLOCK_BITS / 8);
+
+    bloom_clear(filter);
+}
+
+/*!
+ * @brief Adds a key to a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @param hash 64 bit hash of the key
+ * @return None
+ */
+void bloom_add(bloom_filter *filter, uint64_t hash)
+{
+    uint64_t mixed = hash_mix(hash);
+    uint64_t *block = bloom_block(filter, mixed);
+    uint64_t bits = mixed;
+
+    for (int i = 0; i < filter->num_hashes; i++)
+    {
+        uint32_t bit = bloom_next_bit(&bits, i);
+
+        block[bit / 64] |= (uint64_t)1 << (bit % 64);
+    }
+
+    filter->num_keys++;
+}
+
+/*!
+ * @brief Returns if a key may have been added to a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @param hash 64 bit hash of the key
+ * @return False if the key was never added, true if it was or on a false positive
+ */
+bool bloom_contains(bloom_filter *filter, uint64_t hash)
+{
+    uint64_t mixed = hash_mix(hash);
+    uint64_t *block = bloom_block(filter, mixed);
+    uint64_t bits = mixed;
+
+    for (int i = 0; i < filter->num_hashes; i++)
+    {
+        uint32_t bit = bloom_next_bit(&bits, i);
+
+        if ((block[bit / 64] & ((uint64_t)1 << (bit % 64))) == 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Removes every key from a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @return None
+ */
+void bloom_clear(bloom_filter *filter)
+{
+    memset(filter->blocks, 0, bloom_filter_bytes(filter));
+    filter->num_keys = 0;
+}
+
+/*!
+ * @brief Returns the memory held by a Bloom filter's blocks.
+ * @param filter Pointer to a Bloom filter
+ * @return Number of bytes allocated
+ */
+size_t bloom_filter_bytes(bloom_filter *filter)
+{
+    return (size_t)filter->num_blocks * BLOOM_BLOCK_BITS / 8;
+}
+
+/*!
+ * @brief Frees the memory held by a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @return None
+ */
+void free_bloom_filter(bloom_filter *filter)
+{
+    free(filter->blocks);
+
+    // Avoid a dangling pointer to the blocks
+    filter->blocks = NULL;
+    filter->num_blocks = 0;
+}
@@ -0,0 +1,119 @@
+/**
+ ********************************************************************************
+ * @file    bloom_filter.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a blocked Bloom filter. Each
+ *          key sets all of its bits within one 512 bit block, so a query loads a
+ *          single cache line. Keys cannot be removed. Keys are given as 64 bit
+ *          hashes, such as those produced by hash_bytes() or a hash table's
+ *          key_hash function.
+ ********************************************************************************
+ */
+
+#ifndef BLOOM_FILTER_H
+#define BLOOM_FILTER_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Number of bits in each block, one 64 byte cache line
+#define BLOOM_BLOCK_BITS 512
+// Largest number of bits set for each key
+#define BLOOM_MAX_HASHES 16
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct which represents a blocked Bloom filter.
+ */
+typedef struct bloom_filter
+{
+    // Number of blocks
+    int num_blocks;
+    // Number of bits set within a block for each key
+    int num_hashes;
+    // Number of keys added
+    long num_keys;
+    // Blocks of BLOOM_BLOCK_BITS bits, aligned to a cache line
+    uint64_t *blocks;
+} bloom_filter;
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+// Operations for attaching a Bloom filter to a hash table with set_hash_table_filter()
+extern const hash_filter_ops bloom_filter_ops;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes a Bloom filter sized to give a false positive rate once a number
+ *        of keys are added.
+ * @param filter Pointer to a Bloom filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param false_positive_rate Fraction of absent keys which may be reported present
+ * @return None
+ */
+void initialize_bloom_filter(bloom_filter *filter, long expected_keys, double false_positive_rate);
+
+/*!
+ * @brief Initializes a Bloom filter with a number of bits for each expected key. The
+ *        number of bits set per key is chosen to minimize false positives.
+ * @param filter Pointer to a Bloom filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param bits_per_key Bits of filter for each expected key
+ * @return None
+ */
+void initialize_bloom_filter_bits(bloom_filter *filter, long expected_keys, double bits_per_key);
+
+/*!
+ * @brief Adds a key to a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @param hash 64 bit hash of the key
+ * @return None
+ */
+void bloom_add(bloom_filter *filter, uint64_t hash);
+
+/*!
+ * @brief Returns if a key may have been added to a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @param hash 64 bit hash of the key
+ * @return False if the key was never added, true if it was or on a false positive
+ */
+bool bloom_contains(bloom_filter *filter, uint64_t hash);
+
+/*!
+ * @brief Removes every key from a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @return None
+ */
+void bloom_clear(bloom_filter *filter);
+
+/*!
+ * @brief Returns the memory held by a Bloom filter's blocks.
+ * @param filter Pointer to a Bloom filter
+ * @return Number of bytes allocated
+ */
+size_t bloom_filter_bytes(bloom_filter *filter);
+
+/*!
+ * @brief Frees the memory held by a Bloom filter.
+ * @param filter Pointer to a Bloom filter
+ * @return None
+ */
+void free_bloom_filter(bloom_filter *filter);
+
+#endif // BLOOM_FILTER_H
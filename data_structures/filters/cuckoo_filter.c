@@ -0,0 +1,426 @@
+/**
+ ********************************************************************************
+ * @file    cuckoo_filter.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a cuckoo filter.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <math.h>
+#include "cuckoo_filter.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Fraction of slots which can be filled before insertions start to fail
+#define CUCKOO_FILTER_LOAD_FACTOR 0.95
+// Largest number of fingerprints evicted while inserting a single key
+#define CUCKOO_FILTER_MAX_KICKS 500
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Reads the fingerprint held by a slot.
+ * @param filter Pointer to a cuckoo filter
+ * @param slot Index of the slot
+ * @return The fingerprint, 0 if the slot is empty
+ */
+static uint16_t get_slot(cuckoo_filter *filter, int slot)
+{
+    if (filter->fingerprint_bytes == 1)
+    {
+        return (filter->slots)[slot];
+    }
+
+    uint16_t fingerprint;
+
+    memcpy(&fingerprint, filter->slots + (size_t)slot * 2, sizeof(fingerprint));
+
+    return fingerprint;
+}
+
+/*!
+ * @brief Writes the fingerprint held by a slot.
+ * @param filter Pointer to a cuckoo filter
+ * @param slot Index of the slot
+ * @param fingerprint Fingerprint to store, or 0 to empty the slot
+ * @return None
+ */
+static void set_slot(cuckoo_filter *filter, int slot, uint16_t fingerprint)
+{
+    if (filter->fingerprint_bytes == 1)
+    {
+        (filter->slots)[slot] = (unsigned char)fingerprint;
+        return;
+    }
+
+    memcpy(filter->slots + (size_t)slot * 2, &fingerprint, sizeof(fingerprint));
+}
+
+/*!
+ * @brief Returns the fingerprint of a key, which is never 0 as that marks an empty slot.
+ * @param filter Pointer to a cuckoo filter
+ * @param mixed Mixed hash of the key
+ * @return The fingerprint
+ */
+static uint16_t fingerprint_of(cuckoo_filter *filter, uint64_t mixed)
+{
+    uint16_t fingerprint = (uint16_t)(mixed & (((uint64_t)1 << filter->fingerprint_bits) - 1));
+
+    return (fingerprint == 0) ? 1 : fingerprint;
+}
+
+/*!
+ * @brief Returns the first bucket of a key.
+ * @param filter Pointer to a cuckoo filter
+ * @param mixed Mixed hash of the key
+ * @return Index of the bucket
+ */
+static int first_bucket(cuckoo_filter *filter, uint64_t mixed)
+{
+    // Multiplying the high half by the bucket count maps it onto the buckets without a division
+    return (int)(((mixed >> 32) * (uint64_t)filter->num_buckets) >> 32);
+}
+
+/*!
+ * @brief Returns the other bucket a fingerprint may be stored in. The key itself is not
+ *        needed, so an evicted fingerprint can be moved. Subtracting from a hash of the
+ *        fingerprint maps each bucket to the other, without requiring a power of two
+ *        bucket count.
+ * @param filter Pointer to a cuckoo filter
+ * @param bucket Index of the bucket the fingerprint is in
+ * @param fingerprint Fingerprint of the key
+ * @return Index of the alternate bucket
+ */
+static int alternate_bucket(cuckoo_filter *filter, int bucket, uint16_t fingerprint)
+{
+    uint64_t n = (uint64_t)filter->num_buckets;
+    uint64_t offset = hash_mix(fingerprint) % n;
+
+    return (int)((offset + n - (uint64_t)bucket) % n);
+}
+
+/*!
+ * @brief Stores a fingerprint in an empty slot of a bucket.
+ * @param filter Pointer to a cuckoo filter
+ * @param bucket Index of the bucket
+ * @param fingerprint Fingerprint to store
+ * @return True if the bucket had an empty slot
+ */
+static bool bucket_insert(cuckoo_filter *filter, int bucket, uint16_t fingerprint)
+{
+    int first = bucket * CUCKOO_FILTER_BUCKET_SLOTS;
+
+    for (int i = first; i < first + CUCKOO_FILTER_BUCKET_SLOTS; i++)
+    {
+        if (get_slot(filter, i) == 0)
+        {
+            set_slot(filter, i, fingerprint);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * @brief Returns if a bucket holds a fingerprint, optionally removing one copy of it.
+ * @param filter Pointer to a cuckoo filter
+ * @param bucket Index of the bucket
+ * @param fingerprint Fingerprint to search for
+ * @param remove True to empty the slot holding the fingerprint
+ * @return True if the fingerprint was found
+ */
+static bool bucket_find(cuckoo_filter *filter, int bucket, uint16_t fingerprint, bool remove)
+{
+    int first = bucket * CUCKOO_FILTER_BUCKET_SLOTS;
+
+    for (int i = first; i < first + CUCKOO_FILTER_BUCKET_SLOTS; i++)
+    {
+        if (get_slot(filter, i) == fingerprint)
+        {
+            if (remove)
+            {
+                set_slot(filter, i, 0);
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * @brief Wraps cuckoo_filter_add() for use through hash_filter_ops. A filter which
+ *        overflows keeps reporting every key present, so the result is not needed.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return None
+ */
+static void cuckoo_ops_add(void *filter, uint64_t hash)
+{
+    cuckoo_filter_add((cuckoo_filter *)filter, hash);
+}
+
+/*!
+ * @brief Wraps cuckoo_filter_remove() for use through hash_filter_ops.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return None
+ */
+static void cuckoo_ops_remove(void *filter, uint64_t hash)
+{
+    cuckoo_filter_remove((cuckoo_filter *)filter, hash);
+}
+
+/*!
+ * @brief Wraps cuckoo_filter_contains() for use through hash_filter_ops.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return False if the key is not present
+ */
+static bool cuckoo_ops_contains(void *filter, uint64_t hash)
+{
+    return cuckoo_filter_contains((cuckoo_filter *)filter, hash);
+}
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+const hash_filter_ops cuckoo_filter_ops = {&cuckoo_ops_add, &cuckoo_ops_remove, &cuckoo_ops_contains};
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes a cuckoo filter sized to hold a number of keys, with fingerprints
+ *        long enough to give a false positive rate.
+ * @param filter Pointer to a cuckoo filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param false_positive_rate Fraction of absent keys which may be reported present
+ * @return None
+ */
+void initialize_cuckoo_filter(cuckoo_filter *filter, long expected_keys, double false_positive_rate)
+{
+    // A query compares against up to two full buckets of fingerprints, each of which
+    // matches an absent key with probability 2^-bits
+    double fingerprint_bits = ceil(log2(2 * CUCKOO_FILTER_BUCKET_SLOTS / false_positive_rate));
+
+    initialize_cuckoo_filter_bits(filter, expected_keys, fingerprint_bits / CUCKOO_FILTER_LOAD_FACTOR);
+}
+
+/*!
+ * @brief Initializes a cuckoo filter with a number of bits for each expected key. The
+ *        fingerprint length is derived from the bits, and is stored in 1 byte for up to
+ *        8 bits, otherwise widened to 16 bits stored in 2 bytes.
+ * @param filter Pointer to a cuckoo filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param bits_per_key Bits of fingerprint for each expected key
+ * @return None
+ */
+void initialize_cuckoo_filter_bits(cuckoo_filter *filter, long expected_keys, double bits_per_key)
+{
+    // Slots are only filled to the load factor, so part of each key's bits go unused
+    int fingerprint_bits = (int)floor(bits_per_key * CUCKOO_FILTER_LOAD_FACTOR + 1e-9);
+    double buckets = ceil((double)expected_keys / (CUCKOO_FILTER_BUCKET_SLOTS * CUCKOO_FILTER_LOAD_FACTOR));
+
+    if (fingerprint_bits < CUCKOO_FILTER_MIN_FINGERPRINT)
+    {
+        fingerprint_bits = CUCKOO_FILTER_MIN_FINGERPRINT;
+    }
+    // Fingerprints of more than 8 bits take 2 bytes either way, so they use all 16 bits
+    else if (fingerprint_bits > 8)
+    {
+        fingerprint_bits = CUCKOO_FILTER_MAX_FINGERPRINT;
+    }
+
+    filter->num_buckets = (buckets < 1) ? 1 : (int)buckets;
+    filter->fingerprint_bits = fingerprint_bits;
+    filter->fingerprint_bytes = (fingerprint_bits <= 8) ? 1 : 2;
+    filter->slots = (unsigned char *)malloc(cuckoo_filter_bytes(filter));
+    filter->random_state = 0x9E3779B97F4A7C15ULL;
+
+    cuckoo_filter_clear(filter);
+}
+
+/*!
+ * @brief Adds a key to a cuckoo filter. Adding a key twice stores two fingerprints,
+ *        and it must then be removed twice.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return True if the key was stored, false if the filter is full. A full filter
+ *         reports every key as present, so it never gives a false negative
+ */
+bool cuckoo_filter_add(cuckoo_filter *filter, uint64_t hash)
+{
+    uint64_t mixed = hash_mix(hash);
+    uint16_t fingerprint = fingerprint_of(filter, mixed);
+    int bucket = first_bucket(filter, mixed);
+
+    if (filter->overflowed)
+    {
+        return false;
+    }
+
+    if (bucket_insert(filter, bucket, fingerprint) ||
+        bucket_insert(filter, alternate_bucket(filter, bucket, fingerprint), fingerprint))
+    {
+        filter->num_keys++;
+        return true;
+    }
+
+    // With the victim slot taken there is nowhere to leave an evicted fingerprint
+    if (filter->victim != 0)
+    {
+        filter->overflowed = true;
+        return false;
+    }
+
+    // Fingerprints are evicted from random slots until one finds room in its other bucket
+    for (int kick = 0; kick < CUCKOO_FILTER_MAX_KICKS; kick++)
+    {
+        filter->random_state ^= filter->random_state << 13;
+        filter->random_state ^= filter->random_state >> 7;
+        filter->random_state ^= filter->random_state << 17;
+
+        int slot = bucket * CUCKOO_FILTER_BUCKET_SLOTS + (int)(filter->random_state % CUCKOO_FILTER_BUCKET_SLOTS);
+        uint16_t evicted = get_slot(filter, slot);
+
+        set_slot(filter, slot, fingerprint);
+        fingerprint = evicted;
+        bucket = alternate_bucket(filter, bucket, fingerprint);
+
+        if (bucket_insert(filter, bucket, fingerprint))
+        {
+            filter->num_keys++;
+            return true;
+        }
+    }
+
+    // The last evicted fingerprint is held aside, so the key still counts as stored
+    filter->victim = fingerprint;
+    filter->victim_bucket = bucket;
+    filter->num_keys++;
+
+    return true;
+}
+
+/*!
+ * @brief Returns if a key may have been added to a cuckoo filter.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return False if the key was never added or has been removed, true if it is present
+ *         or on a false positive
+ */
+bool cuckoo_filter_contains(cuckoo_filter *filter, uint64_t hash)
+{
+    uint64_t mixed = hash_mix(hash);
+    uint16_t fingerprint = fingerprint_of(filter, mixed);
+    int bucket = first_bucket(filter, mixed);
+    int other = alternate_bucket(filter, bucket, fingerprint);
+
+    if (filter->overflowed)
+    {
+        return true;
+    }
+
+    if (filter->victim == fingerprint && (filter->victim_bucket == bucket || filter->victim_bucket == other))
+    {
+        return true;
+    }
+
+    return bucket_find(filter, bucket, fingerprint, false) || bucket_find(filter, other, fingerprint, false);
+}
+
+/*!
+ * @brief Removes a key from a cuckoo filter. Only keys which were added may be removed,
+ *        as a different key sharing the fingerprint would be removed instead.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return True if a fingerprint of the key was found and removed
+ */
+bool cuckoo_filter_remove(cuckoo_filter *filter, uint64_t hash)
+{
+    uint64_t mixed = hash_mix(hash);
+    uint16_t fingerprint = fingerprint_of(filter, mixed);
+    int bucket = first_bucket(filter, mixed);
+    int other = alternate_bucket(filter, bucket, fingerprint);
+
+    if (filter->victim == fingerprint && (filter->victim_bucket == bucket || filter->victim_bucket == other))
+    {
+        filter->victim = 0;
+        filter->num_keys--;
+        return true;
+    }
+
+    if (!bucket_find(filter, bucket, fingerprint, true) && !bucket_find(filter, other, fingerprint, true))
+    {
+        return false;
+    }
+
+    filter->num_keys--;
+
+    // The freed slot may give the held aside fingerprint a place
+    if (filter->victim != 0)
+    {
+        uint16_t victim = filter->victim;
+        int victim_bucket = filter->victim_bucket;
+
+        if (bucket_insert(filter, victim_bucket, victim) ||
+            bucket_insert(filter, alternate_bucket(filter, victim_bucket, victim), victim))
+        {
+            filter->victim = 0;
+        }
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Removes every key from a cuckoo filter, including after it has overflowed.
+ * @param filter Pointer to a cuckoo filter
+ * @return None
+ */
+void cuckoo_filter_clear(cuckoo_filter *filter)
+{
+    memset(filter->slots, 0, cuckoo_filter_bytes(filter));
+    filter->num_keys = 0;
+    filter->victim = 0;
+    filter->victim_bucket = 0;
+    filter->overflowed = false;
+}
+
+/*!
+ * @brief Returns the memory held by a cuckoo filter's buckets.
+ * @param filter Pointer to a cuckoo filter
+ * @return Number of bytes allocated
+ */
+size_t cuckoo_filter_bytes(cuckoo_filter *filter)
+{
+    return (size_t)filter->num_buckets * CUCKOO_FILTER_BUCKET_SLOTS * filter->fingerprint_bytes;
+}
+
+/*!
+ * @brief Frees the memory held by a cuckoo filter.
+ * @param filter Pointer to a cuckoo filter
+ * @return None
+ */
+void free_cuckoo_filter(cuckoo_filter *filter)
+{
+    free(filter->slots);
+
+    // Avoid a dangling pointer to the slots
+    filter->slots = NULL;
+    filter->num_buckets = 0;
+}
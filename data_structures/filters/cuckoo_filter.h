@@ -0,0 +1,144 @@
+/**
+ ********************************************************************************
+ * @file    cuckoo_filter.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a cuckoo filter. A short
+ *          fingerprint of each key is stored in one of two buckets of
+ *          CUCKOO_FILTER_BUCKET_SLOTS slots, so a query reads at most two
+ *          buckets, and keys can be removed. Keys are given as 64 bit hashes,
+ *          such as those produced by hash_bytes() or a hash table's key_hash
+ *          function.
+ ********************************************************************************
+ */
+
+#ifndef CUCKOO_FILTER_H
+#define CUCKOO_FILTER_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Number of fingerprints held by each bucket
+#define CUCKOO_FILTER_BUCKET_SLOTS 4
+// Smallest and largest number of bits in a fingerprint
+#define CUCKOO_FILTER_MIN_FINGERPRINT 4
+#define CUCKOO_FILTER_MAX_FINGERPRINT 16
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct which represents a cuckoo filter.
+ */
+typedef struct cuckoo_filter
+{
+    // Number of buckets
+    int num_buckets;
+    // Number of bits in each fingerprint
+    int fingerprint_bits;
+    // Bytes used to store each fingerprint, 1 for fingerprints of up to 8 bits, otherwise 2
+    int fingerprint_bytes;
+    // Number of keys added and not removed
+    long num_keys;
+    // Fingerprints, CUCKOO_FILTER_BUCKET_SLOTS per bucket, 0 marking an empty slot
+    unsigned char *slots;
+    // Fingerprint left without a slot when the last insertion ran out of evictions,
+    // and one of its two buckets, 0 if none
+    uint16_t victim;
+    int victim_bucket;
+    // Set once a key could not be stored, after which every query returns true
+    bool overflowed;
+    // State of the generator choosing which fingerprint to evict
+    uint64_t random_state;
+} cuckoo_filter;
+
+/************************************
+ * GLOBAL VARIABLES
+ ************************************/
+
+// Operations for attaching a cuckoo filter to a hash table with set_hash_table_filter()
+extern const hash_filter_ops cuckoo_filter_ops;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes a cuckoo filter sized to hold a number of keys, with fingerprints
+ *        long enough to give a false positive rate.
+ * @param filter Pointer to a cuckoo filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param false_positive_rate Fraction of absent keys which may be reported present
+ * @return None
+ */
+void initialize_cuckoo_filter(cuckoo_filter *filter, long expected_keys, double false_positive_rate);
+
+/*!
+ * @brief Initializes a cuckoo filter with a number of bits for each expected key. The
+ *        fingerprint length is derived from the bits, and is stored in 1 byte for up to
+ *        8 bits, otherwise widened to 16 bits stored in 2 bytes.
+ * @param filter Pointer to a cuckoo filter
+ * @param expected_keys Number of keys the filter is sized for
+ * @param bits_per_key Bits of fingerprint for each expected key
+ * @return None
+ */
+void initialize_cuckoo_filter_bits(cuckoo_filter *filter, long expected_keys, double bits_per_key);
+
+/*!
+ * @brief Adds a key to a cuckoo filter. Adding a key twice stores two fingerprints,
+ *        and it must then be removed twice.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return True if the key was stored, false if the filter is full. A full filter
+ *         reports every key as present, so it never gives a false negative
+ */
+bool cuckoo_filter_add(cuckoo_filter *filter, uint64_t hash);
+
+/*!
+ * @brief Returns if a key may have been added to a cuckoo filter.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return False if the key was never added or has been removed, true if it is present
+ *         or on a false positive
+ */
+bool cuckoo_filter_contains(cuckoo_filter *filter, uint64_t hash);
+
+/*!
+ * @brief Removes a key from a cuckoo filter. Only keys which were added may be removed,
+ *        as a different key sharing the fingerprint would be removed instead.
+ * @param filter Pointer to a cuckoo filter
+ * @param hash 64 bit hash of the key
+ * @return True if a fingerprint of the key was found and removed
+ */
+bool cuckoo_filter_remove(cuckoo_filter *filter, uint64_t hash);
+
+/*!
+ * @brief Removes every key from a cuckoo filter, including after it has overflowed.
+ * @param filter Pointer to a cuckoo filter
+ * @return None
+ */
+void cuckoo_filter_clear(cuckoo_filter *filter);
+
+/*!
+ * @brief Returns the memory held by a cuckoo filter's buckets.
+ * @param filter Pointer to a cuckoo filter
+ * @return Number of bytes allocated
+ */
+size_t cuckoo_filter_bytes(cuckoo_filter *filter);
+
+/*!
+ * @brief Frees the memory held by a cuckoo filter.
+ * @param filter Pointer to a cuckoo filter
+ * @return None
+ */
+void free_cuckoo_filter(cuckoo_filter *filter);
+
+#endif // CUCKOO_FILTER_H
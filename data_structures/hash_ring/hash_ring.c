@@ -0,0 +1,275 @@
+/**
+ ********************************************************************************
+ * @file    hash_ring.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a consistent hash ring.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "hash_ring.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Multiplier of the linear congruential generator stepping jump_hash()
+#define JUMP_HASH_MULTIPLIER 2862933555777941757ULL
+
+/************************************
+ * PRIVATE TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct representing a point of a shard being added, sorted before it is merged
+ *        into the ring.
+ */
+typedef struct hash_ring_point
+{
+    uint64_t position;
+    int shard;
+} hash_ring_point;
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Orders two points by position, for qsort().
+ * @param a Pointer to the first point
+ * @param b Pointer to the second point
+ * @return Negative, zero or positive as the first point comes before, with or after the second
+ */
+static int compare_points(const void *a, const void *b)
+{
+    uint64_t position_a = ((const hash_ring_point *)a)->position;
+    uint64_t position_b = ((const hash_ring_point *)b)->position;
+
+    return (position_a > position_b) - (position_a < position_b);
+}
+
+/*!
+ * @brief Returns the index of the first point at or after a position, wrapping to the
+ *        first point past the end of the ring. Selects rather than branches, as which
+ *        half holds the position is unpredictable.
+ * @param ring Pointer to a hash ring with at least one point
+ * @param position Position on the ring
+ * @return Index of the point
+ */
+static size_t find_point(hash_ring *ring, uint64_t position)
+{
+    const uint64_t *base = ring->positions;
+    size_t length = ring->num_points;
+
+    // Each step keeps the half whose first point is the last one before the position
+    while (length > 1)
+    {
+        size_t half = length / 2;
+
+        base = (base[half - 1] < position) ? base + half : base;
+        length -= half;
+    }
+
+    size_t index = (size_t)(base - ring->positions) + (*base < position);
+
+    return (index == ring->num_points) ? 0 : index;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes an empty consistent hash ring.
+ * @param ring Pointer to a hash ring
+ * @param virtual_nodes Number of points each shard is placed at, more giving a more even
+ *        share of keys per shard. HASH_RING_DEFAULT_VIRTUAL_NODES is used if less than 1
+ * @return None
+ */
+void initialize_hash_ring(hash_ring *ring, int virtual_nodes)
+{
+    ring->virtual_nodes = (virtual_nodes < 1) ? HASH_RING_DEFAULT_VIRTUAL_NODES : virtual_nodes;
+    ring->num_shards = 0;
+    ring->num_points = 0;
+    ring->capacity = 0;
+    ring->positions = NULL;
+    ring->shards = NULL;
+}
+
+/*!
+ * @brief Adds a shard to a hash ring. Only keys whose position now falls before one
+ *        of the shard's points move, all of them to the new shard.
+ * @param ring Pointer to a hash ring
+ * @param shard Identifier of the shard, at least 0
+ * @return True if the shard was added, false if it is already on the ring or negative
+ */
+bool hash_ring_add_shard(hash_ring *ring, int shard)
+{
+    if (shard < 0)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < ring->num_points; i++)
+    {
+        if ((ring->shards)[i] == shard)
+        {
+            return false;
+        }
+    }
+
+    size_t count = (size_t)ring->virtual_nodes;
+    hash_ring_point *points = (hash_ring_point *)malloc(count * sizeof(hash_ring_point));
+
+    // A point's position depends only on its shard and replica, so every process
+    // building a ring from the same shards agrees on it
+    for (size_t i = 0; i < count; i++)
+    {
+        points[i].position = hash_mix(((uint64_t)shard << 32) | i);
+        points[i].shard = shard;
+    }
+
+    qsort(points, count, sizeof(hash_ring_point), &compare_points);
+
+    if (ring->num_points + count > ring->capacity)
+    {
+        ring->capacity = (ring->num_points + count) * 2;
+        ring->positions = (uint64_t *)realloc(ring->positions, ring->capacity * sizeof(uint64_t));
+        ring->shards = (int *)realloc(ring->shards, ring->capacity * sizeof(int));
+    }
+
+    size_t old_index = ring->num_points;
+    size_t new_index = count;
+
+    // Merging from the end moves each existing point at most once
+    for (size_t i = ring->num_points + count; i-- > 0;)
+    {
+        if (new_index > 0 && (old_index == 0 || points[new_index - 1].position > (ring->positions)[old_index - 1]))
+        {
+            new_index--;
+            (ring->positions)[i] = points[new_index].position;
+            (ring->shards)[i] = points[new_index].shard;
+        }
+        else
+        {
+            old_index--;
+            (ring->positions)[i] = (ring->positions)[old_index];
+            (ring->shards)[i] = (ring->shards)[old_index];
+        }
+    }
+
+    ring->num_points += count;
+    ring->num_shards++;
+
+    free(points);
+
+    return true;
+}
+
+/*!
+ * @brief Removes a shard from a hash ring. Only the shard's keys move, each to the
+ *        shard of the next point on the ring.
+ * @param ring Pointer to a hash ring
+ * @param shard Identifier of the shard
+ * @return True if the shard was on the ring and removed
+ */
+bool hash_ring_remove_shard(hash_ring *ring, int shard)
+{
+    size_t kept = 0;
+
+    // The remaining points keep their order, so the ring stays sorted
+    for (size_t i = 0; i < ring->num_points; i++)
+    {
+        if ((ring->shards)[i] != shard)
+        {
+            (ring->positions)[kept] = (ring->positions)[i];
+            (ring->shards)[kept] = (ring->shards)[i];
+            kept++;
+        }
+    }
+
+    if (kept == ring->num_points)
+    {
+        return false;
+    }
+
+    ring->num_points = kept;
+    ring->num_shards--;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the shard a key belongs to, by binary search of the ring's points.
+ * @param ring Pointer to a hash ring
+ * @param hash 64 bit hash of the key
+ * @return Identifier of the shard, or HASH_RING_NO_SHARD if the ring has no shards
+ */
+int hash_ring_lookup(hash_ring *ring, uint64_t hash)
+{
+    if (ring->num_points == 0)
+    {
+        return HASH_RING_NO_SHARD;
+    }
+
+    // Mixing spreads keys whose hashes are poorly distributed, such as small integers
+    return (ring->shards)[find_point(ring, hash_mix(hash))];
+}
+
+/*!
+ * @brief Returns the number of shards on a hash ring.
+ * @param ring Pointer to a hash ring
+ * @return The number of shards
+ */
+int hash_ring_num_shards(hash_ring *ring)
+{
+    return ring->num_shards;
+}
+
+/*!
+ * @brief Frees the memory held by a hash ring.
+ * @param ring Pointer to a hash ring
+ * @return None
+ */
+void free_hash_ring(hash_ring *ring)
+{
+    free(ring->positions);
+    free(ring->shards);
+
+    // Avoid dangling pointers to the points
+    ring->positions = NULL;
+    ring->shards = NULL;
+    ring->num_points = 0;
+    ring->capacity = 0;
+    ring->num_shards = 0;
+}
+
+/*!
+ * @brief Returns the shard of a key among shards 0 to num_shards - 1 by jump consistent
+ *        hashing, using no memory. Growing to num_shards + 1 only moves keys to the new
+ *        last shard, about 1 / (num_shards + 1) of them.
+ * @param hash 64 bit hash of the key
+ * @param num_shards Number of shards, at least 1
+ * @return Shard of the key, from 0 to num_shards - 1
+ */
+int jump_hash(uint64_t hash, int num_shards)
+{
+    uint64_t state = hash_mix(hash);
+    int64_t shard = -1;
+    int64_t next = 0;
+
+    // Each step jumps to the next shard count at which the key would move, which is
+    // past num_shards after about log(num_shards) steps
+    while (next < num_shards)
+    {
+        shard = next;
+        state = state * JUMP_HASH_MULTIPLIER + 1;
+        next = (int64_t)((double)(shard + 1) * ((double)(1LL << 31) / (double)((state >> 33) + 1)));
+    }
+
+    return (int)shard;
+}
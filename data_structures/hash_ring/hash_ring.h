@@ -0,0 +1,122 @@
+/**
+ ********************************************************************************
+ * @file    hash_ring.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a consistent hash ring, which
+ *          maps keys to shards so that adding or removing a shard only moves the
+ *          keys it gains or loses. Each shard is placed at several points
+ *          (virtual nodes) on a ring of 64 bit positions, and a key belongs to
+ *          the first point at or after its own position. The points are kept in
+ *          a sorted array, so a lookup is a binary search. Jump consistent
+ *          hashing is also provided, for shards numbered 0 to n - 1 which are
+ *          only ever added or removed at the end. Keys are given as 64 bit
+ *          hashes, such as those produced by hash_bytes() or a hash table's
+ *          key_hash function.
+ ********************************************************************************
+ */
+
+#ifndef HASH_RING_H
+#define HASH_RING_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Number of virtual nodes per shard used when none is given
+#define HASH_RING_DEFAULT_VIRTUAL_NODES 160
+// Returned by lookups on a ring without shards
+#define HASH_RING_NO_SHARD -1
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct which represents a consistent hash ring.
+ */
+typedef struct hash_ring
+{
+    // Number of points each shard is placed at
+    int virtual_nodes;
+    // Number of shards on the ring
+    int num_shards;
+    // Number of points on the ring, and the number allocated
+    size_t num_points;
+    size_t capacity;
+    // Positions of the points in ascending order, searched by lookups
+    uint64_t *positions;
+    // Shard of the point at the same index of positions
+    int *shards;
+} hash_ring;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes an empty consistent hash ring.
+ * @param ring Pointer to a hash ring
+ * @param virtual_nodes Number of points each shard is placed at, more giving a more even
+ *        share of keys per shard. HASH_RING_DEFAULT_VIRTUAL_NODES is used if less than 1
+ * @return None
+ */
+void initialize_hash_ring(hash_ring *ring, int virtual_nodes);
+
+/*!
+ * @brief Adds a shard to a hash ring. Only keys whose position now falls before one
+ *        of the shard's points move, all of them to the new shard.
+ * @param ring Pointer to a hash ring
+ * @param shard Identifier of the shard, at least 0
+ * @return True if the shard was added, false if it is already on the ring or negative
+ */
+bool hash_ring_add_shard(hash_ring *ring, int shard);
+
+/*!
+ * @brief Removes a shard from a hash ring. Only the shard's keys move, each to the
+ *        shard of the next point on the ring.
+ * @param ring Pointer to a hash ring
+ * @param shard Identifier of the shard
+ * @return True if the shard was on the ring and removed
+ */
+bool hash_ring_remove_shard(hash_ring *ring, int shard);
+
+/*!
+ * @brief Returns the shard a key belongs to, by binary search of the ring's points.
+ * @param ring Pointer to a hash ring
+ * @param hash 64 bit hash of the key
+ * @return Identifier of the shard, or HASH_RING_NO_SHARD if the ring has no shards
+ */
+int hash_ring_lookup(hash_ring *ring, uint64_t hash);
+
+/*!
+ * @brief Returns the number of shards on a hash ring.
+ * @param ring Pointer to a hash ring
+ * @return The number of shards
+ */
+int hash_ring_num_shards(hash_ring *ring);
+
+/*!
+ * @brief Frees the memory held by a hash ring.
+ * @param ring Pointer to a hash ring
+ * @return None
+ */
+void free_hash_ring(hash_ring *ring);
+
+/*!
+ * @brief Returns the shard of a key among shards 0 to num_shards - 1 by jump consistent
+ *        hashing, using no memory. Growing to num_shards + 1 only moves keys to the new
+ *        last shard, about 1 / (num_shards + 1) of them.
+ * @param hash 64 bit hash of the key
+ * @param num_shards Number of shards, at least 1
+ * @return Shard of the key, from 0 to num_shards - 1
+ */
+int jump_hash(uint64_t hash, int num_shards);
+
+#endif // HASH_RING_H
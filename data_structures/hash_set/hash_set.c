@@ -0,0 +1,490 @@
+/**
+ ********************************************************************************
+ * @file    hash_set.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a hash set.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "hash_set.h"
+#include "../hash_table/hash_group.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Largest load factor allowed, as for a hash table in HASH_SWISS mode
+#define MAX_SET_LOAD_FACTOR 0.875f
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Hashes a key, mixing the result so that both the group position and the
+ *        7 bit control tag are well distributed.
+ * @param set Pointer to a hash set
+ * @param key Key to hash
+ * @return A 64 bit hash of the key
+ */
+static uint64_t set_hash(hash_set *set, void *key)
+{
+    return hash_mix((set->key_hash)(key, set->key_length));
+}
+
+/*!
+ * @brief Returns a bitmask of the full slots in the group starting at a slot.
+ * @param set Pointer to a hash set
+ * @param index First slot of the group, a multiple of HASH_GROUP_WIDTH
+ * @return Bitmask with bit i set if slot index + i holds a key
+ */
+static uint32_t full_slots(hash_set *set, int index)
+{
+    return ~group_match_free(set->control + index) & ((1u << HASH_GROUP_WIDTH) - 1);
+}
+
+/*!
+ * @brief Sets the control byte for a slot, mirroring the first group past the end.
+ * @param set Pointer to a hash set
+ * @param index Slot to update
+ * @param byte New control byte
+ * @return None
+ */
+static void set_control(hash_set *set, int index, unsigned char byte)
+{
+    set->control[index] = byte;
+
+    if (index < HASH_GROUP_WIDTH)
+    {
+        set->control[set->capacity + index] = byte;
+    }
+}
+
+/*!
+ * @brief Allocates empty control bytes and key slots.
+ * @param set Pointer to a hash set
+ * @param capacity Number of slots, a power of two of at least HASH_GROUP_WIDTH
+ * @return None
+ */
+static void set_allocate(hash_set *set, int capacity)
+{
+    set->capacity = capacity;
+    set->control = (unsigned char *)malloc(capacity + HASH_GROUP_WIDTH);
+    set->keys = (void **)malloc(capacity * sizeof(void *));
+
+    memset(set->control, CONTROL_EMPTY, capacity + HASH_GROUP_WIDTH);
+
+    set->num_elements = 0;
+    set->num_deleted = 0;
+}
+
+/*!
+ * @brief Finds the slot holding a key by probing groups of control bytes.
+ * @param set Pointer to a hash set
+ * @param key Key to search for
+ * @param hash Hash of the key from set_hash()
+ * @return Index of the slot holding the key, or -1 if the key is not present
+ */
+static int set_find(hash_set *set, void *key, uint64_t hash)
+{
+    int mask = set->capacity - 1;
+    int position = (int)(hash >> 7) & mask;
+    unsigned char tag = (unsigned char)(hash & 0x7F);
+
+    // Triangular probing visits every group once before repeating
+    for (int stride = 0; stride <= set->capacity; stride += HASH_GROUP_WIDTH)
+    {
+        const unsigned char *group = set->control + position;
+        uint32_t matches = group_match(group, tag);
+
+        while (matches != 0)
+        {
+            int index = (position + __builtin_ctz(matches)) & mask;
+            void *stored = (set->keys)[index];
+
+            if (stored == key || (set->key_equal)(stored, key, set->key_length))
+            {
+                return index;
+            }
+
+            matches &= matches - 1;
+        }
+
+        // An empty slot in the group ends the probe sequence
+        if (group_match(group, CONTROL_EMPTY) != 0)
+        {
+            return -1;
+        }
+
+        position = (position + stride + HASH_GROUP_WIDTH) & mask;
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief Places a key which is not in the set in the first free slot of its probe sequence.
+ * @param set Pointer to a hash set with room for the key
+ * @param key Key to place
+ * @param hash Hash of the key from set_hash()
+ * @return None
+ */
+static void set_place(hash_set *set, void *key, uint64_t hash)
+{
+    int mask = set->capacity - 1;
+    int position = (int)(hash >> 7) & mask;
+    int stride = 0;
+    uint32_t free_slots = group_match_free(set->control + position);
+
+    while (free_slots == 0)
+    {
+        stride += HASH_GROUP_WIDTH;
+        position = (position + stride) & mask;
+        free_slots = group_match_free(set->control + position);
+    }
+
+    int index = (position + __builtin_ctz(free_slots)) & mask;
+
+    if ((set->control)[index] == CONTROL_DELETED)
+    {
+        set->num_deleted--;
+    }
+
+    set_control(set, index, (unsigned char)(hash & 0x7F));
+    (set->keys)[index] = key;
+    set->num_elements++;
+}
+
+/*!
+ * @brief Rebuilds the set with a new capacity, dropping deleted markers.
+ * @param set Pointer to a hash set
+ * @param capacity New number of slots, a power of two
+ * @return None
+ */
+static void set_rehash(hash_set *set, int capacity)
+{
+    unsigned char *old_control = set->control;
+    void **old_keys = set->keys;
+    int old_capacity = set->capacity;
+
+    set_allocate(set, capacity);
+
+    for (int i = 0; i < old_capacity; i++)
+    {
+        // Only full slots have the high bit of their control byte clear
+        if ((old_control[i] & 0x80) == 0)
+        {
+            set_place(set, old_keys[i], set_hash(set, old_keys[i]));
+        }
+    }
+
+    free(old_control);
+    free(old_keys);
+}
+
+/*!
+ * @brief Marks a slot deleted.
+ * @param set Pointer to a hash set
+ * @param index Slot holding the key to remove
+ * @return None
+ */
+static void set_erase(hash_set *set, int index)
+{
+    set_control(set, index, CONTROL_DELETED);
+    (set->keys)[index] = NULL;
+
+    set->num_elements--;
+    set->num_deleted++;
+}
+
+/*!
+ * @brief Rebuilds the set in place once bulk removals leave more deleted markers than keys.
+ * @param set Pointer to a hash set
+ * @return None
+ */
+static void set_compact(hash_set *set)
+{
+    if (set->num_deleted > set->num_elements)
+    {
+        set_rehash(set, set->capacity);
+    }
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes the hash set
+ * @param set Pointer to a hash set
+ * @param size Number of keys to size the set for, rounded up to a power of two
+ * @param load_factor Fraction of slots full at which to grow, capped at 0.875
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @return None
+ */
+void initialize_hash_set(hash_set *set, int size, float load_factor, int function_select)
+{
+    switch (function_select)
+    {
+    // Selects content hashing for string keys
+    case HASH_STRING:
+        initialize_hash_set_keys(set, size, load_factor, HASH_KEY_STRING, &hash_bytes, &equal_bytes);
+        break;
+    // Selects the Fibonacci multiplier for integer keys
+    case HASH_FIBONACCI:
+        initialize_hash_set_keys(set, size, load_factor, HASH_KEY_POINTER, &hash_fibonacci, &equal_pointer);
+        break;
+    // Selects the identity hash, which is mixed before use
+    default:
+        initialize_hash_set_keys(set, size, load_factor, HASH_KEY_POINTER, &hash_pointer, &equal_pointer);
+        break;
+    }
+}
+
+/*!
+ * @brief Initializes the hash set with user defined key hashing and equality.
+ * @param set Pointer to a hash set
+ * @param size Number of keys to size the set for, rounded up to a power of two
+ * @param load_factor Fraction of slots full at which to grow, capped at 0.875
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return None
+ */
+void initialize_hash_set_keys(hash_set *set, int size, float load_factor, size_t key_length,
+                              hash_key_function key_hash, hash_equal_function key_equal)
+{
+    int capacity = HASH_GROUP_WIDTH;
+
+    // Group probing relies on masking, so the capacity is a power of two
+    while (capacity < size)
+    {
+        capacity *= 2;
+    }
+
+    set->load_factor = (load_factor > MAX_SET_LOAD_FACTOR) ? MAX_SET_LOAD_FACTOR : load_factor;
+    set->key_length = key_length;
+    set->key_hash = key_hash;
+
+    if (key_equal != NULL)
+    {
+        set->key_equal = key_equal;
+    }
+    else
+    {
+        set->key_equal = (key_length == HASH_KEY_POINTER) ? &equal_pointer : &equal_bytes;
+    }
+
+    set_allocate(set, capacity);
+}
+
+/*!
+ * @brief Adds a key to the set.
+ * @param set Pointer to a hash set
+ * @param key Key to add
+ * @return True if the key was added, false if it was already in the set
+ */
+bool set_add(hash_set *set, void *key)
+{
+    uint64_t hash = set_hash(set, key);
+
+    if (set_find(set, key, hash) >= 0)
+    {
+        return false;
+    }
+
+    int capacity = group_rebuild_capacity(set->capacity, set->num_elements, set->num_deleted, set->load_factor);
+
+    if (capacity != 0)
+    {
+        set_rehash(set, capacity);
+    }
+
+    set_place(set, key, hash);
+
+    return true;
+}
+
+/*!
+ * @brief Returns if a key is in the set.
+ * @param set Pointer to a hash set
+ * @param key Key to look for
+ * @return True if the key is in the set
+ */
+bool set_contains(hash_set *set, void *key)
+{
+    return set_find(set, key, set_hash(set, key)) >= 0;
+}
+
+/*!
+ * @brief Removes a key from the set.
+ * @param set Pointer to a hash set
+ * @param key Key to remove
+ * @return True if the key was in the set
+ */
+bool set_remove(hash_set *set, void *key)
+{
+    int index = set_find(set, key, set_hash(set, key));
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    set_erase(set, index);
+
+    return true;
+}
+
+/*!
+ * @brief Adds every key of another set. The set grows once to fit both sets before
+ *        any key is added. Both sets must hash and compare keys the same way.
+ * @param set Pointer to the hash set to add to
+ * @param other Pointer to the hash set whose keys are added
+ * @return None
+ */
+void set_union(hash_set *set, hash_set *other)
+{
+    int capacity = set->capacity;
+
+    // Sized for the case where no key is shared, so no rebuild happens part way through
+    while (set->num_elements + other->num_elements > (int)(capacity * set->load_factor))
+    {
+        capacity *= 2;
+    }
+
+    if (capacity != set->capacity || set->num_elements + set->num_deleted + other->num_elements >
+                                         (int)(capacity * set->load_factor))
+    {
+        set_rehash(set, capacity);
+    }
+
+    // The other set's slots are walked a group of control bytes at a time
+    for (int group = 0; group < other->capacity; group += HASH_GROUP_WIDTH)
+    {
+        for (uint32_t full = full_slots(other, group); full != 0; full &= full - 1)
+        {
+            void *key = (other->keys)[group + __builtin_ctz(full)];
+            uint64_t hash = set_hash(set, key);
+
+            if (set_find(set, key, hash) < 0)
+            {
+                set_place(set, key, hash);
+            }
+        }
+    }
+}
+
+/*!
+ * @brief Removes every key which is not also in another set. Both sets must hash
+ *        and compare keys the same way.
+ * @param set Pointer to the hash set to remove from
+ * @param other Pointer to the hash set whose keys are kept
+ * @return None
+ */
+void set_intersect(hash_set *set, hash_set *other)
+{
+    for (int group = 0; group < set->capacity; group += HASH_GROUP_WIDTH)
+    {
+        for (uint32_t full = full_slots(set, group); full != 0; full &= full - 1)
+        {
+            int index = group + __builtin_ctz(full);
+
+            if (!set_contains(other, (set->keys)[index]))
+            {
+                set_erase(set, index);
+            }
+        }
+    }
+
+    set_compact(set);
+}
+
+/*!
+ * @brief Removes every key which is also in another set. Both sets must hash and
+ *        compare keys the same way.
+ * @param set Pointer to the hash set to remove from
+ * @param other Pointer to the hash set whose keys are removed
+ * @return None
+ */
+void set_difference(hash_set *set, hash_set *other)
+{
+    // Whichever set has fewer slots is walked, and its keys looked up in the other
+    if (other->capacity < set->capacity)
+    {
+        for (int group = 0; group < other->capacity; group += HASH_GROUP_WIDTH)
+        {
+            for (uint32_t full = full_slots(other, group); full != 0; full &= full - 1)
+            {
+                set_remove(set, (other->keys)[group + __builtin_ctz(full)]);
+            }
+        }
+    }
+    else
+    {
+        for (int group = 0; group < set->capacity; group += HASH_GROUP_WIDTH)
+        {
+            for (uint32_t full = full_slots(set, group); full != 0; full &= full - 1)
+            {
+                int index = group + __builtin_ctz(full);
+
+                if (set_contains(other, (set->keys)[index]))
+                {
+                    set_erase(set, index);
+                }
+            }
+        }
+    }
+
+    set_compact(set);
+}
+
+/*!
+ * @brief Calls a function on every key in the set. The set must not be modified
+ *        until the call returns.
+ * @param set Pointer to a hash set
+ * @param visit Function called with each key and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return None
+ */
+void hash_set_for_each(hash_set *set, void (*visit)(void *key, void *context), void *context)
+{
+    for (int group = 0; group < set->capacity; group += HASH_GROUP_WIDTH)
+    {
+        for (uint32_t full = full_slots(set, group); full != 0; full &= full - 1)
+        {
+            visit((set->keys)[group + __builtin_ctz(full)], context);
+        }
+    }
+}
+
+/*!
+ * @brief Returns the number of bytes allocated for the set's slots.
+ * @param set Pointer to a hash set
+ * @return Bytes held by the control bytes and keys
+ */
+size_t hash_set_bytes(hash_set *set)
+{
+    return (size_t)set->capacity * (sizeof(void *) + 1) + HASH_GROUP_WIDTH;
+}
+
+/*!
+ * @brief Frees the memory held by the hash set.
+ * @param set Pointer to a hash set
+ * @return None
+ */
+void free_hash_set(hash_set *set)
+{
+    free(set->control);
+    free(set->keys);
+
+    // Avoid dangling pointers to the control bytes and keys
+    set->control = NULL;
+    set->keys = NULL;
+    set->num_elements = 0;
+}
@@ -0,0 +1,153 @@
+/**
+ ********************************************************************************
+ * @file    hash_set.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a hash set. Only keys are
+ *          stored, in a flat array beside one control byte per slot, giving
+ *          9 bytes per slot. Keys are hashed, compared and probed the same way
+ *          as a hash table in HASH_SWISS mode.
+ ********************************************************************************
+ */
+
+#ifndef HASH_SET_H
+#define HASH_SET_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct which represents a hash set.
+ */
+typedef struct hash_set
+{
+    // Number of slots, a power of two of at least HASH_GROUP_WIDTH
+    int capacity;
+    // Number of keys in the set
+    int num_elements;
+    // Number of slots holding a deleted marker
+    int num_deleted;
+    // Fraction of slots which may be full or deleted before the set is rebuilt
+    float load_factor;
+    // Function producing the full hash of a key
+    hash_key_function key_hash;
+    // Function comparing two keys for equality
+    hash_equal_function key_equal;
+    // Length of each key passed to the hash and equality functions
+    size_t key_length;
+    // Control bytes, with the first group mirrored past the end
+    unsigned char *control;
+    // Flat array of keys, one per slot
+    void **keys;
+} hash_set;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes the hash set
+ * @param set Pointer to a hash set
+ * @param size Number of keys to size the set for, rounded up to a power of two
+ * @param load_factor Fraction of slots full at which to grow, capped at 0.875
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @return None
+ */
+void initialize_hash_set(hash_set *set, int size, float load_factor, int function_select);
+
+/*!
+ * @brief Initializes the hash set with user defined key hashing and equality.
+ * @param set Pointer to a hash set
+ * @param size Number of keys to size the set for, rounded up to a power of two
+ * @param load_factor Fraction of slots full at which to grow, capped at 0.875
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return None
+ */
+void initialize_hash_set_keys(hash_set *set, int size, float load_factor, size_t key_length,
+                              hash_key_function key_hash, hash_equal_function key_equal);
+
+/*!
+ * @brief Adds a key to the set.
+ * @param set Pointer to a hash set
+ * @param key Key to add
+ * @return True if the key was added, false if it was already in the set
+ */
+bool set_add(hash_set *set, void *key);
+
+/*!
+ * @brief Returns if a key is in the set.
+ * @param set Pointer to a hash set
+ * @param key Key to look for
+ * @return True if the key is in the set
+ */
+bool set_contains(hash_set *set, void *key);
+
+/*!
+ * @brief Removes a key from the set.
+ * @param set Pointer to a hash set
+ * @param key Key to remove
+ * @return True if the key was in the set
+ */
+bool set_remove(hash_set *set, void *key);
+
+/*!
+ * @brief Adds every key of another set. The set grows once to fit both sets before
+ *        any key is added. Both sets must hash and compare keys the same way.
+ * @param set Pointer to the hash set to add to
+ * @param other Pointer to the hash set whose keys are added
+ * @return None
+ */
+void set_union(hash_set *set, hash_set *other);
+
+/*!
+ * @brief Removes every key which is not also in another set. Both sets must hash
+ *        and compare keys the same way.
+ * @param set Pointer to the hash set to remove from
+ * @param other Pointer to the hash set whose keys are kept
+ * @return None
+ */
+void set_intersect(hash_set *set, hash_set *other);
+
+/*!
+ * @brief Removes every key which is also in another set. Both sets must hash and
+ *        compare keys the same way.
+ * @param set Pointer to the hash set to remove from
+ * @param other Pointer to the hash set whose keys are removed
+ * @return None
+ */
+void set_difference(hash_set *set, hash_set *other);
+
+/*!
+ * @brief Calls a function on every key in the set. The set must not be modified
+ *        until the call returns.
+ * @param set Pointer to a hash set
+ * @param visit Function called with each key and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return None
+ */
+void hash_set_for_each(hash_set *set, void (*visit)(void *key, void *context), void *context);
+
+/*!
+ * @brief Returns the number of bytes allocated for the set's slots.
+ * @param set Pointer to a hash set
+ * @return Bytes held by the control bytes and keys
+ */
+size_t hash_set_bytes(hash_set *set);
+
+/*!
+ * @brief Frees the memory held by the hash set.
+ * @param set Pointer to a hash set
+ * @return None
+ */
+void free_hash_set(hash_set *set);
+
+#endif // HASH_SET_H
@@ -0,0 +1,113 @@
+/**
+ ********************************************************************************
+ * @file    hash_group.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Control byte values and group matching shared by the open addressing
+ *          tables which probe HASH_GROUP_WIDTH control bytes at a time.
+ ********************************************************************************
+ */
+
+#ifndef HASH_GROUP_H
+#define HASH_GROUP_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdint.h>
+#include "hash_table.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Control byte marking a slot which has never held an element
+#define CONTROL_EMPTY 0x80
+// Control byte marking a slot whose element has been removed
+#define CONTROL_DELETED 0xFE
+
+/************************************
+ * FUNCTION DEFINITIONS
+ ************************************/
+
+/*!
+ * @brief Returns a bitmask with bit i set if byte i of the group equals the given byte.
+ * @param group Pointer to the first of HASH_GROUP_WIDTH control bytes
+ * @param byte Control byte to match against
+ * @return Bitmask of matching positions within the group
+ */
+static inline uint32_t group_match(const unsigned char *group, unsigned char byte)
+{
+#if defined(__SSE2__)
+    __m128i control = _mm_loadu_si128((const __m128i *)group);
+
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)byte)));
+#else
+    uint32_t mask = 0;
+
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+        if (group[i] == byte)
+        {
+            mask |= (uint32_t)1 << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+/*!
+ * @brief Returns a bitmask with bit i set if slot i of the group is empty or deleted.
+ *        Both markers have their high bit set while full slots do not.
+ * @param group Pointer to the first of HASH_GROUP_WIDTH control bytes
+ * @return Bitmask of free positions within the group
+ */
+static inline uint32_t group_match_free(const unsigned char *group)
+{
+#if defined(__SSE2__)
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+#else
+    uint32_t mask = 0;
+
+    for (int i = 0; i < HASH_GROUP_WIDTH; i++)
+    {
+        if (group[i] & 0x80)
+        {
+            mask |= (uint32_t)1 << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+/*!
+ * @brief Decides if an open addressing table must be rebuilt before another element
+ *        is added. Deleted markers lengthen probe sequences, so they count towards the
+ *        load. Rebuilding at the same capacity is enough when deleted markers make up
+ *        a good part of the load, leaving at least 3/28 of the limit free afterwards.
+ * @param capacity Number of slots
+ * @param num_elements Number of full slots
+ * @param num_deleted Number of slots holding a deleted marker
+ * @param load_factor Fraction of slots which may be full or deleted
+ * @return Capacity to rebuild the table with, or 0 if the element fits
+ */
+static inline int group_rebuild_capacity(int capacity, int num_elements, int num_deleted, float load_factor)
+{
+    int limit = (int)(capacity * load_factor);
+
+    if (num_elements + num_deleted + 1 <= limit)
+    {
+        return 0;
+    }
+
+    return ((num_elements + 1) * 28 <= limit * 25) ? capacity : capacity * 2;
+}
+
+#endif // HASH_GROUP_H
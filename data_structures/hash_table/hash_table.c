@@ -12,268 +12,4406 @@
  * INCLUDES
  ************************************/
 #include "hash_table.h"
+#include "hash_group.h"
+
+#include <float.h>
+
+#ifdef HASH_TABLE_STATS
+#include <time.h>
+#endif
+
+#ifdef HASH_TABLE_THREADS
+#include <pthread.h>
+#endif
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Largest load factor allowed in open addressing mode
+#define MAX_OPEN_LOAD_FACTOR 0.875f
+// Largest load factor allowed in Robin Hood mode
+#define MAX_ROBIN_HOOD_LOAD_FACTOR 0.95f
+// Control byte marking an empty slot in Robin Hood mode
+#define ROBIN_HOOD_EMPTY 0
+// Largest distance from its home slot a Robin Hood control byte records, one less than
+// the largest control byte. Elements further away saturate at it
+#define ROBIN_HOOD_MAX_DISTANCE 254
+// Largest load factor allowed in cuckoo mode
+#define MAX_CUCKOO_LOAD_FACTOR 0.95f
+// Largest number of buckets visited by the search for an eviction path in cuckoo mode
+#define CUCKOO_MAX_SEARCH 256
+// Alignment of cuckoo buckets, so that each bucket fills exactly one cache line
+#define CUCKOO_BUCKET_ALIGNMENT 64
+// Number of elements the cuckoo stash holds, filling one cache line
+#define CUCKOO_STASH_SLOTS (int)(CUCKOO_BUCKET_ALIGNMENT / sizeof(hash_slot))
+// Number of chained nodes in the first slab allocated by a table
+#define MIN_SLAB_NODES 32
+// Largest number of chained nodes in a single slab
+#define MAX_SLAB_NODES 4096
+// Number of keys hashed and prefetched ahead of being resolved by the batch functions
+#define HASH_BATCH_WINDOW 16
+// Number of values the array allocated for a new key holds in multimap mode
+#define MIN_VALUE_ARRAY_CAPACITY 2
+// Largest number of workers used by a bulk load or parallel resize
+#define MAX_BULK_THREADS 256
+// Fewest positions given to each worker inserting elements or migrating a resize
+#define BULK_MIN_PARTITION 1024
+// Fewest keys given to each worker hashing the input of a bulk load
+#define BULK_MIN_SLICE 4096
+// Steps of a bulk load or parallel resize run by each worker
+#define BULK_COUNT 0
+#define BULK_SCATTER 1
+#define BULK_INSERT 2
+#define BULK_MIGRATE 3
+#define BULK_AGGREGATE 4
+
+// Counter updates compile away unless statistics are enabled. Comparisons are also
+// counted per thread, so a lookup's own are told apart from those of concurrent lookups
+#ifdef HASH_TABLE_STATS
+#define STATS_COUNT(table, counter) atomic_fetch_add_explicit(&(((table)->counters).counter), 1, memory_order_relaxed)
+#define STATS_COMPARE(table) (stats_thread_comparisons++, STATS_COUNT(table, comparisons))
+#define STATS_COMPARISONS(table) stats_thread_comparisons
+#define STATS_LOOKUP(table, before, found) stats_lookup(table, before, found)
+#define STATS_RESIZE_BEGIN(table) stats_resize_begin(table)
+#define STATS_RESIZE_END(table) stats_resize_end(table)
+#else
+#define STATS_COUNT(table, counter)
+#define STATS_COMPARE(table)
+#define STATS_COMPARISONS(table) 0
+#define STATS_LOOKUP(table, before, found) ((void)(before))
+#define STATS_RESIZE_BEGIN(table)
+#define STATS_RESIZE_END(table)
+#endif
+
+/************************************
+ * PRIVATE TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief State of one worker of a bulk load or parallel resize. Each worker owns a
+ *        range of the input, or of the table's positions, and a private copy of the table
+ *        so that nodes and counts are never shared between workers.
+ */
+typedef struct hash_worker
+{
+    // Step the worker runs, one of the BULK_ defines
+    int phase;
+    // Copy of the table sharing its arrays
+    hash_table local;
+    // Keys and values of the elements being added
+    void **keys;
+    void **values;
+    // Range of the input, the order or the old positions the worker handles
+    int start;
+    int end;
+    // Number of partitions the positions are split into, and this worker's count or
+    // next free index in the order for each partition
+    int num_partitions;
+    int *counts;
+    // Indices of the elements grouped by partition
+    int *order;
+    // Range of positions the worker may write when inserting
+    int low;
+    int high;
+    // Byte set for each element stored as a new key, or NULL
+    unsigned char *added;
+    // Number of elements left for the calling thread to insert
+    int num_deferred;
+    // Old array being migrated by a parallel resize
+    hash_node *old_array;
+    // Value of each row and the operation applied by a partitioned aggregation
+    const int64_t *deltas;
+    hash_aggregate_op op;
+} hash_worker;
+
+/*!
+ * @brief Table and operation the groups of a worker's private table are combined into
+ *        by a partitioned aggregation.
+ */
+typedef struct hash_aggregate_target
+{
+    // Table receiving the groups
+    hash_table *table;
+    // Operation combining a group's partial value with the value already held
+    hash_aggregate_op op;
+} hash_aggregate_target;
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+#ifdef HASH_TABLE_STATS
+// Key comparisons made by the calling thread
+static _Thread_local long stats_thread_comparisons;
+
+/*!
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ * @return The current time in nanoseconds
+ */
+static uint64_t stats_now(void)
+{
+    struct timespec time;
+
+    clock_gettime(CLOCK_MONOTONIC, &time);
+
+    return (uint64_t)time.tv_sec * 1000000000ULL + (uint64_t)time.tv_nsec;
+}
+
+/*!
+ * @brief Attributes the key comparisons made by a lookup to its outcome.
+ * @param table Pointer to a hash table
+ * @param before Comparison count of the calling thread when the lookup started
+ * @param found True if the key was found
+ * @return None
+ */
+static void stats_lookup(hash_table *table, long before, bool found)
+{
+    hash_table_counters *counters = &(table->counters);
+    long made = stats_thread_comparisons - before;
+
+    if (found)
+    {
+        atomic_fetch_add_explicit(&(counters->successful_lookups), 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&(counters->successful_comparisons), made, memory_order_relaxed);
+    }
+    else
+    {
+        atomic_fetch_add_explicit(&(counters->failed_lookups), 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&(counters->failed_comparisons), made, memory_order_relaxed);
+    }
+}
+
+/*!
+ * @brief Starts timing resize work. Resizes nested inside another are timed by the outer one.
+ * @param table Pointer to a hash table
+ * @return None
+ */
+static void stats_resize_begin(hash_table *table)
+{
+    if ((table->counters).resize_depth++ == 0)
+    {
+        (table->counters).resize_start = stats_now();
+    }
+}
+
+/*!
+ * @brief Stops timing resize work once the outermost resize finishes.
+ * @param table Pointer to a hash table
+ * @return None
+ */
+static void stats_resize_end(hash_table *table)
+{
+    if (--(table->counters).resize_depth == 0)
+    {
+        (table->counters).resize_ns += stats_now() - (table->counters).resize_start;
+    }
+}
+#endif
+
+/*!
+ * @brief Hashes a key for an open addressing table. The key's hash is mixed so that
+ *        both the group position and the 7 bit control tag are well distributed,
+ *        even when the selected hash function is the identity.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to hash
+ * @return A 64 bit hash of the key
+ */
+static uint64_t open_hash(hash_table *table, void *hash_key)
+{
+    return hash_mix((table->key_hash)(hash_key, table->key_length));
+}
+
+/*!
+ * @brief Compares a stored key against a key being searched for.
+ * @param table Pointer to a hash table
+ * @param stored_key Key held by the table
+ * @param hash_key Key being searched for
+ * @return True if the keys are equal
+ */
+static bool keys_equal(hash_table *table, void *stored_key, void *hash_key)
+{
+    STATS_COMPARE(table);
+
+    // Identical pointers are always equal keys, and skip the call
+    return stored_key == hash_key || (table->key_equal)(stored_key, hash_key, table->key_length);
+}
+
+/*!
+ * @brief Returns if a table stores its elements in chains, as HASH_CHAINING and
+ *        HASH_MULTIMAP modes do.
+ * @param table Pointer to a hash table
+ * @return True if the table uses the chaining array and slabs
+ */
+static bool is_chained(hash_table *table)
+{
+    return table->mode == HASH_CHAINING || table->mode == HASH_MULTIMAP;
+}
+
+/*!
+ * @brief Computes the hash of a key used by the table's mode, which is also the hash
+ *        given to the table's filter.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to hash
+ * @return The full hash of the key in chaining modes, otherwise the hash from open_hash()
+ */
+static uint64_t mode_hash(hash_table *table, void *hash_key)
+{
+    return is_chained(table) ? (table->key_hash)(hash_key, table->key_length) : open_hash(table, hash_key);
+}
+
+/*!
+ * @brief Returns the table position for a hash in chaining mode.
+ * @param table Pointer to a hash table
+ * @param hash Full hash of a key
+ * @return An integer specifying the index into the hash table
+ */
+static int chain_index(hash_table *table, uint64_t hash)
+{
+    return (int)(hash % (uint64_t)table->table_size);
+}
+
+/*!
+ * @brief Returns the first node of the position a hash maps to in chaining mode. While
+ *        an incremental resize is in progress, positions of the old array which have
+ *        not been migrated yet still hold their elements.
+ * @param table Pointer to a hash table
+ * @param hash Full hash of a key
+ * @return Pointer to the first node at the position
+ */
+static hash_node *chain_head(hash_table *table, uint64_t hash)
+{
+    if (table->old_array != NULL)
+    {
+        int old_index = (int)(hash % (uint64_t)table->old_table_size);
+
+        // Positions below the rehash index have already been emptied
+        if (old_index >= table->rehash_index)
+        {
+            return &((table->old_array)[old_index]);
+        }
+    }
+
+    return &((table->array)[chain_index(table, hash)]);
+}
+
+/*!
+ * @brief Finds the node holding a key in chaining mode.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Full hash of the key
+ * @return Pointer to the node holding the key, or NULL if the key is not present
+ */
+static hash_node *chain_find(hash_table *table, void *hash_key, uint64_t hash)
+{
+    hash_node *node = chain_head(table, hash);
+
+    // An empty first node means nothing is stored at this position
+    if (node->key == NULL)
+    {
+        return NULL;
+    }
+
+    while (node != NULL)
+    {
+        // The cached hash rejects most mismatches without calling the comparator
+        if (node->hash == hash && keys_equal(table, node->key, hash_key))
+        {
+            return node;
+        }
+
+        node = node->next;
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Takes a node for chaining from the table's free list, or carves a new one out of
+ *        the current slab. A new slab, twice the size of the last, is allocated when the
+ *        current one is used up.
+ * @param table Pointer to a hash table
+ * @return Pointer to an uninitialized node
+ */
+static hash_node *node_allocate(hash_table *table)
+{
+    // Nodes released by remove_hash and resizing are reused first
+    if (table->free_nodes != NULL)
+    {
+        hash_node *node = table->free_nodes;
+
+        table->free_nodes = node->next;
+        return node;
+    }
+
+    if (table->slabs == NULL || table->slab_used == (table->slabs)->capacity)
+    {
+        int capacity = (table->slabs == NULL) ? MIN_SLAB_NODES : (table->slabs)->capacity * 2;
+
+        if (capacity > MAX_SLAB_NODES)
+        {
+            capacity = MAX_SLAB_NODES;
+        }
+
+        hash_node_slab *slab = (hash_node_slab *)malloc(sizeof(hash_node_slab) + capacity * sizeof(hash_node));
+
+        slab->capacity = capacity;
+        slab->next = table->slabs;
+        table->slabs = slab;
+        table->slab_used = 0;
+    }
+
+    return &(((table->slabs)->nodes)[table->slab_used++]);
+}
+
+/*!
+ * @brief Returns a chained node to the table's free list.
+ * @param table Pointer to a hash table
+ * @param node Pointer to a node which is no longer linked into a chain
+ * @return None
+ */
+static void node_release(hash_table *table, hash_node *node)
+{
+    node->key = NULL;
+    node->value = NULL;
+    node->next = table->free_nodes;
+    table->free_nodes = node;
+}
+
+/*!
+ * @brief Adds an element with a known hash to a chaining table without checking the load
+ *        factor. While an incremental resize is in progress, an element whose old position
+ *        has not been migrated yet is chained there, where lookups will search for it.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @param hash Full hash of the key
+ * @return None
+ */
+static void chain_insert(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    hash_node *node = chain_head(table, hash);
+
+    // Entered if no element is stored at the position yet
+    if (node->key == NULL)
+    {
+        node->key = hash_key;
+        node->value = hash_value;
+        node->hash = hash;
+
+        // Only newly occupied positions are counted
+        table->num_elements++;
+        return;
+    }
+
+    // Traverse the chain until the next reference is NULL
+    while (node->next != NULL)
+    {
+        node = node->next;
+    }
+
+    // Take a node for the next element at a given table location from the slabs
+    hash_node *next_node = node_allocate(table);
+
+    next_node->key = hash_key;
+    next_node->value = hash_value;
+    next_node->hash = hash;
+    next_node->next = NULL;
+    // The previous pointer refers to the node the new node is chained after
+    next_node->previous = node;
+
+    node->next = next_node;
+}
+
+/*!
+ * @brief Finds the node holding a key in a chaining table, chaining a new node for the
+ *        key to the end of its position in the same walk when it is not present. The load
+ *        factor is not checked, and a new key's value is left for the caller to set.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Full hash of the key
+ * @param added Set to true if the key was added
+ * @return Pointer to the node holding the key
+ */
+static hash_node *chain_find_or_add(hash_table *table, void *hash_key, uint64_t hash, bool *added)
+{
+    hash_node *node = chain_head(table, hash);
+
+    *added = true;
+
+    // Entered if no element is stored at the position yet
+    if (node->key == NULL)
+    {
+        node->key = hash_key;
+        node->hash = hash;
+
+        // Only newly occupied positions are counted
+        table->num_elements++;
+        return node;
+    }
+
+    while (true)
+    {
+        // The cached hash rejects most mismatches without calling the comparator
+        if (node->hash == hash && keys_equal(table, node->key, hash_key))
+        {
+            *added = false;
+            return node;
+        }
+
+        if (node->next == NULL)
+        {
+            break;
+        }
+
+        node = node->next;
+    }
+
+    hash_node *next_node = node_allocate(table);
+
+    next_node->key = hash_key;
+    next_node->hash = hash;
+    next_node->next = NULL;
+    // The previous pointer refers to the node the new node is chained after
+    next_node->previous = node;
+
+    node->next = next_node;
+
+    return next_node;
+}
+
+/*!
+ * @brief Allocates an array of empty table positions for chaining mode.
+ * @param size Number of positions
+ * @return Pointer to the new array
+ */
+static hash_node *chain_allocate(int size)
+{
+    // Zeroed memory sets every key, next and previous pointer to NULL. Large arrays
+    // are zeroed lazily by the operating system, so allocation does not touch every position
+    return (hash_node *)calloc(size, sizeof(hash_node));
+}
+
+/*!
+ * @brief Moves the elements at one position of the old array into the current array.
+ * @param table Pointer to a hash table, whose current array the elements are placed in
+ * @param head First node of the old position
+ * @return None
+ */
+static void chain_migrate_position(hash_table *table, hash_node *head)
+{
+    if (head->key == NULL)
+    {
+        return;
+    }
+
+    hash_node *node = head;
+
+    while (node != NULL)
+    {
+        hash_node *next_node = node->next;
+
+        // The cached hash avoids rehashing the key
+        chain_insert(table, node->key, node->value, node->hash);
+
+        // Chained nodes are returned to the free list for reuse
+        if (node != head)
+        {
+            node_release(table, node);
+        }
+
+        node = next_node;
+    }
+
+    head->key = NULL;
+    head->value = NULL;
+    head->next = NULL;
+
+    // The old position no longer counts as occupied
+    table->num_elements--;
+}
+
+/*!
+ * @brief Moves elements from positions of the old array into the current array
+ *        during an incremental resize. Frees the old array once it is empty.
+ * @param table Pointer to a hash table
+ * @param count Maximum number of old positions to migrate
+ * @return None
+ */
+static void chain_migrate(hash_table *table, int count)
+{
+    if (table->old_array == NULL)
+    {
+        return;
+    }
+
+    STATS_RESIZE_BEGIN(table);
+
+    while (count > 0 && table->old_array != NULL)
+    {
+        hash_node *head = &((table->old_array)[table->rehash_index]);
+
+        // The position counts as migrated before its elements are reinserted, so they
+        // are placed in the current array
+        table->rehash_index++;
+
+        chain_migrate_position(table, head);
+
+        count--;
+
+        if (table->rehash_index == table->old_table_size)
+        {
+            free(table->old_array);
+
+            table->old_array = NULL;
+            table->old_table_size = 0;
+            table->rehash_index = 0;
+        }
+    }
+
+    STATS_RESIZE_END(table);
+}
+
+/*!
+ * @brief Calls a function on every node of a chaining table, in both arrays while an
+ *        incremental resize is in progress.
+ * @param table Pointer to a hash table in a chaining mode
+ * @param visit Function called with each node holding a key and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return None
+ */
+static void chain_for_each_node(hash_table *table, void (*visit)(hash_node *node, void *context), void *context)
+{
+    hash_node *arrays[2] = {table->array, table->old_array};
+    int sizes[2] = {table->table_size, table->old_table_size};
+
+    for (int a = 0; a < 2 && arrays[a] != NULL; a++)
+    {
+        for (int i = 0; i < sizes[a]; i++)
+        {
+            hash_node *node = &((arrays[a])[i]);
+
+            // An empty first node means nothing is stored at this position
+            if (node->key == NULL)
+            {
+                continue;
+            }
+
+            while (node != NULL)
+            {
+                hash_node *next_node = node->next;
+
+                visit(node, context);
+                node = next_node;
+            }
+        }
+    }
+}
+
+/*!
+ * @brief Resizes a chaining table once an added element takes it past its load factor.
+ * @param table Pointer to a hash table in a chaining mode
+ * @return None
+ */
+static void chain_check_load(hash_table *table)
+{
+    // A new resize is not started until the current one has finished migrating
+    if (table->old_array == NULL && percent_occupied(table) >= (float)(table->load_factor * 100))
+    {
+        resize(table);
+    }
+}
+
+/*!
+ * @brief Adds an element with a known hash to a chaining table, resizing the table
+ *        if the load factor is exceeded.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @param hash Full hash of the key
+ * @return None
+ */
+static void chain_put(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    chain_insert(table, hash_key, hash_value, hash);
+    chain_check_load(table);
+}
+
+/*!
+ * @brief Adds a value for a key with a known hash to a multimap table. A new key is
+ *        inserted with an array holding the value, otherwise the value is added to the end
+ *        of the key's array, which doubles in size when full.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to add the value for
+ * @param hash_value Value to add
+ * @param hash Full hash of the key
+ * @return True if the key was added, false if the value joined an existing key's values
+ */
+static bool multimap_append(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    bool added;
+    hash_node *node = chain_find_or_add(table, hash_key, hash, &added);
+    hash_value_array *values;
+
+    if (added)
+    {
+        values = (hash_value_array *)malloc(sizeof(hash_value_array) + MIN_VALUE_ARRAY_CAPACITY * sizeof(void *));
+        values->count = 1;
+        values->capacity = MIN_VALUE_ARRAY_CAPACITY;
+        (values->values)[0] = hash_value;
+
+        // The array takes the place of the value in the key's node
+        node->value = values;
+        chain_check_load(table);
+        return true;
+    }
+
+    values = (hash_value_array *)node->value;
+
+    if (values->count == values->capacity)
+    {
+        values->capacity *= 2;
+        values = (hash_value_array *)realloc(values, sizeof(hash_value_array) + values->capacity * sizeof(void *));
+        node->value = values;
+    }
+
+    (values->values)[values->count++] = hash_value;
+
+    return false;
+}
+
+/*!
+ * @brief Removes the first element holding a key with a known hash from a chaining table.
+ * @param table Pointer to a hash table
+ * @param hash_key Key associated with the element
+ * @param hash Full hash of the key
+ * @return True if the key was present and removed
+ */
+static bool chain_remove(hash_table *table, void *hash_key, uint64_t hash)
+{
+    hash_node *node = chain_find(table, hash_key, hash);
+
+    // Nothing is removed if the key is not in the table
+    if (node == NULL)
+    {
+        return false;
+    }
+
+    // The node is reused for another key, so a multimap key's values are freed first
+    if (table->mode == HASH_MULTIMAP)
+    {
+        free(node->value);
+    }
+
+    // Entered if the node to remove was chained after the first node at a position
+    if (node->previous != NULL)
+    {
+        // Correctly assigns the next node to the previous node
+        (node->previous)->next = node->next;
+
+        if (node->next != NULL)
+        {
+            (node->next)->previous = node->previous;
+        }
+
+        // Returns the removed node to the free list
+        node_release(table, node);
+    }
+    // Entered if the node to remove is the first at a table position, and there is at least one
+    // other node in the chain
+    else if (node->next != NULL)
+    {
+        hash_node *next_node = node->next;
+
+        // The following node is moved into the table position, as the first
+        // node at a position is not separately allocated
+        node->key = next_node->key;
+        node->value = next_node->value;
+        node->hash = next_node->hash;
+        node->next = next_node->next;
+
+        if (node->next != NULL)
+        {
+            (node->next)->previous = node;
+        }
+
+        node_release(table, next_node);
+    }
+    // If the element to remove is the only element at the table position
+    else
+    {
+        node->key = NULL;
+        node->value = NULL;
+        table->num_elements--;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Returns the entry of a slot in HASH_INLINE mode.
+ * @param table Pointer to a hash table
+ * @param index Slot of the entry
+ * @return Pointer to the entry's key, which its value follows
+ */
+static unsigned char *inline_entry(hash_table *table, int index)
+{
+    return table->entries + (size_t)index * table->entry_size;
+}
+
+/*!
+ * @brief Sets the control byte for a slot. The first group of control bytes is
+ *        mirrored past the end of the array so a group can be loaded from any slot.
+ * @param table Pointer to a hash table
+ * @param index Slot to update
+ * @param byte New control byte
+ * @return None
+ */
+static void set_control(hash_table *table, int index, unsigned char byte)
+{
+    table->control[index] = byte;
+
+    if (index < HASH_GROUP_WIDTH)
+    {
+        table->control[table->table_size + index] = byte;
+    }
+}
+
+/*!
+ * @brief Allocates empty control bytes and slots for an open addressing table, or
+ *        entries in HASH_INLINE mode.
+ * @param table Pointer to a hash table
+ * @param capacity Number of slots, a power of two of at least HASH_GROUP_WIDTH
+ * @return None
+ */
+static void swiss_allocate(hash_table *table, int capacity)
+{
+    table->table_size = capacity;
+    table->control = (unsigned char *)malloc(capacity + HASH_GROUP_WIDTH);
+
+    if (table->mode == HASH_INLINE)
+    {
+        table->entries = (unsigned char *)malloc((size_t)capacity * table->entry_size);
+    }
+    else
+    {
+        // Zeroed slots hold NULL keys, so a reader racing a writer never finds an
+        // uninitialized key behind a control byte
+        table->slots = (hash_slot *)calloc(capacity, sizeof(hash_slot));
+    }
+
+    memset(table->control, (table->mode == HASH_ROBIN_HOOD) ? ROBIN_HOOD_EMPTY : CONTROL_EMPTY,
+           capacity + HASH_GROUP_WIDTH);
+
+    table->num_elements = 0;
+    table->num_deleted = 0;
+}
+
+/*!
+ * @brief Finds the slot holding a key by probing groups of control bytes.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Hash of the key
+ * @return Index of the slot holding the key, or -1 if the key is not present
+ */
+static int swiss_find(hash_table *table, void *hash_key, uint64_t hash)
+{
+    int mask = table->table_size - 1;
+    int position = (int)(hash >> 7) & mask;
+    unsigned char tag = (unsigned char)(hash & 0x7F);
+
+    // Triangular probing visits every group once before repeating
+    for (int stride = 0; stride <= table->table_size; stride += HASH_GROUP_WIDTH)
+    {
+        const unsigned char *group = table->control + position;
+        uint32_t matches = group_match(group, tag);
+
+        // Only slots whose tag matches are compared against the key
+        while (matches != 0)
+        {
+            int index = (position + __builtin_ctz(matches)) & mask;
+            // The key is loaded once, as a lock free reader may race a writer clearing the
+            // slot, and NULL is never a stored key
+            void *stored_key = __atomic_load_n(&((table->slots)[index].key), __ATOMIC_RELAXED);
+
+            if (stored_key != NULL && keys_equal(table, stored_key, hash_key))
+            {
+                return index;
+            }
+
+            matches &= matches - 1;
+        }
+
+        // An empty slot in the group ends the probe sequence
+        if (group_match(group, CONTROL_EMPTY) != 0)
+        {
+            return -1;
+        }
+
+        position = (position + stride + HASH_GROUP_WIDTH) & mask;
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief Finds the first empty or deleted slot along the probe sequence of a hash.
+ * @param table Pointer to a hash table
+ * @param hash Hash of the key to insert
+ * @return Index of a free slot
+ */
+static int swiss_find_free(hash_table *table, uint64_t hash)
+{
+    int mask = table->table_size - 1;
+    int position = (int)(hash >> 7) & mask;
+    int stride = 0;
+    uint32_t free_slots = group_match_free(table->control + position);
+
+    // The load factor cap guarantees a free slot exists
+    while (free_slots == 0)
+    {
+        stride += HASH_GROUP_WIDTH;
+        position = (position + stride) & mask;
+        free_slots = group_match_free(table->control + position);
+    }
+
+    return (position + __builtin_ctz(free_slots)) & mask;
+}
+
+static void open_parallel_rehash(hash_table *table, int capacity);
+
+/*!
+ * @brief Rebuilds an open addressing table with a new capacity, dropping deleted markers.
+ *        A rebuild at the same capacity copies the result back into the existing arrays,
+ *        so pointers to the control bytes and slots stay valid.
+ * @param table Pointer to a hash table
+ * @param capacity New number of slots, a power of two
+ * @return None
+ */
+static void swiss_rehash(hash_table *table, int capacity)
+{
+    unsigned char *old_control = table->control;
+    hash_slot *old_slots = table->slots;
+    unsigned char *old_entries = table->entries;
+    int old_size = table->table_size;
+    int num_elements = table->num_elements;
+
+    STATS_COUNT(table, num_resizes);
+    STATS_RESIZE_BEGIN(table);
+
+    // Growing a table with resize threads set rebuilds ranges of slots in parallel
+    if (table->resize_threads > 1 && capacity != old_size)
+    {
+        open_parallel_rehash(table, capacity);
+
+        STATS_RESIZE_END(table);
+        return;
+    }
+
+    swiss_allocate(table, capacity);
+
+    for (int i = 0; i < old_size; i++)
+    {
+        // Only full slots have the high bit of their control byte clear
+        if ((old_control[i] & 0x80) != 0)
+        {
+            continue;
+        }
+
+        if (table->mode == HASH_INLINE)
+        {
+            unsigned char *entry = old_entries + (size_t)i * table->entry_size;
+            int index = swiss_find_free(table, open_hash(table, entry));
+
+            set_control(table, index, old_control[i]);
+            memcpy(inline_entry(table, index), entry, table->entry_size);
+        }
+        else
+        {
+            int index = swiss_find_free(table, open_hash(table, old_slots[i].key));
+
+            set_control(table, index, old_control[i]);
+            (table->slots)[index] = old_slots[i];
+        }
+    }
+
+    table->num_elements = num_elements;
+
+    if (capacity == old_size)
+    {
+        memcpy(old_control, table->control, capacity + HASH_GROUP_WIDTH);
+        free(table->control);
+        table->control = old_control;
+
+        // The rebuilt contents now live in the original arrays
+        if (table->mode == HASH_INLINE)
+        {
+            memcpy(old_entries, table->entries, (size_t)capacity * table->entry_size);
+            free(table->entries);
+            table->entries = old_entries;
+        }
+        else
+        {
+            memcpy(old_slots, table->slots, capacity * sizeof(hash_slot));
+            free(table->slots);
+            table->slots = old_slots;
+        }
+    }
+    else
+    {
+        free(old_control);
+        free(old_slots);
+        free(old_entries);
+    }
+
+    STATS_RESIZE_END(table);
+}
+
+/*!
+ * @brief Adds or updates an element in an open addressing table.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to create an index from
+ * @param hash_value Value to place into the hash table
+ * @param hash Hash of the key from open_hash()
+ * @return True if the key was added, false if an existing key's value was replaced
+ */
+static bool swiss_put(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    int index = swiss_find(table, hash_key, hash);
+
+    // An existing key has its value replaced rather than being stored twice
+    if (index >= 0)
+    {
+        (table->slots)[index].value = hash_value;
+        return false;
+    }
+
+    int capacity = group_rebuild_capacity(table->table_size, table->num_elements, table->num_deleted,
+                                          table->load_factor);
+
+    if (capacity != 0)
+    {
+        swiss_rehash(table, capacity);
+    }
+
+    index = swiss_find_free(table, hash);
+
+    if ((table->control)[index] == CONTROL_DELETED)
+    {
+        table->num_deleted--;
+    }
+
+    set_control(table, index, (unsigned char)(hash & 0x7F));
+    (table->slots)[index].key = hash_key;
+    (table->slots)[index].value = hash_value;
+
+    table->num_elements++;
+
+    return true;
+}
+
+/*!
+ * @brief Removes an element from an open addressing table, leaving a deleted marker.
+ * @param table Pointer to a hash table
+ * @param hash_key Key associated with the element
+ * @return True if the key was present and removed
+ */
+static bool swiss_remove(hash_table *table, void *hash_key)
+{
+    int index = swiss_find(table, hash_key, open_hash(table, hash_key));
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    set_control(table, index, CONTROL_DELETED);
+    (table->slots)[index].key = NULL;
+    (table->slots)[index].value = NULL;
+
+    table->num_elements--;
+    table->num_deleted++;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the slot a hash maps to in Robin Hood mode.
+ * @param table Pointer to a hash table
+ * @param hash Hash of the key from open_hash()
+ * @return Index of the key's home slot
+ */
+static int robin_hood_home(hash_table *table, uint64_t hash)
+{
+    return (int)(hash & (uint64_t)(table->table_size - 1));
+}
+
+/*!
+ * @brief Returns the distance of a slot's element from its home slot in Robin Hood mode.
+ *        The control byte holds it unless saturated, when it is found from the key's hash.
+ * @param table Pointer to a hash table
+ * @param index Index of the slot
+ * @return Distance from the home slot, or -1 if the slot is empty
+ */
+static int robin_hood_distance(hash_table *table, int index)
+{
+    int stored = (table->control)[index] - 1;
+
+    if (stored < ROBIN_HOOD_MAX_DISTANCE)
+    {
+        return stored;
+    }
+
+    int home = robin_hood_home(table, open_hash(table, (table->slots)[index].key));
+
+    return (index - home) & (table->table_size - 1);
+}
+
+/*!
+ * @brief Records the distance of a slot's element from its home slot in Robin Hood mode.
+ * @param table Pointer to a hash table
+ * @param index Index of the slot
+ * @param distance Distance from the home slot
+ * @return None
+ */
+static void robin_hood_set_distance(hash_table *table, int index, int distance)
+{
+    int recorded = (distance < ROBIN_HOOD_MAX_DISTANCE) ? distance : ROBIN_HOOD_MAX_DISTANCE;
+
+    (table->control)[index] = (unsigned char)(recorded + 1);
+}
+
+/*!
+ * @brief Finds the slot holding a key in Robin Hood mode. Elements along a probe are
+ *        ordered by their distance from home, so the search stops at the first element
+ *        closer to its home slot than the key would be.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Hash of the key from open_hash()
+ * @return Index of the slot holding the key, or -1 if the key is not present
+ */
+static int robin_hood_find(hash_table *table, void *hash_key, uint64_t hash)
+{
+    int mask = table->table_size - 1;
+    int index = robin_hood_home(table, hash);
+
+    // The load factor cap guarantees an empty slot ends the search
+    for (int distance = 0;; distance++)
+    {
+        // An empty slot reads as a distance of -1
+        int stored = robin_hood_distance(table, index);
+
+        // The key would have displaced this element had it been inserted
+        if (stored < distance)
+        {
+            return -1;
+        }
+
+        // Only an element at the same distance shares the key's home slot
+        if (stored == distance && keys_equal(table, (table->slots)[index].key, hash_key))
+        {
+            return index;
+        }
+
+        index = (index + 1) & mask;
+    }
+}
+
+/*!
+ * @brief Places an element which is not already in the table in Robin Hood mode. Walking
+ *        on from a slot along the element's probe, the element takes the place of the
+ *        first element closer to its own home, which then continues the walk in its stead.
+ *        Distances past ROBIN_HOOD_MAX_DISTANCE, as keys with equal hashes build up,
+ *        saturate the control byte rather than growing a table which no size would help.
+ * @param table Pointer to a hash table
+ * @param slot Key value pair to place
+ * @param index Slot to start walking from, at or before where the element belongs
+ * @param distance Distance of that slot from the element's home slot
+ * @return Index of the slot the element was placed in
+ */
+static int robin_hood_insert_from(hash_table *table, hash_slot slot, int index, int distance)
+{
+    int mask = table->table_size - 1;
+    int placed = -1;
+
+    while (true)
+    {
+        int stored = robin_hood_distance(table, index);
+
+        if (stored < 0)
+        {
+            robin_hood_set_distance(table, index, distance);
+            (table->slots)[index] = slot;
+            table->num_elements++;
+            return (placed < 0) ? index : placed;
+        }
+
+        // Taking from the element nearer its home evens out the probe lengths
+        if (stored < distance)
+        {
+            hash_slot displaced = (table->slots)[index];
+
+            robin_hood_set_distance(table, index, distance);
+            (table->slots)[index] = slot;
+
+            // Only the first slot taken holds the element being placed
+            if (placed < 0)
+            {
+                placed = index;
+            }
+
+            slot = displaced;
+            distance = stored;
+        }
+
+        index = (index + 1) & mask;
+        distance++;
+    }
+}
+
+/*!
+ * @brief Places an element which is not already in the table in Robin Hood mode, walking
+ *        from its home slot.
+ * @param table Pointer to a hash table
+ * @param slot Key value pair to place
+ * @param hash Hash of the key from open_hash()
+ * @return Index of the slot the element was placed in
+ */
+static int robin_hood_insert(hash_table *table, hash_slot slot, uint64_t hash)
+{
+    return robin_hood_insert_from(table, slot, robin_hood_home(table, hash), 0);
+}
+
+/*!
+ * @brief Rebuilds a Robin Hood table with a new capacity.
+ * @param table Pointer to a hash table
+ * @param capacity New number of slots, a power of two
+ * @return None
+ */
+static void robin_hood_rehash(hash_table *table, int capacity)
+{
+    unsigned char *old_control = table->control;
+    hash_slot *old_slots = table->slots;
+    int old_size = table->table_size;
+
+    STATS_COUNT(table, num_resizes);
+    STATS_RESIZE_BEGIN(table);
+
+    swiss_allocate(table, capacity);
+
+    for (int i = 0; i < old_size; i++)
+    {
+        if (old_control[i] != ROBIN_HOOD_EMPTY)
+        {
+            robin_hood_insert(table, old_slots[i], open_hash(table, old_slots[i].key));
+        }
+    }
+
+    free(old_control);
+    free(old_slots);
+
+    STATS_RESIZE_END(table);
+}
+
+/*!
+ * @brief Adds or updates an element in a Robin Hood table.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to create an index from
+ * @param hash_value Value to place into the hash table
+ * @param hash Hash of the key from open_hash()
+ * @return True if the key was added, false if an existing key's value was replaced
+ */
+static bool robin_hood_put(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    int index = robin_hood_find(table, hash_key, hash);
+
+    // An existing key has its value replaced rather than being stored twice
+    if (index >= 0)
+    {
+        (table->slots)[index].value = hash_value;
+        return false;
+    }
+
+    if (table->num_elements + 1 > (int)(table->table_size * table->load_factor))
+    {
+        robin_hood_rehash(table, table->table_size * 2);
+    }
+
+    hash_slot slot = {hash_key, hash_value};
+
+    robin_hood_insert(table, slot, hash);
+
+    return true;
+}
+
+/*!
+ * @brief Finds the slot holding a key in a Robin Hood table, adding the key in the same
+ *        probe when it is not present. The probe stops where the key belongs, so a new key
+ *        is placed from there. A new key's value is left for the caller to set.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Hash of the key from open_hash()
+ * @param added Set to true if the key was added
+ * @return Index of the slot holding the key
+ */
+static int robin_hood_find_or_add(hash_table *table, void *hash_key, uint64_t hash, bool *added)
+{
+    int mask = table->table_size - 1;
+    int index = robin_hood_home(table, hash);
+    int distance = 0;
+    hash_slot slot = {hash_key, NULL};
+
+    // The load factor cap guarantees an empty slot ends the search
+    while (true)
+    {
+        int stored = robin_hood_distance(table, index);
+
+        if (stored < distance)
+        {
+            break;
+        }
+
+        if (stored == distance && keys_equal(table, (table->slots)[index].key, hash_key))
+        {
+            *added = false;
+            return index;
+        }
+
+        index = (index + 1) & mask;
+        distance++;
+    }
+
+    *added = true;
+
+    // Growing moves every element, so the key is placed from its home slot instead
+    if (table->num_elements + 1 > (int)(table->table_size * table->load_factor))
+    {
+        robin_hood_rehash(table, table->table_size * 2);
+
+        return robin_hood_insert(table, slot, hash);
+    }
+
+    return robin_hood_insert_from(table, slot, index, distance);
+}
+
+/*!
+ * @brief Removes an element from a Robin Hood table. Following elements which are away
+ *        from their home slot are shifted back one slot, so no deleted marker is left.
+ * @param table Pointer to a hash table
+ * @param hash_key Key associated with the element
+ * @return True if the key was present and removed
+ */
+static bool robin_hood_remove(hash_table *table, void *hash_key)
+{
+    int index = robin_hood_find(table, hash_key, open_hash(table, hash_key));
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    int mask = table->table_size - 1;
+    int next = (index + 1) & mask;
+
+    // The shift ends at an empty slot or an element already in its home slot
+    while ((table->control)[next] > 1)
+    {
+        robin_hood_set_distance(table, index, robin_hood_distance(table, next) - 1);
+        (table->slots)[index] = (table->slots)[next];
+
+        index = next;
+        next = (next + 1) & mask;
+    }
+
+    (table->control)[index] = ROBIN_HOOD_EMPTY;
+    (table->slots)[index].key = NULL;
+    (table->slots)[index].value = NULL;
+
+    table->num_elements--;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the two buckets a hash maps to in cuckoo mode, taken from the low and
+ *        high halves of the hash.
+ * @param table Pointer to a hash table
+ * @param hash Hash of the key from open_hash()
+ * @param buckets Array receiving the first and second bucket
+ * @return None
+ */
+static void cuckoo_buckets(hash_table *table, uint64_t hash, int buckets[2])
+{
+    uint64_t mask = (uint64_t)(table->table_size / HASH_BUCKET_SLOTS - 1);
+
+    buckets[0] = (int)(hash & mask);
+    buckets[1] = (int)((hash >> 32) & mask);
+
+    // Distinct buckets give every key eight candidate slots
+    if (buckets[1] == buckets[0])
+    {
+        buckets[1] ^= 1;
+    }
+}
+
+/*!
+ * @brief Allocates empty cache line aligned buckets for a cuckoo table.
+ * @param table Pointer to a hash table
+ * @param capacity Number of slots, a power of two of at least HASH_GROUP_WIDTH
+ * @return None
+ */
+static void cuckoo_allocate(hash_table *table, int capacity)
+{
+    table->table_size = capacity;
+    table->slots = (hash_slot *)aligned_alloc(CUCKOO_BUCKET_ALIGNMENT, capacity * sizeof(hash_slot));
+
+    // A NULL key marks an empty slot
+    memset(table->slots, 0, capacity * sizeof(hash_slot));
+
+    table->stash = NULL;
+    table->num_stashed = 0;
+    table->num_elements = 0;
+}
+
+/*!
+ * @brief Finds the slot holding a key in cuckoo mode. Only the key's two buckets are
+ *        examined along with the stash, so a lookup touches at most three cache lines.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Hash of the key from open_hash()
+ * @return Pointer to the slot holding the key, or NULL if the key is not present
+ */
+static hash_slot *cuckoo_find(hash_table *table, void *hash_key, uint64_t hash)
+{
+    int buckets[2];
+
+    cuckoo_buckets(table, hash, buckets);
+
+    for (int b = 0; b < 2; b++)
+    {
+        hash_slot *bucket = &((table->slots)[buckets[b] * HASH_BUCKET_SLOTS]);
+
+        for (int i = 0; i < HASH_BUCKET_SLOTS; i++)
+        {
+            if (bucket[i].key != NULL && keys_equal(table, bucket[i].key, hash_key))
+            {
+                return &(bucket[i]);
+            }
+        }
+    }
+
+    for (int i = 0; i < table->num_stashed; i++)
+    {
+        if (keys_equal(table, (table->stash)[i].key, hash_key))
+        {
+            return &((table->stash)[i]);
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Places an element which is not already in the table in cuckoo mode. A breadth
+ *        first search from the element's two buckets looks for the shortest chain of
+ *        elements which can each move to their other bucket, ending at a free slot. The
+ *        chain is then shifted from its free end, leaving a free slot for the element.
+ * @param table Pointer to a hash table
+ * @param slot Key value pair to place
+ * @param hash Hash of the key from open_hash()
+ * @return True if the element was placed, false if no path was found within
+ *         CUCKOO_MAX_SEARCH buckets
+ */
+static bool cuckoo_insert(hash_table *table, hash_slot slot, uint64_t hash)
+{
+    // Each search entry records a bucket, the entry it was reached from, and the slot of
+    // that entry's bucket whose element would move into it
+    int search_bucket[CUCKOO_MAX_SEARCH];
+    int search_parent[CUCKOO_MAX_SEARCH];
+    int search_slot[CUCKOO_MAX_SEARCH];
+    int tail = 2;
+
+    cuckoo_buckets(table, hash, search_bucket);
+    search_parent[0] = search_parent[1] = -1;
+
+    for (int head = 0; head < tail; head++)
+    {
+        hash_slot *bucket = &((table->slots)[search_bucket[head] * HASH_BUCKET_SLOTS]);
+        int free_slot = -1;
+
+        for (int i = 0; i < HASH_BUCKET_SLOTS && free_slot < 0; i++)
+        {
+            if (bucket[i].key == NULL)
+            {
+                free_slot = i;
+            }
+        }
+
+        if (free_slot >= 0)
+        {
+            int entry = head;
+
+            // Each element on the path moves into the slot freed by the one after it
+            while (search_parent[entry] >= 0)
+            {
+                int parent = search_parent[entry];
+                int from = search_bucket[parent] * HASH_BUCKET_SLOTS + search_slot[entry];
+                int buckets[2];
+
+                // A bucket reached twice along the path can leave a slot emptied or holding
+                // an element which does not belong here, in which case the moves so far are kept
+                if ((table->slots)[from].key == NULL)
+                {
+                    return false;
+                }
+
+                cuckoo_buckets(table, open_hash(table, (table->slots)[from].key), buckets);
+
+                if (buckets[0] != search_bucket[entry] && buckets[1] != search_bucket[entry])
+                {
+                    return false;
+                }
+
+                (table->slots)[search_bucket[entry] * HASH_BUCKET_SLOTS + free_slot] = (table->slots)[from];
+                (table->slots)[from].key = NULL;
+
+                free_slot = search_slot[entry];
+                entry = parent;
+            }
+
+            (table->slots)[search_bucket[entry] * HASH_BUCKET_SLOTS + free_slot] = slot;
+            table->num_elements++;
+            return true;
+        }
+
+        // Every element of a full bucket is a candidate to move to its other bucket
+        for (int i = 0; i < HASH_BUCKET_SLOTS && tail < CUCKOO_MAX_SEARCH; i++)
+        {
+            int buckets[2];
+
+            cuckoo_buckets(table, open_hash(table, bucket[i].key), buckets);
+
+            search_bucket[tail] = (buckets[0] == search_bucket[head]) ? buckets[1] : buckets[0];
+            search_parent[tail] = head;
+            search_slot[tail] = i;
+            tail++;
+        }
+    }
+
+    return false;
+}
+
+/*!
+ * @brief Counts the elements in a hash's two buckets and the stash whose hashes are equal
+ *        to it. No table size separates them, so past a point growing cannot help.
+ * @param table Pointer to a hash table
+ * @param hash Hash of the key from open_hash()
+ * @return Number of elements with the same hash
+ */
+static int cuckoo_equal_hashes(hash_table *table, uint64_t hash)
+{
+    int buckets[2];
+    int count = 0;
+
+    cuckoo_buckets(table, hash, buckets);
+
+    for (int b = 0; b < 2; b++)
+    {
+        hash_slot *bucket = &((table->slots)[buckets[b] * HASH_BUCKET_SLOTS]);
+
+        for (int i = 0; i < HASH_BUCKET_SLOTS; i++)
+        {
+            count += bucket[i].key != NULL && open_hash(table, bucket[i].key) == hash;
+        }
+    }
+
+    for (int i = 0; i < table->num_stashed; i++)
+    {
+        count += open_hash(table, (table->stash)[i].key) == hash;
+    }
+
+    return count;
+}
+
+/*!
+ * @brief Places an element in cuckoo mode. When no eviction path is found the table is
+ *        grown through resize(), unless it is under half full, where growing rarely helps
+ *        and the element goes to the stash instead. The stash holds one cache line of
+ *        elements, past which the table grows as well, unless the element's two buckets
+ *        and the stash are already full of elements with its hash.
+ * @param table Pointer to a hash table
+ * @param slot Key value pair to place
+ * @param hash Hash of the key from open_hash()
+ * @return True if the element was placed, false if too many elements share its hash
+ */
+static bool cuckoo_place(hash_table *table, hash_slot slot, uint64_t hash)
+{
+    while (!cuckoo_insert(table, slot, hash))
+    {
+        if (table->num_elements < table->table_size / 2)
+        {
+            if (table->num_stashed < CUCKOO_STASH_SLOTS)
+            {
+                if (table->stash == NULL)
+                {
+                    table->stash = (hash_slot *)aligned_alloc(CUCKOO_BUCKET_ALIGNMENT,
+                                                              CUCKOO_STASH_SLOTS * sizeof(hash_slot));
+                }
+
+                (table->stash)[table->num_stashed] = slot;
+                table->num_stashed++;
+                table->num_elements++;
+                return true;
+            }
+
+            if (cuckoo_equal_hashes(table, hash) >= 2 * HASH_BUCKET_SLOTS + CUCKOO_STASH_SLOTS)
+            {
+                return false;
+            }
+        }
+
+        resize(table);
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Rebuilds a cuckoo table with a new capacity.
+ * @param table Pointer to a hash table
+ * @param capacity New number of slots, a power of two
+ * @return None
+ */
+static void cuckoo_rehash(hash_table *table, int capacity)
+{
+    hash_slot *old_slots = table->slots;
+    int old_size = table->table_size;
+    hash_slot *old_stash = table->stash;
+    int old_stashed = table->num_stashed;
+
+    STATS_COUNT(table, num_resizes);
+    STATS_RESIZE_BEGIN(table);
+
+    cuckoo_allocate(table, capacity);
+
+    // Every element fit in the smaller table, so no more share a hash than can be placed
+    for (int i = 0; i < old_size; i++)
+    {
+        if (old_slots[i].key != NULL)
+        {
+            cuckoo_place(table, old_slots[i], open_hash(table, old_slots[i].key));
+        }
+    }
+
+    // Stashed elements get another chance at a bucket in the larger table
+    for (int i = 0; i < old_stashed; i++)
+    {
+        cuckoo_place(table, old_stash[i], open_hash(table, old_stash[i].key));
+    }
+
+    free(old_slots);
+    free(old_stash);
+
+    STATS_RESIZE_END(table);
+}
+
+/*!
+ * @brief Adds or updates an element in a cuckoo table.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to create an index from
+ * @param hash_value Value to place into the hash table
+ * @param hash Hash of the key from open_hash()
+ * @param added Set to true if the key was added, false if an existing key's value was replaced
+ * @return True if the element was stored, false if too many keys share its hash
+ */
+static bool cuckoo_put(hash_table *table, void *hash_key, void *hash_value, uint64_t hash, bool *added)
+{
+    hash_slot *existing = cuckoo_find(table, hash_key, hash);
+
+    *added = false;
+
+    // An existing key has its value replaced rather than being stored twice
+    if (existing != NULL)
+    {
+        existing->value = hash_value;
+        return true;
+    }
+
+    if (table->num_elements + 1 > (int)(table->table_size * table->load_factor))
+    {
+        cuckoo_rehash(table, table->table_size * 2);
+    }
+
+    hash_slot slot = {hash_key, hash_value};
+
+    *added = cuckoo_place(table, slot, hash);
+
+    return *added;
+}
+
+/*!
+ * @brief Removes an element from a cuckoo table.
+ * @param table Pointer to a hash table
+ * @param hash_key Key associated with the element
+ * @return True if the key was present and removed
+ */
+static bool cuckoo_remove(hash_table *table, void *hash_key)
+{
+    hash_slot *slot = cuckoo_find(table, hash_key, open_hash(table, hash_key));
+
+    if (slot == NULL)
+    {
+        return false;
+    }
+
+    // The last stashed element fills the gap left in the stash
+    if (slot >= table->stash && slot < table->stash + table->num_stashed)
+    {
+        table->num_stashed--;
+        *slot = (table->stash)[table->num_stashed];
+    }
+    else
+    {
+        slot->key = NULL;
+        slot->value = NULL;
+    }
+
+    table->num_elements--;
+
+    return true;
+}
+
+/*!
+ * @brief Hashes a HASH_INLINE key. Keys of 4 and 8 bytes are read as integers, which
+ *        open_hash() then mixes, and other lengths are hashed by content.
+ * @param key Pointer to the key's bytes
+ * @param key_length Number of bytes in the key
+ * @return A 64 bit hash of the key
+ */
+static uint64_t hash_inline_key(const void *key, size_t key_length)
+{
+    if (key_length == sizeof(uint64_t))
+    {
+        uint64_t word;
+
+        memcpy(&word, key, sizeof(word));
+        return word;
+    }
+
+    if (key_length == sizeof(uint32_t))
+    {
+        uint32_t word;
+
+        memcpy(&word, key, sizeof(word));
+        return word;
+    }
+
+    return hash_bytes(key, key_length);
+}
+
+/*!
+ * @brief Compares a key stored in a HASH_INLINE entry against a key being searched for.
+ * @param table Pointer to a hash table
+ * @param stored_key Key bytes held by the table
+ * @param hash_key Key bytes being searched for
+ * @return True if the keys are equal
+ */
+static bool inline_keys_equal(hash_table *table, const unsigned char *stored_key, const void *hash_key)
+{
+    STATS_COMPARE(table);
+
+    // Integer sized keys are compared with a single load of each, without a call
+    if (table->key_length == sizeof(uint64_t))
+    {
+        uint64_t a;
+        uint64_t b;
+
+        memcpy(&a, stored_key, sizeof(a));
+        memcpy(&b, hash_key, sizeof(b));
+        return a == b;
+    }
+
+    if (table->key_length == sizeof(uint32_t))
+    {
+        uint32_t a;
+        uint32_t b;
+
+        memcpy(&a, stored_key, sizeof(a));
+        memcpy(&b, hash_key, sizeof(b));
+        return a == b;
+    }
+
+    return memcmp(stored_key, hash_key, table->key_length) == 0;
+}
+
+/*!
+ * @brief Finds the slot holding a key in HASH_INLINE mode, probing as swiss_find() does.
+ * @param table Pointer to a hash table
+ * @param hash_key Pointer to the key's bytes
+ * @param hash Hash of the key from open_hash()
+ * @return Index of the slot holding the key, or -1 if the key is not present
+ */
+static int inline_find(hash_table *table, void *hash_key, uint64_t hash)
+{
+    int mask = table->table_size - 1;
+    int position = (int)(hash >> 7) & mask;
+    unsigned char tag = (unsigned char)(hash & 0x7F);
+
+    for (int stride = 0; stride <= table->table_size; stride += HASH_GROUP_WIDTH)
+    {
+        const unsigned char *group = table->control + position;
+        uint32_t matches = group_match(group, tag);
+
+        while (matches != 0)
+        {
+            int index = (position + __builtin_ctz(matches)) & mask;
+
+            if (inline_keys_equal(table, inline_entry(table, index), hash_key))
+            {
+                return index;
+            }
+
+            matches &= matches - 1;
+        }
+
+        if (group_match(group, CONTROL_EMPTY) != 0)
+        {
+            return -1;
+        }
+
+        position = (position + stride + HASH_GROUP_WIDTH) & mask;
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief Copies a value into a HASH_INLINE entry.
+ * @param table Pointer to a hash table
+ * @param index Slot of the entry
+ * @param hash_value Pointer to the value's bytes, or NULL to store zero bytes
+ * @return None
+ */
+static void inline_set_value(hash_table *table, int index, const void *hash_value)
+{
+    unsigned char *value = inline_entry(table, index) + table->key_length;
+
+    if (hash_value != NULL)
+    {
+        memcpy(value, hash_value, table->value_size);
+    }
+    else
+    {
+        memset(value, 0, table->value_size);
+    }
+}
+
+/*!
+ * @brief Adds or updates an element in a HASH_INLINE table, copying the key and value.
+ * @param table Pointer to a hash table
+ * @param hash_key Pointer to the key's bytes
+ * @param hash_value Pointer to the value's bytes, or NULL to store zero bytes
+ * @param hash Hash of the key from open_hash()
+ * @return True if the key was added, false if an existing key's value was replaced
+ */
+static bool inline_put(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    int index = inline_find(table, hash_key, hash);
+
+    if (index >= 0)
+    {
+        inline_set_value(table, index, hash_value);
+        return false;
+    }
+
+    int capacity = group_rebuild_capacity(table->table_size, table->num_elements, table->num_deleted,
+                                          table->load_factor);
+
+    if (capacity != 0)
+    {
+        swiss_rehash(table, capacity);
+    }
+
+    index = swiss_find_free(table, hash);
+
+    if ((table->control)[index] == CONTROL_DELETED)
+    {
+        table->num_deleted--;
+    }
+
+    set_control(table, index, (unsigned char)(hash & 0x7F));
+    memcpy(inline_entry(table, index), hash_key, table->key_length);
+    inline_set_value(table, index, hash_value);
+
+    table->num_elements++;
+
+    return true;
+}
+
+/*!
+ * @brief Removes an element from a HASH_INLINE table, leaving a deleted marker.
+ * @param table Pointer to a hash table
+ * @param hash_key Pointer to the key's bytes
+ * @return True if the key was present and removed
+ */
+static bool inline_remove(hash_table *table, void *hash_key)
+{
+    int index = inline_find(table, hash_key, open_hash(table, hash_key));
+
+    if (index < 0)
+    {
+        return false;
+    }
+
+    // The entry's bytes are left in place, as only the control byte is ever checked
+    set_control(table, index, CONTROL_DELETED);
+
+    table->num_elements--;
+    table->num_deleted++;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the key stored in a full slot of an open addressing table.
+ * @param table Pointer to a hash table in an open addressing mode
+ * @param index Slot of the element
+ * @return The stored key, or a pointer to its bytes in HASH_INLINE mode
+ */
+static void *open_key(hash_table *table, int index)
+{
+    return (table->mode == HASH_INLINE) ? (void *)inline_entry(table, index) : (table->slots)[index].key;
+}
+
+/*!
+ * @brief Returns the value stored in a full slot of an open addressing table.
+ * @param table Pointer to a hash table in an open addressing mode
+ * @param index Slot of the element
+ * @return The stored value, or a pointer to its bytes in HASH_INLINE mode
+ */
+static void *open_value(hash_table *table, int index)
+{
+    return (table->mode == HASH_INLINE) ? (void *)(inline_entry(table, index) + table->key_length)
+                                        : (table->slots)[index].value;
+}
+
+/*!
+ * @brief Adds an element with a known hash in any mode, adding the key to the table's
+ *        filter when a new element is stored.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @param hash Hash of the key from mode_hash()
+ * @return True if the element was stored, which only fails in HASH_CUCKOO mode
+ */
+static bool store(hash_table *table, void *hash_key, void *hash_value, uint64_t hash)
+{
+    // Chaining stores every put as an element of its own
+    bool added = true;
+    bool stored = true;
+
+    if (table->mode == HASH_SWISS)
+    {
+        added = swiss_put(table, hash_key, hash_value, hash);
+    }
+    else if (table->mode == HASH_ROBIN_HOOD)
+    {
+        added = robin_hood_put(table, hash_key, hash_value, hash);
+    }
+    else if (table->mode == HASH_CUCKOO)
+    {
+        stored = cuckoo_put(table, hash_key, hash_value, hash, &added);
+    }
+    else if (table->mode == HASH_MULTIMAP)
+    {
+        added = multimap_append(table, hash_key, hash_value, hash);
+    }
+    else if (table->mode == HASH_INLINE)
+    {
+        added = inline_put(table, hash_key, hash_value, hash);
+    }
+    else
+    {
+        chain_put(table, hash_key, hash_value, hash);
+    }
+
+    if (added && table->filter != NULL)
+    {
+        ((table->filter_ops)->add)(table->filter, hash);
+    }
+
+    return stored;
+}
+
+/*!
+ * @brief Returns the value a lookup resolves to from the value stored for a key.
+ * @param table Pointer to a hash table
+ * @param value Pointer to the stored value, or NULL if the key is not present
+ * @return The stored value, the first of a multimap key's values, or NULL
+ */
+static void *first_value(hash_table *table, void **value)
+{
+    // An inline value is its bytes, which the pointer already addresses
+    if (value == NULL || table->mode == HASH_INLINE)
+    {
+        return (void *)value;
+    }
+
+    // A multimap key is removed with its last value, so its array is never empty
+    if (table->mode == HASH_MULTIMAP)
+    {
+        return (((hash_value_array *)*value)->values)[0];
+    }
+
+    return *value;
+}
+
+/*!
+ * @brief Finds the value stored for a key in any mode, recording the lookup when
+ *        statistics are enabled.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @param hash Hash of the key, from open_hash() in open addressing modes
+ * @return Pointer to the stored value, or NULL if the key is not present
+ */
+static void **find_value(hash_table *table, void *hash_key, uint64_t hash)
+{
+    long comparisons = STATS_COMPARISONS(table);
+    void **value = NULL;
+
+    // A key the filter has never seen is absent without touching the table
+    if (table->filter != NULL && !((table->filter_ops)->contains)(table->filter, hash))
+    {
+        STATS_COUNT(table, filtered_lookups);
+        STATS_LOOKUP(table, comparisons, false);
+
+        return NULL;
+    }
+
+    if (table->mode == HASH_SWISS || table->mode == HASH_ROBIN_HOOD)
+    {
+        int slot = (table->mode == HASH_SWISS) ? swiss_find(table, hash_key, hash)
+                                               : robin_hood_find(table, hash_key, hash);
+
+        value = (slot >= 0) ? &(((table->slots)[slot]).value) : NULL;
+    }
+    else if (table->mode == HASH_CUCKOO)
+    {
+        hash_slot *slot = cuckoo_find(table, hash_key, hash);
+
+        value = (slot != NULL) ? &(slot->value) : NULL;
+    }
+    else if (table->mode == HASH_INLINE)
+    {
+        int slot = inline_find(table, hash_key, hash);
+
+        value = (slot >= 0) ? (void **)open_value(table, slot) : NULL;
+    }
+    else
+    {
+        hash_node *node = chain_find(table, hash_key, hash);
+
+        value = (node != NULL) ? &(node->value) : NULL;
+    }
+
+    STATS_LOOKUP(table, comparisons, value != NULL);
+
+    return value;
+}
+
+/*!
+ * @brief Finds the slot holding a key in a HASH_SWISS or HASH_INLINE table, adding the
+ *        key in the same probe when it is not present. The first free slot the probe
+ *        passes is where swiss_find_free() would place the key, so the table is laid out
+ *        as put would leave it. A new key's value is left for the caller to set.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for, or a pointer to its bytes in HASH_INLINE mode
+ * @param hash Hash of the key from open_hash()
+ * @param added Set to true if the key was added
+ * @return Index of the slot holding the key
+ */
+static int open_find_or_add(hash_table *table, void *hash_key, uint64_t hash, bool *added)
+{
+    int mask = table->table_size - 1;
+    int position = (int)(hash >> 7) & mask;
+    unsigned char tag = (unsigned char)(hash & 0x7F);
+    int index = -1;
+
+    for (int stride = 0; stride <= table->table_size; stride += HASH_GROUP_WIDTH)
+    {
+        const unsigned char *group = table->control + position;
+        uint32_t matches = group_match(group, tag);
+
+        while (matches != 0)
+        {
+            int match = (position + __builtin_ctz(matches)) & mask;
+
+            if ((table->mode == HASH_INLINE) ? inline_keys_equal(table, inline_entry(table, match), hash_key)
+                                             : keys_equal(table, (table->slots)[match].key, hash_key))
+            {
+                *added = false;
+                return match;
+            }
+
+            matches &= matches - 1;
+        }
+
+        // The first empty or deleted slot is kept in case the key is not found
+        if (index < 0 && group_match_free(group) != 0)
+        {
+            index = (position + __builtin_ctz(group_match_free(group))) & mask;
+        }
+
+        if (group_match(group, CONTROL_EMPTY) != 0)
+        {
+            break;
+        }
+
+        position = (position + stride + HASH_GROUP_WIDTH) & mask;
+    }
+
+    int capacity = group_rebuild_capacity(table->table_size, table->num_elements, table->num_deleted,
+                                          table->load_factor);
+
+    // A rebuild moves every element, so the free slot is found again
+    if (capacity != 0)
+    {
+        swiss_rehash(table, capacity);
+        index = swiss_find_free(table, hash);
+    }
+
+    if ((table->control)[index] == CONTROL_DELETED)
+    {
+        table->num_deleted--;
+    }
+
+    set_control(table, index, tag);
+
+    if (table->mode == HASH_INLINE)
+    {
+        memcpy(inline_entry(table, index), hash_key, table->key_length);
+    }
+    else
+    {
+        (table->slots)[index].key = hash_key;
+    }
+
+    table->num_elements++;
+    *added = true;
+
+    return index;
+}
+
+/*!
+ * @brief Combines a group's value with the value of one of its rows.
+ * @param op Operation to apply
+ * @param value Current value of the group
+ * @param delta Value of the row
+ * @return The group's new value
+ */
+static int64_t aggregate_apply(hash_aggregate_op op, int64_t value, int64_t delta)
+{
+    switch (op)
+    {
+    case HASH_AGGREGATE_MIN:
+        return (delta < value) ? delta : value;
+    case HASH_AGGREGATE_MAX:
+        return (delta > value) ? delta : value;
+    case HASH_AGGREGATE_COUNT:
+        return value + 1;
+    default:
+        return value + delta;
+    }
+}
+
+/*!
+ * @brief Applies a row to the value of its group, adding the group if it is not present.
+ *        Values are read and written by their bytes, as an inline value need not be aligned.
+ * @param table Pointer to a hash table
+ * @param hash_key Key of the row's group
+ * @param delta Value of the row
+ * @param op Operation combining the row with its group's value
+ * @param hash Hash of the key from mode_hash()
+ * @return None
+ */
+static void aggregate_row(hash_table *table, void *hash_key, int64_t delta, hash_aggregate_op op, uint64_t hash)
+{
+    int64_t first = (op == HASH_AGGREGATE_COUNT) ? 1 : delta;
+    void *value;
+    int64_t current;
+
+    if (table->mode == HASH_CUCKOO)
+    {
+        void **stored = find_value(table, hash_key, hash);
+
+        // Placing a key may move other elements, so a new group is added with its value set
+        if (stored == NULL)
+        {
+            store(table, hash_key, (void *)(intptr_t)first, hash);
+            return;
+        }
+
+        value = (void *)stored;
+    }
+    else
+    {
+        bool added;
+
+        // Every other mode finds or adds the group in one probe
+        if (table->mode == HASH_SWISS || table->mode == HASH_INLINE)
+        {
+            int index = open_find_or_add(table, hash_key, hash, &added);
+
+            value = (table->mode == HASH_INLINE) ? open_value(table, index) : (void *)&((table->slots)[index].value);
+        }
+        else if (table->mode == HASH_ROBIN_HOOD)
+        {
+            int index = robin_hood_find_or_add(table, hash_key, hash, &added);
+
+            value = (void *)&((table->slots)[index].value);
+        }
+        else
+        {
+            hash_node *node = chain_find_or_add(table, hash_key, hash, &added);
+
+            // A new multimap group holds its value as the first of its array
+            if (added && table->mode == HASH_MULTIMAP)
+            {
+                hash_value_array *values = (hash_value_array *)malloc(sizeof(hash_value_array) +
+                                                                      MIN_VALUE_ARRAY_CAPACITY * sizeof(void *));
+
+                values->count = 1;
+                values->capacity = MIN_VALUE_ARRAY_CAPACITY;
+                node->value = values;
+            }
+
+            value = (table->mode == HASH_MULTIMAP) ? (void *)(((hash_value_array *)node->value)->values)
+                                                   : (void *)&(node->value);
+        }
+
+        if (added)
+        {
+            memcpy(value, &first, sizeof(int64_t));
+
+            if (table->filter != NULL)
+            {
+                ((table->filter_ops)->add)(table->filter, hash);
+            }
+
+            // The value is set before a resize can move the node holding it
+            if (is_chained(table))
+            {
+                chain_check_load(table);
+            }
+
+            return;
+        }
+    }
+
+    memcpy(&current, value, sizeof(int64_t));
+    current = aggregate_apply(op, current, delta);
+    memcpy(value, &current, sizeof(int64_t));
+}
+
+/*!
+ * @brief Returns the partition of the table's positions a hash falls in, each partition
+ *        being a contiguous range of positions.
+ * @param table Pointer to a hash table
+ * @param hash Hash of the key from mode_hash()
+ * @param num_partitions Number of partitions the positions are split into
+ * @return Index of the partition
+ */
+static int bulk_partition(hash_table *table, uint64_t hash, int num_partitions)
+{
+    uint64_t position = is_chained(table) ? hash % (uint64_t)table->table_size
+                                          : (hash >> 7) & (uint64_t)(table->table_size - 1);
+
+    return (int)(position * (uint64_t)num_partitions / (uint64_t)table->table_size);
+}
+
+/*!
+ * @brief Returns the first position of a partition, such that bulk_partition() maps
+ *        exactly the positions from here to the next partition's first to it.
+ * @param table Pointer to a hash table
+ * @param partition Index of the partition, or the number of partitions for the end
+ * @param num_partitions Number of partitions the positions are split into
+ * @return First position of the partition
+ */
+static int bulk_partition_start(hash_table *table, int partition, int num_partitions)
+{
+    return (int)(((uint64_t)partition * (uint64_t)table->table_size + num_partitions - 1) / num_partitions);
+}
+
+/*!
+ * @brief Adds or updates an element in an open addressing table, probing only groups
+ *        which lie within a range of positions. The probe sequence is the one swiss_find()
+ *        follows, and no slot of the table is deleted, so the element is found by later
+ *        lookups wherever it is placed.
+ * @param table Pointer to a worker's copy of a HASH_SWISS or HASH_INLINE table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @param hash Hash of the key from open_hash()
+ * @param low First position the worker owns
+ * @param high Position after the last the worker owns
+ * @return 1 if the key was added, 0 if an existing key's value was replaced, and -1 if
+ *         the probe left the range before finding the key or an empty slot
+ */
+static int bulk_open_insert(hash_table *table, void *hash_key, void *hash_value, uint64_t hash, int low, int high)
+{
+    int mask = table->table_size - 1;
+    int position = (int)(hash >> 7) & mask;
+    unsigned char tag = (unsigned char)(hash & 0x7F);
+
+    for (int stride = 0; stride <= table->table_size; stride += HASH_GROUP_WIDTH)
+    {
+        // A group reaching outside the range may be written by another worker
+        if (position < low || position + HASH_GROUP_WIDTH > high)
+        {
+            return -1;
+        }
+
+        const unsigned char *group = table->control + position;
+        uint32_t matches = group_match(group, tag);
+
+        while (matches != 0)
+        {
+            int index = position + __builtin_ctz(matches);
+
+            if (table->mode == HASH_INLINE && inline_keys_equal(table, inline_entry(table, index), hash_key))
+            {
+                inline_set_value(table, index, hash_value);
+                return 0;
+            }
+
+            if (table->mode != HASH_INLINE && keys_equal(table, (table->slots)[index].key, hash_key))
+            {
+                (table->slots)[index].value = hash_value;
+                return 0;
+            }
+
+            matches &= matches - 1;
+        }
+
+        uint32_t empty = group_match(group, CONTROL_EMPTY);
+
+        // The first empty slot ends the probe, and is where put would place the key
+        if (empty != 0)
+        {
+            int index = position + __builtin_ctz(empty);
+
+            set_control(table, index, tag);
+
+            if (table->mode == HASH_INLINE)
+            {
+                memcpy(inline_entry(table, index), hash_key, table->key_length);
+                inline_set_value(table, index, hash_value);
+            }
+            else
+            {
+                (table->slots)[index].key = hash_key;
+                (table->slots)[index].value = hash_value;
+            }
+
+            return 1;
+        }
+
+        position = (position + stride + HASH_GROUP_WIDTH) & mask;
+    }
+
+    return -1;
+}
+
+/*!
+ * @brief Runs one worker's share of a step of a bulk load or parallel resize.
+ * @param arg Pointer to the worker's hash_worker
+ * @return NULL
+ */
+static void *bulk_worker(void *arg)
+{
+    hash_worker *worker = (hash_worker *)arg;
+    hash_table *table = &(worker->local);
+
+    for (int i = worker->start; i < worker->end; i++)
+    {
+        if (worker->phase == BULK_MIGRATE)
+        {
+            chain_migrate_position(table, &((worker->old_array)[i]));
+            continue;
+        }
+
+        // Indices are scattered by partition before elements are inserted or aggregated
+        int element = (worker->phase == BULK_INSERT || worker->phase == BULK_AGGREGATE) ? (worker->order)[i] : i;
+        void *hash_key = (worker->keys)[element];
+        uint64_t hash = mode_hash(table, hash_key);
+
+        if (worker->phase == BULK_COUNT)
+        {
+            (worker->counts)[bulk_partition(table, hash, worker->num_partitions)]++;
+        }
+        else if (worker->phase == BULK_SCATTER)
+        {
+            (worker->order)[(worker->counts)[bulk_partition(table, hash, worker->num_partitions)]++] = element;
+        }
+        else if (worker->phase == BULK_AGGREGATE)
+        {
+            aggregate_row(table, hash_key, (worker->deltas != NULL) ? (worker->deltas)[element] : 1, worker->op, hash);
+        }
+        else
+        {
+            void *hash_value = (worker->values)[element];
+            int added = 1;
+
+            if (table->mode == HASH_CHAINING)
+            {
+                chain_insert(table, hash_key, hash_value, hash);
+            }
+            else if (table->mode == HASH_MULTIMAP)
+            {
+                added = multimap_append(table, hash_key, hash_value, hash);
+            }
+            else
+            {
+                added = bulk_open_insert(table, hash_key, hash_value, hash, worker->low, worker->high);
+
+                // Elements left over are kept at the front of the worker's range of the order
+                if (added < 0)
+                {
+                    (worker->order)[worker->start + worker->num_deferred++] = element;
+                    continue;
+                }
+
+                table->num_elements += added;
+            }
+
+            if (added > 0 && worker->added != NULL)
+            {
+                (worker->added)[element] = 1;
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Runs a step on every worker, in parallel when built with HASH_TABLE_THREADS
+ *        defined. The calling thread runs the first worker itself.
+ * @param workers Array of workers, each with its phase and range set
+ * @param count Number of workers
+ * @return None
+ */
+static void bulk_run(hash_worker *workers, int count)
+{
+#ifdef HASH_TABLE_THREADS
+    pthread_t threads[MAX_BULK_THREADS];
+    bool started[MAX_BULK_THREADS];
+
+    for (int i = 1; i < count; i++)
+    {
+        started[i] = pthread_create(&(threads[i]), NULL, &bulk_worker, &(workers[i])) == 0;
+
+        // A worker which could not be started runs in the calling thread instead
+        if (!started[i])
+        {
+            bulk_worker(&(workers[i]));
+        }
+    }
+
+    bulk_worker(&(workers[0]));
+
+    for (int i = 1; i < count; i++)
+    {
+        if (started[i])
+        {
+            pthread_join(threads[i], NULL);
+        }
+    }
+#else
+    for (int i = 0; i < count; i++)
+    {
+        bulk_worker(&(workers[i]));
+    }
+#endif
+}
+
+/*!
+ * @brief Prepares a worker's private copy of a table, which shares the table's arrays
+ *        but allocates and releases chained nodes on its own and counts only the
+ *        positions or elements it adds.
+ * @param worker Pointer to the worker
+ * @param table Pointer to the table being filled
+ * @return None
+ */
+static void bulk_prepare(hash_worker *worker, hash_table *table)
+{
+    worker->local = *table;
+    worker->local.num_elements = 0;
+    worker->local.slabs = NULL;
+    worker->local.slab_used = 0;
+    worker->local.free_nodes = NULL;
+    worker->local.filter = NULL;
+
+    // The copy never reaches its load factor, so it never resizes the shared arrays
+    worker->local.load_factor = FLT_MAX;
+}
+
+/*!
+ * @brief Hands a worker's chained nodes and element count over to the table.
+ * @param table Pointer to the table being filled
+ * @param local Pointer to the worker's copy of the table
+ * @return None
+ */
+static void bulk_adopt(hash_table *table, hash_table *local)
+{
+    table->num_elements += local->num_elements;
+
+    // The worker's slabs go behind the table's current slab, which new nodes are still
+    // carved from, so only the unused end of the worker's last slab goes to waste
+    if (local->slabs != NULL)
+    {
+        if (table->slabs == NULL)
+        {
+            table->slabs = local->slabs;
+            table->slab_used = local->slab_used;
+        }
+        else
+        {
+            hash_node_slab *last = local->slabs;
+
+            while (last->next != NULL)
+            {
+                last = last->next;
+            }
+
+            last->next = (table->slabs)->next;
+            (table->slabs)->next = local->slabs;
+        }
+    }
+
+    if (local->free_nodes != NULL)
+    {
+        hash_node *last = local->free_nodes;
+
+        while (last->next != NULL)
+        {
+            last = last->next;
+        }
+
+        last->next = table->free_nodes;
+        table->free_nodes = local->free_nodes;
+    }
+}
+
+/*!
+ * @brief Groups the indices of a bulk load's elements by the partition of positions each
+ *        key falls in, hashing slices of the input on separate workers.
+ * @param table Pointer to the table being filled
+ * @param workers Array of MAX_BULK_THREADS workers
+ * @param keys Array of keys to add
+ * @param n Number of elements
+ * @param num_slices Number of slices the input is split into
+ * @param num_partitions Number of partitions the positions are split into
+ * @param order Array of n indices, filled partition by partition
+ * @param starts Array filled with the first index in the order of each partition, followed by n
+ * @return None
+ */
+static void bulk_order(hash_table *table, hash_worker *workers, void **keys, int n, int num_slices,
+                       int num_partitions, int *order, int *starts)
+{
+    int *counts = (int *)calloc((size_t)num_slices * num_partitions, sizeof(int));
+    int next = 0;
+
+    // Each slice of the input counts how many of its keys fall in each partition
+    for (int w = 0; w < num_slices; w++)
+    {
+        bulk_prepare(&(workers[w]), table);
+        workers[w].phase = BULK_COUNT;
+        workers[w].keys = keys;
+        workers[w].start = (int)((int64_t)n * w / num_slices);
+        workers[w].end = (int)((int64_t)n * (w + 1) / num_slices);
+        workers[w].num_partitions = num_partitions;
+        workers[w].counts = counts + (size_t)w * num_partitions;
+        workers[w].order = order;
+    }
+
+    bulk_run(workers, num_slices);
+
+    // Partitions are laid out one after another, and within a partition the slices are in
+    // input order, so elements reach each position in the order put would have added them
+    for (int p = 0; p < num_partitions; p++)
+    {
+        starts[p] = next;
+
+        for (int w = 0; w < num_slices; w++)
+        {
+            int count = counts[(size_t)w * num_partitions + p];
+
+            counts[(size_t)w * num_partitions + p] = next;
+            next += count;
+        }
+    }
+
+    starts[num_partitions] = n;
+
+    for (int w = 0; w < num_slices; w++)
+    {
+        workers[w].phase = BULK_SCATTER;
+    }
+
+    bulk_run(workers, num_slices);
+
+    free(counts);
+}
+
+/*!
+ * @brief Adds elements to a table which already has room for all of them, filling each
+ *        range of positions with its own worker. Chaining tables must not be part way
+ *        through an incremental resize, and open addressing tables must be empty.
+ * @param table Pointer to a hash table in a chaining, HASH_SWISS or HASH_INLINE mode
+ * @param keys Array of keys to add
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @param threads Number of workers to use
+ * @param added Array with a byte for each element set when it is stored as a new key,
+ *              or NULL
+ * @return None
+ */
+static void bulk_store(hash_table *table, void **keys, void **values, int n, int threads, unsigned char *added)
+{
+    int num_slices = (n / BULK_MIN_SLICE < threads) ? n / BULK_MIN_SLICE : threads;
+    int num_partitions = (table->table_size / BULK_MIN_PARTITION < threads) ? table->table_size / BULK_MIN_PARTITION
+                                                                           : threads;
+
+    num_slices = (num_slices < 1) ? 1 : (num_slices > MAX_BULK_THREADS) ? MAX_BULK_THREADS : num_slices;
+    num_partitions = (num_partitions < 1) ? 1 : (num_partitions > MAX_BULK_THREADS) ? MAX_BULK_THREADS : num_partitions;
+
+    hash_worker *workers = (hash_worker *)calloc(MAX_BULK_THREADS, sizeof(hash_worker));
+    int *order = (int *)malloc((size_t)n * sizeof(int));
+    int starts[MAX_BULK_THREADS + 1];
+
+    // A single partition takes the elements in input order
+    if (num_partitions == 1)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            order[i] = i;
+        }
+
+        starts[0] = 0;
+        starts[1] = n;
+    }
+    else
+    {
+        bulk_order(table, workers, keys, n, num_slices, num_partitions, order, starts);
+    }
+
+    for (int p = 0; p < num_partitions; p++)
+    {
+        bulk_prepare(&(workers[p]), table);
+        workers[p].phase = BULK_INSERT;
+        workers[p].keys = keys;
+        workers[p].values = values;
+        workers[p].order = order;
+        workers[p].start = starts[p];
+        workers[p].end = starts[p + 1];
+        workers[p].low = bulk_partition_start(table, p, num_partitions);
+        workers[p].high = bulk_partition_start(table, p + 1, num_partitions);
+        workers[p].added = added;
+        workers[p].num_deferred = 0;
+    }
+
+    bulk_run(workers, num_partitions);
+
+    for (int p = 0; p < num_partitions; p++)
+    {
+        bulk_adopt(table, &(workers[p].local));
+    }
+
+    // Elements whose probe crossed into another worker's range are placed last, in order
+    for (int p = 0; p < num_partitions; p++)
+    {
+        for (int i = 0; i < workers[p].num_deferred; i++)
+        {
+            int element = order[starts[p] + i];
+
+            if (table->mode == HASH_INLINE)
+            {
+                if (inline_put(table, keys[element], values[element], open_hash(table, keys[element])) && added != NULL)
+                {
+                    added[element] = 1;
+                }
+            }
+            else if (swiss_put(table, keys[element], values[element], open_hash(table, keys[element])) && added != NULL)
+            {
+                added[element] = 1;
+            }
+        }
+    }
+
+    free(workers);
+    free(order);
+}
+
+/*!
+ * @brief Completes a chaining resize by migrating ranges of old positions on separate
+ *        workers. Elements at an old position only move to positions of the new array
+ *        that are equal to it modulo the old size, so workers given separate old ranges
+ *        never touch the same new position.
+ * @param table Pointer to a hash table in a chaining mode, with every old position still
+ *              to be migrated
+ * @return None
+ */
+static void chain_parallel_migrate(hash_table *table)
+{
+    int threads = (table->old_table_size / BULK_MIN_PARTITION < table->resize_threads)
+                      ? table->old_table_size / BULK_MIN_PARTITION
+                      : table->resize_threads;
+    hash_worker *workers;
+
+    threads = (threads < 1) ? 1 : (threads > MAX_BULK_THREADS) ? MAX_BULK_THREADS : threads;
+    workers = (hash_worker *)calloc(threads, sizeof(hash_worker));
+
+    for (int w = 0; w < threads; w++)
+    {
+        bulk_prepare(&(workers[w]), table);
+
+        // Copies resolve every hash to the new array
+        workers[w].local.old_array = NULL;
+        workers[w].local.old_table_size = 0;
+        workers[w].phase = BULK_MIGRATE;
+        workers[w].old_array = table->old_array;
+        workers[w].start = (int)((int64_t)table->old_table_size * w / threads);
+        workers[w].end = (int)((int64_t)table->old_table_size * (w + 1) / threads);
+    }
+
+    bulk_run(workers, threads);
+
+    for (int w = 0; w < threads; w++)
+    {
+        bulk_adopt(table, &(workers[w].local));
+    }
+
+    free(workers);
+    free(table->old_array);
+
+    table->old_array = NULL;
+    table->old_table_size = 0;
+    table->rehash_index = 0;
+}
+
+/*!
+ * @brief Rebuilds a HASH_SWISS or HASH_INLINE table into a new capacity with workers,
+ *        adding the elements of the old arrays as hash_table_bulk_load() does.
+ * @param table Pointer to a hash table
+ * @param capacity New number of slots, a power of two
+ * @return None
+ */
+static void open_parallel_rehash(hash_table *table, int capacity)
+{
+    unsigned char *old_control = table->control;
+    hash_slot *old_slots = table->slots;
+    unsigned char *old_entries = table->entries;
+    int old_size = table->table_size;
+    int n = table->num_elements;
+    void **keys = (void **)malloc(((size_t)n + 1) * sizeof(void *));
+    void **values = (void **)malloc(((size_t)n + 1) * sizeof(void *));
+    int count = 0;
+
+    // Inline keys and values are gathered as pointers into the old entries
+    for (int i = 0; i < old_size; i++)
+    {
+        if ((old_control[i] & 0x80) == 0)
+        {
+            keys[count] = (table->mode == HASH_INLINE) ? (void *)(old_entries + (size_t)i * table->entry_size) : old_slots[i].key;
+            values[count] = (table->mode == HASH_INLINE) ? (void *)(old_entries + (size_t)i * table->entry_size + table->key_length)
+                                                         : old_slots[i].value;
+            count++;
+        }
+    }
+
+    swiss_allocate(table, capacity);
+    bulk_store(table, keys, values, count, table->resize_threads, NULL);
+
+    free(old_control);
+    free(old_slots);
+    free(old_entries);
+    free(keys);
+    free(values);
+}
+
+/*!
+ * @brief Initializes an empty private table for a worker of a partitioned aggregation,
+ *        with the same mode and key handling as the table being aggregated into.
+ * @param local Pointer to the worker's table
+ * @param table Pointer to the table being aggregated into
+ * @return None
+ */
+static void aggregate_prepare(hash_table *local, hash_table *table)
+{
+    if (table->mode == HASH_INLINE)
+    {
+        initialize_hash_table_inline(local, HASH_GROUP_WIDTH, table->load_factor, table->key_length, table->value_size);
+        return;
+    }
+
+    initialize_hash_table_keys(local, HASH_GROUP_WIDTH, table->load_factor, table->mode, table->key_length,
+                               table->key_hash, table->key_equal);
+}
+
+/*!
+ * @brief Combines a group from a worker's private table into the target table.
+ * @param key Key of the group, or a pointer to its bytes in HASH_INLINE mode
+ * @param value Partial value of the group, or a pointer to its bytes in HASH_INLINE mode
+ * @param context Pointer to the hash_aggregate_target
+ * @return None
+ */
+static void aggregate_merge(void *key, void *value, void *context)
+{
+    hash_aggregate_target *target = (hash_aggregate_target *)context;
+    int64_t partial = (intptr_t)value;
+
+    if ((target->table)->mode == HASH_INLINE)
+    {
+        memcpy(&partial, value, sizeof(int64_t));
+    }
+
+    aggregate_row(target->table, key, partial, target->op, mode_hash(target->table, key));
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Defines the division method for creating an index from a key. Uses
+ *        the remainder of the key's hash divided by the table size to determine the index.
+ * @param hash_key Key to create an index from
+ * @return An integer specifying the index into the hash table
+ */
+int division(hash_table *table, void *hash_key)
+{
+    return chain_index(table, (table->key_hash)(hash_key, table->key_length));
+}
+
+/*!
+ * @brief Hashes a key stored directly in the key pointer to its own value.
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return The key as an unsigned 64 bit integer
+ */
+uint64_t hash_pointer(const void *key, size_t key_length)
+{
+    (void)key_length;
+
+    return (uint64_t)(uintptr_t)key;
+}
+
+/*!
+ * @brief Hashes a key stored directly in the key pointer using a Fibonacci
+ *        (golden ratio) multiplier, spreading sequential integers across the table.
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return A 64 bit hash of the key
+ */
+uint64_t hash_fibonacci(const void *key, size_t key_length)
+{
+    (void)key_length;
+
+    uint64_t hash = (uint64_t)(uintptr_t)key * 0x9e3779b97f4a7c15ULL;
+
+    // The high bits of the product are the well mixed ones, so they are folded
+    // into the low bits used by the remainder
+    return hash ^ (hash >> 32);
+}
+
+/*!
+ * @brief Finalizes a 64 bit hash so that every output bit depends on every input bit.
+ * @param hash Hash to mix
+ * @return The mixed hash
+ */
+uint64_t hash_mix(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    return hash;
+}
+
+/*!
+ * @brief Multiplies two 64 bit integers and folds the 128 bit product into 64 bits.
+ * @param a First operand
+ * @param b Second operand
+ * @return The low half of the product exclusive or'd with the high half
+ */
+static uint64_t multiply_fold(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)a * b;
+
+    return (uint64_t)product ^ (uint64_t)(product >> 64);
+#else
+    uint64_t a_high = a >> 32, a_low = (uint32_t)a;
+    uint64_t b_high = b >> 32, b_low = (uint32_t)b;
+    uint64_t cross_1 = a_high * b_low, cross_2 = a_low * b_high;
+    uint64_t low = a_low * b_low;
+    uint64_t middle = (low >> 32) + (uint32_t)cross_1 + (uint32_t)cross_2;
+    uint64_t high = a_high * b_high + (cross_1 >> 32) + (cross_2 >> 32) + (middle >> 32);
+
+    return ((middle << 32) | (uint32_t)low) ^ high;
+#endif
+}
+
+/*!
+ * @brief Reads 8 bytes of a key without requiring alignment.
+ * @param bytes Pointer to the bytes to read
+ * @return The bytes as an unsigned 64 bit integer
+ */
+static uint64_t read_64(const unsigned char *bytes)
+{
+    uint64_t word;
+
+    memcpy(&word, bytes, sizeof(word));
+
+    return word;
+}
+
+/*!
+ * @brief Reads 4 bytes of a key without requiring alignment.
+ * @param bytes Pointer to the bytes to read
+ * @return The bytes as an unsigned 64 bit integer
+ */
+static uint64_t read_32(const unsigned char *bytes)
+{
+    uint32_t word;
+
+    memcpy(&word, bytes, sizeof(word));
+
+    return word;
+}
+
+/*!
+ * @brief Hashes the bytes a key points to using a wyhash style multiply-mix.
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key, or HASH_KEY_STRING for a NUL terminated string
+ * @return A 64 bit hash of the key
+ */
+uint64_t hash_bytes(const void *key, size_t key_length)
+{
+    // Mixing constants taken from wyhash
+    const uint64_t secret_0 = 0xa0761d6478bd642fULL;
+    const uint64_t secret_1 = 0xe7037ed1a0b428dbULL;
+    const uint64_t secret_2 = 0x8ebc6af09c88c6e3ULL;
+    const uint64_t secret_3 = 0x589965cc75374cc3ULL;
+
+    const unsigned char *bytes = (const unsigned char *)key;
+    size_t length = (key_length == HASH_KEY_STRING) ? strlen((const char *)key) : key_length;
+    uint64_t seed = multiply_fold(secret_0, secret_1);
+    uint64_t a = 0;
+    uint64_t b = 0;
+
+    if (length <= 16)
+    {
+        // Short keys are read as up to four overlapping words
+        if (length >= 4)
+        {
+            size_t offset = (length >> 3) << 2;
+
+            a = (read_32(bytes) << 32) | read_32(bytes + offset);
+            b = (read_32(bytes + length - 4) << 32) | read_32(bytes + length - 4 - offset);
+        }
+        else if (length > 0)
+        {
+            a = ((uint64_t)bytes[0] << 16) | ((uint64_t)bytes[length >> 1] << 8) | bytes[length - 1];
+        }
+    }
+    else
+    {
+        size_t remaining = length;
+
+        // Long keys are consumed 48 bytes at a time in three independent lanes
+        if (remaining > 48)
+        {
+            uint64_t seed_1 = seed;
+            uint64_t seed_2 = seed;
+
+            do
+            {
+                seed = multiply_fold(read_64(bytes) ^ secret_1, read_64(bytes + 8) ^ seed);
+                seed_1 = multiply_fold(read_64(bytes + 16) ^ secret_2, read_64(bytes + 24) ^ seed_1);
+                seed_2 = multiply_fold(read_64(bytes + 32) ^ secret_3, read_64(bytes + 40) ^ seed_2);
+                bytes += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+
+            seed ^= seed_1 ^ seed_2;
+        }
+
+        while (remaining > 16)
+        {
+            seed = multiply_fold(read_64(bytes) ^ secret_1, read_64(bytes + 8) ^ seed);
+            bytes += 16;
+            remaining -= 16;
+        }
+
+        // The final 16 bytes may overlap bytes which were already consumed
+        a = read_64(bytes + remaining - 16);
+        b = read_64(bytes + remaining - 8);
+    }
+
+    a ^= secret_1;
+    b ^= seed;
+
+    return multiply_fold(multiply_fold(a, b) ^ secret_0 ^ length, b ^ secret_1);
+}
+
+/*!
+ * @brief Compares two keys stored directly in the key pointer.
+ * @param key_a First key
+ * @param key_b Second key
+ * @param key_length Unused
+ * @return True if the keys are equal
+ */
+bool equal_pointer(const void *key_a, const void *key_b, size_t key_length)
+{
+    (void)key_length;
+
+    return key_a == key_b;
+}
+
+/*!
+ * @brief Compares the bytes two keys point to.
+ * @param key_a First key
+ * @param key_b Second key
+ * @param key_length Number of bytes in the key, or HASH_KEY_STRING for NUL terminated strings
+ * @return True if the keys are equal
+ */
+bool equal_bytes(const void *key_a, const void *key_b, size_t key_length)
+{
+    if (key_length == HASH_KEY_STRING)
+    {
+        return strcmp((const char *)key_a, (const char *)key_b) == 0;
+    }
+
+    return memcmp(key_a, key_b, key_length) == 0;
+}
+
+/*!
+ * @brief Adds an element to the hash table. In HASH_CHAINING mode every put is stored
+ *        as an element of its own, so get finds the first value put for a key and each
+ *        remove_hash removes one element. The open addressing modes replace the value of
+ *        a key already present. In HASH_MULTIMAP mode the value is appended to those
+ *        already stored for the key. In HASH_INLINE mode the key and value point to the
+ *        bytes to copy into the table, and a NULL value stores zero bytes.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to create an index from
+ * @param hash_value Value to place into the hash table
+ * @return True if the element was stored. Only a HASH_CUCKOO table can refuse a key,
+ *         once both of its buckets and the stash hold keys with the same hash
+ */
+bool put(hash_table *table, void *hash_key, void *hash_value)
+{
+    // Each operation moves a bounded number of positions while a resize is in progress
+    if (is_chained(table))
+    {
+        chain_migrate(table, table->rehash_step);
+    }
+
+    return store(table, hash_key, hash_value, mode_hash(table, hash_key));
+}
+
+/*!
+ * @brief Finds the value stored for a key, migrating positions first while an
+ *        incremental resize is in progress.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to search for
+ * @return Pointer to the stored value, or NULL if the key is not present
+ */
+static void **lookup(hash_table *table, void *hash_key)
+{
+    if (is_chained(table))
+    {
+        chain_migrate(table, table->rehash_step);
+
+        return find_value(table, hash_key, (table->key_hash)(hash_key, table->key_length));
+    }
+
+    return find_value(table, hash_key, open_hash(table, hash_key));
+}
+
+/*!
+ * @brief Returns the element associated with a key
+ * @param table Pointer to a hash table
+ * @param hash_key Key associated with the element
+ * @return The value associated with the specified key. In HASH_MULTIMAP mode the first
+ *         value stored for the key. In HASH_INLINE mode a pointer to the value's bytes
+ *         within the table, valid until the next put or remove_hash
+ */
+void *get(hash_table *table, void *hash_key)
+{
+    return first_value(table, lookup(table, hash_key));
+}
+
+/*!
+ * @brief Removes a key value pair from the hash table. In HASH_MULTIMAP mode every value
+ *        stored for the key is removed.
+ * @param table Pointer to a hash table
+ * @param hash_key Key associated with the element
+ * @return None
+ */
+void remove_hash(hash_table *table, void *hash_key)
+{
+    bool removed;
+
+    if (table->mode == HASH_SWISS)
+    {
+        removed = swiss_remove(table, hash_key);
+    }
+    else if (table->mode == HASH_ROBIN_HOOD)
+    {
+        removed = robin_hood_remove(table, hash_key);
+    }
+    else if (table->mode == HASH_CUCKOO)
+    {
+        removed = cuckoo_remove(table, hash_key);
+    }
+    else if (table->mode == HASH_INLINE)
+    {
+        removed = inline_remove(table, hash_key);
+    }
+    else
+    {
+        chain_migrate(table, table->rehash_step);
+
+        removed = chain_remove(table, hash_key, (table->key_hash)(hash_key, table->key_length));
+    }
+
+    // A filter which cannot delete keeps the key, which only costs a false positive
+    if (removed && table->filter != NULL && (table->filter_ops)->remove != NULL)
+    {
+        ((table->filter_ops)->remove)(table->filter, mode_hash(table, hash_key));
+    }
+}
+
+/*!
+ * @brief Adds a value to those stored for a key in a HASH_MULTIMAP table, keeping any
+ *        values already stored. The key's array of values doubles in size when full.
+ *        In other modes the same as put.
+ * @param table Pointer to a hash table in HASH_MULTIMAP mode
+ * @param hash_key Key to add the value for
+ * @param hash_value Value to add
+ * @return None
+ */
+void append(hash_table *table, void *hash_key, void *hash_value)
+{
+    put(table, hash_key, hash_value);
+}
+
+/*!
+ * @brief Returns every value stored for a key in a HASH_MULTIMAP table, in the order they
+ *        were added. The values are contiguous and remain valid until the key is next
+ *        modified by put, append, remove_value or remove_hash. In other modes the single
+ *        value stored for the key is returned with a count of 1, which in HASH_INLINE
+ *        mode points to the value's bytes.
+ * @param table Pointer to a hash table in HASH_MULTIMAP mode
+ * @param hash_key Key associated with the values
+ * @param count Receives the number of values, 0 if the key is not present
+ * @return Pointer to the first value, or NULL if the key is not present
+ */
+void **get_all(hash_table *table, void *hash_key, int *count)
+{
+    void **value = lookup(table, hash_key);
+
+    if (value == NULL)
+    {
+        *count = 0;
+        return NULL;
+    }
+
+    if (table->mode == HASH_MULTIMAP)
+    {
+        hash_value_array *values = (hash_value_array *)*value;
+
+        *count = values->count;
+        return values->values;
+    }
+
+    *count = 1;
+    return value;
+}
+
+/*!
+ * @brief Removes the first occurrence of a value stored for a key in a HASH_MULTIMAP
+ *        table, keeping the remaining values in order. The key is removed along with
+ *        its last value. In other modes the key is removed if it holds the value.
+ * @param table Pointer to a hash table in HASH_MULTIMAP mode
+ * @param hash_key Key associated with the value
+ * @param hash_value Value to remove, compared by pointer, or by its bytes in HASH_INLINE mode
+ * @return True if the value was found and removed
+ */
+bool remove_value(hash_table *table, void *hash_key, void *hash_value)
+{
+    void **value = lookup(table, hash_key);
+
+    if (value == NULL)
+    {
+        return false;
+    }
+
+    if (table->mode == HASH_INLINE)
+    {
+        if (table->value_size > 0 && (hash_value == NULL || memcmp(value, hash_value, table->value_size) != 0))
+        {
+            return false;
+        }
+
+        remove_hash(table, hash_key);
+        return true;
+    }
+
+    if (table->mode != HASH_MULTIMAP)
+    {
+        if (*value != hash_value)
+        {
+            return false;
+        }
+
+        remove_hash(table, hash_key);
+        return true;
+    }
+
+    hash_value_array *values = (hash_value_array *)*value;
+
+    for (int i = 0; i < values->count; i++)
+    {
+        if ((values->values)[i] != hash_value)
+        {
+            continue;
+        }
+
+        // The last value takes its key with it
+        if (values->count == 1)
+        {
+            remove_hash(table, hash_key);
+        }
+        else
+        {
+            // Later values are shifted down so they stay in the order they were added
+            memmove(&((values->values)[i]), &((values->values)[i + 1]), (values->count - i - 1) * sizeof(void *));
+            values->count--;
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+ * @brief Computes the hash of a key for the table's mode and prefetches the memory
+ *        its lookup will touch first.
+ * @param table Pointer to a hash table
+ * @param hash_key Key to hash
+ * @return The hash of the key, as used by the table's mode
+ */
+static uint64_t hash_and_prefetch(hash_table *table, void *hash_key)
+{
+    if (table->mode == HASH_SWISS || table->mode == HASH_INLINE)
+    {
+        uint64_t hash = open_hash(table, hash_key);
+        int position = (int)(hash >> 7) & (table->table_size - 1);
+
+        // The first group of control bytes and the slot at the start of the probe
+        __builtin_prefetch(table->control + position);
+
+        if (table->mode == HASH_INLINE)
+        {
+            __builtin_prefetch(inline_entry(table, position));
+        }
+        else
+        {
+            __builtin_prefetch(&((table->slots)[position]));
+        }
+
+        return hash;
+    }
+
+    if (table->mode == HASH_ROBIN_HOOD)
+    {
+        uint64_t hash = open_hash(table, hash_key);
+        int position = robin_hood_home(table, hash);
+
+        __builtin_prefetch(table->control + position);
+        __builtin_prefetch(&((table->slots)[position]));
+
+        return hash;
+    }
+
+    if (table->mode == HASH_CUCKOO)
+    {
+        uint64_t hash = open_hash(table, hash_key);
+        int buckets[2];
+
+        // Both candidate buckets are fetched, one line each
+        cuckoo_buckets(table, hash, buckets);
+        __builtin_prefetch(&((table->slots)[buckets[0] * HASH_BUCKET_SLOTS]));
+        __builtin_prefetch(&((table->slots)[buckets[1] * HASH_BUCKET_SLOTS]));
+
+        return hash;
+    }
+
+    uint64_t hash = (table->key_hash)(hash_key, table->key_length);
+
+    // The first node at a position lives in the array, so one line holds it
+    __builtin_prefetch(chain_head(table, hash));
+
+    return hash;
+}
+
+/*!
+ * @brief Returns the elements associated with a batch of keys. Keys are hashed and their
+ *        table positions prefetched a window at a time before any are resolved, so the
+ *        memory loads for different keys overlap instead of running one after another.
+ * @param table Pointer to a hash table
+ * @param keys Array of keys to look up
+ * @param n Number of keys
+ * @param out_values Array receiving the value for each key, NULL for keys not present
+ * @return None
+ */
+void get_many(hash_table *table, void **keys, int n, void **out_values)
+{
+    uint64_t hashes[HASH_BATCH_WINDOW];
+
+    // Migration is done up front so positions stay put while the batch is resolved
+    if (is_chained(table))
+    {
+        chain_migrate(table, table->rehash_step * n);
+    }
+
+    for (int start = 0; start < n; start += HASH_BATCH_WINDOW)
+    {
+        int count = (n - start < HASH_BATCH_WINDOW) ? n - start : HASH_BATCH_WINDOW;
+
+        for (int i = 0; i < count; i++)
+        {
+            hashes[i] = hash_and_prefetch(table, keys[start + i]);
+        }
+
+        for (int i = 0; i < count; i++)
+        {
+            out_values[start + i] = first_value(table, find_value(table, keys[start + i], hashes[i]));
+        }
+    }
+}
+
+/*!
+ * @brief Adds a batch of elements to the hash table, hashing and prefetching a window
+ *        of keys before inserting them.
+ * @param table Pointer to a hash table
+ * @param keys Array of keys to add
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @return None
+ */
+void put_many(hash_table *table, void **keys, void **values, int n)
+{
+    uint64_t hashes[HASH_BATCH_WINDOW];
+
+    if (is_chained(table))
+    {
+        chain_migrate(table, table->rehash_step * n);
+    }
+
+    for (int start = 0; start < n; start += HASH_BATCH_WINDOW)
+    {
+        int count = (n - start < HASH_BATCH_WINDOW) ? n - start : HASH_BATCH_WINDOW;
+
+        for (int i = 0; i < count; i++)
+        {
+            hashes[i] = hash_and_prefetch(table, keys[start + i]);
+        }
+
+        // Positions are recomputed from the hash on insertion, so a resize part way
+        // through the window only wastes the remaining prefetches
+        for (int i = 0; i < count; i++)
+        {
+            store(table, keys[start + i], values[start + i], hashes[i]);
+        }
+    }
+}
+
+/*!
+ * @brief Aggregates a batch of rows into the groups held by the table, keyed by each
+ *        row's key. Keys are hashed and prefetched a window at a time, and each row finds
+ *        or adds its group in one probe and updates the group's value in place, rather
+ *        than calling get and then put. HASH_CUCKOO tables look a group up before adding
+ *        it, as placing a key may move others. A group's value is a 64 bit integer held in its value pointer and
+ *        read back with get() cast through intptr_t. In HASH_INLINE mode values must be
+ *        8 bytes and hold the integer, and in HASH_MULTIMAP mode it is the key's first
+ *        value. A new group starts from its first row's delta, or 1 when counting.
+ * @param table Pointer to a hash table
+ * @param keys Array of the key of each row
+ * @param deltas Array of the value of each row, or NULL to give every row the value 1
+ * @param n Number of rows
+ * @param op Operation combining each row with its group's value
+ * @return None
+ */
+void aggregate_batch(hash_table *table, void **keys, const int64_t *deltas, int n, hash_aggregate_op op)
+{
+    uint64_t hashes[HASH_BATCH_WINDOW];
+
+    // An inline value too small for the integer cannot hold a group's value
+    if (table->mode == HASH_INLINE && table->value_size != sizeof(int64_t))
+    {
+        return;
+    }
+
+    if (is_chained(table))
+    {
+        chain_migrate(table, table->rehash_step * n);
+    }
+
+    for (int start = 0; start < n; start += HASH_BATCH_WINDOW)
+    {
+        int count = (n - start < HASH_BATCH_WINDOW) ? n - start : HASH_BATCH_WINDOW;
+
+        for (int i = 0; i < count; i++)
+        {
+            hashes[i] = hash_and_prefetch(table, keys[start + i]);
+        }
+
+        // A group added part way through the window may resize the table, which only
+        // wastes the remaining prefetches
+        for (int i = 0; i < count; i++)
+        {
+            aggregate_row(table, keys[start + i], (deltas != NULL) ? deltas[start + i] : 1, op, hashes[i]);
+        }
+    }
+}
+
+/*!
+ * @brief Aggregates a batch of rows as aggregate_batch() does using several workers. Rows
+ *        are split by the partition of table positions their key hashes to, so each
+ *        group belongs to one worker, which aggregates its rows into a private table. The
+ *        groups of each private table are then combined into the table. Workers run in
+ *        parallel when built with HASH_TABLE_THREADS defined and linked with -pthread,
+ *        otherwise one after another. Batches too small to split are aggregated directly.
+ * @param table Pointer to a hash table
+ * @param keys Array of the key of each row
+ * @param deltas Array of the value of each row, or NULL to give every row the value 1
+ * @param n Number of rows
+ * @param op Operation combining each row with its group's value
+ * @param threads Number of workers to use
+ * @return None
+ */
+void aggregate_batch_partitioned(hash_table *table, void **keys, const int64_t *deltas, int n, hash_aggregate_op op,
+                                 int threads)
+{
+    int num_partitions = (n / BULK_MIN_SLICE < threads) ? n / BULK_MIN_SLICE : threads;
+
+    // Each partition needs at least one position of the table
+    num_partitions = (num_partitions > table->table_size) ? table->table_size : num_partitions;
+    num_partitions = (num_partitions > MAX_BULK_THREADS) ? MAX_BULK_THREADS : num_partitions;
+
+    if (num_partitions <= 1 || (table->mode == HASH_INLINE && table->value_size != sizeof(int64_t)))
+    {
+        aggregate_batch(table, keys, deltas, n, op);
+        return;
+    }
+
+    hash_worker *workers = (hash_worker *)calloc(MAX_BULK_THREADS, sizeof(hash_worker));
+    int *order = (int *)malloc((size_t)n * sizeof(int));
+    int starts[MAX_BULK_THREADS + 1];
+    // Partial counts are added together
+    hash_aggregate_target target = {table, (op == HASH_AGGREGATE_COUNT) ? HASH_AGGREGATE_SUM : op};
+
+    bulk_order(table, workers, keys, n, num_partitions, num_partitions, order, starts);
+
+    for (int p = 0; p < num_partitions; p++)
+    {
+        aggregate_prepare(&(workers[p].local), table);
+        workers[p].phase = BULK_AGGREGATE;
+        workers[p].keys = keys;
+        workers[p].deltas = deltas;
+        workers[p].op = op;
+        workers[p].order = order;
+        workers[p].start = starts[p];
+        workers[p].end = starts[p + 1];
+    }
+
+    bulk_run(workers, num_partitions);
+
+    // Partitions hold disjoint groups, so each group is combined into the table once
+    for (int p = 0; p < num_partitions; p++)
+    {
+        hash_table_for_each(&(workers[p].local), &aggregate_merge, &target);
+        free_hash_table(&(workers[p].local));
+    }
+
+    free(workers);
+    free(order);
+}
+
+/*!
+ * @brief Adds a large batch of elements using several workers. The table is first grown
+ *        to hold every element, then the keys are split by the range of table positions
+ *        they hash to, and each range is filled by its own worker, so workers never touch
+ *        the same position. The result is the same as calling put for each element in
+ *        order. Workers run in parallel when built with HASH_TABLE_THREADS defined and
+ *        linked with -pthread, otherwise one after another. HASH_SWISS and HASH_INLINE
+ *        tables which already hold elements are rebuilt with them, and HASH_ROBIN_HOOD
+ *        and HASH_CUCKOO tables are filled with put_many.
+ * @param table Pointer to a hash table
+ * @param keys Array of keys to add
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @param threads Number of workers to use
+ * @return None
+ */
+void hash_table_bulk_load(hash_table *table, void **keys, void **values, int n, int threads)
+{
+    if (n <= 0)
+    {
+        return;
+    }
+
+    // Displacing elements would let workers write outside their ranges
+    if (table->mode == HASH_ROBIN_HOOD || table->mode == HASH_CUCKOO)
+    {
+        put_many(table, keys, values, n);
+        return;
+    }
+
+    unsigned char *old_control = NULL;
+    hash_slot *old_slots = NULL;
+    unsigned char *old_entries = NULL;
+    void **all_keys = keys;
+    void **all_values = values;
+    int existing = 0;
+
+    if (is_chained(table))
+    {
+        chain_migrate(table, table->old_table_size);
+
+        // Every element is assumed to occupy a new position, as put would resize for it
+        while ((float)(table->num_elements + n) * 100 / table->table_size >= (float)(table->load_factor * 100))
+        {
+            if (table->num_elements == 0)
+            {
+                // An empty table is reallocated rather than migrated
+                free(table->array);
+
+                table->table_size *= 2;
+                table->array = chain_allocate(table->table_size);
+            }
+            else
+            {
+                resize(table);
+                chain_migrate(table, table->old_table_size);
+            }
+        }
+    }
+    else
+    {
+        int capacity = table->table_size;
+
+        while ((int)(capacity * table->load_factor) < table->num_elements + n + 1)
+        {
+            capacity *= 2;
+        }
+
+        // Elements already stored are added again ahead of the new ones
+        if (capacity != table->table_size || table->num_elements != 0 || table->num_deleted != 0)
+        {
+            existing = table->num_elements;
+            all_keys = (void **)malloc(((size_t)existing + n) * sizeof(void *));
+            all_values = (void **)malloc(((size_t)existing + n) * sizeof(void *));
+
+            for (int i = 0, count = 0; i < table->table_size; i++)
+            {
+                if (((table->control)[i] & 0x80) == 0)
+                {
+                    all_keys[count] = open_key(table, i);
+                    all_values[count] = open_value(table, i);
+                    count++;
+                }
+            }
+
+            memcpy(all_keys + existing, keys, (size_t)n * sizeof(void *));
+            memcpy(all_values + existing, values, (size_t)n * sizeof(void *));
+
+            // The old arrays are kept while inline keys and values still point into them
+            old_control = table->control;
+            old_slots = table->slots;
+            old_entries = table->entries;
+
+            swiss_allocate(table, capacity);
+        }
+    }
+
+    unsigned char *added = (table->filter != NULL) ? (unsigned char *)calloc((size_t)existing + n, 1) : NULL;
+
+    bulk_store(table, all_keys, all_values, existing + n, (threads < 1) ? 1 : threads, added);
+
+    // Keys stored before the bulk load are already in the filter
+    if (added != NULL)
+    {
+        for (int i = existing; i < existing + n; i++)
+        {
+            if (added[i])
+            {
+                ((table->filter_ops)->add)(table->filter, mode_hash(table, all_keys[i]));
+            }
+        }
+
+        free(added);
+    }
+
+    if (all_keys != keys)
+    {
+        free(all_keys);
+        free(all_values);
+        free(old_control);
+        free(old_slots);
+        free(old_entries);
+    }
+}
+
+/*!
+ * @brief Returns the percent of the hash table occupied
+ * @param table Pointer to a hash table
+ * @return A float representing the percentage of the hash table that is occupied
+ */
+float percent_occupied(hash_table *table)
+{
+    // Scaling before dividing keeps whole percentages exact
+    return ((float)table->num_elements * 100) / table->table_size;
+}
+
+/*!
+ * @brief Resizes the hash table when the load factor is exceeded.
+ * @param table Pointer to a hash table
+ * @return None
+ */
+void resize(hash_table *table)
+{
+    if (table->mode == HASH_SWISS || table->mode == HASH_INLINE)
+    {
+        swiss_rehash(table, table->table_size * 2);
+        return;
+    }
+
+    if (table->mode == HASH_ROBIN_HOOD)
+    {
+        robin_hood_rehash(table, table->table_size * 2);
+        return;
+    }
+
+    if (table->mode == HASH_CUCKOO)
+    {
+        cuckoo_rehash(table, table->table_size * 2);
+        return;
+    }
+
+    STATS_COUNT(table, num_resizes);
+    STATS_RESIZE_BEGIN(table);
+
+    // A resize requested while one is in progress first completes the migration
+    chain_migrate(table, table->old_table_size);
+
+    // The original array is kept until its elements have been migrated
+    table->old_array = table->array;
+    table->old_table_size = table->table_size;
+    table->rehash_index = 0;
+
+    // Reassign the array pointer for the hash table to the new array
+    table->array = chain_allocate(table->table_size * 2);
+    // Update the size of the table
+    table->table_size = table->table_size * 2;
+
+    // Without incremental resizing every element is migrated in this call, by several
+    // workers when resize threads are set
+    if (table->rehash_step == 0 && table->resize_threads > 1)
+    {
+        chain_parallel_migrate(table);
+    }
+    else if (table->rehash_step == 0)
+    {
+        chain_migrate(table, table->old_table_size);
+    }
+
+    STATS_RESIZE_END(table);
+}
+
+/*!
+ * @brief Enables or disables incremental resizing. When enabled, resize() only allocates
+ *        the larger array, and each following put, get and remove_hash migrates a bounded
+ *        number of positions from the old array, capping the latency of any single operation.
+ * @param table Pointer to a hash table
+ * @param positions_per_step Number of old positions migrated per operation, or 0 to
+ *                           migrate every element within resize()
+ * @return None
+ */
+void set_incremental_resize(hash_table *table, int positions_per_step)
+{
+    table->rehash_step = positions_per_step;
+}
+
+/*!
+ * @brief Sets the number of workers each resize uses. A chaining resize splits the old
+ *        positions into ranges migrated by separate workers, and HASH_SWISS and HASH_INLINE
+ *        tables rebuild into the larger array as hash_table_bulk_load() does. Incremental
+ *        resizing and the other modes always resize in the calling thread. Workers only
+ *        run in parallel when built with HASH_TABLE_THREADS defined.
+ * @param table Pointer to a hash table
+ * @param threads Number of workers, 1 to resize in the calling thread
+ * @return None
+ */
+void set_resize_threads(hash_table *table, int threads)
+{
+    table->resize_threads = (threads < 1) ? 1 : threads;
+}
+
+/*!
+ * @brief Adds a chained node's key to the table's filter.
+ * @param node Node holding a key
+ * @param context Pointer to the hash table
+ * @return None
+ */
+static void filter_node(hash_node *node, void *context)
+{
+    hash_table *table = (hash_table *)context;
+
+    ((table->filter_ops)->add)(table->filter, node->hash);
+}
+
+/*!
+ * @brief Adds a key stored in a slot to the table's filter.
+ * @param key Key of the element
+ * @param value Value of the element
+ * @param context Pointer to the hash table
+ * @return None
+ */
+static void filter_slot(void *key, void *value, void *context)
+{
+    (void)value;
+
+    hash_table *table = (hash_table *)context;
+
+    ((table->filter_ops)->add)(table->filter, open_hash(table, key));
+}
+
+/*!
+ * @brief Attaches a membership filter which put and remove_hash keep up to date, so that
+ *        get, get_many and get_all return at once for most keys which are not present.
+ *        Keys already in the table are added to the filter. The filter is not freed by
+ *        free_hash_table, and should be sized for the most keys the table will hold.
+ *        A filter pays off when a miss costs more than the filter's own cache miss, as
+ *        in chained modes or with costly key comparisons, and slows the open addressing
+ *        modes on integer keys, whose misses usually read a single group.
+ * @param table Pointer to a hash table
+ * @param filter Pointer to an empty filter, or NULL to detach the current filter
+ * @param ops Operations on the filter, such as bloom_filter_ops or cuckoo_filter_ops
+ * @return None
+ */
+void set_hash_table_filter(hash_table *table, void *filter, const hash_filter_ops *ops)
+{
+    table->filter = filter;
+    table->filter_ops = ops;
+
+    if (filter == NULL)
+    {
+        return;
+    }
+
+    // Chained nodes cache their hash, and a multimap key is added once rather than per value
+    if (is_chained(table))
+    {
+        chain_for_each_node(table, &filter_node, table);
+    }
+    else
+    {
+        hash_table_for_each(table, &filter_slot, table);
+    }
+}
+
+/*!
+ * @brief Returns if an incremental resize is in progress.
+ * @param table Pointer to a hash table
+ * @return True if elements remain in the old array
+ */
+bool is_rehashing(hash_table *table)
+{
+    return table->old_array != NULL;
+}
+
+/*!
+ * @brief Returns how far an incremental resize has progressed.
+ * @param table Pointer to a hash table
+ * @return A float representing the percentage of old positions which have been migrated,
+ *         100 if no resize is in progress
+ */
+float rehash_progress(hash_table *table)
+{
+    if (table->old_array == NULL)
+    {
+        return 100;
+    }
+
+    return ((float)table->rehash_index * 100) / table->old_table_size;
+}
+
+/*!
+ * @brief Migrates old positions of an incremental resize outside of put, get and
+ *        remove_hash, for example from an idle loop.
+ * @param table Pointer to a hash table
+ * @param positions Maximum number of old positions to migrate
+ * @return None
+ */
+void rehash_positions(hash_table *table, int positions)
+{
+    chain_migrate(table, positions);
+}
+
+/*!
+ * @brief Adds the size of a multimap node's value array to a running total.
+ * @param node Node holding a multimap key
+ * @param context Pointer to the size_t total
+ * @return None
+ */
+static void add_value_array_bytes(hash_node *node, void *context)
+{
+    hash_value_array *values = (hash_value_array *)node->value;
+
+    *(size_t *)context += sizeof(hash_value_array) + (size_t)values->capacity * sizeof(void *);
+}
+
+/*!
+ * @brief Frees a multimap node's value array.
+ * @param node Node holding a multimap key
+ * @param context Unused
+ * @return None
+ */
+static void free_value_array(hash_node *node, void *context)
+{
+    (void)context;
+
+    free(node->value);
+    node->value = NULL;
+}
+
+/*!
+ * @brief Calls a function on every value stored in a chained node.
+ * @param table Pointer to a hash table in a chaining mode
+ * @param node Node holding a key
+ * @param visit Function called with the key, each of its values and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Number of values visited
+ */
+static int visit_node(hash_table *table, hash_node *node,
+                      void (*visit)(void *key, void *value, void *context), void *context)
+{
+    if (table->mode != HASH_MULTIMAP)
+    {
+        visit(node->key, node->value, context);
+        return 1;
+    }
+
+    hash_value_array *values = (hash_value_array *)node->value;
+
+    for (int i = 0; i < values->count; i++)
+    {
+        visit(node->key, (values->values)[i], context);
+    }
+
+    return values->count;
+}
+
+/*!
+ * @brief Adds one element's probe length to a running measurement.
+ * @param length Probe length of the element
+ * @param histogram Histogram to update, or NULL
+ * @param total Running sum of probe lengths
+ * @param count Running number of elements
+ * @param longest Longest probe length seen so far
+ * @return None
+ */
+static void record_probe_length(int length, int *histogram, long *total, int *count, int *longest)
+{
+    *total += length;
+    (*count)++;
+
+    if (length > *longest)
+    {
+        *longest = length;
+    }
+
+    if (histogram != NULL)
+    {
+        histogram[(length < HASH_STATS_HISTOGRAM_SIZE) ? length : HASH_STATS_HISTOGRAM_SIZE - 1]++;
+    }
+}
+
+/*!
+ * @brief Measures the probe length of every element in the table.
+ * @param table Pointer to a hash table
+ * @param histogram Histogram of HASH_STATS_HISTOGRAM_SIZE entries to add to, or NULL
+ * @param total Receives the sum of all probe lengths
+ * @param count Receives the number of elements measured
+ * @param longest Receives the longest probe length
+ * @return None
+ */
+static void scan_probe_lengths(hash_table *table, int *histogram, long *total, int *count, int *longest)
+{
+    int mask = table->table_size - 1;
+
+    *total = 0;
+    *count = 0;
+    *longest = 0;
+
+    if (!is_chained(table))
+    {
+        for (int i = 0; i < table->table_size; i++)
+        {
+            int length;
+
+            if (table->mode == HASH_ROBIN_HOOD)
+            {
+                // The control byte holds the distance unless it saturated
+                if ((table->control)[i] == ROBIN_HOOD_EMPTY)
+                {
+                    continue;
+                }
+
+                length = robin_hood_distance(table, i);
+            }
+            else if (table->mode == HASH_CUCKOO)
+            {
+                if ((table->slots)[i].key == NULL)
+                {
+                    continue;
+                }
+
+                int buckets[2];
+
+                cuckoo_buckets(table, open_hash(table, (table->slots)[i].key), buckets);
+                length = (i / HASH_BUCKET_SLOTS != buckets[0]) ? 1 : 0;
+            }
+            else
+            {
+                if ((table->control)[i] & 0x80)
+                {
+                    continue;
+                }
+
+                int home = (int)(open_hash(table, open_key(table, i)) >> 7) & mask;
+
+                length = (i - home) & mask;
+            }
+
+            record_probe_length(length, histogram, total, count, longest);
+        }
+
+        // Stashed elements are only reached after both buckets
+        for (int i = 0; i < table->num_stashed; i++)
+        {
+            record_probe_length(2, histogram, total, count, longest);
+        }
+
+        return;
+    }
+
+    hash_node *arrays[2] = {table->array, table->old_array};
+    int sizes[2] = {table->table_size, table->old_table_size};
+
+    for (int a = 0; a < 2 && arrays[a] != NULL; a++)
+    {
+        for (int i = 0; i < sizes[a]; i++)
+        {
+            hash_node *node = &((arrays[a])[i]);
+
+            if (node->key == NULL)
+            {
+                continue;
+            }
+
+            for (int length = 0; node != NULL; length++, node = node->next)
+            {
+                record_probe_length(length, histogram, total, count, longest);
+            }
+        }
+    }
+}
 
 /*!
- * @brief Defines the division method for creating an index from a key. Uses
- *        the remainder of the hash key divided by the table size to determine the index.
- * @param hash_key Key to create an index from
- * @return An integer specifying the index into the hash table
+ * @brief Measures how far elements are stored from where a lookup starts. For open
+ *        addressing this is the number of slots between an element and its home slot,
+ *        for cuckoo hashing 1 if the element is in its second bucket and 0 otherwise, and
+ *        for chaining the number of nodes before it in its chain.
+ * @param table Pointer to a hash table
+ * @param mean Receives the average probe length over all elements, 0 if the table is empty
+ * @param longest Receives the longest probe length of any element
+ * @return None
  */
-int division(hash_table *table, void *hash_key)
+void probe_length_stats(hash_table *table, float *mean, int *longest)
 {
-    int index = 0;
-    // Casts the hash key to a long type
-    long cast_hash_key = (long *)hash_key;
-    // Calculates the index
-    index = cast_hash_key % (table->table_size);
+    long total;
+    int count;
 
-    return index;
+    scan_probe_lengths(table, NULL, &total, &count, longest);
+
+    *mean = (count > 0) ? (float)total / count : 0;
 }
 
 /*!
- * @brief Adds an element to the hash table
+ * @brief Reports the probe length histogram, memory use and, when built with
+ *        HASH_TABLE_STATS defined, resize and lookup counters of a hash table.
+ *        Probe lengths are measured by scanning the table, in time proportional to its size.
  * @param table Pointer to a hash table
- * @param hash_key Key to create an index from
- * @param hash_value Value to place into the hash table
+ * @param stats Pointer to the statistics to fill
  * @return None
  */
-void put(hash_table *table, void *hash_key, void *hash_value)
+void hash_table_stats(hash_table *table, hash_table_statistics *stats)
 {
+    long total;
+    int count;
+
+    memset(stats, 0, sizeof(hash_table_statistics));
 
-    // Calculate the index to store the element at
-    int index = (table->hash_function)(table, hash_key);
-    // Boolean used to track if a collision has occurred.
-    bool collision = false;
+    scan_probe_lengths(table, stats->probe_histogram, &total, &count, &(stats->longest_probe));
+    stats->mean_probe = (count > 0) ? (float)total / count : 0;
 
-    // Entered if only one element is hashed to a given location
-    if (((table->array)[index]).key == NULL)
+    if (is_chained(table))
     {
-        // Assign the value to be stored by the node in the table entry
-        ((table->array)[index]).value = hash_value;
-        // Assign the associated hash key to the node
-        ((table->array)[index]).key = hash_key;
-    }
+        stats->bucket_bytes = (size_t)(table->table_size + table->old_table_size) * sizeof(hash_node);
+
+        for (hash_node_slab *slab = table->slabs; slab != NULL; slab = slab->next)
+        {
+            stats->node_bytes += sizeof(hash_node_slab) + (size_t)slab->capacity * sizeof(hash_node);
+        }
 
+        // Multimap value arrays are counted with the nodes which hold them
+        if (table->mode == HASH_MULTIMAP)
+        {
+            chain_for_each_node(table, &add_value_array_bytes, &(stats->node_bytes));
+        }
+    }
     else
     {
-        // Allocate memory for a hash_node pointer and assign to the first element in the hash table
-        hash_node *node = &((table->array)[index]);
-        // Pointer to keep track of the previous node
-        hash_node *previous_node;
+        size_t slot_bytes = (table->mode == HASH_INLINE) ? table->entry_size : sizeof(hash_slot);
 
-        // Indicates a collision has occurred
-        collision = true;
+        stats->bucket_bytes = (size_t)(table->table_size + table->num_stashed) * slot_bytes;
 
-        // Traverse the hash table entry until the next reference is NULL.
-        // Artifact of collisions
-        while (node->next != NULL)
+        // Cuckoo tables do not use control bytes
+        if (table->control != NULL)
         {
-            previous_node = node;
-            node = node->next;
+            stats->bucket_bytes += table->table_size + HASH_GROUP_WIDTH;
         }
+    }
 
-        // Allocate memory for the next node at a given table location
-        hash_node *next_node = (hash_node *)malloc(sizeof(hash_node));
-
-        // Assign this node's next node to NULL
-        next_node->next = NULL;
-        // Assign the previous node pointer to the predecessor of the current node
-        next_node->previous = previous_node;
-        // Assign the value to be stored by the node in the table entry
-        next_node->value = hash_value;
-        // Assign the associated hash key to the node
-        next_node->key = hash_key;
+    // Counters stay 0 unless statistics are enabled
+    hash_table_counters *counters = &(table->counters);
 
-        // Assigns the next node
-        node->next = next_node;
-    }
+    stats->num_resizes = counters->num_resizes;
+    stats->resize_ns = counters->resize_ns;
+    stats->successful_lookups = counters->successful_lookups;
+    stats->failed_lookups = counters->failed_lookups;
+    stats->filtered_lookups = counters->filtered_lookups;
 
-    // If a collision did not occur, the counter for the number of elements is incremented
-    if (collision == false)
+    if (counters->successful_lookups > 0)
     {
-        table->num_elements++;
+        stats->successful_comparisons = (float)counters->successful_comparisons / counters->successful_lookups;
     }
 
-    if (percent_occupied(table) >= (float)(table->load_factor * 100))
+    if (counters->failed_lookups > 0)
     {
-        resize(table);
+        stats->failed_comparisons = (float)counters->failed_comparisons / counters->failed_lookups;
     }
 }
 
 /*!
- * @brief Returns the element associated with a key
+ * @brief Calls a function on every key value pair stored in the hash table. In
+ *        HASH_INLINE mode the key and value are pointers to their bytes. The table
+ *        must not be modified until the call returns.
  * @param table Pointer to a hash table
- * @param hash_key Key associated with the element
- * @return The value associated with the specified key
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return None
  */
-void *get(hash_table *table, void *hash_key)
+void hash_table_for_each(hash_table *table, void (*visit)(void *key, void *value, void *context), void *context)
 {
-    // Calculate index
-    int index = (table->hash_function)(table, hash_key);
-
-    // Entered if key is not found and only one element is hashed to a given position
-    if (&(table->array[index]) == NULL || (((table->array)[index]).next == NULL && ((table->array)[index]).key != hash_key))
+    if (table->mode == HASH_SWISS || table->mode == HASH_INLINE)
     {
-        return NULL;
+        for (int i = 0; i < table->table_size; i++)
+        {
+            // Only full slots have the high bit of their control byte clear
+            if (((table->control)[i] & 0x80) == 0)
+            {
+                visit(open_key(table, i), open_value(table, i), context);
+            }
+        }
+
+        return;
     }
 
-    // Entered if only one element is hashed to given index
-    else if (((table->array)[index]).next == NULL && ((table->array)[index]).key == hash_key)
+    if (table->mode == HASH_ROBIN_HOOD)
     {
-        return ((table->array)[index]).value;
+        for (int i = 0; i < table->table_size; i++)
+        {
+            if ((table->control)[i] != ROBIN_HOOD_EMPTY)
+            {
+                visit((table->slots)[i].key, (table->slots)[i].value, context);
+            }
+        }
+
+        return;
     }
 
-    // Entered if more than one node is assigned to a given position
-    else
+    if (table->mode == HASH_CUCKOO)
     {
-        // Allocate memory for traversal node
-        hash_node *node = &((table->array)[index]);
+        for (int i = 0; i < table->table_size; i++)
+        {
+            if ((table->slots)[i].key != NULL)
+            {
+                visit((table->slots)[i].key, (table->slots)[i].value, context);
+            }
+        }
+
+        for (int i = 0; i < table->num_stashed; i++)
+        {
+            visit((table->stash)[i].key, (table->stash)[i].value, context);
+        }
+
+        return;
+    }
 
-        // While the key does not match the one specified, continue traversing the nodes at a given index
-        while (node->key != hash_key)
+    // Positions of an in progress incremental resize are visited in both arrays
+    hash_node *arrays[2] = {table->array, table->old_array};
+    int sizes[2] = {table->table_size, table->old_table_size};
+
+    for (int a = 0; a < 2 && arrays[a] != NULL; a++)
+    {
+        for (int i = 0; i < sizes[a]; i++)
         {
-            node = node->next;
+            hash_node *node = &((arrays[a])[i]);
 
-            // If the key is not found in the table
-            if (node->next == NULL && node->key != hash_key)
+            // An empty first node means nothing is stored at this position
+            if (node->key == NULL)
             {
-                return NULL;
+                continue;
             }
-        }
 
-        return node->value;
+            while (node != NULL)
+            {
+                visit_node(table, node, visit, context);
+                node = node->next;
+            }
+        }
     }
 }
 
 /*!
- * @brief Removes a key value pair from the hash table
- * @param table Pointer to a hash table
- * @param hash_key Key associated with the element
- * @return None
+ * @brief Reverses the order of the bits of a scan cursor.
+ * @param v Cursor bits
+ * @return The bits of v in reverse order
  */
-void remove_hash(hash_table *table, void *hash_key)
+static uint32_t reverse_bits(uint32_t v)
+{
+    v = ((v >> 1) & 0x55555555u) | ((v & 0x55555555u) << 1);
+    v = ((v >> 2) & 0x33333333u) | ((v & 0x33333333u) << 2);
+    v = ((v >> 4) & 0x0F0F0F0Fu) | ((v & 0x0F0F0F0Fu) << 4);
+    v = ((v >> 8) & 0x00FF00FFu) | ((v & 0x00FF00FFu) << 8);
+
+    return (v >> 16) | (v << 16);
+}
+
+/*!
+ * @brief Advances a scan cursor by incrementing its reversed bits within a mask. Each
+ *        position of a table is reached before any of the positions it splits into
+ *        when the table doubles, so growth never revisits or skips a position.
+ * @param v Cursor bits
+ * @param mask Mask of the cursor bits which select a position
+ * @return The next cursor, 0 once every position has been reached
+ */
+static uint32_t next_cursor(uint32_t v, uint32_t mask)
 {
-    // Calculate index
-    int index = (table->hash_function)(table, hash_key);
+    v |= ~mask;
+    v = reverse_bits(v);
+    v++;
 
-    // Allocate memory for traversal node
-    hash_node *node = &((table->array)[index]);
+    return reverse_bits(v);
+}
 
-    // Allocate memory for a previous node hash_node pointer
-    hash_node *previous_node;
+/*!
+ * @brief Visits every element chained at a position.
+ * @param table Pointer to a hash table
+ * @param head First node of the position
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Number of elements visited
+ */
+static int scan_chain(hash_table *table, hash_node *head, void (*visit)(void *key, void *value, void *context), void *context)
+{
+    int visited = 0;
 
-    // While the key does not match the one specified, continue traversing the nodes at a given index
-    while (node != NULL && node->key != hash_key)
+    // An empty first node means nothing is stored at this position
+    if (head->key == NULL)
     {
-        previous_node = node;
-        node = node->next;
+        return 0;
     }
 
-    // If the previous node (first node at a given index) is not NULL, the previous node is reassigned
-    if (node->next != NULL && node->previous != NULL)
+    for (hash_node *node = head; node != NULL; node = node->next)
     {
-        // Correctly assigns the next node to the previous node
-        previous_node->next = node->next;
-        (node->next)->previous = previous_node;
-
-        // Releases memory held by the removed node
-        free(node);
-        // Avoid dangling pointer
-        node = NULL;
+        visited += visit_node(table, node, visit, context);
     }
-    // Entered if the node to remove is the first at a table position, and there is at least one
-    // other node in the chain
-    else if (node->previous == NULL && node->next != NULL)
-    {
-        node->key = (node->next)->key;
-        node->value = (node->next)->value;
 
-        hash_node *next_node = (node->next)->next;
+    return visited;
+}
 
-        // Release memory held by next node of node to remove.
-        // Does not release memory allocated for hash table position.
-        free(node->next);
-        // Avoid dangling pointer
-        node->next = NULL;
+/*!
+ * @brief Visits every element of a HASH_SWISS or HASH_INLINE table whose home slot lies
+ *        in one group of HASH_GROUP_WIDTH slots. The probe sequences of the group's home
+ *        slots are followed a step at a time until each reaches a group holding an empty
+ *        slot, where its lookups end. An element is only visited in the probe step of its
+ *        own home slot, so it is visited once wherever along the sequence it sits.
+ * @param table Pointer to a hash table
+ * @param group Index of the group of home slots
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Number of elements visited
+ */
+static int scan_group(hash_table *table, int group, void (*visit)(void *key, void *value, void *context), void *context)
+{
+    int mask = table->table_size - 1;
+    int first = group * HASH_GROUP_WIDTH;
+    int position = first;
+    // Bit j is set while the probe sequence from home slot first + j continues
+    uint32_t active = (1u << HASH_GROUP_WIDTH) - 1;
+    int visited = 0;
 
-        node->next = next_node;
-    }
-    // If the element to remove is the only element at the table position
-    else
+    // Each step of every sequence lies within the two aligned groups from position, and
+    // a sequence visits each group once, so the steps are bounded by the number of groups
+    for (int stride = 0; active != 0 && stride < table->table_size; stride += HASH_GROUP_WIDTH)
     {
-        node->key = NULL;
-        node->value = NULL;
-        table->num_elements--;
+        int second = (position + HASH_GROUP_WIDTH) & mask;
+        uint32_t empty = group_match(table->control + position, CONTROL_EMPTY) |
+                         (group_match(table->control + second, CONTROL_EMPTY) << HASH_GROUP_WIDTH);
+
+        for (int offset = 0; offset < 2 * HASH_GROUP_WIDTH - 1; offset++)
+        {
+            int index = (position + offset) & mask;
+
+            if (((table->control)[index] & 0x80) != 0)
+            {
+                continue;
+            }
+
+            int home = (int)(open_hash(table, open_key(table, index)) >> 7) & mask;
+            int j = home - first;
+
+            // The slot must be within this step of the element's own home slot
+            if (j >= 0 && j < HASH_GROUP_WIDTH && (active & (1u << j)) != 0 && offset >= j &&
+                offset < j + HASH_GROUP_WIDTH)
+            {
+                visit(open_key(table, index), open_value(table, index), context);
+                visited++;
+            }
+        }
+
+        for (int j = 0; j < HASH_GROUP_WIDTH; j++)
+        {
+            if (((empty >> j) & ((1u << HASH_GROUP_WIDTH) - 1)) != 0)
+            {
+                active &= ~(1u << j);
+            }
+        }
+
+        position = (position + stride + HASH_GROUP_WIDTH) & mask;
     }
+
+    return visited;
 }
 
 /*!
- * @brief Returns the percent of the hash table occupied
+ * @brief Visits every element of a Robin Hood table whose home is one slot. They sit in
+ *        a run starting at or after the home slot, each at its distance from home, which
+ *        ends at the first element closer to its own home.
  * @param table Pointer to a hash table
- * @return A float representing the percentage of the hash table that is occupied
+ * @param home Index of the home slot
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Number of elements visited
  */
-float percent_occupied(hash_table *table)
+static int scan_run(hash_table *table, int home, void (*visit)(void *key, void *value, void *context), void *context)
 {
-    return ((float)table->num_elements / table->table_size) * 100;
+    int mask = table->table_size - 1;
+    int visited = 0;
+
+    for (int distance = 0;; distance++)
+    {
+        int index = (home + distance) & mask;
+        // An empty slot reads as a distance of -1
+        int stored = robin_hood_distance(table, index);
+
+        if (stored < distance)
+        {
+            break;
+        }
+
+        if (stored == distance)
+        {
+            visit((table->slots)[index].key, (table->slots)[index].value, context);
+            visited++;
+        }
+    }
+
+    return visited;
 }
 
 /*!
- * @brief Resizes the hash table when the load factor is exceeded.
+ * @brief Visits a batch of slots of a cuckoo table in index order.
  * @param table Pointer to a hash table
- * @return None
+ * @param cursor Slot to start from
+ * @param count Number of elements after which the batch ends
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Cursor for the next call, or 0 once the scan is complete
  */
-void resize(hash_table *table)
+static uint64_t scan_slots(hash_table *table, uint64_t cursor, int count,
+                           void (*visit)(void *key, void *value, void *context), void *context)
 {
-    hash_node *new_array = (hash_node *)malloc((table->table_size * 2) * sizeof(hash_node));
-    hash_node *old_array = (hash_node *)malloc(table->table_size * sizeof(hash_node));
+    int visited = 0;
 
-    // Initialize all elements in the new array
-    for (int i = 0; i < (table->table_size * 2); i++)
+    for (uint64_t i = cursor; i < (uint64_t)table->table_size; i++)
     {
-        // Sets the hash key to NULL
-        (new_array[i]).key = NULL;
-        // Sets the next pointer of the first node in the hash table position to NULL
-        (new_array[i]).next = NULL;
-        // Sets the previous pointer of the first node in the hash table position to NULL
-        (new_array[i]).previous = NULL;
+        if ((table->slots)[i].key != NULL)
+        {
+            visit((table->slots)[i].key, (table->slots)[i].value, context);
+            visited++;
+        }
 
-        // Save the contents of the original array
-        if (i < table->table_size)
+        if (visited >= count && i + 1 < (uint64_t)table->table_size)
         {
-            old_array[i] = table->array[i];
+            return i + 1;
         }
     }
 
-    // Reset the counter for the number of elements to 0
-    table->num_elements = 0;
-    // Reassign the array pointer for the hash table to the new array
-    table->array = new_array;
-    // Save the original size of the hash table
-    int orig_size = table->table_size;
-    // Update the size of the table
-    table->table_size = table->table_size * 2;
+    // The cuckoo stash is small and visited with the last batch
+    for (int i = 0; i < table->num_stashed; i++)
+    {
+        visit((table->stash)[i].key, (table->stash)[i].value, context);
+    }
+
+    return 0;
+}
+
+/*!
+ * @brief Visits the next batch of elements of an incremental scan, allowing the table to
+ *        be modified between calls. Start with a cursor of 0 and pass the returned cursor
+ *        to the next call until 0 is returned. In every mode but HASH_CUCKOO, every element
+ *        present for the whole scan is visited exactly once even if the table grows,
+ *        including during an incremental resize, and elements added or removed during the
+ *        scan may or may not be visited. A put in HASH_CUCKOO mode may move elements between
+ *        their two buckets, so there the same holds only while no put is made between calls.
+ *        The table must not be modified by the visit function.
+ * @param table Pointer to a hash table
+ * @param cursor 0 to start a scan, otherwise the cursor returned by the previous call
+ * @param count Number of elements after which the batch ends. Elements sharing a home
+ *              position, or a home group in HASH_SWISS and HASH_INLINE modes, are always
+ *              visited together, so a batch may be larger
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Cursor for the next call, or 0 once the scan is complete
+ */
+uint64_t hash_table_scan(hash_table *table, uint64_t cursor, int count,
+                         void (*visit)(void *key, void *value, void *context), void *context)
+{
+    if (table->mode == HASH_CUCKOO)
+    {
+        return scan_slots(table, cursor, count, visit, context);
+    }
 
-    // Iterate through all entries which existed in the old array, and rehash them into the new array
-    for (int j = 0; j < orig_size; j++)
+    // Open addressing tables only ever double, so the cursor steps through home positions
+    // in reverse binary order as for chaining. Robin Hood homes are slots, and Swiss homes
+    // are taken a group at a time so each slot is hashed about twice per scan
+    if (!is_chained(table))
     {
-        hash_node *node = &(old_array[j]);
+        uint32_t v = (uint32_t)cursor;
+        int visited = 0;
 
         do
         {
-            if (node->key != NULL)
+            uint32_t mask;
+
+            if (table->mode == HASH_ROBIN_HOOD)
+            {
+                mask = (uint32_t)table->table_size - 1;
+                visited += scan_run(table, (int)(v & mask), visit, context);
+            }
+            else
             {
-                put(table, node->key, node->value);
+                mask = (uint32_t)(table->table_size / HASH_GROUP_WIDTH) - 1;
+                visited += scan_group(table, (int)(v & mask), visit, context);
             }
 
-            node = node->next;
-            // Iteration is continued if multiple elements are hashed to the same location
-        } while (node != NULL);
+            v = next_cursor(v, mask);
+
+            if (v == 0)
+            {
+                return 0;
+            }
+        } while (visited < count);
 
-        // Free the memory used to hold the elements of the original array
-        free(&(old_array[j]));
+        return v;
     }
 
-    printf("\nResized. Hash table size is now %d", table->table_size);
+    // Chaining positions are a hash modulo the table size, which only ever doubles, so the
+    // size is a fixed odd base times a power of two. The remainder of the hash by the base
+    // is fixed for a key, and the quotient's low bits select among the base's multiples
+    // exactly as a mask would, so the cursor holds the remainder in its upper half and
+    // reverse binary increments of the quotient bits in its lower half
+    int base = table->table_size >> __builtin_ctz(table->table_size);
+    int remainder = (int)(cursor >> 32);
+    uint32_t v = (uint32_t)cursor;
+    int visited = 0;
+
+    do
+    {
+        uint32_t mask = (uint32_t)(table->table_size / base) - 1;
+
+        if (table->old_array == NULL)
+        {
+            visited += scan_chain(table, &((table->array)[(int)(v & mask) * base + remainder]), visit, context);
+        }
+        else
+        {
+            uint32_t old_mask = (uint32_t)(table->old_table_size / base) - 1;
+
+            // Positions already migrated are empty in the old array
+            visited += scan_chain(table, &((table->old_array)[(int)(v & old_mask) * base + remainder]), visit, context);
+
+            // Every position of the new array the old position splits into
+            do
+            {
+                visited += scan_chain(table, &((table->array)[(int)(v & mask) * base + remainder]), visit, context);
+                v = (((v | old_mask) + 1) & ~old_mask) | (v & old_mask);
+            } while ((v & (old_mask ^ mask)) != 0);
+
+            mask = old_mask;
+        }
+
+        v = next_cursor(v, mask);
+
+        // Once every quotient has been reached, the scan moves on to the next remainder
+        if (v == 0 && ++remainder == base)
+        {
+            return 0;
+        }
+    } while (visited < count);
+
+    return ((uint64_t)remainder << 32) | v;
 }
 
 /*!
@@ -284,11 +4422,30 @@ void resize(hash_table *table)
  */
 static void hash_function_select(hash_table *table, int function_select)
 {
+    // Positions are always the remainder of the selected hash divided by the table size
+    table->hash_function = &division;
+    table->key_equal = &equal_pointer;
+    table->key_length = HASH_KEY_POINTER;
+
     switch (function_select)
     {
     // Selects the division method
-    case 0:
-        table->hash_function = &division;
+    case HASH_DIVISION:
+        table->key_hash = &hash_pointer;
+        break;
+    // Selects the Fibonacci multiplier for integer keys
+    case HASH_FIBONACCI:
+        table->key_hash = &hash_fibonacci;
+        break;
+    // Selects content hashing for string keys
+    case HASH_STRING:
+        table->key_hash = &hash_bytes;
+        table->key_equal = &equal_bytes;
+        table->key_length = HASH_KEY_STRING;
+        break;
+    // An unknown selection falls back to the division method rather than leaving no hash
+    default:
+        table->key_hash = &hash_pointer;
         break;
     }
 }
@@ -303,27 +4460,148 @@ static void hash_function_select(hash_table *table, int function_select)
  */
 void initialize_hash_table(hash_table *table, int size, float load_factor, int function_select)
 {
+    initialize_hash_table_mode(table, size, load_factor, function_select, HASH_CHAINING);
+}
+
+/*!
+ * @brief Initializes the hash table with a specified collision resolution strategy.
+ *        In HASH_SWISS mode the size is rounded up to a power of two of at least
+ *        HASH_GROUP_WIDTH, and the load factor is capped at 0.875. HASH_ROBIN_HOOD and
+ *        HASH_CUCKOO modes round the size the same way and cap the load factor at 0.95.
+ *        HASH_INLINE tables are initialized with initialize_hash_table_inline() instead.
+ * @param table Pointer to a hash table
+ * @param size Number of elements in the hash table
+ * @param load_factor Percentage of table full at which to dynamically resize
+ * @param function_select Integer specifying which hash function to use
+ * @param mode Collision resolution strategy to use
+ * @return None
+ */
+void initialize_hash_table_mode(hash_table *table, int size, float load_factor, int function_select, hash_table_mode mode)
+{
+    table->mode = mode;
+    table->array = NULL;
+    table->control = NULL;
+    table->slots = NULL;
+    table->num_deleted = 0;
+    table->old_array = NULL;
+    table->old_table_size = 0;
+    table->rehash_index = 0;
+    table->rehash_step = 0;
+    table->resize_threads = 1;
+    table->slabs = NULL;
+    table->slab_used = 0;
+    table->free_nodes = NULL;
+    table->stash = NULL;
+    table->num_stashed = 0;
+    table->filter = NULL;
+    table->filter_ops = NULL;
+    table->entries = NULL;
+    table->value_size = 0;
+    table->entry_size = 0;
+
+    memset(&(table->counters), 0, sizeof(hash_table_counters));
+
+    // Selects the desired hashing function
+    hash_function_select(table, function_select);
+
+    if (!is_chained(table))
+    {
+        float max_load_factor = (mode == HASH_SWISS || mode == HASH_INLINE) ? MAX_OPEN_LOAD_FACTOR
+                                : (mode == HASH_ROBIN_HOOD) ? MAX_ROBIN_HOOD_LOAD_FACTOR
+                                : MAX_CUCKOO_LOAD_FACTOR;
+        int capacity = HASH_GROUP_WIDTH;
+
+        // Group probing relies on masking, so the capacity is a power of two
+        while (capacity < size)
+        {
+            capacity *= 2;
+        }
+
+        table->load_factor = (load_factor > max_load_factor) ? max_load_factor : load_factor;
+
+        if (mode == HASH_CUCKOO)
+        {
+            cuckoo_allocate(table, capacity);
+        }
+        // Inline entries are allocated once initialize_hash_table_inline() sets their size
+        else if (mode == HASH_INLINE)
+        {
+            table->table_size = capacity;
+            table->num_elements = 0;
+        }
+        else
+        {
+            swiss_allocate(table, capacity);
+        }
+
+        return;
+    }
+
     // Defines the size of the hash table
     table->table_size = size;
     // Defines the load factor
     table->load_factor = load_factor;
     // Assigns the array pointer to an array of the desired size
-    table->array = (hash_node *)malloc(size * sizeof(hash_node));
+    table->array = chain_allocate(size);
+
+    // Sets the initial counter for table elements to 0
+    table->num_elements = 0;
+}
+
+/*!
+ * @brief Initializes the hash table with user defined key hashing and equality.
+ * @param table Pointer to a hash table
+ * @param size Number of elements in the hash table
+ * @param load_factor Percentage of table full at which to dynamically resize
+ * @param mode Collision resolution strategy to use
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return None
+ */
+void initialize_hash_table_keys(hash_table *table, int size, float load_factor, hash_table_mode mode,
+                                size_t key_length, hash_key_function key_hash, hash_equal_function key_equal)
+{
+    initialize_hash_table_mode(table, size, load_factor, HASH_DIVISION, mode);
+
+    table->key_length = key_length;
+    table->key_hash = key_hash;
 
-    for (int i = 0; i < size; i++)
+    if (key_equal != NULL)
+    {
+        table->key_equal = key_equal;
+    }
+    else
     {
-        // Sets the hash key to NULL
-        ((table->array)[i]).key = NULL;
-        // Sets the next pointer of the first node in the hash table position to NULL
-        ((table->array)[i]).next = NULL;
-        // Sets the previous pointer of the first node in the hash table position to NULL
-        ((table->array)[i]).previous = NULL;
+        table->key_equal = (key_length == HASH_KEY_POINTER) ? &equal_pointer : &equal_bytes;
     }
+}
 
-    // Sets the initial counter for table elements to 0
-    table->num_elements = 0;
-    // Selects the desired hashing function
-    hash_function_select(table, function_select);
+/*!
+ * @brief Initializes a HASH_INLINE hash table, which copies fixed size keys and values
+ *        into its entries rather than storing pointers to them. Keys are hashed and
+ *        compared by their bytes, with 4 and 8 byte keys compared as integers. The size
+ *        and load factor are treated as in HASH_SWISS mode.
+ * @param table Pointer to a hash table
+ * @param size Number of elements in the hash table
+ * @param load_factor Percentage of table full at which to dynamically resize
+ * @param key_size Number of bytes in each key
+ * @param value_size Number of bytes in each value, 0 to store keys only
+ * @return None
+ */
+void initialize_hash_table_inline(hash_table *table, int size, float load_factor, size_t key_size, size_t value_size)
+{
+    initialize_hash_table_mode(table, size, load_factor, HASH_DIVISION, HASH_INLINE);
+
+    table->key_length = key_size;
+    table->key_hash = &hash_inline_key;
+    table->key_equal = &equal_bytes;
+    table->value_size = value_size;
+
+    // Rounding up to a multiple of 8 bytes keeps every entry's key aligned for integer loads
+    table->entry_size = (key_size + value_size + 7) & ~(size_t)7;
+
+    swiss_allocate(table, table->table_size);
 }
 
 /*!
@@ -333,28 +4611,50 @@ void initialize_hash_table(hash_table *table, int size, float load_factor, int f
  */
 void free_hash_table(hash_table *table)
 {
-    for (int i = 0; i < table->table_size; i++)
+    if (!is_chained(table))
     {
-        if (((table->array)[i]).next != NULL)
-        {
-            // Frees the memory held by the next reference to the current node if one exists
-            free(((table->array)[i]).next);
-            // Avoid dangling pointer
-            ((table->array)[i]).next = NULL;
-        }
+        free(table->control);
+        free(table->slots);
+        free(table->entries);
+        free(table->stash);
+        table->stash = NULL;
+        table->num_stashed = 0;
 
-        if (((table->array)[i]).previous != NULL)
-        {
-            // Frees the memory held by the previous reference to the current node if one exists
-            free(((table->array)[i]).previous);
-            // Avoid dangling pointer
-            ((table->array)[i]).previous = NULL;
-        }
+        // Avoid dangling pointers to the control bytes and slots
+        table->control = NULL;
+        table->slots = NULL;
+        table->entries = NULL;
+        table->array = NULL;
+        return;
+    }
+
+    // Value arrays are the only per key allocations, so chains are walked only in multimap mode
+    if (table->mode == HASH_MULTIMAP)
+    {
+        chain_for_each_node(table, &free_value_array, NULL);
+    }
 
-        // Frees the node itself
-        free(&(table->array[i]));
+    // Every chained node lives in a slab
+    while (table->slabs != NULL)
+    {
+        hash_node_slab *slab = table->slabs;
+
+        table->slabs = slab->next;
+        free(slab);
+    }
+
+    table->free_nodes = NULL;
+
+    // Frees the array of table positions in a single call
+    free(table->array);
+
+    // Entered if the table is freed part way through an incremental resize
+    if (table->old_array != NULL)
+    {
+        free(table->old_array);
+        table->old_array = NULL;
     }
 
     // Avoids dangling pointer to the array
     table->array = NULL;
-}
+}
\ No newline at end of file
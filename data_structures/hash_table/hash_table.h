@@ -19,11 +19,103 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Number of control bytes compared at once when probing an open addressing table
+#define HASH_GROUP_WIDTH 16
+
+// Hash function selections accepted by initialize_hash_table()
+// Integer keys stored in the key pointer, hashed to themselves
+#define HASH_DIVISION 0
+// Integer keys stored in the key pointer, scrambled with a Fibonacci multiplier
+#define HASH_FIBONACCI 1
+// NUL terminated string keys, hashed by content
+#define HASH_STRING 2
+
+// Key length for keys which are stored directly in the key pointer
+#define HASH_KEY_POINTER 0
+// Key length for NUL terminated string keys
+#define HASH_KEY_STRING ((size_t)-1)
+// Number of slots in each bucket of a cuckoo table
+#define HASH_BUCKET_SLOTS 4
+// Number of entries in the probe length histogram, the last counting all longer probes
+#define HASH_STATS_HISTOGRAM_SIZE 16
 
 /************************************
  * TYPEDEFS
  ************************************/
 
+/*!
+ * @brief Collision resolution strategies supported by the hash table.
+ */
+typedef enum hash_table_mode
+{
+    // Separate chaining, colliding elements are linked off the table position
+    HASH_CHAINING = 0,
+    // Open addressing with one control byte per slot, probed a group at a time
+    HASH_SWISS = 1,
+    // Linear probing where elements far from their home slot displace closer ones
+    HASH_ROBIN_HOOD = 2,
+    // Two candidate buckets of HASH_BUCKET_SLOTS slots each, one cache line per bucket
+    HASH_CUCKOO = 3,
+    // Separate chaining where each key holds every value added for it in one contiguous array
+    HASH_MULTIMAP = 4,
+    // Swiss table probing over fixed size keys and values copied into the table's entries,
+    // set up with initialize_hash_table_inline()
+    HASH_INLINE = 5
+} hash_table_mode;
+
+/*!
+ * @brief Operations aggregate_batch() applies to the value held for each group.
+ */
+typedef enum hash_aggregate_op
+{
+    // Adds each row's delta to the group's value
+    HASH_AGGREGATE_SUM = 0,
+    // Keeps the smallest delta given for the group
+    HASH_AGGREGATE_MIN = 1,
+    // Keeps the largest delta given for the group
+    HASH_AGGREGATE_MAX = 2,
+    // Counts the rows given for the group, ignoring their deltas
+    HASH_AGGREGATE_COUNT = 3
+} hash_aggregate_op;
+
+/*!
+ * @brief Function computing a 64 bit hash of a key.
+ * @param key Key to hash
+ * @param key_length Number of bytes in the key, or HASH_KEY_POINTER / HASH_KEY_STRING
+ * @return A 64 bit hash of the key
+ */
+typedef uint64_t (*hash_key_function)(const void *key, size_t key_length);
+
+/*!
+ * @brief Function comparing two keys for equality.
+ * @param key_a First key
+ * @param key_b Second key
+ * @param key_length Number of bytes in the key, or HASH_KEY_POINTER / HASH_KEY_STRING
+ * @return True if the keys are equal
+ */
+typedef bool (*hash_equal_function)(const void *key_a, const void *key_b, size_t key_length);
+
+/*!
+ * @brief Operations on a membership filter consulted before a lookup touches the table.
+ *        Each operation is given the hash the table's mode uses for a key.
+ */
+typedef struct hash_filter_ops
+{
+    // Records a key added to the table
+    void (*add)(void *filter, uint64_t hash);
+    // Forgets a key removed from the table, NULL for filters which cannot delete
+    void (*remove)(void *filter, uint64_t hash);
+    // Returns false only if the key was never added, or has since been removed
+    bool (*contains)(void *filter, uint64_t hash);
+} hash_filter_ops;
+
 /*!
  * @brief Struct representing a hash table element.
  */
@@ -33,12 +125,104 @@ typedef struct hash_node
     void *key;
     // Value held by the node
     void *value;
+    // Full hash of the key, compared before calling the key equality function
+    uint64_t hash;
     // Pointer to the next node
     struct hash_node *next;
     // Pointer to the previous node
     struct hash_node *previous;
 } hash_node;
 
+/*!
+ * @brief Struct representing a block of memory that chained nodes are carved out of.
+ */
+typedef struct hash_node_slab
+{
+    // Next slab in the table's list of slabs
+    struct hash_node_slab *next;
+    // Number of nodes the slab holds
+    int capacity;
+    // Nodes held by the slab
+    hash_node nodes[];
+} hash_node_slab;
+
+/*!
+ * @brief Struct representing a slot in an open addressing hash table.
+ */
+typedef struct hash_slot
+{
+    // Key associated with the slot
+    void *key;
+    // Value held by the slot
+    void *value;
+} hash_slot;
+
+/*!
+ * @brief Struct representing the values stored for a key in HASH_MULTIMAP mode. The
+ *        key's node holds a pointer to it in place of a single value.
+ */
+typedef struct hash_value_array
+{
+    // Number of values stored
+    int count;
+    // Number of values the array can hold before it is reallocated
+    int capacity;
+    // Values in the order they were added
+    void *values[];
+} hash_value_array;
+
+/*!
+ * @brief Running counters kept by a hash table built with HASH_TABLE_STATS defined.
+ *        Lookups may run on several threads at once, as in the concurrent tables, so the
+ *        counts are atomic. Resize timing is only updated by writers.
+ */
+typedef struct hash_table_counters
+{
+    // Key comparisons made by all operations
+    atomic_long comparisons;
+    // Lookups which found their key, and the key comparisons they made
+    atomic_long successful_lookups;
+    atomic_long successful_comparisons;
+    // Lookups which did not find their key, and the key comparisons they made
+    atomic_long failed_lookups;
+    atomic_long failed_comparisons;
+    // Failed lookups answered by the table's filter without searching the table
+    atomic_long filtered_lookups;
+    // Number of times the table has been rebuilt with a new array
+    atomic_long num_resizes;
+    // Nanoseconds spent rebuilding and migrating, including incremental migration
+    uint64_t resize_ns;
+    // Nesting depth of resize work being timed, and when the outermost began
+    int resize_depth;
+    uint64_t resize_start;
+} hash_table_counters;
+
+/*!
+ * @brief Snapshot of a hash table's shape and behaviour, filled by hash_table_stats().
+ */
+typedef struct hash_table_statistics
+{
+    // Number of elements with each probe length, as measured by probe_length_stats()
+    int probe_histogram[HASH_STATS_HISTOGRAM_SIZE];
+    // Longest probe length or chain of any element
+    int longest_probe;
+    // Average probe length over all elements
+    float mean_probe;
+    // Bytes allocated for table positions, control bytes and slots
+    size_t bucket_bytes;
+    // Bytes allocated for chained nodes
+    size_t node_bytes;
+    // Counters below are only collected with HASH_TABLE_STATS defined, otherwise 0
+    long num_resizes;
+    uint64_t resize_ns;
+    long successful_lookups;
+    long failed_lookups;
+    long filtered_lookups;
+    // Average key comparisons per successful and failed lookup
+    float successful_comparisons;
+    float failed_comparisons;
+} hash_table_statistics;
+
 /*!
  * @brief Struct which represents a hash table.
  */
@@ -46,14 +230,68 @@ typedef struct hash_table
 {
     // Size of the hash table
     int table_size;
-    // Number of elements stored in the hash table
+    // Number of elements stored in the hash table. Chaining modes count occupied
+    // positions instead, so keys sharing a position never trigger a resize
     int num_elements;
     // Load factor to specify when to resize the hash table
     float load_factor;
     // Pointer to a hash function
     int (*hash_function)(struct hash_table *, void *);
+    // Function producing the full hash of a key
+    hash_key_function key_hash;
+    // Function comparing two keys for equality
+    hash_equal_function key_equal;
+    // Length of each key passed to the hash and equality functions
+    size_t key_length;
     // Pointer to an array of hash nodes (hash table elements)
     hash_node *array;
+    // Collision resolution strategy used by the table
+    hash_table_mode mode;
+    // Control bytes for open addressing. In HASH_SWISS mode holds the low 7 bits of the
+    // hash for a full slot, otherwise marks the slot as empty or deleted. In
+    // HASH_ROBIN_HOOD mode holds the slot's distance from its home slot plus one, 0 if empty
+    unsigned char *control;
+    // Pointer to the flat array of slots used for open addressing. In HASH_CUCKOO mode
+    // each run of HASH_BUCKET_SLOTS slots forms a bucket aligned to a cache line
+    hash_slot *slots;
+    // Number of slots holding a deleted marker in open addressing mode
+    int num_deleted;
+    // Array being migrated from during an incremental resize, NULL otherwise
+    hash_node *old_array;
+    // Size of the array being migrated from
+    int old_table_size;
+    // Next position of the old array to migrate
+    int rehash_index;
+    // Number of old positions migrated per operation, 0 migrates everything within resize()
+    int rehash_step;
+    // Number of workers a resize splits its positions between, 1 to resize in the calling thread
+    int resize_threads;
+    // List of slabs chained nodes are allocated from, most recent first
+    hash_node_slab *slabs;
+    // Number of nodes handed out from the most recent slab
+    int slab_used;
+    // List of released nodes, linked through their next pointers
+    hash_node *free_nodes;
+    // Up to one cache line of elements of a cuckoo table for which no eviction path
+    // exists while the table is lightly loaded, such as keys with equal hashes
+    hash_slot *stash;
+    // Number of elements in the stash
+    int num_stashed;
+    // Membership filter checked before each lookup, NULL if none is attached
+    void *filter;
+    // Operations on the filter
+    const hash_filter_ops *filter_ops;
+    // Entries of a HASH_INLINE table, entry_size bytes per slot, each holding key_length
+    // bytes of key followed by value_size bytes of value
+    unsigned char *entries;
+    // Number of bytes in each inline value
+    size_t value_size;
+    // Number of bytes in each inline entry, rounded up to keep keys 8 byte aligned
+    size_t entry_size;
+    // Counters reported by hash_table_stats(), only updated when hash_table.c is built
+    // with HASH_TABLE_STATS defined. They are always present, so the layout of the struct
+    // does not depend on the define
+    hash_table_counters counters;
 
 } hash_table;
 
@@ -63,37 +301,206 @@ typedef struct hash_table
 
 /*!
  * @brief Defines the division method for creating an index from a key. Uses
- *        the remainder of the hash key divided by the table size to determine the index.
+ *        the remainder of the key's hash divided by the table size to determine the index.
  * @param hash_key Key to create an index from
  * @return An integer specifying the index into the hash table
  */
 int division(hash_table *table, void *hash_key);
 
 /*!
- * @brief Adds an element to the hash table
+ * @brief Hashes a key stored directly in the key pointer to its own value.
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return The key as an unsigned 64 bit integer
+ */
+uint64_t hash_pointer(const void *key, size_t key_length);
+
+/*!
+ * @brief Hashes a key stored directly in the key pointer using a Fibonacci
+ *        (golden ratio) multiplier, spreading sequential integers across the table.
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return A 64 bit hash of the key
+ */
+uint64_t hash_fibonacci(const void *key, size_t key_length);
+
+/*!
+ * @brief Hashes the bytes a key points to using a wyhash style multiply-mix.
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key, or HASH_KEY_STRING for a NUL terminated string
+ * @return A 64 bit hash of the key
+ */
+uint64_t hash_bytes(const void *key, size_t key_length);
+
+/*!
+ * @brief Finalizes a 64 bit hash so that every output bit depends on every input bit.
+ *        Used to derive independent positions from hashes which may be poorly mixed.
+ * @param hash Hash to mix
+ * @return The mixed hash
+ */
+uint64_t hash_mix(uint64_t hash);
+
+/*!
+ * @brief Compares two keys stored directly in the key pointer.
+ * @param key_a First key
+ * @param key_b Second key
+ * @param key_length Unused
+ * @return True if the keys are equal
+ */
+bool equal_pointer(const void *key_a, const void *key_b, size_t key_length);
+
+/*!
+ * @brief Compares the bytes two keys point to.
+ * @param key_a First key
+ * @param key_b Second key
+ * @param key_length Number of bytes in the key, or HASH_KEY_STRING for NUL terminated strings
+ * @return True if the keys are equal
+ */
+bool equal_bytes(const void *key_a, const void *key_b, size_t key_length);
+
+/*!
+ * @brief Adds an element to the hash table. In HASH_CHAINING mode every put is stored
+ *        as an element of its own, so get finds the first value put for a key and each
+ *        remove_hash removes one element. The open addressing modes replace the value of
+ *        a key already present. In HASH_MULTIMAP mode the value is appended to those
+ *        already stored for the key. In HASH_INLINE mode the key and value point to the
+ *        bytes to copy into the table, and a NULL value stores zero bytes.
  * @param table Pointer to a hash table
  * @param hash_key Key to create an index from
  * @param hash_value Value to place into the hash table
- * @return None
+ * @return True if the element was stored. Only a HASH_CUCKOO table can refuse a key,
+ *         once both of its buckets and the stash hold keys with the same hash
  */
-void put(hash_table *table, void *hash_key, void *hash_value);
+bool put(hash_table *table, void *hash_key, void *hash_value);
 
 /*!
  * @brief Returns the element associated with a key
  * @param table Pointer to a hash table
  * @param hash_key Key associated with the element
- * @return The value associated with the specified key
+ * @return The value associated with the specified key. In HASH_MULTIMAP mode the first
+ *         value stored for the key. In HASH_INLINE mode a pointer to the value's bytes
+ *         within the table, valid until the next put or remove_hash
  */
 void *get(hash_table *table, void *hash_key);
 
 /*!
- * @brief Removes a key value pair from the hash table
+ * @brief Removes a key value pair from the hash table. In HASH_MULTIMAP mode every value
+ *        stored for the key is removed.
  * @param table Pointer to a hash table
  * @param hash_key Key to create an index from
  * @return None
  */
 void remove_hash(hash_table *table, void *hash_key);
 
+/*!
+ * @brief Adds a value to those stored for a key in a HASH_MULTIMAP table, keeping any
+ *        values already stored. The key's array of values doubles in size when full.
+ * @param table Pointer to a hash table in HASH_MULTIMAP mode
+ * @param hash_key Key to add the value for
+ * @param hash_value Value to add
+ * @return None
+ */
+void append(hash_table *table, void *hash_key, void *hash_value);
+
+/*!
+ * @brief Returns every value stored for a key in a HASH_MULTIMAP table, in the order they
+ *        were added. The values are contiguous and remain valid until the key is next
+ *        modified by put, append, remove_value or remove_hash.
+ * @param table Pointer to a hash table in HASH_MULTIMAP mode
+ * @param hash_key Key associated with the values
+ * @param count Receives the number of values, 0 if the key is not present
+ * @return Pointer to the first value, or NULL if the key is not present
+ */
+void **get_all(hash_table *table, void *hash_key, int *count);
+
+/*!
+ * @brief Removes the first occurrence of a value stored for a key in a HASH_MULTIMAP
+ *        table, keeping the remaining values in order. The key is removed along with
+ *        its last value.
+ * @param table Pointer to a hash table in HASH_MULTIMAP mode
+ * @param hash_key Key associated with the value
+ * @param hash_value Value to remove, compared by pointer, or by its bytes in HASH_INLINE mode
+ * @return True if the value was found and removed
+ */
+bool remove_value(hash_table *table, void *hash_key, void *hash_value);
+
+/*!
+ * @brief Returns the elements associated with a batch of keys. Keys are hashed and their
+ *        table positions prefetched a window at a time before any are resolved, so the
+ *        memory loads for different keys overlap instead of running one after another.
+ * @param table Pointer to a hash table
+ * @param keys Array of keys to look up
+ * @param n Number of keys
+ * @param out_values Array receiving the value for each key, NULL for keys not present
+ * @return None
+ */
+void get_many(hash_table *table, void **keys, int n, void **out_values);
+
+/*!
+ * @brief Adds a batch of elements to the hash table, hashing and prefetching a window
+ *        of keys before inserting them.
+ * @param table Pointer to a hash table
+ * @param keys Array of keys to add
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @return None
+ */
+void put_many(hash_table *table, void **keys, void **values, int n);
+
+/*!
+ * @brief Aggregates a batch of rows into the groups held by the table, keyed by each
+ *        row's key. Keys are hashed and prefetched a window at a time, and each row finds
+ *        or adds its group in one probe and updates the group's value in place, rather
+ *        than calling get and then put. HASH_CUCKOO tables look a group up before adding
+ *        it, as placing a key may move others. A group's value is a 64 bit integer held in its value pointer and
+ *        read back with get() cast through intptr_t. In HASH_INLINE mode values must be
+ *        8 bytes and hold the integer, and in HASH_MULTIMAP mode it is the key's first
+ *        value. A new group starts from its first row's delta, or 1 when counting.
+ * @param table Pointer to a hash table
+ * @param keys Array of the key of each row
+ * @param deltas Array of the value of each row, or NULL to give every row the value 1
+ * @param n Number of rows
+ * @param op Operation combining each row with its group's value
+ * @return None
+ */
+void aggregate_batch(hash_table *table, void **keys, const int64_t *deltas, int n, hash_aggregate_op op);
+
+/*!
+ * @brief Aggregates a batch of rows as aggregate_batch() does using several workers. Rows
+ *        are split by the partition of table positions their key hashes to, so each
+ *        group belongs to one worker, which aggregates its rows into a private table. The
+ *        groups of each private table are then combined into the table. Workers run in
+ *        parallel when built with HASH_TABLE_THREADS defined and linked with -pthread,
+ *        otherwise one after another. Batches too small to split are aggregated directly.
+ * @param table Pointer to a hash table
+ * @param keys Array of the key of each row
+ * @param deltas Array of the value of each row, or NULL to give every row the value 1
+ * @param n Number of rows
+ * @param op Operation combining each row with its group's value
+ * @param threads Number of workers to use
+ * @return None
+ */
+void aggregate_batch_partitioned(hash_table *table, void **keys, const int64_t *deltas, int n, hash_aggregate_op op,
+                                 int threads);
+
+/*!
+ * @brief Adds a large batch of elements using several workers. The table is first grown
+ *        to hold every element, then the keys are split by the range of table positions
+ *        they hash to, and each range is filled by its own worker, so workers never touch
+ *        the same position. The result is the same as calling put for each element in
+ *        order. Workers run in parallel when built with HASH_TABLE_THREADS defined and
+ *        linked with -pthread, otherwise one after another. HASH_SWISS and HASH_INLINE
+ *        tables which already hold elements are rebuilt with them, and HASH_ROBIN_HOOD
+ *        and HASH_CUCKOO tables are filled with put_many.
+ * @param table Pointer to a hash table
+ * @param keys Array of keys to add
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @param threads Number of workers to use
+ * @return None
+ */
+void hash_table_bulk_load(hash_table *table, void **keys, void **values, int n, int threads);
+
 /*!
  * @brief Returns the percent of the hash table occupied
  * @param table Pointer to a hash table
@@ -119,6 +526,49 @@ static void hash_function_select(hash_table *table, int function_select);
  */
 void initialize_hash_table(hash_table *table, int size, float load_factor, int function_select);
 
+/*!
+ * @brief Initializes the hash table with a specified collision resolution strategy.
+ *        In HASH_SWISS mode the size is rounded up to a power of two of at least
+ *        HASH_GROUP_WIDTH, and the load factor is capped at 0.875. HASH_ROBIN_HOOD and
+ *        HASH_CUCKOO modes round the size the same way and cap the load factor at 0.95.
+ *        HASH_INLINE tables are initialized with initialize_hash_table_inline() instead.
+ * @param table Pointer to a hash table
+ * @param size Number of elements in the hash table
+ * @param load_factor Percentage of table full at which to dynamically resize
+ * @param function_select Integer specifying which hash function to use
+ * @param mode Collision resolution strategy to use
+ * @return None
+ */
+void initialize_hash_table_mode(hash_table *table, int size, float load_factor, int function_select, hash_table_mode mode);
+
+/*!
+ * @brief Initializes the hash table with user defined key hashing and equality.
+ * @param table Pointer to a hash table
+ * @param size Number of elements in the hash table
+ * @param load_factor Percentage of table full at which to dynamically resize
+ * @param mode Collision resolution strategy to use
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return None
+ */
+void initialize_hash_table_keys(hash_table *table, int size, float load_factor, hash_table_mode mode,
+                                size_t key_length, hash_key_function key_hash, hash_equal_function key_equal);
+
+/*!
+ * @brief Initializes a HASH_INLINE hash table, which copies fixed size keys and values
+ *        into its entries rather than storing pointers to them. Keys are hashed and
+ *        compared by their bytes, with 4 and 8 byte keys compared as integers. The size
+ *        and load factor are treated as in HASH_SWISS mode.
+ * @param table Pointer to a hash table
+ * @param size Number of elements in the hash table
+ * @param load_factor Percentage of table full at which to dynamically resize
+ * @param key_size Number of bytes in each key
+ * @param value_size Number of bytes in each value, 0 to store keys only
+ * @return None
+ */
+void initialize_hash_table_inline(hash_table *table, int size, float load_factor, size_t key_size, size_t value_size);
+
 /*!
  * @brief Resizes the hash table when the load factor is exceeded
  * @param table Pointer to a hash table
@@ -127,13 +577,138 @@ void initialize_hash_table(hash_table *table, int size, float load_factor, int f
 void resize(hash_table *table);
 
 /*!
- * @brief Adds an element to the hash table
+ * @brief Enables or disables incremental resizing. When enabled, resize() only allocates
+ *        the larger array, and each following put, get and remove_hash migrates a bounded
+ *        number of positions from the old array, capping the latency of any single operation.
+ *        Applies to HASH_CHAINING and HASH_MULTIMAP modes.
+ * @param table Pointer to a hash table
+ * @param positions_per_step Number of old positions migrated per operation, or 0 to
+ *                           migrate every element within resize()
+ * @return None
+ */
+void set_incremental_resize(hash_table *table, int positions_per_step);
+
+/*!
+ * @brief Sets the number of workers each resize uses. A chaining resize splits the old
+ *        positions into ranges migrated by separate workers, and HASH_SWISS and HASH_INLINE
+ *        tables rebuild into the larger array as hash_table_bulk_load() does. Incremental
+ *        resizing and the other modes always resize in the calling thread. Workers only
+ *        run in parallel when built with HASH_TABLE_THREADS defined.
+ * @param table Pointer to a hash table
+ * @param threads Number of workers, 1 to resize in the calling thread
+ * @return None
+ */
+void set_resize_threads(hash_table *table, int threads);
+
+/*!
+ * @brief Attaches a membership filter which put and remove_hash keep up to date, so that
+ *        get, get_many and get_all return at once for most keys which are not present.
+ *        Keys already in the table are added to the filter. The filter is not freed by
+ *        free_hash_table, and should be sized for the most keys the table will hold.
+ *        A filter pays off when a miss costs more than the filter's own cache miss, as
+ *        in chained modes or with costly key comparisons, and slows the open addressing
+ *        modes on integer keys, whose misses usually read a single group.
+ * @param table Pointer to a hash table
+ * @param filter Pointer to an empty filter, or NULL to detach the current filter
+ * @param ops Operations on the filter, such as bloom_filter_ops or cuckoo_filter_ops
+ * @return None
+ */
+void set_hash_table_filter(hash_table *table, void *filter, const hash_filter_ops *ops);
+
+/*!
+ * @brief Returns if an incremental resize is in progress.
+ * @param table Pointer to a hash table
+ * @return True if elements remain in the old array
+ */
+bool is_rehashing(hash_table *table);
+
+/*!
+ * @brief Returns how far an incremental resize has progressed.
+ * @param table Pointer to a hash table
+ * @return A float representing the percentage of old positions which have been migrated,
+ *         100 if no resize is in progress
+ */
+float rehash_progress(hash_table *table);
+
+/*!
+ * @brief Migrates old positions of an incremental resize outside of put, get and
+ *        remove_hash, for example from an idle loop.
+ * @param table Pointer to a hash table
+ * @param positions Maximum number of old positions to migrate
+ * @return None
+ */
+void rehash_positions(hash_table *table, int positions);
+
+/*!
+ * @brief Measures how far elements are stored from where a lookup starts. For open
+ *        addressing this is the number of slots between an element and its home slot,
+ *        for cuckoo hashing 1 if the element is in its second bucket and 0 otherwise, and
+ *        for chaining the number of nodes before it in its chain.
+ * @param table Pointer to a hash table
+ * @param mean Receives the average probe length over all elements, 0 if the table is empty
+ * @param longest Receives the longest probe length of any element
+ * @return None
+ */
+void probe_length_stats(hash_table *table, float *mean, int *longest);
+
+/*!
+ * @brief Reports the probe length histogram, memory use and, when built with
+ *        HASH_TABLE_STATS defined, resize and lookup counters of a hash table.
+ *        Probe lengths are measured by scanning the table, in time proportional to its size.
+ * @param table Pointer to a hash table
+ * @param stats Pointer to the statistics to fill
+ * @return None
+ */
+void hash_table_stats(hash_table *table, hash_table_statistics *stats);
+
+/*!
+ * @brief Calls a function on every key value pair stored in the hash table. In
+ *        HASH_MULTIMAP mode a key is visited once for each of its values, and in
+ *        HASH_INLINE mode the key and value are pointers to their bytes. The table
+ *        must not be modified until the call returns.
+ * @param table Pointer to a hash table
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return None
+ */
+void hash_table_for_each(hash_table *table, void (*visit)(void *key, void *value, void *context), void *context);
+
+/*!
+ * @brief Visits the next batch of elements of an incremental scan, allowing the table to
+ *        be modified between calls. Start with a cursor of 0 and pass the returned cursor
+ *        to the next call until 0 is returned. In every mode but HASH_CUCKOO, every element
+ *        present for the whole scan is visited exactly once even if the table grows,
+ *        including during an incremental resize, and elements added or removed during the
+ *        scan may or may not be visited. A put in HASH_CUCKOO mode may move elements between
+ *        their two buckets, so there the same holds only while no put is made between calls.
+ *        HASH_MULTIMAP mode scans as chaining does, visiting a key once for each of its
+ *        values. The table must not be modified by the visit function.
+ * @param table Pointer to a hash table
+ * @param cursor 0 to start a scan, otherwise the cursor returned by the previous call
+ * @param count Number of elements after which the batch ends. Elements sharing a home
+ *              position, or a home group in HASH_SWISS and HASH_INLINE modes, are always
+ *              visited together, so a batch may be larger
+ * @param visit Function called with each key, its value and the context pointer
+ * @param context Pointer passed through to the visit function
+ * @return Cursor for the next call, or 0 once the scan is complete
+ */
+uint64_t hash_table_scan(hash_table *table, uint64_t cursor, int count,
+                         void (*visit)(void *key, void *value, void *context), void *context);
+
+/*!
+ * @brief Adds an element to the hash table. In HASH_CHAINING mode every put is stored
+ *        as an element of its own, so get finds the first value put for a key and each
+ *        remove_hash removes one element. The open addressing modes replace the value of
+ *        a key already present. In HASH_MULTIMAP mode the value is appended to those
+ *        already stored for the key. In HASH_INLINE mode the key and value point to the
+ *        bytes to copy into the table, and a NULL value stores zero bytes.
  * @param table Pointer to a hash table
  * @param hash_key Key to create an index from
  * @param hash_value Value to place into the hash table
- * @return None
+ * @return True if the element was stored. Only a HASH_CUCKOO table can refuse a key,
+ *         once both of its buckets and the stash hold keys with the same hash
  */
-void put(hash_table *table, void *hash_key, void *hash_value);
+bool put(hash_table *table, void *hash_key, void *hash_value);
 
 /*!
  * @brief Frees the memory held by the hash table.
@@ -290,6 +290,109 @@ void *remove_dl_node(doubly_linked_list *list, void *removal_value)
 	} while (search_node != NULL);
 }
 
+/*!
+ * @brief Links a new node in front of the head of the doubly linked list and returns it.
+ *        The node holds its value until it is unlinked, so it can be used as a handle
+ *        for move_dl_node_to_head() and unlink_dl_node(). Handles should not be mixed
+ *        with add_dl_node_to_head() or remove_dl_node(), which move values between nodes.
+ * @param list Pointer to a doubly linked list struct.
+ * @param insert_value Value to insert at the head of the list.
+ * @return Pointer to the node holding the value.
+ */
+doubly_linked_list_node *push_dl_node_to_head(doubly_linked_list *list, void *insert_value)
+{
+	doubly_linked_list_node *new_node = (doubly_linked_list_node *)malloc(sizeof(doubly_linked_list_node));
+
+	new_node->value = insert_value;
+	new_node->previous = NULL;
+	new_node->next = list->head;
+
+	// The new node becomes the head, and also the tail of an empty list
+	if (list->head != NULL)
+	{
+		(list->head)->previous = new_node;
+	}
+	else
+	{
+		list->tail = new_node;
+	}
+
+	list->head = new_node;
+	list->list_size++;
+
+	return new_node;
+}
+
+/*!
+ * @brief Detaches a node from its neighbours, updating the head and tail pointers.
+ * @param list Pointer to a doubly linked list struct.
+ * @param node Node of the list to detach.
+ * @return None
+ */
+static void detach_dl_node(doubly_linked_list *list, doubly_linked_list_node *node)
+{
+	if (node->previous != NULL)
+	{
+		(node->previous)->next = node->next;
+	}
+	else
+	{
+		list->head = node->next;
+	}
+
+	if (node->next != NULL)
+	{
+		(node->next)->previous = node->previous;
+	}
+	else
+	{
+		list->tail = node->previous;
+	}
+}
+
+/*!
+ * @brief Moves a node of the doubly linked list to the head in constant time.
+ * @param list Pointer to a doubly linked list struct.
+ * @param node Node of the list returned by push_dl_node_to_head().
+ * @return None
+ */
+void move_dl_node_to_head(doubly_linked_list *list, doubly_linked_list_node *node)
+{
+	// Nothing to do if the node is already at the head
+	if (node == list->head)
+	{
+		return;
+	}
+
+	detach_dl_node(list, node);
+
+	// Relink the node in front of the current head
+	node->previous = NULL;
+	node->next = list->head;
+	(list->head)->previous = node;
+	list->head = node;
+}
+
+/*!
+ * @brief Removes a node from the doubly linked list in constant time and frees it.
+ * @param list Pointer to a doubly linked list struct.
+ * @param node Node of the list returned by push_dl_node_to_head().
+ * @return The value held by the removed node.
+ */
+void *unlink_dl_node(doubly_linked_list *list, doubly_linked_list_node *node)
+{
+	void *removed_element = node->value;
+
+	detach_dl_node(list, node);
+
+	// Free memory held by removed node
+	free(node);
+
+	list->list_size--;
+
+	return removed_element;
+}
+
 /*!
  * @brief Frees the memory held by a doubly linked list struct
  * @param list Pointer to a doubly linked list struct
@@ -113,6 +113,33 @@ void insert_dl_node(doubly_linked_list *list, int insert_value, void *insert_aft
  */
 void *remove_dl_node(doubly_linked_list *list, void *removal_value);
 
+/*!
+ * @brief Links a new node in front of the head of the doubly linked list and returns it.
+ *        The node holds its value until it is unlinked, so it can be used as a handle
+ *        for move_dl_node_to_head() and unlink_dl_node(). Handles should not be mixed
+ *        with add_dl_node_to_head() or remove_dl_node(), which move values between nodes.
+ * @param list Pointer to a doubly linked list struct.
+ * @param insert_value Value to insert at the head of the list.
+ * @return Pointer to the node holding the value.
+ */
+doubly_linked_list_node *push_dl_node_to_head(doubly_linked_list *list, void *insert_value);
+
+/*!
+ * @brief Moves a node of the doubly linked list to the head in constant time.
+ * @param list Pointer to a doubly linked list struct.
+ * @param node Node of the list returned by push_dl_node_to_head().
+ * @return None
+ */
+void move_dl_node_to_head(doubly_linked_list *list, doubly_linked_list_node *node);
+
+/*!
+ * @brief Removes a node from the doubly linked list in constant time and frees it.
+ * @param list Pointer to a doubly linked list struct.
+ * @param node Node of the list returned by push_dl_node_to_head().
+ * @return The value held by the removed node.
+ */
+void *unlink_dl_node(doubly_linked_list *list, doubly_linked_list_node *node);
+
 /*!
  * @brief Prints the contents of the doubly linked list to the terminal
  * @param list Pointer to a doubly linked list struct.
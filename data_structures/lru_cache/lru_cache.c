@@ -0,0 +1,315 @@
+/**
+ ********************************************************************************
+ * @file    lru_cache.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a least recently used cache.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "lru_cache.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Load factor of the table mapping keys to list nodes
+#define LRU_LOAD_FACTOR 0.875
+// Table size used when the number of entries is not limited
+#define LRU_INIT_TABLE_SIZE 16
+// Largest initial table size, beyond which the table grows as entries are added
+#define LRU_MAX_INIT_TABLE_SIZE (1 << 20)
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Returns the initial size of the table mapping keys to list nodes.
+ * @param max_entries Largest number of entries the cache holds, 0 for no limit
+ * @return Initial table size
+ */
+static int initial_table_size(size_t max_entries)
+{
+    if (max_entries == 0)
+    {
+        return LRU_INIT_TABLE_SIZE;
+    }
+
+    return (max_entries > LRU_MAX_INIT_TABLE_SIZE) ? LRU_MAX_INIT_TABLE_SIZE : (int)max_entries;
+}
+
+/*!
+ * @brief Sets the fields shared by both initializers.
+ * @param cache Pointer to a cache
+ * @param max_entries Largest number of entries to hold, 0 for no limit
+ * @param max_bytes Largest total size of the entries to hold, 0 for no limit
+ * @return None
+ */
+static void initialize_fields(lru_cache *cache, size_t max_entries, size_t max_bytes)
+{
+    initialize_dl_list(&cache->list);
+
+    cache->max_entries = max_entries;
+    cache->max_bytes = max_bytes;
+    cache->used_bytes = 0;
+    cache->on_evict = NULL;
+    cache->evict_context = NULL;
+
+    memset(&cache->counters, 0, sizeof(lru_cache_counters));
+}
+
+/*!
+ * @brief Returns if the cache holds more than its capacity allows.
+ * @param cache Pointer to a cache
+ * @return True if an entry must be evicted
+ */
+static bool over_capacity(lru_cache *cache)
+{
+    if (cache->max_entries != 0 && (size_t)cache->list.list_size > cache->max_entries)
+    {
+        return true;
+    }
+
+    return cache->max_bytes != 0 && cache->used_bytes > cache->max_bytes;
+}
+
+/*!
+ * @brief Removes the entry held by a list node from the table and the list.
+ * @param cache Pointer to a cache
+ * @param node Node of the use list holding the entry
+ * @return The removed entry, which the caller frees
+ */
+static lru_entry *detach_entry(lru_cache *cache, doubly_linked_list_node *node)
+{
+    lru_entry *entry = (lru_entry *)unlink_dl_node(&cache->list, node);
+
+    remove_hash(&cache->table, entry->key);
+    cache->used_bytes -= entry->size;
+
+    return entry;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes the cache
+ * @param cache Pointer to a cache
+ * @param max_entries Largest number of entries to hold, 0 for no limit
+ * @param max_bytes Largest total size of the entries to hold, 0 for no limit
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @return None
+ */
+void initialize_lru_cache(lru_cache *cache, size_t max_entries, size_t max_bytes, int function_select)
+{
+    initialize_hash_table_mode(&cache->table, initial_table_size(max_entries), LRU_LOAD_FACTOR,
+                               function_select, HASH_SWISS);
+    initialize_fields(cache, max_entries, max_bytes);
+}
+
+/*!
+ * @brief Initializes the cache with user defined key hashing and equality.
+ * @param cache Pointer to a cache
+ * @param max_entries Largest number of entries to hold, 0 for no limit
+ * @param max_bytes Largest total size of the entries to hold, 0 for no limit
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return None
+ */
+void initialize_lru_cache_keys(lru_cache *cache, size_t max_entries, size_t max_bytes, size_t key_length,
+                               hash_key_function key_hash, hash_equal_function key_equal)
+{
+    initialize_hash_table_keys(&cache->table, initial_table_size(max_entries), LRU_LOAD_FACTOR, HASH_SWISS,
+                               key_length, key_hash, key_equal);
+    initialize_fields(cache, max_entries, max_bytes);
+}
+
+/*!
+ * @brief Sets the function called with each entry the cache evicts.
+ * @param cache Pointer to a cache
+ * @param on_evict Function called with each evicted entry, or NULL
+ * @param context Pointer passed through to the function
+ * @return None
+ */
+void set_lru_eviction_callback(lru_cache *cache, lru_evict_function on_evict, void *context)
+{
+    cache->on_evict = on_evict;
+    cache->evict_context = context;
+}
+
+/*!
+ * @brief Returns the value of a key and marks it most recently used.
+ * @param cache Pointer to a cache
+ * @param key Key to look up
+ * @return The value of the key, or NULL if the key is not cached
+ */
+void *lru_get(lru_cache *cache, void *key)
+{
+    doubly_linked_list_node *node = (doubly_linked_list_node *)get(&cache->table, key);
+
+    if (node == NULL)
+    {
+        cache->counters.misses++;
+        return NULL;
+    }
+
+    cache->counters.hits++;
+    move_dl_node_to_head(&cache->list, node);
+
+    return ((lru_entry *)node->value)->value;
+}
+
+/*!
+ * @brief Marks a key most recently used without counting a hit or miss.
+ * @param cache Pointer to a cache
+ * @param key Key to touch
+ * @return True if the key is cached
+ */
+bool lru_touch(lru_cache *cache, void *key)
+{
+    doubly_linked_list_node *node = (doubly_linked_list_node *)get(&cache->table, key);
+
+    if (node == NULL)
+    {
+        return false;
+    }
+
+    move_dl_node_to_head(&cache->list, node);
+
+    return true;
+}
+
+/*!
+ * @brief Adds or replaces an entry and marks it most recently used, then evicts the
+ *        least recently used entries until the cache is within its capacity. The new
+ *        entry itself is never evicted by the call which adds it.
+ * @param cache Pointer to a cache
+ * @param key Key of the entry
+ * @param value Value of the entry
+ * @param size Number of bytes charged against the byte capacity
+ * @return The value the key replaced, which is not passed to the eviction function,
+ *         or NULL if the key was not cached
+ */
+void *lru_put(lru_cache *cache, void *key, void *value, size_t size)
+{
+    doubly_linked_list_node *node = (doubly_linked_list_node *)get(&cache->table, key);
+    void *replaced = NULL;
+
+    if (node != NULL)
+    {
+        lru_entry *entry = (lru_entry *)node->value;
+
+        // Replace the value in place and recharge the entry's size
+        replaced = entry->value;
+        entry->value = value;
+        cache->used_bytes += size - entry->size;
+        entry->size = size;
+
+        move_dl_node_to_head(&cache->list, node);
+    }
+    else
+    {
+        lru_entry *entry = (lru_entry *)malloc(sizeof(lru_entry));
+
+        entry->key = key;
+        entry->value = value;
+        entry->size = size;
+
+        // The table holds the node, so the entry is reached without searching the list
+        node = push_dl_node_to_head(&cache->list, entry);
+        put(&cache->table, key, node);
+        cache->used_bytes += size;
+    }
+
+    // Evict from the tail, stopping short of the entry just added
+    while (over_capacity(cache) && cache->list.tail != node)
+    {
+        lru_evict(cache);
+    }
+
+    return replaced;
+}
+
+/*!
+ * @brief Removes an entry without calling the eviction function.
+ * @param cache Pointer to a cache
+ * @param key Key of the entry to remove
+ * @return The value of the removed entry, or NULL if the key was not cached
+ */
+void *lru_remove(lru_cache *cache, void *key)
+{
+    doubly_linked_list_node *node = (doubly_linked_list_node *)get(&cache->table, key);
+
+    if (node == NULL)
+    {
+        return NULL;
+    }
+
+    lru_entry *entry = detach_entry(cache, node);
+    void *value = entry->value;
+
+    free(entry);
+
+    return value;
+}
+
+/*!
+ * @brief Evicts the least recently used entry, calling the eviction function.
+ * @param cache Pointer to a cache
+ * @return True if an entry was evicted, false if the cache was empty
+ */
+bool lru_evict(lru_cache *cache)
+{
+    if (cache->list.tail == NULL)
+    {
+        return false;
+    }
+
+    lru_entry *entry = detach_entry(cache, cache->list.tail);
+
+    cache->counters.evictions++;
+
+    // The entry is out of the table before the callback runs, so the callback may free the key
+    if (cache->on_evict != NULL)
+    {
+        (cache->on_evict)(entry->key, entry->value, cache->evict_context);
+    }
+
+    free(entry);
+
+    return true;
+}
+
+/*!
+ * @brief Returns the number of entries in the cache.
+ * @param cache Pointer to a cache
+ * @return Number of entries
+ */
+int lru_num_elements(lru_cache *cache)
+{
+    return cache->list.list_size;
+}
+
+/*!
+ * @brief Frees the memory held by the cache. The eviction function is not called
+ *        for the entries still held.
+ * @param cache Pointer to a cache
+ * @return None
+ */
+void free_lru_cache(lru_cache *cache)
+{
+    while (cache->list.head != NULL)
+    {
+        free(unlink_dl_node(&cache->list, cache->list.head));
+    }
+
+    free_hash_table(&cache->table);
+    cache->used_bytes = 0;
+}
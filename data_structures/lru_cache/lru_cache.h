@@ -0,0 +1,179 @@
+/**
+ ********************************************************************************
+ * @file    lru_cache.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a least recently used cache.
+ *          A hash table maps each key to its node in a doubly linked list kept
+ *          in order of use, so lookups, updates and evictions take constant time.
+ ********************************************************************************
+ */
+
+#ifndef LRU_CACHE_H
+#define LRU_CACHE_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+#include "../linked_lists/doubly_linked_list/doubly_linked_list.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Function called with each entry the cache evicts to stay within its capacity.
+ * @param key Key of the evicted entry
+ * @param value Value of the evicted entry
+ * @param context Pointer given to set_lru_eviction_callback()
+ * @return None
+ */
+typedef void (*lru_evict_function)(void *key, void *value, void *context);
+
+/*!
+ * @brief Struct representing an entry of the cache, held by a node of the use list.
+ */
+typedef struct lru_entry
+{
+    // Key of the entry
+    void *key;
+    // Value of the entry
+    void *value;
+    // Number of bytes charged against the cache's byte capacity
+    size_t size;
+} lru_entry;
+
+/*!
+ * @brief Struct holding the running counters of a cache.
+ */
+typedef struct lru_cache_counters
+{
+    // Number of calls to lru_get() which found their key
+    unsigned long long hits;
+    // Number of calls to lru_get() which did not find their key
+    unsigned long long misses;
+    // Number of entries evicted to stay within capacity or by lru_evict()
+    unsigned long long evictions;
+} lru_cache_counters;
+
+/*!
+ * @brief Struct which represents a least recently used cache.
+ */
+typedef struct lru_cache
+{
+    // Maps each key to the node of the use list holding its entry
+    hash_table table;
+    // Entries in order of use, most recently used at the head
+    doubly_linked_list list;
+    // Largest number of entries held, 0 for no limit
+    size_t max_entries;
+    // Largest total size of the entries held, 0 for no limit
+    size_t max_bytes;
+    // Total size of the entries held
+    size_t used_bytes;
+    // Function called with each evicted entry, or NULL
+    lru_evict_function on_evict;
+    // Pointer passed through to the eviction function
+    void *evict_context;
+    // Hit, miss and eviction counts
+    lru_cache_counters counters;
+} lru_cache;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes the cache
+ * @param cache Pointer to a cache
+ * @param max_entries Largest number of entries to hold, 0 for no limit
+ * @param max_bytes Largest total size of the entries to hold, 0 for no limit
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @return None
+ */
+void initialize_lru_cache(lru_cache *cache, size_t max_entries, size_t max_bytes, int function_select);
+
+/*!
+ * @brief Initializes the cache with user defined key hashing and equality.
+ * @param cache Pointer to a cache
+ * @param max_entries Largest number of entries to hold, 0 for no limit
+ * @param max_bytes Largest total size of the entries to hold, 0 for no limit
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return None
+ */
+void initialize_lru_cache_keys(lru_cache *cache, size_t max_entries, size_t max_bytes, size_t key_length,
+                               hash_key_function key_hash, hash_equal_function key_equal);
+
+/*!
+ * @brief Sets the function called with each entry the cache evicts.
+ * @param cache Pointer to a cache
+ * @param on_evict Function called with each evicted entry, or NULL
+ * @param context Pointer passed through to the function
+ * @return None
+ */
+void set_lru_eviction_callback(lru_cache *cache, lru_evict_function on_evict, void *context);
+
+/*!
+ * @brief Returns the value of a key and marks it most recently used.
+ * @param cache Pointer to a cache
+ * @param key Key to look up
+ * @return The value of the key, or NULL if the key is not cached
+ */
+void *lru_get(lru_cache *cache, void *key);
+
+/*!
+ * @brief Marks a key most recently used without counting a hit or miss.
+ * @param cache Pointer to a cache
+ * @param key Key to touch
+ * @return True if the key is cached
+ */
+bool lru_touch(lru_cache *cache, void *key);
+
+/*!
+ * @brief Adds or replaces an entry and marks it most recently used, then evicts the
+ *        least recently used entries until the cache is within its capacity. The new
+ *        entry itself is never evicted by the call which adds it.
+ * @param cache Pointer to a cache
+ * @param key Key of the entry
+ * @param value Value of the entry
+ * @param size Number of bytes charged against the byte capacity
+ * @return The value the key replaced, which is not passed to the eviction function,
+ *         or NULL if the key was not cached
+ */
+void *lru_put(lru_cache *cache, void *key, void *value, size_t size);
+
+/*!
+ * @brief Removes an entry without calling the eviction function.
+ * @param cache Pointer to a cache
+ * @param key Key of the entry to remove
+ * @return The value of the removed entry, or NULL if the key was not cached
+ */
+void *lru_remove(lru_cache *cache, void *key);
+
+/*!
+ * @brief Evicts the least recently used entry, calling the eviction function.
+ * @param cache Pointer to a cache
+ * @return True if an entry was evicted, false if the cache was empty
+ */
+bool lru_evict(lru_cache *cache);
+
+/*!
+ * @brief Returns the number of entries in the cache.
+ * @param cache Pointer to a cache
+ * @return Number of entries
+ */
+int lru_num_elements(lru_cache *cache);
+
+/*!
+ * @brief Frees the memory held by the cache. The eviction function is not called
+ *        for the entries still held.
+ * @param cache Pointer to a cache
+ * @return None
+ */
+void free_lru_cache(lru_cache *cache);
+
+#endif // LRU_CACHE_H
@@ -0,0 +1,575 @@
+/**
+ ********************************************************************************
+ * @file    mapped_hash_table.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a hash table stored in a memory mapped file.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "mapped_hash_table.h"
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Smallest number of slots in a table
+#define MAPPED_MIN_CAPACITY 16
+// Entries and slot arrays start on multiples of this many bytes
+#define MAPPED_ALIGNMENT 8
+// Fraction of slots, in quarters, which may be full before the slot array grows
+#define MAPPED_LOAD_QUARTERS 3
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Returns the header at the start of the mapping.
+ * @param table Pointer to a mapped hash table
+ * @return Pointer to the header
+ */
+static mapped_header *header_of(mapped_hash_table *table)
+{
+    return (mapped_header *)table->base;
+}
+
+/*!
+ * @brief Returns the slot array.
+ * @param table Pointer to a mapped hash table
+ * @return Pointer to the first slot
+ */
+static mapped_slot *slots_of(mapped_hash_table *table)
+{
+    return (mapped_slot *)(table->base + header_of(table)->slots_offset);
+}
+
+/*!
+ * @brief Returns the lengths at the start of an entry.
+ * @param table Pointer to a mapped hash table
+ * @param entry Offset of the entry
+ * @return Pointer to the key length, which is followed by the value length
+ */
+static uint32_t *entry_lengths(mapped_hash_table *table, uint64_t entry)
+{
+    return (uint32_t *)(table->base + entry);
+}
+
+/*!
+ * @brief Returns the key bytes of an entry.
+ * @param table Pointer to a mapped hash table
+ * @param entry Offset of the entry
+ * @return Pointer to the key
+ */
+static unsigned char *entry_key(mapped_hash_table *table, uint64_t entry)
+{
+    return table->base + entry + 2 * sizeof(uint32_t);
+}
+
+/*!
+ * @brief Rounds a size up to a multiple of MAPPED_ALIGNMENT.
+ * @param size Size in bytes
+ * @return The rounded size
+ */
+static uint64_t align_size(uint64_t size)
+{
+    return (size + MAPPED_ALIGNMENT - 1) & ~(uint64_t)(MAPPED_ALIGNMENT - 1);
+}
+
+/*!
+ * @brief Returns the offset of the value within an entry. The key is padded so that
+ *        values start on an aligned address and can be read in place.
+ * @param key_length Number of bytes in the key
+ * @return Offset of the value from the start of the entry
+ */
+static uint64_t value_offset(uint64_t key_length)
+{
+    return align_size(2 * sizeof(uint32_t) + key_length);
+}
+
+/*!
+ * @brief Returns the number of arena bytes taken by an entry.
+ * @param table Pointer to a mapped hash table
+ * @param entry Offset of the entry
+ * @return Size of the entry, including padding
+ */
+static uint64_t entry_size(mapped_hash_table *table, uint64_t entry)
+{
+    return align_size(value_offset(entry_lengths(table, entry)[0]) + entry_lengths(table, entry)[1]);
+}
+
+/*!
+ * @brief Maps the whole of the open file.
+ * @param table Pointer to a mapped hash table with its file descriptor and size set
+ * @return True if the file was mapped
+ */
+static bool map_file(mapped_hash_table *table)
+{
+    int protection = table->writable ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    void *base = mmap(NULL, table->size, protection, MAP_SHARED, table->fd, 0);
+
+    if (base == MAP_FAILED)
+    {
+        table->base = NULL;
+        return false;
+    }
+
+    table->base = (unsigned char *)base;
+
+    return true;
+}
+
+/*!
+ * @brief Makes room for a number of bytes past the end of the arena, doubling the file
+ *        and remapping it if it is too small. Offsets stay valid, pointers do not.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @param bytes Number of bytes needed
+ * @return True if the space is available
+ */
+static bool reserve_arena(mapped_hash_table *table, uint64_t bytes)
+{
+    uint64_t needed = header_of(table)->arena_used + bytes;
+
+    if (needed <= table->size)
+    {
+        return true;
+    }
+
+    size_t new_size = table->size * 2;
+
+    while (new_size < needed)
+    {
+        new_size *= 2;
+    }
+
+    // Changes already in the mapping are kept by the file while it is remapped
+    if (ftruncate(table->fd, (off_t)new_size) != 0)
+    {
+        return false;
+    }
+
+    unsigned char *old_base = table->base;
+    size_t old_size = table->size;
+
+    // The old mapping is only released once the new one is in place, so a failure
+    // leaves the table as it was
+    table->size = new_size;
+
+    if (!map_file(table))
+    {
+        table->base = old_base;
+        table->size = old_size;
+        return false;
+    }
+
+    munmap(old_base, old_size);
+
+    return true;
+}
+
+/*!
+ * @brief Takes space from the end of the arena.
+ * @param table Pointer to a mapped hash table with the space reserved
+ * @param bytes Number of bytes to take
+ * @return Offset of the space
+ */
+static uint64_t arena_take(mapped_hash_table *table, uint64_t bytes)
+{
+    uint64_t offset = header_of(table)->arena_used;
+
+    header_of(table)->arena_used = offset + align_size(bytes);
+
+    return offset;
+}
+
+/*!
+ * @brief Finds the slot holding a key, or the empty slot where it would be added.
+ * @param table Pointer to a mapped hash table
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @param hash Hash of the key
+ * @return Index of the slot
+ */
+static uint64_t find_slot(mapped_hash_table *table, const void *key, size_t key_length, uint64_t hash)
+{
+    mapped_slot *slots = slots_of(table);
+    uint64_t mask = header_of(table)->capacity - 1;
+    uint64_t index = hash & mask;
+
+    // The load factor guarantees an empty slot ends the probe
+    while (slots[index].entry != 0)
+    {
+        uint64_t entry = slots[index].entry;
+
+        // The stored hash rejects most mismatches before the entry's page is touched
+        if (slots[index].hash == hash && entry_lengths(table, entry)[0] == key_length &&
+            memcmp(entry_key(table, entry), key, key_length) == 0)
+        {
+            return index;
+        }
+
+        index = (index + 1) & mask;
+    }
+
+    return index;
+}
+
+/*!
+ * @brief Moves the slots to a new array of double the size in the arena. Only the
+ *        stored hashes are read, so no entry is touched.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @return True if the slots were moved
+ */
+static bool grow_slots(mapped_hash_table *table)
+{
+    uint64_t old_capacity = header_of(table)->capacity;
+    uint64_t new_capacity = old_capacity * 2;
+    uint64_t bytes = new_capacity * sizeof(mapped_slot);
+
+    if (!reserve_arena(table, bytes))
+    {
+        return false;
+    }
+
+    mapped_header *header = header_of(table);
+    uint64_t offset = arena_take(table, bytes);
+    mapped_slot *old_slots = slots_of(table);
+    mapped_slot *new_slots = (mapped_slot *)(table->base + offset);
+    uint64_t mask = new_capacity - 1;
+
+    memset(new_slots, 0, bytes);
+
+    for (uint64_t i = 0; i < old_capacity; i++)
+    {
+        if (old_slots[i].entry != 0)
+        {
+            uint64_t index = old_slots[i].hash & mask;
+
+            while (new_slots[index].entry != 0)
+            {
+                index = (index + 1) & mask;
+            }
+
+            new_slots[index] = old_slots[i];
+        }
+    }
+
+    // The new array is complete before the header refers to it
+    header->garbage_bytes += old_capacity * sizeof(mapped_slot);
+    header->slots_offset = offset;
+    header->capacity = new_capacity;
+
+    return true;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Creates a new mapped hash table file, replacing any existing file, and opens it
+ *        for writing.
+ * @param table Pointer to a mapped hash table
+ * @param path Path of the file
+ * @param capacity Number of elements to size the table for
+ * @return True if the file was created and mapped
+ */
+bool create_mapped_hash_table(mapped_hash_table *table, const char *path, int capacity)
+{
+    uint64_t num_slots = MAPPED_MIN_CAPACITY;
+
+    // Slots are sized so the requested capacity stays under the load factor
+    while (num_slots * MAPPED_LOAD_QUARTERS < (uint64_t)capacity * 4)
+    {
+        num_slots *= 2;
+    }
+
+    uint64_t slots_offset = align_size(sizeof(mapped_header));
+
+    table->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    table->writable = true;
+    table->base = NULL;
+    table->size = (size_t)(slots_offset + num_slots * sizeof(mapped_slot));
+
+    if (table->fd < 0)
+    {
+        return false;
+    }
+
+    // A new file reads as zeros, so every slot starts out empty
+    if (ftruncate(table->fd, (off_t)table->size) != 0 || !map_file(table))
+    {
+        close(table->fd);
+        table->fd = -1;
+        return false;
+    }
+
+    mapped_header *header = header_of(table);
+
+    memcpy(header->magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC));
+    header->version = MAPPED_VERSION;
+    header->capacity = num_slots;
+    header->num_elements = 0;
+    header->slots_offset = slots_offset;
+    header->arena_used = table->size;
+    header->garbage_bytes = 0;
+
+    return true;
+}
+
+/*!
+ * @brief Opens an existing mapped hash table file. No part of the table is read
+ *        beyond its header until it is used.
+ * @param table Pointer to a mapped hash table
+ * @param path Path of the file
+ * @param writable True to allow changes, false to open the file read only
+ * @return True if the file was mapped and holds a table of this version whose slot
+ *         array fits in the file
+ */
+bool open_mapped_hash_table(mapped_hash_table *table, const char *path, bool writable)
+{
+    struct stat status;
+
+    table->fd = open(path, writable ? O_RDWR : O_RDONLY);
+    table->writable = writable;
+    table->base = NULL;
+    table->size = 0;
+
+    if (table->fd < 0)
+    {
+        return false;
+    }
+
+    if (fstat(table->fd, &status) != 0 || (size_t)status.st_size < sizeof(mapped_header))
+    {
+        close(table->fd);
+        table->fd = -1;
+        return false;
+    }
+
+    table->size = (size_t)status.st_size;
+
+    if (!map_file(table))
+    {
+        close(table->fd);
+        table->fd = -1;
+        return false;
+    }
+
+    mapped_header *header = header_of(table);
+
+    uint64_t capacity = header->capacity;
+
+    // Only the header is checked, the rest of the file is faulted in by lookups. The
+    // slot array must be a power of two that lies inside the file, and must keep an
+    // empty slot to end probes.
+    if (memcmp(header->magic, MAPPED_MAGIC, sizeof(MAPPED_MAGIC)) != 0 || header->version != MAPPED_VERSION ||
+        header->arena_used > table->size || capacity == 0 || (capacity & (capacity - 1)) != 0 ||
+        capacity > table->size / sizeof(mapped_slot) || header->slots_offset < sizeof(mapped_header) ||
+        header->slots_offset > table->size - capacity * sizeof(mapped_slot) || header->num_elements >= capacity)
+    {
+        close_mapped_hash_table(table);
+        return false;
+    }
+
+    return true;
+}
+
+/*!
+ * @brief Adds or updates an element, copying the key and value into the file. The
+ *        file grows as needed, which moves the mapping and invalidates pointers
+ *        returned by mapped_get(), so the key and value must not point into it.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @param value Pointer to the value bytes
+ * @param value_length Number of bytes in the value
+ * @return True if the element was stored, false if the table is read only or the
+ *         file could not grow
+ */
+bool mapped_put(mapped_hash_table *table, const void *key, size_t key_length, const void *value,
+                size_t value_length)
+{
+    if (!table->writable || key_length > UINT32_MAX || value_length > UINT32_MAX)
+    {
+        return false;
+    }
+
+    mapped_header *header = header_of(table);
+
+    if ((header->num_elements + 1) * 4 > header->capacity * MAPPED_LOAD_QUARTERS && !grow_slots(table))
+    {
+        return false;
+    }
+
+    uint64_t entry_bytes = value_offset(key_length) + value_length;
+
+    if (!reserve_arena(table, align_size(entry_bytes)))
+    {
+        return false;
+    }
+
+    header = header_of(table);
+
+    uint64_t hash = hash_bytes(key, key_length);
+    uint64_t entry = arena_take(table, entry_bytes);
+
+    entry_lengths(table, entry)[0] = (uint32_t)key_length;
+    entry_lengths(table, entry)[1] = (uint32_t)value_length;
+    memcpy(entry_key(table, entry), key, key_length);
+    memcpy(table->base + entry + value_offset(key_length), value, value_length);
+
+    uint64_t index = find_slot(table, key, key_length, hash);
+    mapped_slot *slot = &(slots_of(table)[index]);
+
+    if (slot->entry != 0)
+    {
+        // The replaced entry is left in place, and the slot switches to the new one
+        header->garbage_bytes += entry_size(table, slot->entry);
+        slot->entry = entry;
+        return true;
+    }
+
+    // The hash is written before the entry offset which makes the slot full
+    slot->hash = hash;
+    slot->entry = entry;
+    header->num_elements++;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the value associated with a key.
+ * @param table Pointer to a mapped hash table
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @param value_length Receives the number of bytes in the value, may be NULL
+ * @return Pointer to the 8 byte aligned value bytes within the mapping, or NULL if the
+ *         key is not present
+ */
+const void *mapped_get(mapped_hash_table *table, const void *key, size_t key_length, size_t *value_length)
+{
+    uint64_t index = find_slot(table, key, key_length, hash_bytes(key, key_length));
+    uint64_t entry = slots_of(table)[index].entry;
+
+    if (entry == 0)
+    {
+        return NULL;
+    }
+
+    if (value_length != NULL)
+    {
+        *value_length = entry_lengths(table, entry)[1];
+    }
+
+    return table->base + entry + value_offset(key_length);
+}
+
+/*!
+ * @brief Removes a key value pair.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @return True if the key was present and removed
+ */
+bool mapped_remove(mapped_hash_table *table, const void *key, size_t key_length)
+{
+    if (!table->writable)
+    {
+        return false;
+    }
+
+    mapped_header *header = header_of(table);
+    mapped_slot *slots = slots_of(table);
+    uint64_t mask = header->capacity - 1;
+    uint64_t index = find_slot(table, key, key_length, hash_bytes(key, key_length));
+
+    if (slots[index].entry == 0)
+    {
+        return false;
+    }
+
+    header->garbage_bytes += entry_size(table, slots[index].entry);
+
+    // Later slots of the probe are moved back into the gap when their home slot is not
+    // between the gap and themselves, so no deleted marker is needed
+    uint64_t next = (index + 1) & mask;
+
+    while (slots[next].entry != 0)
+    {
+        uint64_t home = slots[next].hash & mask;
+
+        if (((next - home) & mask) >= ((next - index) & mask))
+        {
+            slots[index] = slots[next];
+            index = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    slots[index].entry = 0;
+    slots[index].hash = 0;
+    header->num_elements--;
+
+    return true;
+}
+
+/*!
+ * @brief Returns the number of elements stored.
+ * @param table Pointer to a mapped hash table
+ * @return The number of elements
+ */
+int mapped_num_elements(mapped_hash_table *table)
+{
+    return (int)header_of(table)->num_elements;
+}
+
+/*!
+ * @brief Writes every change made so far back to the file and waits for it to reach
+ *        the disk.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @return True if the changes were written
+ */
+bool mapped_checkpoint(mapped_hash_table *table)
+{
+    if (!table->writable)
+    {
+        return false;
+    }
+
+    return msync(table->base, table->size, MS_SYNC) == 0;
+}
+
+/*!
+ * @brief Unmaps and closes the file. Changes not yet checkpointed are still written
+ *        back by the operating system, but without waiting for the disk.
+ * @param table Pointer to a mapped hash table
+ * @return None
+ */
+void close_mapped_hash_table(mapped_hash_table *table)
+{
+    if (table->base != NULL)
+    {
+        munmap(table->base, table->size);
+    }
+
+    if (table->fd >= 0)
+    {
+        close(table->fd);
+    }
+
+    // Avoid a dangling pointer to the unmapped file
+    table->base = NULL;
+    table->size = 0;
+    table->fd = -1;
+}
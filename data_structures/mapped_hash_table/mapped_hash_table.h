@@ -0,0 +1,184 @@
+/**
+ ********************************************************************************
+ * @file    mapped_hash_table.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a hash table stored in a
+ *          memory mapped file. Opening an existing file only maps it, so a table
+ *          of any size is ready in constant time and its pages are faulted in as
+ *          lookups reach them. Everything in the file refers to everything else by
+ *          offset from the start of the file, so the mapping may move.
+ *
+ *          File layout:
+ *              header | arena
+ *          The arena holds the slot array and one entry per element, each entry
+ *          being the key and value lengths followed by their bytes, with the value
+ *          starting on an 8 byte boundary. Slots use
+ *          linear probing and hold a key's hash with the offset of its entry.
+ *
+ *          Entries are never modified once written. Updating a value appends a
+ *          new entry and then switches the slot to it, so a crash between
+ *          checkpoints never leaves a slot pointing at a partly written entry.
+ *          The space of replaced and removed entries is not reused.
+ ********************************************************************************
+ */
+
+#ifndef MAPPED_HASH_TABLE_H
+#define MAPPED_HASH_TABLE_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Identifies a mapped hash table file
+#define MAPPED_MAGIC "CDSHMAP"
+// Version of the file layout
+#define MAPPED_VERSION 1
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Header at the start of a mapped hash table file.
+ */
+typedef struct mapped_header
+{
+    // MAPPED_MAGIC followed by a NUL byte
+    char magic[8];
+    // Layout version, MAPPED_VERSION
+    uint32_t version;
+    // Unused, keeps the following fields 8 byte aligned
+    uint32_t reserved;
+    // Number of slots, a power of two
+    uint64_t capacity;
+    // Number of elements stored
+    uint64_t num_elements;
+    // Offset of the slot array
+    uint64_t slots_offset;
+    // Offset one past the last byte of the arena in use
+    uint64_t arena_used;
+    // Bytes of the arena held by replaced or removed entries and old slot arrays
+    uint64_t garbage_bytes;
+} mapped_header;
+
+/*!
+ * @brief Struct representing a slot of a mapped hash table.
+ */
+typedef struct mapped_slot
+{
+    // Hash of the key
+    uint64_t hash;
+    // Offset of the entry holding the key and value, 0 for an empty slot
+    uint64_t entry;
+} mapped_slot;
+
+/*!
+ * @brief Struct which represents an open mapped hash table.
+ */
+typedef struct mapped_hash_table
+{
+    // File descriptor of the open file
+    int fd;
+    // True if the file was opened for writing
+    bool writable;
+    // Start of the mapping
+    unsigned char *base;
+    // Size of the mapping, equal to the size of the file
+    size_t size;
+} mapped_hash_table;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Creates a new mapped hash table file, replacing any existing file, and opens it
+ *        for writing.
+ * @param table Pointer to a mapped hash table
+ * @param path Path of the file
+ * @param capacity Number of elements to size the table for
+ * @return True if the file was created and mapped
+ */
+bool create_mapped_hash_table(mapped_hash_table *table, const char *path, int capacity);
+
+/*!
+ * @brief Opens an existing mapped hash table file. No part of the table is read
+ *        beyond its header until it is used.
+ * @param table Pointer to a mapped hash table
+ * @param path Path of the file
+ * @param writable True to allow changes, false to open the file read only
+ * @return True if the file was mapped and holds a table of this version whose slot
+ *         array fits in the file
+ */
+bool open_mapped_hash_table(mapped_hash_table *table, const char *path, bool writable);
+
+/*!
+ * @brief Adds or updates an element, copying the key and value into the file. The
+ *        file grows as needed, which moves the mapping and invalidates pointers
+ *        returned by mapped_get(), so the key and value must not point into it.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @param value Pointer to the value bytes
+ * @param value_length Number of bytes in the value
+ * @return True if the element was stored, false if the table is read only or the
+ *         file could not grow
+ */
+bool mapped_put(mapped_hash_table *table, const void *key, size_t key_length, const void *value,
+                size_t value_length);
+
+/*!
+ * @brief Returns the value associated with a key.
+ * @param table Pointer to a mapped hash table
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @param value_length Receives the number of bytes in the value, may be NULL
+ * @return Pointer to the 8 byte aligned value bytes within the mapping, or NULL if the
+ *         key is not present
+ */
+const void *mapped_get(mapped_hash_table *table, const void *key, size_t key_length, size_t *value_length);
+
+/*!
+ * @brief Removes a key value pair.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @param key Pointer to the key bytes
+ * @param key_length Number of bytes in the key
+ * @return True if the key was present and removed
+ */
+bool mapped_remove(mapped_hash_table *table, const void *key, size_t key_length);
+
+/*!
+ * @brief Returns the number of elements stored.
+ * @param table Pointer to a mapped hash table
+ * @return The number of elements
+ */
+int mapped_num_elements(mapped_hash_table *table);
+
+/*!
+ * @brief Writes every change made so far back to the file and waits for it to reach
+ *        the disk.
+ * @param table Pointer to a mapped hash table opened for writing
+ * @return True if the changes were written
+ */
+bool mapped_checkpoint(mapped_hash_table *table);
+
+/*!
+ * @brief Unmaps and closes the file. Changes not yet checkpointed are still written
+ *        back by the operating system, but without waiting for the disk.
+ * @param table Pointer to a mapped hash table
+ * @return None
+ */
+void close_mapped_hash_table(mapped_hash_table *table);
+
+#endif // MAPPED_HASH_TABLE_H
@@ -0,0 +1,459 @@
+/**
+ ********************************************************************************
+ * @file    perfect_hash_table.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the construction of and lookups on a minimal perfect hash table.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "perfect_hash_table.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Number of seeds tried before the build gives up
+#define PERFECT_MAX_ATTEMPTS 32
+// Number of displacements tried for a bucket per element, before another seed is tried
+#define PERFECT_DISPLACEMENTS_PER_ELEMENT 64
+// Odd constant spreading displacements and seeds across the 64 bit hash
+#define PERFECT_MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+/************************************
+ * PRIVATE TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Key hash paired with the position of its key, used to find repeated keys.
+ */
+typedef struct perfect_entry
+{
+    uint64_t hash;
+    int index;
+} perfect_entry;
+
+/*!
+ * @brief Arrays filled with the elements of a hash table.
+ */
+typedef struct perfect_collector
+{
+    void **keys;
+    void **values;
+    int count;
+} perfect_collector;
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Maps 32 bits of a hash onto a range without division.
+ * @param bits Value whose low 32 bits are used
+ * @param range Size of the range
+ * @return An integer between 0 and range - 1
+ */
+static int reduce(uint64_t bits, int range)
+{
+    return (int)(((bits & 0xFFFFFFFFULL) * (uint64_t)range) >> 32);
+}
+
+/*!
+ * @brief Returns the slot of an element for a displacement.
+ * @param perfect Pointer to a perfect hash table
+ * @param hash Seeded hash of the key
+ * @param displacement Displacement of the key's bucket
+ * @return Index of the slot
+ */
+static int slot_index(perfect_hash_table *perfect, uint64_t hash, uint32_t displacement)
+{
+    return reduce(hash_mix(hash ^ ((uint64_t)displacement * PERFECT_MULTIPLIER)), perfect->num_elements);
+}
+
+/*!
+ * @brief Returns the displacement bucket of an element, chosen by the upper half of its hash.
+ * @param perfect Pointer to a perfect hash table
+ * @param hash Seeded hash of the key
+ * @return Index of the bucket
+ */
+static int bucket_index(perfect_hash_table *perfect, uint64_t hash)
+{
+    return reduce(hash >> 32, perfect->num_buckets);
+}
+
+/*!
+ * @brief Comparison function ordering entries by hash, then by position.
+ * @param a Pointer to the first entry
+ * @param b Pointer to the second entry
+ * @return Negative, zero or positive as a orders before, with or after b
+ */
+static int compare_entries(const void *a, const void *b)
+{
+    const perfect_entry *entry_a = (const perfect_entry *)a;
+    const perfect_entry *entry_b = (const perfect_entry *)b;
+
+    if (entry_a->hash != entry_b->hash)
+    {
+        return (entry_a->hash > entry_b->hash) ? 1 : -1;
+    }
+
+    return entry_a->index - entry_b->index;
+}
+
+/*!
+ * @brief Appends a visited element to a collector.
+ * @param key Key of the visited element
+ * @param value Value of the visited element
+ * @param context Pointer to a perfect collector
+ * @return None
+ */
+static void collect_element(void *key, void *value, void *context)
+{
+    perfect_collector *collector = (perfect_collector *)context;
+
+    if (collector->keys != NULL)
+    {
+        (collector->keys)[collector->count] = key;
+        (collector->values)[collector->count] = value;
+    }
+
+    collector->count++;
+}
+
+/*!
+ * @brief Chooses a displacement for every bucket under the current seed and places each
+ *        element in its slot. Buckets holding the most elements are placed first, while
+ *        most slots are still free.
+ * @param perfect Pointer to a perfect hash table with its sizes and seed set
+ * @param elements Array of distinct elements
+ * @param key_hashes Unseeded hash of each element's key
+ * @return True if every element was placed
+ */
+static bool place_elements(perfect_hash_table *perfect, hash_slot *elements, uint64_t *key_hashes)
+{
+    int n = perfect->num_elements;
+    int num_buckets = perfect->num_buckets;
+    uint64_t max_displacement = (uint64_t)n * PERFECT_DISPLACEMENTS_PER_ELEMENT + 1024;
+    uint64_t *hashes = (uint64_t *)malloc(n * sizeof(uint64_t));
+    int *bucket_start = (int *)calloc(num_buckets + 1, sizeof(int));
+    int *cursor = (int *)malloc(num_buckets * sizeof(int));
+    int *members = (int *)malloc(n * sizeof(int));
+    int *order = (int *)malloc(num_buckets * sizeof(int));
+    int *positions = (int *)malloc(n * sizeof(int));
+    bool *taken = (bool *)calloc(n, sizeof(bool));
+    bool placed = true;
+    int largest = 0;
+
+    if (max_displacement > UINT32_MAX)
+    {
+        max_displacement = UINT32_MAX;
+    }
+
+    // Counting sort of the elements by bucket
+    for (int i = 0; i < n; i++)
+    {
+        hashes[i] = hash_mix(key_hashes[i] ^ perfect->seed);
+        bucket_start[bucket_index(perfect, hashes[i]) + 1]++;
+    }
+
+    for (int b = 0; b < num_buckets; b++)
+    {
+        int size = bucket_start[b + 1];
+
+        largest = (size > largest) ? size : largest;
+        bucket_start[b + 1] += bucket_start[b];
+        cursor[b] = bucket_start[b];
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        members[cursor[bucket_index(perfect, hashes[i])]++] = i;
+    }
+
+    // Counting sort of the buckets by size, largest first
+    int *size_start = (int *)calloc(largest + 2, sizeof(int));
+
+    for (int b = 0; b < num_buckets; b++)
+    {
+        size_start[largest - (bucket_start[b + 1] - bucket_start[b]) + 1]++;
+    }
+
+    for (int s = 0; s <= largest; s++)
+    {
+        size_start[s + 1] += size_start[s];
+    }
+
+    for (int b = 0; b < num_buckets; b++)
+    {
+        order[size_start[largest - (bucket_start[b + 1] - bucket_start[b])]++] = b;
+    }
+
+    free(size_start);
+
+    for (int o = 0; o < num_buckets && placed; o++)
+    {
+        int b = order[o];
+        int first = bucket_start[b];
+        int size = bucket_start[b + 1] - first;
+        uint64_t displacement = 0;
+
+        // Every bucket after the first empty one is empty too
+        if (size == 0)
+        {
+            break;
+        }
+
+        while (true)
+        {
+            int count = 0;
+
+            // Each element of the bucket must land on a distinct free slot
+            for (; count < size; count++)
+            {
+                int slot = slot_index(perfect, hashes[members[first + count]], (uint32_t)displacement);
+
+                if (taken[slot])
+                {
+                    break;
+                }
+
+                taken[slot] = true;
+                positions[count] = slot;
+            }
+
+            if (count == size)
+            {
+                break;
+            }
+
+            // The slots claimed by this attempt are released before the next
+            for (int i = 0; i < count; i++)
+            {
+                taken[positions[i]] = false;
+            }
+
+            if (++displacement == max_displacement)
+            {
+                placed = false;
+                break;
+            }
+        }
+
+        (perfect->displacements)[b] = (uint32_t)displacement;
+
+        for (int i = 0; i < size && placed; i++)
+        {
+            (perfect->slots)[positions[i]] = elements[members[first + i]];
+        }
+    }
+
+    free(hashes);
+    free(bucket_start);
+    free(cursor);
+    free(members);
+    free(order);
+    free(positions);
+    free(taken);
+
+    return placed;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Builds a perfect hash table holding every element of a hash table, using its
+ *        key hashing and equality. Where a chaining table holds a key more than once,
+ *        the value get() returns is kept. The hash table is not modified, and keys and
+ *        values are not copied.
+ * @param perfect Pointer to the perfect hash table to build
+ * @param table Pointer to the hash table to copy from
+ * @return True if the table was built, false if two different keys have equal hashes
+ */
+bool build_perfect_hash_table(perfect_hash_table *perfect, hash_table *table)
+{
+    perfect_collector collector = {NULL, NULL, 0};
+
+    // A chaining table counts occupied positions rather than elements, so they are counted first
+    hash_table_for_each(table, &collect_element, &collector);
+
+    collector.keys = (void **)malloc((collector.count + 1) * sizeof(void *));
+    collector.values = (void **)malloc((collector.count + 1) * sizeof(void *));
+    collector.count = 0;
+
+    // Chains are visited from their first node, so the value get() finds comes first
+    hash_table_for_each(table, &collect_element, &collector);
+
+    bool built = build_perfect_hash_table_arrays(perfect, collector.keys, collector.values, collector.count,
+                                                 table->key_length, table->key_hash, table->key_equal);
+
+    free(collector.keys);
+    free(collector.values);
+
+    return built;
+}
+
+/*!
+ * @brief Builds a perfect hash table from arrays of keys and values. Where a key
+ *        appears more than once the first value is kept. Keys and values are not copied.
+ * @param perfect Pointer to the perfect hash table to build
+ * @param keys Array of keys
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return True if the table was built, false if two different keys have equal hashes
+ */
+bool build_perfect_hash_table_arrays(perfect_hash_table *perfect, void **keys, void **values, int n,
+                                     size_t key_length, hash_key_function key_hash, hash_equal_function key_equal)
+{
+    perfect->num_elements = 0;
+    perfect->num_buckets = 0;
+    perfect->seed = 0;
+    perfect->displacements = NULL;
+    perfect->slots = NULL;
+    perfect->key_hash = key_hash;
+    perfect->key_length = key_length;
+
+    if (key_equal != NULL)
+    {
+        perfect->key_equal = key_equal;
+    }
+    else
+    {
+        perfect->key_equal = (key_length == HASH_KEY_POINTER) ? &equal_pointer : &equal_bytes;
+    }
+
+    if (n == 0)
+    {
+        return true;
+    }
+
+    perfect_entry *entries = (perfect_entry *)malloc(n * sizeof(perfect_entry));
+    hash_slot *elements = (hash_slot *)malloc(n * sizeof(hash_slot));
+    uint64_t *key_hashes = (uint64_t *)malloc(n * sizeof(uint64_t));
+    int count = 0;
+    bool built = true;
+
+    for (int i = 0; i < n; i++)
+    {
+        entries[i].hash = key_hash(keys[i], key_length);
+        entries[i].index = i;
+    }
+
+    // Equal keys have equal hashes, so sorting by hash brings repeats together
+    qsort(entries, n, sizeof(perfect_entry), &compare_entries);
+
+    for (int i = 0; i < n && built; i++)
+    {
+        bool repeated = false;
+        int j = i - 1;
+
+        // Earlier keys with the same hash are either the same key or an unresolvable collision
+        for (; j >= 0 && entries[j].hash == entries[i].hash; j--)
+        {
+            void *earlier = keys[entries[j].index];
+
+            if (earlier == keys[entries[i].index] || perfect->key_equal(earlier, keys[entries[i].index], key_length))
+            {
+                repeated = true;
+                break;
+            }
+        }
+
+        if (repeated)
+        {
+            continue;
+        }
+
+        if (i > 0 && entries[i - 1].hash == entries[i].hash)
+        {
+            built = false;
+            break;
+        }
+
+        elements[count].key = keys[entries[i].index];
+        elements[count].value = values[entries[i].index];
+        key_hashes[count] = entries[i].hash;
+        count++;
+    }
+
+    if (built)
+    {
+        perfect->num_elements = count;
+        perfect->num_buckets = count / PERFECT_KEYS_PER_BUCKET + 1;
+        perfect->displacements = (uint32_t *)calloc(perfect->num_buckets, sizeof(uint32_t));
+        perfect->slots = (hash_slot *)malloc(count * sizeof(hash_slot));
+
+        built = false;
+
+        // A seed which leaves a bucket without a displacement is replaced by the next
+        for (uint64_t attempt = 0; attempt < PERFECT_MAX_ATTEMPTS && !built; attempt++)
+        {
+            perfect->seed = attempt * PERFECT_MULTIPLIER;
+            memset(perfect->displacements, 0, perfect->num_buckets * sizeof(uint32_t));
+
+            built = place_elements(perfect, elements, key_hashes);
+        }
+    }
+
+    free(entries);
+    free(elements);
+    free(key_hashes);
+
+    if (!built)
+    {
+        free_perfect_hash_table(perfect);
+    }
+
+    return built;
+}
+
+/*!
+ * @brief Returns the element associated with a key, probing a single slot.
+ * @param perfect Pointer to a perfect hash table
+ * @param hash_key Key associated with the element
+ * @return The value associated with the specified key, or NULL if it is not present
+ */
+void *perfect_get(perfect_hash_table *perfect, void *hash_key)
+{
+    if (perfect->num_elements == 0)
+    {
+        return NULL;
+    }
+
+    uint64_t hash = hash_mix((perfect->key_hash)(hash_key, perfect->key_length) ^ perfect->seed);
+    uint32_t displacement = (perfect->displacements)[bucket_index(perfect, hash)];
+    hash_slot *slot = &((perfect->slots)[slot_index(perfect, hash, displacement)]);
+
+    // Every slot is full, so a key which was not in the build still lands on one
+    if (slot->key == hash_key || (perfect->key_equal)(slot->key, hash_key, perfect->key_length))
+    {
+        return slot->value;
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Frees the memory held by the perfect hash table.
+ * @param perfect Pointer to a perfect hash table
+ * @return None
+ */
+void free_perfect_hash_table(perfect_hash_table *perfect)
+{
+    free(perfect->displacements);
+    free(perfect->slots);
+
+    // Avoid dangling pointers and leave an empty table behind
+    perfect->displacements = NULL;
+    perfect->slots = NULL;
+    perfect->num_elements = 0;
+    perfect->num_buckets = 0;
+}
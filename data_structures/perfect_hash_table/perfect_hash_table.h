@@ -0,0 +1,103 @@
+/**
+ ********************************************************************************
+ * @file    perfect_hash_table.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of an immutable minimal perfect
+ *          hash table, built once from a finished hash table or arrays of keys
+ *          and values. Built with the hash and displace (CHD) method: keys are
+ *          split into small buckets, and each bucket is given a displacement which
+ *          places all of its keys in free slots. Every key has exactly one slot,
+ *          so a lookup makes a single probe and no slot is left empty.
+ ********************************************************************************
+ */
+
+#ifndef PERFECT_HASH_TABLE_H
+#define PERFECT_HASH_TABLE_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Average number of keys placed in each displacement bucket
+#define PERFECT_KEYS_PER_BUCKET 4
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct which represents a minimal perfect hash table.
+ */
+typedef struct perfect_hash_table
+{
+    // Number of elements, equal to the number of slots
+    int num_elements;
+    // Number of displacement buckets
+    int num_buckets;
+    // Seed mixed into every key's hash, chosen by the builder
+    uint64_t seed;
+    // Displacement chosen for each bucket
+    uint32_t *displacements;
+    // Array of exactly num_elements slots
+    hash_slot *slots;
+    // Function producing the hash of a key
+    hash_key_function key_hash;
+    // Function comparing two keys for equality
+    hash_equal_function key_equal;
+    // Length of each key passed to the hash and equality functions
+    size_t key_length;
+} perfect_hash_table;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Builds a perfect hash table holding every element of a hash table, using its
+ *        key hashing and equality. Where a chaining table holds a key more than once,
+ *        the value get() returns is kept. The hash table is not modified, and keys and
+ *        values are not copied.
+ * @param perfect Pointer to the perfect hash table to build
+ * @param table Pointer to the hash table to copy from
+ * @return True if the table was built, false if two different keys have equal hashes
+ */
+bool build_perfect_hash_table(perfect_hash_table *perfect, hash_table *table);
+
+/*!
+ * @brief Builds a perfect hash table from arrays of keys and values. Where a key
+ *        appears more than once the first value is kept. Keys and values are not copied.
+ * @param perfect Pointer to the perfect hash table to build
+ * @param keys Array of keys
+ * @param values Array of values, one for each key
+ * @param n Number of elements
+ * @param key_length Number of bytes in each key, HASH_KEY_POINTER or HASH_KEY_STRING
+ * @param key_hash Function producing the hash of a key
+ * @param key_equal Function comparing two keys, or NULL to compare by key_length
+ * @return True if the table was built, false if two different keys have equal hashes
+ */
+bool build_perfect_hash_table_arrays(perfect_hash_table *perfect, void **keys, void **values, int n,
+                                     size_t key_length, hash_key_function key_hash, hash_equal_function key_equal);
+
+/*!
+ * @brief Returns the element associated with a key, probing a single slot.
+ * @param perfect Pointer to a perfect hash table
+ * @param hash_key Key associated with the element
+ * @return The value associated with the specified key, or NULL if it is not present
+ */
+void *perfect_get(perfect_hash_table *perfect, void *hash_key);
+
+/*!
+ * @brief Frees the memory held by the perfect hash table.
+ * @param perfect Pointer to a perfect hash table
+ * @return None
+ */
+void free_perfect_hash_table(perfect_hash_table *perfect);
+
+#endif // PERFECT_HASH_TABLE_H
@@ -0,0 +1,486 @@
+/**
+ ********************************************************************************
+ * @file    rcu_hash_table.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a read mostly hash table with epoch based
+ *          reclamation.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "rcu_hash_table.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Number of retired pointers which triggers an attempt to reclaim them
+#define RCU_RECLAIM_BATCH 64
+// Smallest number of buckets
+#define RCU_MIN_BUCKETS 16
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Allocates a bucket array with every chain empty.
+ * @param size Number of buckets, a power of two
+ * @return Pointer to the bucket array
+ */
+static rcu_bucket_array *allocate_buckets(int size)
+{
+    rcu_bucket_array *array =
+        (rcu_bucket_array *)malloc(sizeof(rcu_bucket_array) + (size_t)size * sizeof(_Atomic(rcu_node *)));
+
+    array->size = size;
+
+    for (int i = 0; i < size; i++)
+    {
+        atomic_init(&(array->buckets)[i], NULL);
+    }
+
+    return array;
+}
+
+/*!
+ * @brief Frees a bucket array and every node of its chains.
+ * @param array Pointer to a bucket array no reader can hold
+ * @return None
+ */
+static void free_buckets(rcu_bucket_array *array)
+{
+    for (int i = 0; i < array->size; i++)
+    {
+        rcu_node *node = atomic_load_explicit(&(array->buckets)[i], memory_order_relaxed);
+
+        while (node != NULL)
+        {
+            rcu_node *next = atomic_load_explicit(&node->next, memory_order_relaxed);
+
+            free(node);
+            node = next;
+        }
+    }
+
+    free(array);
+}
+
+/*!
+ * @brief Frees a retired pointer along with its entry in the retired list.
+ * @param retired Retired entry no reader can still hold
+ * @return None
+ */
+static void free_retired(rcu_retired *retired)
+{
+    if (retired->is_array)
+    {
+        free_buckets((rcu_bucket_array *)retired->pointer);
+    }
+    else
+    {
+        free(retired->pointer);
+    }
+
+    free(retired);
+}
+
+/*!
+ * @brief Returns the mixed hash of a key.
+ * @param table Pointer to a read mostly hash table
+ * @param hash_key Key to hash
+ * @return The hash of the key
+ */
+static uint64_t rcu_hash(rcu_hash_table *table, void *hash_key)
+{
+    return hash_mix((table->key_hash)(hash_key, table->key_length));
+}
+
+/*!
+ * @brief Tries to advance the global epoch and frees every retired pointer which no
+ *        reader can still hold.
+ * @param table Pointer to a read mostly hash table whose write lock is held
+ * @return Number of retired pointers freed
+ */
+static int reclaim(rcu_hash_table *table)
+{
+    unsigned long long epoch = atomic_load_explicit(&table->epoch, memory_order_relaxed);
+    bool can_advance = true;
+    int freed = 0;
+
+    // Pairs with the fence in rcu_get(), ordering the unlinks before the scan of readers
+    atomic_thread_fence(memory_order_seq_cst);
+
+    for (int i = 0; i < RCU_MAX_READERS; i++)
+    {
+        unsigned long long state = atomic_load_explicit(&(table->readers)[i].state, memory_order_acquire);
+
+        // A reader inside a read which announced an older epoch holds the epoch back
+        if ((state & 1) != 0 && (state >> 1) != epoch)
+        {
+            can_advance = false;
+            break;
+        }
+    }
+
+    if (can_advance)
+    {
+        epoch++;
+        atomic_store_explicit(&table->epoch, epoch, memory_order_release);
+    }
+
+    // Pointers retired two epochs ago were unlinked before any current reader started
+    rcu_retired **link = &table->retired;
+
+    while (*link != NULL)
+    {
+        rcu_retired *retired = *link;
+
+        if (retired->epoch + 2 <= epoch)
+        {
+            *link = retired->next;
+            free_retired(retired);
+            table->num_retired--;
+            freed++;
+        }
+        else
+        {
+            link = &retired->next;
+        }
+    }
+
+    return freed;
+}
+
+/*!
+ * @brief Adds a node or bucket array to the retired list, reclaiming the list once it
+ *        reaches RCU_RECLAIM_BATCH entries.
+ * @param table Pointer to a read mostly hash table whose write lock is held
+ * @param pointer Node or bucket array already unlinked from the table
+ * @param is_array True if pointer is a bucket array
+ * @return None
+ */
+static void retire(rcu_hash_table *table, void *pointer, bool is_array)
+{
+    rcu_retired *retired = (rcu_retired *)malloc(sizeof(rcu_retired));
+
+    retired->pointer = pointer;
+    retired->is_array = is_array;
+    retired->epoch = atomic_load_explicit(&table->epoch, memory_order_relaxed);
+    retired->next = table->retired;
+
+    table->retired = retired;
+    table->num_retired++;
+
+    if (table->num_retired >= RCU_RECLAIM_BATCH)
+    {
+        reclaim(table);
+    }
+}
+
+/*!
+ * @brief Doubles the number of buckets. Readers may be walking the old chains, so
+ *        every node is copied into the new array rather than relinked, and the old
+ *        array is retired along with its nodes once the new one is published.
+ * @param table Pointer to a read mostly hash table whose write lock is held
+ * @param old_array Bucket array currently published
+ * @return None
+ */
+static void grow(rcu_hash_table *table, rcu_bucket_array *old_array)
+{
+    rcu_bucket_array *new_array = allocate_buckets(old_array->size * 2);
+    int mask = new_array->size - 1;
+
+    for (int i = 0; i < old_array->size; i++)
+    {
+        rcu_node *node = atomic_load_explicit(&(old_array->buckets)[i], memory_order_relaxed);
+
+        while (node != NULL)
+        {
+            rcu_node *copy = (rcu_node *)malloc(sizeof(rcu_node));
+            _Atomic(rcu_node *) *bucket = &(new_array->buckets)[node->hash & mask];
+
+            copy->key = node->key;
+            copy->hash = node->hash;
+            atomic_init(&copy->value, atomic_load_explicit(&node->value, memory_order_relaxed));
+            atomic_init(&copy->next, atomic_load_explicit(bucket, memory_order_relaxed));
+            atomic_store_explicit(bucket, copy, memory_order_relaxed);
+
+            node = atomic_load_explicit(&node->next, memory_order_relaxed);
+        }
+    }
+
+    // Release ordering makes the filled array visible to readers which load it
+    atomic_store_explicit(&table->current, new_array, memory_order_release);
+
+    retire(table, old_array, true);
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes the table. The table must not be moved once readers use it.
+ * @param table Pointer to a read mostly hash table
+ * @param size Initial number of buckets, rounded up to a power of two
+ * @param load_factor Fraction of buckets used at which the table doubles
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @return None
+ */
+void initialize_rcu_hash_table(rcu_hash_table *table, int size, float load_factor, int function_select)
+{
+    int buckets = RCU_MIN_BUCKETS;
+
+    // Buckets are selected by masking, so their number is a power of two
+    while (buckets < size)
+    {
+        buckets *= 2;
+    }
+
+    switch (function_select)
+    {
+    // Selects content hashing for string keys
+    case HASH_STRING:
+        table->key_hash = &hash_bytes;
+        table->key_equal = &equal_bytes;
+        table->key_length = HASH_KEY_STRING;
+        break;
+    // Selects the Fibonacci multiplier for integer keys
+    case HASH_FIBONACCI:
+        table->key_hash = &hash_fibonacci;
+        table->key_equal = &equal_pointer;
+        table->key_length = HASH_KEY_POINTER;
+        break;
+    // Selects the identity hash, which is mixed before use
+    default:
+        table->key_hash = &hash_pointer;
+        table->key_equal = &equal_pointer;
+        table->key_length = HASH_KEY_POINTER;
+        break;
+    }
+
+    atomic_init(&table->current, allocate_buckets(buckets));
+    atomic_init(&table->epoch, 0);
+
+    table->num_elements = 0;
+    table->load_factor = load_factor;
+    table->retired = NULL;
+    table->num_retired = 0;
+
+    pthread_mutex_init(&table->write_lock, NULL);
+
+    for (int i = 0; i < RCU_MAX_READERS; i++)
+    {
+        atomic_init(&(table->readers)[i].state, 0);
+        atomic_init(&(table->readers)[i].in_use, false);
+    }
+}
+
+/*!
+ * @brief Claims a reader record for the calling thread.
+ * @param table Pointer to a read mostly hash table
+ * @return Pointer to the reader, or NULL if RCU_MAX_READERS are registered
+ */
+rcu_reader *rcu_register_reader(rcu_hash_table *table)
+{
+    for (int i = 0; i < RCU_MAX_READERS; i++)
+    {
+        bool expected = false;
+
+        if (atomic_compare_exchange_strong(&(table->readers)[i].in_use, &expected, true))
+        {
+            return &(table->readers)[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Releases a reader record. The reader must not be inside a read.
+ * @param reader Pointer to a reader from rcu_register_reader()
+ * @return None
+ */
+void rcu_unregister_reader(rcu_reader *reader)
+{
+    atomic_store_explicit(&reader->in_use, false, memory_order_release);
+}
+
+/*!
+ * @brief Returns the element associated with a key without taking a lock or retrying.
+ * @param table Pointer to a read mostly hash table
+ * @param reader Reader registered by the calling thread
+ * @param hash_key Key associated with the element
+ * @return The value associated with the key, or NULL if it is not present
+ */
+void *rcu_get(rcu_hash_table *table, rcu_reader *reader, void *hash_key)
+{
+    uint64_t hash = rcu_hash(table, hash_key);
+    unsigned long long epoch = atomic_load_explicit(&table->epoch, memory_order_relaxed);
+    void *value = NULL;
+
+    // Announce the epoch, then fence so either the writer sees the announcement before
+    // freeing anything, or this read sees every unlink made before that check
+    atomic_store_explicit(&reader->state, (epoch << 1) | 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    rcu_bucket_array *array = atomic_load_explicit(&table->current, memory_order_acquire);
+    rcu_node *node = atomic_load_explicit(&(array->buckets)[hash & (uint64_t)(array->size - 1)],
+                                          memory_order_acquire);
+
+    while (node != NULL)
+    {
+        if (node->hash == hash && (table->key_equal)(node->key, hash_key, table->key_length))
+        {
+            value = atomic_load_explicit(&node->value, memory_order_acquire);
+            break;
+        }
+
+        node = atomic_load_explicit(&node->next, memory_order_acquire);
+    }
+
+    // Leaving the read lets writers advance past the announced epoch
+    atomic_store_explicit(&reader->state, 0, memory_order_release);
+
+    return value;
+}
+
+/*!
+ * @brief Adds or updates an element, blocking only other writers.
+ * @param table Pointer to a read mostly hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @return None
+ */
+void rcu_put(rcu_hash_table *table, void *hash_key, void *hash_value)
+{
+    uint64_t hash = rcu_hash(table, hash_key);
+
+    pthread_mutex_lock(&table->write_lock);
+
+    rcu_bucket_array *array = atomic_load_explicit(&table->current, memory_order_relaxed);
+    _Atomic(rcu_node *) *bucket = &(array->buckets)[hash & (uint64_t)(array->size - 1)];
+    rcu_node *node = atomic_load_explicit(bucket, memory_order_relaxed);
+
+    while (node != NULL)
+    {
+        // An existing element has its value replaced in place
+        if (node->hash == hash && (table->key_equal)(node->key, hash_key, table->key_length))
+        {
+            atomic_store_explicit(&node->value, hash_value, memory_order_release);
+            pthread_mutex_unlock(&table->write_lock);
+            return;
+        }
+
+        node = atomic_load_explicit(&node->next, memory_order_relaxed);
+    }
+
+    // The node is complete before the release store links it at the head of the chain
+    node = (rcu_node *)malloc(sizeof(rcu_node));
+    node->key = hash_key;
+    node->hash = hash;
+    atomic_init(&node->value, hash_value);
+    atomic_init(&node->next, atomic_load_explicit(bucket, memory_order_relaxed));
+    atomic_store_explicit(bucket, node, memory_order_release);
+
+    table->num_elements++;
+
+    if (table->num_elements > (int)(array->size * table->load_factor))
+    {
+        grow(table, array);
+    }
+
+    pthread_mutex_unlock(&table->write_lock);
+}
+
+/*!
+ * @brief Removes an element, blocking only other writers. The node is reclaimed once
+ *        no reader can still hold it.
+ * @param table Pointer to a read mostly hash table
+ * @param hash_key Key associated with the element
+ * @return None
+ */
+void rcu_remove(rcu_hash_table *table, void *hash_key)
+{
+    uint64_t hash = rcu_hash(table, hash_key);
+
+    pthread_mutex_lock(&table->write_lock);
+
+    rcu_bucket_array *array = atomic_load_explicit(&table->current, memory_order_relaxed);
+    _Atomic(rcu_node *) *link = &(array->buckets)[hash & (uint64_t)(array->size - 1)];
+    rcu_node *node = atomic_load_explicit(link, memory_order_relaxed);
+
+    while (node != NULL)
+    {
+        if (node->hash == hash && (table->key_equal)(node->key, hash_key, table->key_length))
+        {
+            // Readers already on the node keep following its next pointer, which is unchanged
+            atomic_store_explicit(link, atomic_load_explicit(&node->next, memory_order_relaxed),
+                                  memory_order_release);
+            table->num_elements--;
+            retire(table, node, false);
+            break;
+        }
+
+        link = &node->next;
+        node = atomic_load_explicit(link, memory_order_relaxed);
+    }
+
+    pthread_mutex_unlock(&table->write_lock);
+}
+
+/*!
+ * @brief Tries to advance the global epoch and frees every retired pointer which no
+ *        reader can still hold. Writers call this as retired pointers build up.
+ * @param table Pointer to a read mostly hash table
+ * @return Number of retired pointers freed
+ */
+int rcu_reclaim(rcu_hash_table *table)
+{
+    pthread_mutex_lock(&table->write_lock);
+
+    int freed = reclaim(table);
+
+    pthread_mutex_unlock(&table->write_lock);
+
+    return freed;
+}
+
+/*!
+ * @brief Returns the number of elements stored. The result is only exact when no
+ *        writer is active.
+ * @param table Pointer to a read mostly hash table
+ * @return The number of elements stored
+ */
+int rcu_num_elements(rcu_hash_table *table)
+{
+    return table->num_elements;
+}
+
+/*!
+ * @brief Frees the memory held by the table, including retired pointers. No other
+ *        thread may be using the table.
+ * @param table Pointer to a read mostly hash table
+ * @return None
+ */
+void free_rcu_hash_table(rcu_hash_table *table)
+{
+    while (table->retired != NULL)
+    {
+        rcu_retired *retired = table->retired;
+
+        table->retired = retired->next;
+        free_retired(retired);
+    }
+
+    free_buckets(atomic_load_explicit(&table->current, memory_order_relaxed));
+    pthread_mutex_destroy(&table->write_lock);
+
+    table->num_elements = 0;
+    table->num_retired = 0;
+}
@@ -0,0 +1,199 @@
+/**
+ ********************************************************************************
+ * @file    rcu_hash_table.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a read mostly chained hash
+ *          table. Readers take no lock and never retry: writers, serialized by
+ *          a mutex, publish fully built nodes and bucket arrays with release
+ *          stores. Unlinked nodes and replaced bucket arrays are reclaimed
+ *          through epoch based reclamation once no reader can still hold them.
+ ********************************************************************************
+ */
+
+#ifndef RCU_HASH_TABLE_H
+#define RCU_HASH_TABLE_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdatomic.h>
+#include <pthread.h>
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Size of a cache line, used to keep readers' epochs from sharing one
+#define RCU_CACHE_LINE 64
+// Largest number of readers registered at once
+#define RCU_MAX_READERS 128
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct representing an element of a chain.
+ */
+typedef struct rcu_node
+{
+    // Key of the element
+    void *key;
+    // Value of the element, replaced in place by updates
+    _Atomic(void *) value;
+    // Mixed hash of the key
+    uint64_t hash;
+    // Next element of the chain
+    _Atomic(struct rcu_node *) next;
+} rcu_node;
+
+/*!
+ * @brief Struct holding a bucket array published to readers.
+ */
+typedef struct rcu_bucket_array
+{
+    // Number of buckets, a power of two
+    int size;
+    // Heads of the chains
+    _Atomic(rcu_node *) buckets[];
+} rcu_bucket_array;
+
+/*!
+ * @brief Struct representing a registered reader.
+ */
+typedef struct rcu_reader
+{
+    // Global epoch observed on entering a read, shifted left by one, with the low bit
+    // set while the reader is inside a read
+    atomic_ullong state;
+    // Set while a thread holds the reader
+    atomic_bool in_use;
+} __attribute__((aligned(RCU_CACHE_LINE))) rcu_reader;
+
+/*!
+ * @brief Struct representing a node or bucket array waiting to be reclaimed.
+ */
+typedef struct rcu_retired
+{
+    // Node, or bucket array together with every node of its chains
+    void *pointer;
+    // True if pointer is a bucket array
+    bool is_array;
+    // Global epoch when the pointer was retired
+    unsigned long long epoch;
+    // Next retired pointer, most recent first
+    struct rcu_retired *next;
+} rcu_retired;
+
+/*!
+ * @brief Struct which represents a read mostly hash table.
+ */
+typedef struct rcu_hash_table
+{
+    // Bucket array currently published to readers
+    _Atomic(rcu_bucket_array *) current;
+    // Number of elements stored
+    int num_elements;
+    // Fraction of buckets used at which the table doubles
+    float load_factor;
+    // Function producing the hash of a key
+    hash_key_function key_hash;
+    // Function comparing two keys for equality
+    hash_equal_function key_equal;
+    // Length of each key passed to the hash and equality functions
+    size_t key_length;
+    // Serializes writers
+    pthread_mutex_t write_lock;
+    // Global epoch, advanced by writers once every reader inside a read has seen it
+    atomic_ullong epoch;
+    // Pointers retired by writers and not yet reclaimed
+    rcu_retired *retired;
+    // Number of entries in the retired list
+    int num_retired;
+    // Reader records, claimed by rcu_register_reader()
+    rcu_reader readers[RCU_MAX_READERS];
+} rcu_hash_table;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes the table. The table must not be moved once readers use it.
+ * @param table Pointer to a read mostly hash table
+ * @param size Initial number of buckets, rounded up to a power of two
+ * @param load_factor Fraction of buckets used at which the table doubles
+ * @param function_select Integer specifying which hash function to use, as for a hash table
+ * @return None
+ */
+void initialize_rcu_hash_table(rcu_hash_table *table, int size, float load_factor, int function_select);
+
+/*!
+ * @brief Claims a reader record for the calling thread.
+ * @param table Pointer to a read mostly hash table
+ * @return Pointer to the reader, or NULL if RCU_MAX_READERS are registered
+ */
+rcu_reader *rcu_register_reader(rcu_hash_table *table);
+
+/*!
+ * @brief Releases a reader record. The reader must not be inside a read.
+ * @param reader Pointer to a reader from rcu_register_reader()
+ * @return None
+ */
+void rcu_unregister_reader(rcu_reader *reader);
+
+/*!
+ * @brief Returns the element associated with a key without taking a lock or retrying.
+ * @param table Pointer to a read mostly hash table
+ * @param reader Reader registered by the calling thread
+ * @param hash_key Key associated with the element
+ * @return The value associated with the key, or NULL if it is not present
+ */
+void *rcu_get(rcu_hash_table *table, rcu_reader *reader, void *hash_key);
+
+/*!
+ * @brief Adds or updates an element, blocking only other writers.
+ * @param table Pointer to a read mostly hash table
+ * @param hash_key Key to store
+ * @param hash_value Value to store
+ * @return None
+ */
+void rcu_put(rcu_hash_table *table, void *hash_key, void *hash_value);
+
+/*!
+ * @brief Removes an element, blocking only other writers. The node is reclaimed once
+ *        no reader can still hold it.
+ * @param table Pointer to a read mostly hash table
+ * @param hash_key Key associated with the element
+ * @return None
+ */
+void rcu_remove(rcu_hash_table *table, void *hash_key);
+
+/*!
+ * @brief Tries to advance the global epoch and frees every retired pointer which no
+ *        reader can still hold. Writers call this as retired pointers build up.
+ * @param table Pointer to a read mostly hash table
+ * @return Number of retired pointers freed
+ */
+int rcu_reclaim(rcu_hash_table *table);
+
+/*!
+ * @brief Returns the number of elements stored. The result is only exact when no
+ *        writer is active.
+ * @param table Pointer to a read mostly hash table
+ * @return The number of elements stored
+ */
+int rcu_num_elements(rcu_hash_table *table);
+
+/*!
+ * @brief Frees the memory held by the table, including retired pointers. No other
+ *        thread may be using the table.
+ * @param table Pointer to a read mostly hash table
+ * @return None
+ */
+void free_rcu_hash_table(rcu_hash_table *table);
+
+#endif // RCU_HASH_TABLE_H
@@ -0,0 +1,180 @@
+/**
+ ********************************************************************************
+ * @file    count_min_sketch.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a count-min sketch.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <math.h>
+#include "count_min_sketch.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Alignment of the counters, so that each row starts on a cache line
+#define COUNT_MIN_ALIGNMENT 64
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Finds the counter of a key in each row and returns the smallest of them.
+ *        Positions are derived from the two halves of one mixed hash, the second
+ *        half stepping the position between rows.
+ * @param sketch Pointer to a count-min sketch
+ * @param hash 64 bit hash of the key
+ * @param offsets Array filled with the offset of the key's counter in each row
+ * @return The smallest of the key's counters
+ */
+static uint32_t count_min_minimum(count_min_sketch *sketch, uint64_t hash, uint32_t *offsets)
+{
+    uint64_t mixed = hash_mix(hash);
+    uint32_t position = (uint32_t)mixed;
+    // An odd step visits a different position of a power of two row for every row
+    uint32_t step = (uint32_t)(mixed >> 32) | 1;
+    uint32_t mask = (uint32_t)sketch->width - 1;
+    uint32_t *row = sketch->counters;
+    uint32_t minimum = COUNT_MIN_MAX_COUNT;
+
+    // Selects rather than branches, as which row holds the minimum is unpredictable
+    for (int i = 0; i < sketch->depth; i++)
+    {
+        offsets[i] = position & mask;
+        minimum = (row[offsets[i]] < minimum) ? row[offsets[i]] : minimum;
+        position += step;
+        row += sketch->width;
+    }
+
+    return minimum;
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes a count-min sketch whose estimates exceed the true count by at
+ *        most epsilon times the total of all counts, with probability 1 - delta.
+ * @param sketch Pointer to a count-min sketch
+ * @param epsilon Largest error as a fraction of the total count
+ * @param delta Probability that an estimate exceeds the error bound
+ * @return None
+ */
+void initialize_count_min_sketch(count_min_sketch *sketch, double epsilon, double delta)
+{
+    // e / epsilon counters per row bound the expected error, and each row fails
+    // independently with probability 1 / e
+    initialize_count_min_sketch_size(sketch, (int)ceil(exp(1.0) / epsilon), (int)ceil(log(1.0 / delta)));
+}
+
+/*!
+ * @brief Initializes a count-min sketch with a given number of counters per row and
+ *        of rows.
+ * @param sketch Pointer to a count-min sketch
+ * @param width Number of counters in each row, rounded up to a power of two
+ * @param depth Number of rows, at most COUNT_MIN_MAX_DEPTH
+ * @return None
+ */
+void initialize_count_min_sketch_size(count_min_sketch *sketch, int width, int depth)
+{
+    // Rows of at least a cache line keep every row aligned
+    sketch->width = COUNT_MIN_ALIGNMENT / sizeof(uint32_t);
+
+    while (sketch->width < width)
+    {
+        sketch->width *= 2;
+    }
+
+    sketch->depth = (depth < 1) ? 1 : (depth > COUNT_MIN_MAX_DEPTH) ? COUNT_MIN_MAX_DEPTH : depth;
+    sketch->counters = (uint32_t *)aligned_alloc(COUNT_MIN_ALIGNMENT, count_min_sketch_bytes(sketch));
+
+    count_min_clear(sketch);
+}
+
+/*!
+ * @brief Adds occurrences of a key to a count-min sketch. With conservative update,
+ *        only the counters below the key's new estimate are raised, to that estimate,
+ *        which keeps keys sharing a counter from inflating each other's estimates.
+ *        Counters stop at COUNT_MIN_MAX_COUNT.
+ * @param sketch Pointer to a count-min sketch
+ * @param hash 64 bit hash of the key
+ * @param count Number of occurrences to add
+ * @return The key's estimated count after the addition
+ */
+uint32_t count_min_add(count_min_sketch *sketch, uint64_t hash, uint32_t count)
+{
+    uint32_t offsets[COUNT_MIN_MAX_DEPTH];
+    uint32_t estimate = count_min_minimum(sketch, hash, offsets);
+    uint32_t *row = sketch->counters;
+
+    // A saturated estimate stays at the largest count
+    estimate = (estimate > COUNT_MIN_MAX_COUNT - count) ? COUNT_MIN_MAX_COUNT : estimate + count;
+
+    // Every counter is written, keeping its value when it already reaches the estimate
+    for (int i = 0; i < sketch->depth; i++)
+    {
+        row[offsets[i]] = (row[offsets[i]] < estimate) ? estimate : row[offsets[i]];
+        row += sketch->width;
+    }
+
+    sketch->total += count;
+
+    return estimate;
+}
+
+/*!
+ * @brief Returns the estimated count of a key in a count-min sketch.
+ * @param sketch Pointer to a count-min sketch
+ * @param hash 64 bit hash of the key
+ * @return Estimated count, never less than the key's true count
+ */
+uint32_t count_min_estimate(count_min_sketch *sketch, uint64_t hash)
+{
+    uint32_t offsets[COUNT_MIN_MAX_DEPTH];
+
+    return count_min_minimum(sketch, hash, offsets);
+}
+
+/*!
+ * @brief Resets every counter of a count-min sketch to 0.
+ * @param sketch Pointer to a count-min sketch
+ * @return None
+ */
+void count_min_clear(count_min_sketch *sketch)
+{
+    memset(sketch->counters, 0, count_min_sketch_bytes(sketch));
+    sketch->total = 0;
+}
+
+/*!
+ * @brief Returns the memory held by a count-min sketch's counters.
+ * @param sketch Pointer to a count-min sketch
+ * @return Number of bytes allocated
+ */
+size_t count_min_sketch_bytes(count_min_sketch *sketch)
+{
+    return (size_t)sketch->width * sketch->depth * sizeof(uint32_t);
+}
+
+/*!
+ * @brief Frees the memory held by a count-min sketch.
+ * @param sketch Pointer to a count-min sketch
+ * @return None
+ */
+void free_count_min_sketch(count_min_sketch *sketch)
+{
+    free(sketch->counters);
+
+    // Avoid a dangling pointer to the counters
+    sketch->counters = NULL;
+    sketch->width = 0;
+    sketch->depth = 0;
+}
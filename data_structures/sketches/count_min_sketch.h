@@ -0,0 +1,118 @@
+/**
+ ********************************************************************************
+ * @file    count_min_sketch.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a count-min sketch with
+ *          conservative update. Each key increments one counter in each of
+ *          several rows, and its frequency is estimated by the smallest of
+ *          them, which never falls below the key's true count. Memory is fixed
+ *          when the sketch is created, however many keys are counted. Keys are
+ *          given as 64 bit hashes, such as those produced by hash_bytes() or a
+ *          hash table's key_hash function.
+ ********************************************************************************
+ */
+
+#ifndef COUNT_MIN_SKETCH_H
+#define COUNT_MIN_SKETCH_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../hash_table/hash_table.h"
+
+/************************************
+ * MACROS AND DEFINES
+ ************************************/
+
+// Largest number of rows in a sketch
+#define COUNT_MIN_MAX_DEPTH 16
+// Value at which counters stop increasing
+#define COUNT_MIN_MAX_COUNT UINT32_MAX
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct which represents a count-min sketch.
+ */
+typedef struct count_min_sketch
+{
+    // Number of counters in each row, a power of two
+    int width;
+    // Number of rows
+    int depth;
+    // Sum of every count added
+    uint64_t total;
+    // Counters, one row after another
+    uint32_t *counters;
+} count_min_sketch;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes a count-min sketch whose estimates exceed the true count by at
+ *        most epsilon times the total of all counts, with probability 1 - delta.
+ * @param sketch Pointer to a count-min sketch
+ * @param epsilon Largest error as a fraction of the total count
+ * @param delta Probability that an estimate exceeds the error bound
+ * @return None
+ */
+void initialize_count_min_sketch(count_min_sketch *sketch, double epsilon, double delta);
+
+/*!
+ * @brief Initializes a count-min sketch with a given number of counters per row and
+ *        of rows.
+ * @param sketch Pointer to a count-min sketch
+ * @param width Number of counters in each row, rounded up to a power of two
+ * @param depth Number of rows, at most COUNT_MIN_MAX_DEPTH
+ * @return None
+ */
+void initialize_count_min_sketch_size(count_min_sketch *sketch, int width, int depth);
+
+/*!
+ * @brief Adds occurrences of a key to a count-min sketch. With conservative update,
+ *        only the counters below the key's new estimate are raised, to that estimate,
+ *        which keeps keys sharing a counter from inflating each other's estimates.
+ *        Counters stop at COUNT_MIN_MAX_COUNT.
+ * @param sketch Pointer to a count-min sketch
+ * @param hash 64 bit hash of the key
+ * @param count Number of occurrences to add
+ * @return The key's estimated count after the addition
+ */
+uint32_t count_min_add(count_min_sketch *sketch, uint64_t hash, uint32_t count);
+
+/*!
+ * @brief Returns the estimated count of a key in a count-min sketch.
+ * @param sketch Pointer to a count-min sketch
+ * @param hash 64 bit hash of the key
+ * @return Estimated count, never less than the key's true count
+ */
+uint32_t count_min_estimate(count_min_sketch *sketch, uint64_t hash);
+
+/*!
+ * @brief Resets every counter of a count-min sketch to 0.
+ * @param sketch Pointer to a count-min sketch
+ * @return None
+ */
+void count_min_clear(count_min_sketch *sketch);
+
+/*!
+ * @brief Returns the memory held by a count-min sketch's counters.
+ * @param sketch Pointer to a count-min sketch
+ * @return Number of bytes allocated
+ */
+size_t count_min_sketch_bytes(count_min_sketch *sketch);
+
+/*!
+ * @brief Frees the memory held by a count-min sketch.
+ * @param sketch Pointer to a count-min sketch
+ * @return None
+ */
+void free_count_min_sketch(count_min_sketch *sketch);
+
+#endif // COUNT_MIN_SKETCH_H
@@ -0,0 +1,260 @@
+/**
+ ********************************************************************************
+ * @file    top_k.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the operations on a top-k tracker.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "top_k.h"
+
+/************************************
+ * PRIVATE MACROS AND DEFINES
+ ************************************/
+
+// Load factor of the table of tracked keys, which never grows past k keys
+#define TOP_K_LOAD_FACTOR 0.75
+
+/************************************
+ * STATIC FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Returns the count of the item at a heap position.
+ * @param tracker Pointer to a top-k tracker
+ * @param index Position in the heap
+ * @return Count of the item
+ */
+static uint32_t heap_count(top_k *tracker, int index)
+{
+    return ((tracker->items)[(tracker->heap)[index]]).count;
+}
+
+/*!
+ * @brief Places an item at a heap position and records the position in the item.
+ * @param tracker Pointer to a top-k tracker
+ * @param index Position in the heap
+ * @param item Index of the item
+ * @return None
+ */
+static void heap_set(top_k *tracker, int index, int item)
+{
+    (tracker->heap)[index] = item;
+    ((tracker->items)[item]).heap_index = index;
+}
+
+/*!
+ * @brief Moves an item towards the root of the heap while its count is smaller than
+ *        its parent's.
+ * @param tracker Pointer to a top-k tracker
+ * @param index Position of the item
+ * @return None
+ */
+static void sift_up(top_k *tracker, int index)
+{
+    int item = (tracker->heap)[index];
+    uint32_t count = ((tracker->items)[item]).count;
+
+    while (index > 0 && heap_count(tracker, (index - 1) / 2) > count)
+    {
+        heap_set(tracker, index, (tracker->heap)[(index - 1) / 2]);
+        index = (index - 1) / 2;
+    }
+
+    heap_set(tracker, index, item);
+}
+
+/*!
+ * @brief Moves an item away from the root of the heap while a child has a smaller count.
+ * @param tracker Pointer to a top-k tracker
+ * @param index Position of the item
+ * @return None
+ */
+static void sift_down(top_k *tracker, int index)
+{
+    int item = (tracker->heap)[index];
+    uint32_t count = ((tracker->items)[item]).count;
+
+    while (2 * index + 1 < tracker->size)
+    {
+        int child = 2 * index + 1;
+
+        if (child + 1 < tracker->size && heap_count(tracker, child + 1) < heap_count(tracker, child))
+        {
+            child++;
+        }
+
+        if (heap_count(tracker, child) >= count)
+        {
+            break;
+        }
+
+        heap_set(tracker, index, (tracker->heap)[child]);
+        index = child;
+    }
+
+    heap_set(tracker, index, item);
+}
+
+/*!
+ * @brief Orders items by decreasing count for qsort.
+ * @param a Pointer to the first item
+ * @param b Pointer to the second item
+ * @return Negative, zero or positive as a's count is greater than, equal to or less than b's
+ */
+static int compare_counts(const void *a, const void *b)
+{
+    uint32_t count_a = ((const top_k_item *)a)->count;
+    uint32_t count_b = ((const top_k_item *)b)->count;
+
+    return (count_a < count_b) - (count_a > count_b);
+}
+
+/************************************
+ * GLOBAL FUNCTIONS
+ ************************************/
+
+/*!
+ * @brief Initializes a top-k tracker counting keys with a count-min sketch.
+ * @param tracker Pointer to a top-k tracker
+ * @param k Largest number of keys tracked
+ * @param sketch Pointer to an initialized count-min sketch, which must outlive the tracker
+ * @param function_select Integer specifying the hash function for keys (see hash_table.h)
+ * @return None
+ */
+void initialize_top_k(top_k *tracker, int k, count_min_sketch *sketch, int function_select)
+{
+    tracker->k = (k < 1) ? 1 : k;
+    tracker->size = 0;
+    tracker->items = (top_k_item *)malloc(tracker->k * sizeof(top_k_item));
+    tracker->heap = (int *)malloc(tracker->k * sizeof(int));
+    tracker->sketch = sketch;
+
+    // Sized so that k keys fit without a resize
+    initialize_hash_table_mode(&(tracker->table), (int)(tracker->k / TOP_K_LOAD_FACTOR) + 1, TOP_K_LOAD_FACTOR,
+                               function_select, HASH_SWISS);
+}
+
+/*!
+ * @brief Adds occurrences of a key to a top-k tracker. A key whose estimate does not
+ *        pass the smallest tracked count only updates the sketch. Keys are stored as
+ *        given, so string keys must stay valid while they may be tracked.
+ * @param tracker Pointer to a top-k tracker
+ * @param key Key which occurred
+ * @param count Number of occurrences
+ * @return None
+ */
+void top_k_add(top_k *tracker, void *key, uint32_t count)
+{
+    uint64_t hash = ((tracker->table).key_hash)(key, (tracker->table).key_length);
+    uint32_t estimate = count_min_add(tracker->sketch, hash, count);
+
+    // A tracked key's estimate only grows, so one at or below the smallest tracked count
+    // belongs to an untracked key, and the table need not be searched
+    if (tracker->size == tracker->k && estimate <= heap_count(tracker, 0))
+    {
+        return;
+    }
+
+    top_k_item *item = (top_k_item *)get(&(tracker->table), key);
+
+    if (item != NULL)
+    {
+        item->count = estimate;
+        sift_down(tracker, item->heap_index);
+        return;
+    }
+
+    if (tracker->size < tracker->k)
+    {
+        item = &((tracker->items)[tracker->size]);
+        item->key = key;
+        item->count = estimate;
+
+        put(&(tracker->table), key, item);
+        heap_set(tracker, tracker->size, tracker->size);
+
+        tracker->size++;
+        sift_up(tracker, tracker->size - 1);
+        return;
+    }
+
+    // The key with the smallest count makes way for the new one
+    item = &((tracker->items)[(tracker->heap)[0]]);
+    remove_hash(&(tracker->table), item->key);
+
+    item->key = key;
+    item->count = estimate;
+
+    put(&(tracker->table), key, item);
+    sift_down(tracker, 0);
+}
+
+/*!
+ * @brief Returns the estimated count of any key, tracked or not.
+ * @param tracker Pointer to a top-k tracker
+ * @param key Key to estimate
+ * @return Estimated count from the sketch, never less than the key's true count
+ */
+uint32_t top_k_estimate(top_k *tracker, void *key)
+{
+    return count_min_estimate(tracker->sketch, ((tracker->table).key_hash)(key, (tracker->table).key_length));
+}
+
+/*!
+ * @brief Copies the tracked keys in order of decreasing estimated count.
+ * @param tracker Pointer to a top-k tracker
+ * @param keys Array of at least k entries filled with the keys
+ * @param counts Array of at least k entries filled with each key's current estimate,
+ *               or NULL
+ * @return Number of keys copied
+ */
+int top_k_items(top_k *tracker, void **keys, uint32_t *counts)
+{
+    top_k_item *sorted = (top_k_item *)malloc((tracker->size + 1) * sizeof(top_k_item));
+
+    // Estimates may have risen since each key was last added, through keys sharing its counters
+    for (int i = 0; i < tracker->size; i++)
+    {
+        sorted[i] = (tracker->items)[i];
+        sorted[i].count = top_k_estimate(tracker, sorted[i].key);
+    }
+
+    qsort(sorted, tracker->size, sizeof(top_k_item), &compare_counts);
+
+    for (int i = 0; i < tracker->size; i++)
+    {
+        keys[i] = sorted[i].key;
+
+        if (counts != NULL)
+        {
+            counts[i] = sorted[i].count;
+        }
+    }
+
+    free(sorted);
+
+    return tracker->size;
+}
+
+/*!
+ * @brief Frees the memory held by a top-k tracker, leaving its sketch to the caller.
+ * @param tracker Pointer to a top-k tracker
+ * @return None
+ */
+void free_top_k(top_k *tracker)
+{
+    free_hash_table(&(tracker->table));
+    free(tracker->items);
+    free(tracker->heap);
+
+    // Avoid dangling pointers to the items
+    tracker->items = NULL;
+    tracker->heap = NULL;
+    tracker->size = 0;
+}
@@ -0,0 +1,111 @@
+/**
+ ********************************************************************************
+ * @file    top_k.h
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Defines the structure and functions of a tracker of the k most
+ *          frequent keys in a stream. Every key is counted by a count-min
+ *          sketch, and the keys with the largest estimates are held in a
+ *          hash table of at most k keys alongside a min-heap of their counts.
+ *          As in the SpaceSaving algorithm, a key whose estimate passes the
+ *          smallest tracked count takes that key's place, so memory stays
+ *          fixed however many distinct keys the stream holds.
+ ********************************************************************************
+ */
+
+#ifndef TOP_K_H
+#define TOP_K_H
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "count_min_sketch.h"
+
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Struct representing a key held by a top-k tracker.
+ */
+typedef struct top_k_item
+{
+    // Tracked key
+    void *key;
+    // Estimated count of the key when it was last added
+    uint32_t count;
+    // Position of the item in the heap
+    int heap_index;
+} top_k_item;
+
+/*!
+ * @brief Struct which represents a top-k tracker.
+ */
+typedef struct top_k
+{
+    // Largest number of keys tracked
+    int k;
+    // Number of keys tracked
+    int size;
+    // Tracked keys, whose addresses stay fixed while they are tracked
+    top_k_item *items;
+    // Indices of the items ordered as a min-heap by count
+    int *heap;
+    // Map from each tracked key to its item
+    hash_table table;
+    // Sketch counting every key added, owned by the caller
+    count_min_sketch *sketch;
+} top_k;
+
+/************************************
+ * FUNCTION PROTOTYPES
+ ************************************/
+
+/*!
+ * @brief Initializes a top-k tracker counting keys with a count-min sketch.
+ * @param tracker Pointer to a top-k tracker
+ * @param k Largest number of keys tracked
+ * @param sketch Pointer to an initialized count-min sketch, which must outlive the tracker
+ * @param function_select Integer specifying the hash function for keys (see hash_table.h)
+ * @return None
+ */
+void initialize_top_k(top_k *tracker, int k, count_min_sketch *sketch, int function_select);
+
+/*!
+ * @brief Adds occurrences of a key to a top-k tracker. A key whose estimate does not
+ *        pass the smallest tracked count only updates the sketch. Keys are stored as
+ *        given, so string keys must stay valid while they may be tracked.
+ * @param tracker Pointer to a top-k tracker
+ * @param key Key which occurred
+ * @param count Number of occurrences
+ * @return None
+ */
+void top_k_add(top_k *tracker, void *key, uint32_t count);
+
+/*!
+ * @brief Returns the estimated count of any key, tracked or not.
+ * @param tracker Pointer to a top-k tracker
+ * @param key Key to estimate
+ * @return Estimated count from the sketch, never less than the key's true count
+ */
+uint32_t top_k_estimate(top_k *tracker, void *key);
+
+/*!
+ * @brief Copies the tracked keys in order of decreasing estimated count.
+ * @param tracker Pointer to a top-k tracker
+ * @param keys Array of at least k entries filled with the keys
+ * @param counts Array of at least k entries filled with each key's current estimate,
+ *               or NULL
+ * @return Number of keys copied
+ */
+int top_k_items(top_k *tracker, void **keys, uint32_t *counts);
+
+/*!
+ * @brief Frees the memory held by a top-k tracker, leaving its sketch to the caller.
+ * @param tracker Pointer to a top-k tracker
+ * @return None
+ */
+void free_top_k(top_k *tracker);
+
+#endif // TOP_K_H
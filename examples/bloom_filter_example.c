@@ -0,0 +1,58 @@
+/**
+ ********************************************************************************
+ * @file    bloom_filter_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the bloom_filter header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.75
+#define EXPECTED_KEYS 1000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/filters/bloom_filter.h"
+
+/*!
+ * @brief main function used to test the functionality of the bloom_filter header file.
+ */
+int main(void)
+{
+    bloom_filter filter;
+    hash_table table;
+
+    // Sized so that about 1 in 100 absent keys is reported present
+    initialize_bloom_filter(&filter, EXPECTED_KEYS, 0.01);
+
+    bloom_add(&filter, hash_bytes("CA", HASH_KEY_STRING));
+
+    printf("\nMay contain CA: %d", bloom_contains(&filter, hash_bytes("CA", HASH_KEY_STRING)));
+    printf("\nMay contain DE: %d", bloom_contains(&filter, hash_bytes("DE", HASH_KEY_STRING)));
+    printf("\nHashes per key: %d, bytes: %zu", filter.num_hashes, bloom_filter_bytes(&filter));
+
+    // Attached to a table, the filter answers most lookups of absent keys
+    bloom_clear(&filter);
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING);
+    set_hash_table_filter(&table, &filter, &bloom_filter_ops);
+
+    put(&table, "CA", "Canada");
+    put(&table, "JP", "Japan");
+
+    printf("\nValue for key CA: %s", (char *)get(&table, "CA"));
+    printf("\nValue for key DE: %p\n", get(&table, "DE"));
+
+    // The table does not free its filter
+    free_hash_table(&table);
+    free_bloom_filter(&filter);
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ ********************************************************************************
+ * @file    concurrent_hash_table_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the concurrent_hash_table header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_SHARDS 4
+#define NUM_THREADS 4
+#define INIT_TABLE_SIZE 16
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/concurrent_hash_table/concurrent_hash_table.h"
+
+// Table shared between the threads
+concurrent_hash_table table;
+
+/*!
+ * @brief Adds 100 keys belonging to one thread
+ * @param argument Index of the thread
+ * @return NULL
+ */
+void *add_keys(void *argument)
+{
+    long first = (long)argument * 100 + 1;
+
+    for (long key = first; key < first + 100; key++)
+    {
+        concurrent_put(&table, (void *)key, (void *)(key * 10));
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief main function used to test the functionality of the concurrent_hash_table header file.
+ */
+int main(void)
+{
+    pthread_t threads[NUM_THREADS];
+
+    // Initialize the concurrent hash table
+    initialize_concurrent_hash_table(&table, NUM_SHARDS, INIT_TABLE_SIZE, LOAD_FACTOR, HASH_FIBONACCI);
+
+    // Each thread writes its own keys, only contending with others on the same shard
+    for (long i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_create(&threads[i], NULL, &add_keys, (void *)i);
+    }
+
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    printf("\nNum elems: %d", concurrent_num_elements(&table));
+
+    // Reads do not take a lock
+    printf("\nValue for key 1: %ld", (long)concurrent_get(&table, (void *)1));
+    printf("\nValue for key 250: %ld", (long)concurrent_get(&table, (void *)250));
+
+    concurrent_remove(&table, (void *)250);
+    printf("\nValue for key 250 after removal: %p\n", concurrent_get(&table, (void *)250));
+
+    // Free the memory held by the concurrent hash table
+    free_concurrent_hash_table(&table);
+
+    return 0;
+}
@@ -0,0 +1,44 @@
+/**
+ ********************************************************************************
+ * @file    count_min_sketch_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the count_min_sketch header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/sketches/count_min_sketch.h"
+
+/*!
+ * @brief main function used to test the functionality of the count_min_sketch header file.
+ */
+int main(void)
+{
+    count_min_sketch sketch;
+
+    // Estimates within 0.1% of the total count, with 99% confidence
+    initialize_count_min_sketch(&sketch, 0.001, 0.01);
+
+    count_min_add(&sketch, hash_bytes("/index.html", HASH_KEY_STRING), 1);
+    count_min_add(&sketch, hash_bytes("/index.html", HASH_KEY_STRING), 1);
+    count_min_add(&sketch, hash_bytes("/about.html", HASH_KEY_STRING), 1);
+
+    // Counts can also be added in batches
+    count_min_add(&sketch, hash_bytes("/login", HASH_KEY_STRING), 40);
+
+    printf("\nEstimate for /index.html: %u", count_min_estimate(&sketch, hash_bytes("/index.html", HASH_KEY_STRING)));
+    printf("\nEstimate for /login: %u", count_min_estimate(&sketch, hash_bytes("/login", HASH_KEY_STRING)));
+    printf("\nEstimate for /missing: %u", count_min_estimate(&sketch, hash_bytes("/missing", HASH_KEY_STRING)));
+    printf("\nTotal count: %llu, rows: %d, counters per row: %d, bytes: %zu\n",
+           (unsigned long long)sketch.total, sketch.depth, sketch.width, count_min_sketch_bytes(&sketch));
+
+    free_count_min_sketch(&sketch);
+
+    return 0;
+}
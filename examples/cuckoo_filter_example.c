@@ -0,0 +1,62 @@
+/**
+ ********************************************************************************
+ * @file    cuckoo_filter_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the cuckoo_filter header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.75
+#define EXPECTED_KEYS 1000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/filters/cuckoo_filter.h"
+
+/*!
+ * @brief main function used to test the functionality of the cuckoo_filter header file.
+ */
+int main(void)
+{
+    cuckoo_filter filter;
+    hash_table table;
+
+    // Sized so that about 1 in 1000 absent keys is reported present
+    initialize_cuckoo_filter(&filter, EXPECTED_KEYS, 0.001);
+
+    cuckoo_filter_add(&filter, hash_bytes("CA", HASH_KEY_STRING));
+
+    printf("\nMay contain CA: %d", cuckoo_filter_contains(&filter, hash_bytes("CA", HASH_KEY_STRING)));
+
+    // Unlike a Bloom filter, keys can be removed
+    cuckoo_filter_remove(&filter, hash_bytes("CA", HASH_KEY_STRING));
+
+    printf("\nMay contain CA after removal: %d", cuckoo_filter_contains(&filter, hash_bytes("CA", HASH_KEY_STRING)));
+    printf("\nFingerprint bits: %d, bytes: %zu", filter.fingerprint_bits, cuckoo_filter_bytes(&filter));
+
+    // Attached to a table, keys removed from the table are removed from the filter
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING, HASH_SWISS);
+    set_hash_table_filter(&table, &filter, &cuckoo_filter_ops);
+
+    put(&table, "CA", "Canada");
+    put(&table, "JP", "Japan");
+    remove_hash(&table, "JP");
+
+    printf("\nValue for key CA: %s", (char *)get(&table, "CA"));
+    printf("\nKeys in filter: %ld\n", filter.num_keys);
+
+    // The table does not free its filter
+    free_hash_table(&table);
+    free_cuckoo_filter(&filter);
+
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ ********************************************************************************
+ * @file    expiring_map_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the expiring_map header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define INIT_TABLE_SIZE 5
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/expiring_map/expiring_map.h"
+
+/*!
+ * @brief Prints each entry removed from the map by expiring.
+ * @param key Key of the expired entry
+ * @param value Value of the expired entry
+ * @param context Unused
+ * @return None
+ */
+void print_expiry(void *key, void *value, void *context)
+{
+    printf("\nExpired %s -> %s", (char *)key, (char *)value);
+}
+
+/*!
+ * @brief main function used to test the functionality of the expiring_map header file.
+ */
+int main(void)
+{
+    expiring_map sessions;
+
+    // Ticks are seconds, starting from 0
+    initialize_expiring_map(&sessions, INIT_TABLE_SIZE, HASH_STRING, 0);
+    set_expiry_callback(&sessions, &print_expiry, NULL);
+
+    expiring_put(&sessions, "alice", "token-a", 0, 30);
+    expiring_put(&sessions, "bob", "token-b", 0, 300);
+
+    printf("\nSession for alice at 10s: %s", (char *)expiring_get(&sessions, "alice", 10));
+    printf("\nSession for alice at 45s: %p", expiring_get(&sessions, "alice", 45));
+
+    // Advancing the clock removes alice's session and leaves bob's
+    printf("\nExpired by 60s: %d", expiring_advance(&sessions, 60));
+    printf("\nNum elems: %d\n", expiring_num_elements(&sessions));
+
+    // Free the memory held by the map
+    free_expiring_map(&sessions);
+
+    return 0;
+}
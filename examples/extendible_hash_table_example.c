@@ -0,0 +1,68 @@
+/**
+ ********************************************************************************
+ * @file    extendible_hash_table_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the extendible_hash_table header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define TABLE_FILE "extendible_hash_table_example.bin"
+#define POOL_PAGES 8
+#define NUM_KEYS 100000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../data_structures/extendible_hash_table/extendible_hash_table.h"
+
+/*!
+ * @brief main function used to test the functionality of the extendible_hash_table header file.
+ */
+int main(void)
+{
+    extendible_hash_table table;
+    uint64_t value;
+
+    // Keys and values are 8 bytes each, and only 8 pages are kept in memory
+    if (!create_extendible_hash_table(&table, TABLE_FILE, sizeof(uint64_t), sizeof(uint64_t), POOL_PAGES))
+    {
+        printf("\nCould not create %s\n", TABLE_FILE);
+        return 1;
+    }
+
+    for (uint64_t key = 1; key <= NUM_KEYS; key++)
+    {
+        value = key * key;
+        extendible_put(&table, &key, &value);
+    }
+
+    printf("\nNum elems: %ld", extendible_num_elements(&table));
+    printf("\nGlobal depth: %u", table.header.global_depth);
+    printf("\nPages: %llu", (unsigned long long)table.header.num_pages);
+    printf("\nSplits: %llu", table.counters.splits);
+
+    close_extendible_hash_table(&table);
+
+    // Reopening reads the directory, each lookup then reads at most one page
+    open_extendible_hash_table(&table, TABLE_FILE, POOL_PAGES);
+
+    uint64_t key = 1234;
+
+    if (extendible_get(&table, &key, &value))
+    {
+        printf("\nValue for key 1234: %llu", (unsigned long long)value);
+    }
+
+    printf("\nPage reads: %llu\n", table.counters.page_reads);
+
+    close_extendible_hash_table(&table);
+    remove(TABLE_FILE);
+
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ ********************************************************************************
+ * @file    hash_ring_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the hash_ring header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_SHARDS 4
+#define NUM_KEYS 10000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../data_structures/hash_ring/hash_ring.h"
+
+/*!
+ * @brief main function used to test the functionality of the hash_ring header file.
+ */
+int main(void)
+{
+    hash_ring ring;
+    int before[NUM_KEYS];
+    int ring_moved = 0;
+    int modulo_moved = 0;
+    int jump_moved = 0;
+
+    initialize_hash_ring(&ring, HASH_RING_DEFAULT_VIRTUAL_NODES);
+
+    for (int shard = 0; shard < NUM_SHARDS; shard++)
+    {
+        hash_ring_add_shard(&ring, shard);
+    }
+
+    const char *name = "user:1234";
+
+    printf("\nShard for key %s: %d", name, hash_ring_lookup(&ring, hash_bytes(name, strlen(name))));
+
+    for (int key = 0; key < NUM_KEYS; key++)
+    {
+        before[key] = hash_ring_lookup(&ring, (uint64_t)key);
+    }
+
+    // Adding a fifth shard moves only the keys it takes over
+    hash_ring_add_shard(&ring, NUM_SHARDS);
+
+    for (int key = 0; key < NUM_KEYS; key++)
+    {
+        ring_moved += hash_ring_lookup(&ring, (uint64_t)key) != before[key];
+        modulo_moved += (hash_mix(key) % NUM_SHARDS) != (hash_mix(key) % (NUM_SHARDS + 1));
+        jump_moved += jump_hash((uint64_t)key, NUM_SHARDS) != jump_hash((uint64_t)key, NUM_SHARDS + 1);
+    }
+
+    printf("\nKeys moved by adding a shard, out of %d", NUM_KEYS);
+    printf("\nHash ring: %d", ring_moved);
+    printf("\nJump hash: %d", jump_moved);
+    printf("\nModulo: %d\n", modulo_moved);
+
+    free_hash_ring(&ring);
+
+    return 0;
+}
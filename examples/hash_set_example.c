@@ -0,0 +1,76 @@
+/**
+ ********************************************************************************
+ * @file    hash_set_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the hash_set header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define INIT_SET_SIZE 5
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/hash_set/hash_set.h"
+
+/*!
+ * @brief Prints a string key.
+ * @param key Key being visited
+ * @param context Unused
+ * @return None
+ */
+void print_key(void *key, void *context)
+{
+    printf(" %s", (char *)key);
+}
+
+/*!
+ * @brief main function used to test the functionality of the hash_set header file.
+ */
+int main(void)
+{
+    hash_set fruit;
+    hash_set red;
+
+    initialize_hash_set(&fruit, INIT_SET_SIZE, LOAD_FACTOR, HASH_STRING);
+    initialize_hash_set(&red, INIT_SET_SIZE, LOAD_FACTOR, HASH_STRING);
+
+    set_add(&fruit, "apple");
+    set_add(&fruit, "banana");
+    set_add(&fruit, "cherry");
+
+    set_add(&red, "apple");
+    set_add(&red, "cherry");
+    set_add(&red, "brick");
+
+    printf("\nNum elems: %d", fruit.num_elements);
+    printf("\nContains banana: %d", set_contains(&fruit, "banana"));
+    printf("\nContains brick: %d", set_contains(&fruit, "brick"));
+
+    // Keep only the fruit which is also red
+    set_intersect(&fruit, &red);
+
+    printf("\nRed fruit:");
+    hash_set_for_each(&fruit, &print_key, NULL);
+
+    // Whatever is left of the red set after removing the fruit
+    set_difference(&red, &fruit);
+
+    printf("\nRed, not fruit:");
+    hash_set_for_each(&red, &print_key, NULL);
+    printf("\nBytes held by the red set: %zu\n", hash_set_bytes(&red));
+
+    // Free the memory held by the hash sets
+    free_hash_set(&fruit);
+    free_hash_set(&red);
+
+    return 0;
+}
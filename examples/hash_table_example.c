@@ -21,6 +21,18 @@
 #include <stdio.h>
 #include "../data_structures/hash_table/hash_table.h"
 
+/*!
+ * @brief Prints a key value pair visited by a scan.
+ * @param key Key of the element
+ * @param value Value of the element
+ * @param context Unused
+ * @return None
+ */
+void print_element(void *key, void *value, void *context)
+{
+    printf(" %ld:%ld", (long)key, (long)value);
+}
+
 /*!
  * @brief main function used to test the functionality of the hash_table header file.
  */
@@ -66,8 +78,58 @@ int main(void)
     // Return the percentage of the table occupied
     printf("\nPercent Occupied: %f", percent_occupied(&table));
 
+    // Scan the table two elements at a time. The table may change between batches
+    uint64_t cursor = 0;
+
+    do
+    {
+        printf("\nBatch:");
+        cursor = hash_table_scan(&table, cursor, 2, &print_element, NULL);
+    } while (cursor != 0);
+
+    printf("\n");
+
     // Free the memory held by the hash table
     free_hash_table(&table);
 
+    // A multimap keeps every value added for a key in one array
+    hash_table index;
+    int count;
+
+    initialize_hash_table_mode(&index, 10, 0.75, HASH_DIVISION, HASH_MULTIMAP);
+
+    append(&index, 7, 101);
+    append(&index, 7, 102);
+    append(&index, 7, 105);
+    remove_value(&index, 7, 102);
+
+    void **values = get_all(&index, 7, &count);
+
+    printf("\nValues for key 7:");
+
+    for (int i = 0; i < count; i++)
+    {
+        printf(" %d", values[i]);
+    }
+
+    printf("\n");
+
+    free_hash_table(&index);
+
+    // An inline table copies fixed size keys and values into its own entries
+    hash_table points;
+    long key = 3;
+    double point[2] = {1.5, -2.0};
+
+    initialize_hash_table_inline(&points, 10, 0.75, sizeof(long), sizeof(point));
+
+    put(&points, &key, point);
+
+    double *stored = (double *)get(&points, &key);
+
+    printf("Point for key 3: (%.1f, %.1f)\n", stored[0], stored[1]);
+
+    free_hash_table(&points);
+
     return 0;
 }
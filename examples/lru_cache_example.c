@@ -0,0 +1,63 @@
+/**
+ ********************************************************************************
+ * @file    lru_cache_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the lru_cache header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define MAX_ENTRIES 2
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/lru_cache/lru_cache.h"
+
+/*!
+ * @brief Prints each entry evicted from the cache.
+ * @param key Key of the evicted entry
+ * @param value Value of the evicted entry
+ * @param context Unused
+ * @return None
+ */
+void print_eviction(void *key, void *value, void *context)
+{
+    printf("\nEvicted %s -> %s", (char *)key, (char *)value);
+}
+
+/*!
+ * @brief main function used to test the functionality of the lru_cache header file.
+ */
+int main(void)
+{
+    lru_cache cache;
+
+    // Holds at most two entries, with no limit on their total size
+    initialize_lru_cache(&cache, MAX_ENTRIES, 0, HASH_STRING);
+    set_lru_eviction_callback(&cache, &print_eviction, NULL);
+
+    lru_put(&cache, "CA", "Canada", 0);
+    lru_put(&cache, "DE", "Germany", 0);
+
+    // Looking up CA makes DE the least recently used entry
+    printf("\nValue for key CA: %s", (char *)lru_get(&cache, "CA"));
+
+    lru_put(&cache, "JP", "Japan", 0);
+
+    printf("\nValue for key DE: %p", lru_get(&cache, "DE"));
+    printf("\nNum elems: %d", lru_num_elements(&cache));
+    printf("\nHits: %llu, misses: %llu, evictions: %llu\n", cache.counters.hits, cache.counters.misses,
+           cache.counters.evictions);
+
+    // Free the memory held by the cache
+    free_lru_cache(&cache);
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ ********************************************************************************
+ * @file    mapped_hash_table_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the mapped_hash_table header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define TABLE_FILE "mapped_hash_table_example.bin"
+#define INIT_TABLE_SIZE 5
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include "../data_structures/mapped_hash_table/mapped_hash_table.h"
+
+/*!
+ * @brief main function used to test the functionality of the mapped_hash_table header file.
+ */
+int main(void)
+{
+    mapped_hash_table table;
+
+    // Create the file and store a few elements in it
+    if (!create_mapped_hash_table(&table, TABLE_FILE, INIT_TABLE_SIZE))
+    {
+        printf("\nCould not create %s\n", TABLE_FILE);
+        return 1;
+    }
+
+    mapped_put(&table, "CA", 2, "Canada", 7);
+    mapped_put(&table, "DE", 2, "Germany", 8);
+    mapped_put(&table, "JP", 2, "Japan", 6);
+
+    // Make sure the elements are on disk before closing
+    mapped_checkpoint(&table);
+    close_mapped_hash_table(&table);
+
+    // Reopening only maps the file, the elements are read as they are looked up
+    open_mapped_hash_table(&table, TABLE_FILE, false);
+
+    printf("\nNum elems: %d", mapped_num_elements(&table));
+    printf("\nValue for key DE: %s", (const char *)mapped_get(&table, "DE", 2, NULL));
+    printf("\nValue for key US: %p\n", mapped_get(&table, "US", 2, NULL));
+
+    close_mapped_hash_table(&table);
+    remove(TABLE_FILE);
+
+    return 0;
+}
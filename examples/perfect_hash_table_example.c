@@ -0,0 +1,58 @@
+/**
+ ********************************************************************************
+ * @file    perfect_hash_table_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the perfect_hash_table header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define INIT_TABLE_SIZE 5
+#define LOAD_FACTOR 0.5
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/perfect_hash_table/perfect_hash_table.h"
+
+/*!
+ * @brief main function used to test the functionality of the perfect_hash_table header file.
+ */
+int main(void)
+{
+    hash_table table;
+    perfect_hash_table perfect;
+
+    // Reference data is loaded into an ordinary hash table first
+    initialize_hash_table(&table, INIT_TABLE_SIZE, LOAD_FACTOR, HASH_STRING);
+
+    put(&table, "CA", "Canada");
+    put(&table, "DE", "Germany");
+    put(&table, "JP", "Japan");
+    put(&table, "NZ", "New Zealand");
+
+    // The finished table is turned into a read only table with one slot per key
+    if (!build_perfect_hash_table(&perfect, &table))
+    {
+        printf("\nBuild failed\n");
+        return 1;
+    }
+
+    free_hash_table(&table);
+
+    printf("\nNum elems: %d", perfect.num_elements);
+    printf("\nValue for key JP: %s", (char *)perfect_get(&perfect, "JP"));
+    printf("\nValue for key NZ: %s", (char *)perfect_get(&perfect, "NZ"));
+    printf("\nValue for key US: %p\n", perfect_get(&perfect, "US"));
+
+    // Free the memory held by the perfect hash table
+    free_perfect_hash_table(&perfect);
+
+    return 0;
+}
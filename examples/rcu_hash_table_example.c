@@ -0,0 +1,72 @@
+/**
+ ********************************************************************************
+ * @file    rcu_hash_table_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the rcu_hash_table header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define INIT_TABLE_SIZE 5
+#define LOAD_FACTOR 0.75
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/rcu_hash_table/rcu_hash_table.h"
+
+// Configuration shared between the threads
+rcu_hash_table config;
+
+/*!
+ * @brief Reads the configuration without taking a lock.
+ * @param argument Unused
+ * @return NULL
+ */
+void *reader(void *argument)
+{
+    // Each thread which reads registers once
+    rcu_reader *handle = rcu_register_reader(&config);
+
+    printf("\nReader sees log level: %s", (char *)rcu_get(&config, handle, "log_level"));
+
+    rcu_unregister_reader(handle);
+
+    return NULL;
+}
+
+/*!
+ * @brief main function used to test the functionality of the rcu_hash_table header file.
+ */
+int main(void)
+{
+    pthread_t thread;
+
+    initialize_rcu_hash_table(&config, INIT_TABLE_SIZE, LOAD_FACTOR, HASH_STRING);
+
+    rcu_put(&config, "log_level", "info");
+    rcu_put(&config, "timeout", "30");
+
+    pthread_create(&thread, NULL, &reader, NULL);
+    pthread_join(thread, NULL);
+
+    // Updates are published to readers without blocking them
+    rcu_put(&config, "log_level", "debug");
+    rcu_remove(&config, "timeout");
+
+    pthread_create(&thread, NULL, &reader, NULL);
+    pthread_join(thread, NULL);
+
+    printf("\nNum elems: %d\n", rcu_num_elements(&config));
+
+    // Free the memory held by the table
+    free_rcu_hash_table(&config);
+
+    return 0;
+}
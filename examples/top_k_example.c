@@ -0,0 +1,59 @@
+/**
+ ********************************************************************************
+ * @file    top_k_example.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Tests the functionality of the operations defined in
+ *          the top_k header file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define K 3
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <stdio.h>
+#include "../data_structures/sketches/top_k.h"
+
+/*!
+ * @brief main function used to test the functionality of the top_k header file.
+ */
+int main(void)
+{
+    count_min_sketch sketch;
+    top_k tracker;
+    char *requests[] = {"/index.html", "/login", "/index.html", "/about.html", "/cart",
+                        "/index.html", "/login", "/search", "/index.html", "/login"};
+    void *keys[K];
+    uint32_t counts[K];
+
+    initialize_count_min_sketch(&sketch, 0.001, 0.01);
+
+    // Only the 3 most frequent keys are kept, while the sketch counts every key
+    initialize_top_k(&tracker, K, &sketch, HASH_STRING);
+
+    for (int i = 0; i < 10; i++)
+    {
+        top_k_add(&tracker, requests[i], 1);
+    }
+
+    int count = top_k_items(&tracker, keys, counts);
+
+    for (int i = 0; i < count; i++)
+    {
+        printf("\n%s: %u", (char *)keys[i], counts[i]);
+    }
+
+    printf("\nEstimate for /search: %u\n", top_k_estimate(&tracker, "/search"));
+
+    // The tracker does not free its sketch
+    free_top_k(&tracker);
+    free_count_min_sketch(&sketch);
+
+    return 0;
+}
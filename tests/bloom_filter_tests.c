@@ -0,0 +1,241 @@
+/**
+ ********************************************************************************
+ * @file    bloom_filter_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the bloom_filter.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.75
+#define NUM_KEYS 100000
+#define NUM_PROBES 200000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/filters/bloom_filter.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Returns the hash of an integer key
+ * @param key Key to hash
+ * @return A 64 bit hash of the key
+ */
+uint64_t key_hash(long key)
+{
+    return hash_fibonacci((void *)key, HASH_KEY_POINTER);
+}
+
+/*!
+ * @brief Measures the fraction of keys never added which a filter reports present
+ * @param filter Pointer to a Bloom filter holding the keys 1 to NUM_KEYS
+ * @return The measured false positive rate
+ */
+double measure_false_positives(bloom_filter *filter)
+{
+    long false_positives = 0;
+
+    for (long i = NUM_KEYS + 1; i <= NUM_KEYS + NUM_PROBES; i++)
+    {
+        false_positives += bloom_contains(filter, key_hash(i));
+    }
+
+    return (double)false_positives / NUM_PROBES;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests that every added key is reported present, at several false positive rates
+ * @return  None
+ */
+void no_false_negatives_test()
+{
+    double rates[] = {0.1, 0.01, 0.0001};
+
+    for (int r = 0; r < 3; r++)
+    {
+        bloom_filter filter;
+
+        initialize_bloom_filter(&filter, NUM_KEYS, rates[r]);
+
+        assert(!bloom_contains(&filter, key_hash(1)));
+
+        for (long i = 1; i <= NUM_KEYS; i++)
+        {
+            bloom_add(&filter, key_hash(i));
+        }
+
+        assert(filter.num_keys == NUM_KEYS);
+
+        for (long i = 1; i <= NUM_KEYS; i++)
+        {
+            assert(bloom_contains(&filter, key_hash(i)));
+        }
+
+        free_bloom_filter(&filter);
+        assert(filter.blocks == NULL);
+    }
+}
+
+/*!
+ * @brief Tests that the measured false positive rate stays near the rate the filter
+ *        was sized for
+ * @return  None
+ */
+void false_positive_rate_test()
+{
+    double rates[] = {0.05, 0.01, 0.001};
+
+    for (int r = 0; r < 3; r++)
+    {
+        bloom_filter filter;
+
+        initialize_bloom_filter(&filter, NUM_KEYS, rates[r]);
+
+        for (long i = 1; i <= NUM_KEYS; i++)
+        {
+            bloom_add(&filter, key_hash(i));
+        }
+
+        double measured = measure_false_positives(&filter);
+
+        assert(measured <= rates[r] * 1.5);
+
+        free_bloom_filter(&filter);
+    }
+}
+
+/*!
+ * @brief Tests sizing by bits per key, where more bits give fewer false positives
+ * @return  None
+ */
+void bits_per_key_test()
+{
+    bloom_filter small;
+    bloom_filter large;
+
+    initialize_bloom_filter_bits(&small, NUM_KEYS, 6);
+    initialize_bloom_filter_bits(&large, NUM_KEYS, 16);
+
+    // Blocks are whole cache lines, so the size is rounded up to a block
+    assert(bloom_filter_bytes(&small) >= NUM_KEYS * 6 / 8);
+    assert(bloom_filter_bytes(&small) < NUM_KEYS * 6 / 8 + BLOOM_BLOCK_BITS / 8);
+    assert(small.num_hashes == 4 && large.num_hashes == 11);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        bloom_add(&small, key_hash(i));
+        bloom_add(&large, key_hash(i));
+    }
+
+    assert(measure_false_positives(&large) < measure_false_positives(&small));
+
+    free_bloom_filter(&small);
+    free_bloom_filter(&large);
+}
+
+/*!
+ * @brief Tests that clearing a filter forgets every key
+ * @return  None
+ */
+void clear_test()
+{
+    bloom_filter filter;
+
+    initialize_bloom_filter(&filter, 1, 0.01);
+
+    // A single key still gets a whole block
+    assert(filter.num_blocks == 1);
+
+    bloom_add(&filter, key_hash(7));
+    assert(bloom_contains(&filter, key_hash(7)));
+
+    bloom_clear(&filter);
+
+    assert(!bloom_contains(&filter, key_hash(7)));
+    assert(filter.num_keys == 0);
+
+    free_bloom_filter(&filter);
+}
+
+/*!
+ * @brief Tests a Bloom filter attached to a hash table, including keys present before it
+ *        was attached and keys removed afterwards
+ * @return  None
+ */
+void hash_table_filter_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO, HASH_MULTIMAP};
+
+    for (int m = 0; m < 5; m++)
+    {
+        hash_table table;
+        bloom_filter filter;
+        void *values[4];
+        void *keys[4] = {(void *)2, (void *)(NUM_KEYS + 1), (void *)4, (void *)(NUM_KEYS + 2)};
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+        initialize_bloom_filter(&filter, NUM_KEYS, 0.01);
+
+        for (long i = 1; i <= NUM_KEYS / 2; i++)
+        {
+            put(&table, (void *)i, (void *)(i * 2));
+        }
+
+        set_hash_table_filter(&table, &filter, &bloom_filter_ops);
+
+        for (long i = NUM_KEYS / 2 + 1; i <= NUM_KEYS; i++)
+        {
+            put(&table, (void *)i, (void *)(i * 2));
+        }
+
+        assert(filter.num_keys == NUM_KEYS);
+
+        for (long i = 1; i <= NUM_KEYS; i++)
+        {
+            assert(get(&table, (void *)i) == (void *)(i * 2));
+        }
+
+        for (long i = NUM_KEYS + 1; i <= NUM_KEYS * 2; i++)
+        {
+            assert(get(&table, (void *)i) == NULL);
+        }
+
+        // A removed key stays in the filter, but the table still reports it absent
+        remove_hash(&table, (void *)3);
+        assert(get(&table, (void *)3) == NULL);
+
+        get_many(&table, keys, 4, values);
+        assert(values[0] == (void *)4 && values[1] == NULL && values[2] == (void *)8 && values[3] == NULL);
+
+        free_hash_table(&table);
+        free_bloom_filter(&filter);
+    }
+}
+
+int main(void)
+{
+    no_false_negatives_test();
+    false_positive_rate_test();
+    bits_per_key_test();
+    clear_test();
+
+    hash_table_filter_test();
+
+    printf("\nBloom filter tests passed.\n\n");
+
+    return 0;
+}
@@ -0,0 +1,412 @@
+/**
+ ********************************************************************************
+ * @file    concurrent_hash_table_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the concurrent_hash_table.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_SHARDS 8
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.5
+#define NUM_THREADS 4
+#define KEYS_PER_THREAD 20000
+#define CHURN_WINDOW 1000
+#define CHURN_KEYS 200000
+#define STRING_KEYS 50000
+#define STRING_KEY_LENGTH 16
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/concurrent_hash_table/concurrent_hash_table.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+// Table shared by the threads of the multithreaded test
+concurrent_hash_table shared_table;
+
+// String keys of the string churn test, which stay valid while readers may compare them
+char string_keys[STRING_KEYS][STRING_KEY_LENGTH];
+
+// Number of string keys the string churn writer has added
+atomic_long strings_added;
+
+/*!
+ * @brief Writes a distinct range of keys, removing every third one again
+ * @param argument Index of the writer thread
+ * @return NULL
+ */
+void *writer(void *argument)
+{
+    long first = (long)argument * KEYS_PER_THREAD + 1;
+
+    for (long key = first; key < first + KEYS_PER_THREAD; key++)
+    {
+        concurrent_put(&shared_table, (void *)key, (void *)(key * 2));
+
+        if (key % 3 == 0)
+        {
+            concurrent_remove(&shared_table, (void *)key);
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Reads keys while they are being written. A key is either missing or maps to its value
+ * @param argument Unused
+ * @return NULL
+ */
+void *reader(void *argument)
+{
+    for (int pass = 0; pass < 5; pass++)
+    {
+        for (long key = 1; key <= NUM_THREADS * KEYS_PER_THREAD; key++)
+        {
+            void *value = concurrent_get(&shared_table, (void *)key);
+
+            assert(value == NULL || value == (void *)(key * 2));
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Keeps a sliding window of keys in the table, adding the newest key and removing
+ *        the oldest, so deleted markers keep building up
+ * @param argument Unused
+ * @return NULL
+ */
+void *churn_writer(void *argument)
+{
+    for (long key = 1; key <= CHURN_KEYS; key++)
+    {
+        concurrent_put(&shared_table, (void *)key, (void *)(key * 2));
+
+        if (key > CHURN_WINDOW)
+        {
+            concurrent_remove(&shared_table, (void *)(key - CHURN_WINDOW));
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Reads keys around the sliding window while it moves. A key is either missing or
+ *        maps to its value
+ * @param argument Unused
+ * @return NULL
+ */
+void *churn_reader(void *argument)
+{
+    for (int pass = 0; pass < 20; pass++)
+    {
+        for (long key = 1; key <= CHURN_KEYS; key += 7)
+        {
+            void *value = concurrent_get(&shared_table, (void *)key);
+
+            assert(value == NULL || value == (void *)(key * 2));
+        }
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Keeps a sliding window of string keys in the table, so readers keep matching
+ *        tags of slots whose keys are being cleared
+ * @param argument Unused
+ * @return NULL
+ */
+void *string_churn_writer(void *argument)
+{
+    for (long i = 0; i < STRING_KEYS; i++)
+    {
+        concurrent_put(&shared_table, string_keys[i], (void *)(i + 1));
+
+        if (i >= CHURN_WINDOW)
+        {
+            concurrent_remove(&shared_table, string_keys[i - CHURN_WINDOW]);
+        }
+
+        atomic_store(&strings_added, i + 1);
+    }
+
+    return NULL;
+}
+
+/*!
+ * @brief Reads the string keys at both ends of the sliding window until the writer is
+ *        done. Each lookup is made with a copy of the key, so stored keys are compared
+ *        with strcmp rather than matched by pointer
+ * @param argument Unused
+ * @return NULL
+ */
+void *string_churn_reader(void *argument)
+{
+    char key[STRING_KEY_LENGTH];
+    long added;
+
+    while ((added = atomic_load(&strings_added)) < STRING_KEYS)
+    {
+        // The oldest keys are being removed and the newest added
+        for (long i = added - CHURN_WINDOW - 16; i < added + 16; i++)
+        {
+            if (i < 0 || i >= STRING_KEYS || (i > added - CHURN_WINDOW + 16 && i < added - 16))
+            {
+                continue;
+            }
+
+            strcpy(key, string_keys[i]);
+
+            void *value = concurrent_get(&shared_table, key);
+
+            assert(value == NULL || value == (void *)(i + 1));
+        }
+    }
+
+    return NULL;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests initialization of a concurrent hash table
+ * @return  None
+ */
+void init_test()
+{
+    concurrent_hash_table table;
+
+    // The number of shards is rounded up to a power of two
+    initialize_concurrent_hash_table(&table, 5, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION);
+
+    assert(table.num_shards == NUM_SHARDS);
+    assert(concurrent_num_elements(&table) == 0);
+
+    for (int i = 0; i < table.num_shards; i++)
+    {
+        assert(table.shards[i].current->table.mode == HASH_SWISS);
+        assert(table.shards[i].retired == NULL);
+    }
+
+    free_concurrent_hash_table(&table);
+
+    assert(table.shards == NULL);
+}
+
+/*!
+ * @brief Tests adding, retrieving and removing elements from a single thread
+ * @return  None
+ */
+void put_get_remove_test()
+{
+    concurrent_hash_table table;
+
+    initialize_concurrent_hash_table(&table, NUM_SHARDS, NUM_ELEMS, LOAD_FACTOR, HASH_STRING);
+
+    concurrent_put(&table, "Test1", 1);
+    concurrent_put(&table, "Test2", 2);
+    concurrent_put(&table, "Test1", 3);
+
+    assert(concurrent_num_elements(&table) == 2);
+    assert(concurrent_get(&table, "Test1") == 3);
+    assert(concurrent_get(&table, "Test2") == 2);
+    assert(concurrent_get(&table, "Test3") == NULL);
+
+    concurrent_remove(&table, "Test1");
+
+    assert(concurrent_num_elements(&table) == 1);
+    assert(concurrent_get(&table, "Test1") == NULL);
+
+    free_concurrent_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that shards grow and keep all of their elements
+ * @return  None
+ */
+void growth_test()
+{
+    concurrent_hash_table table;
+
+    initialize_concurrent_hash_table(&table, NUM_SHARDS, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    for (long i = 1; i <= 10000; i++)
+    {
+        concurrent_put(&table, i, i + 1);
+    }
+
+    assert(concurrent_num_elements(&table) == 10000);
+
+    for (long i = 1; i <= 10000; i++)
+    {
+        assert(concurrent_get(&table, i) == i + 1);
+    }
+
+    // Without readers, a replaced table is freed by the puts following its rebuild
+    for (int i = 0; i < table.num_shards; i++)
+    {
+        assert(table.shards[i].retired == NULL || table.shards[i].retired->retired_next == NULL);
+    }
+
+    free_concurrent_hash_table(&table);
+}
+
+/*!
+ * @brief Tests concurrent writers and lock free readers
+ * @return  None
+ */
+void multithreaded_test()
+{
+    pthread_t writers[NUM_THREADS];
+    pthread_t readers[NUM_THREADS];
+
+    initialize_concurrent_hash_table(&shared_table, NUM_SHARDS, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    for (long i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_create(&writers[i], NULL, &writer, (void *)i);
+        pthread_create(&readers[i], NULL, &reader, NULL);
+    }
+
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_join(writers[i], NULL);
+        pthread_join(readers[i], NULL);
+    }
+
+    for (long key = 1; key <= NUM_THREADS * KEYS_PER_THREAD; key++)
+    {
+        void *expected = (key % 3 == 0) ? NULL : (void *)(key * 2);
+
+        assert(concurrent_get(&shared_table, (void *)key) == expected);
+    }
+
+    free_concurrent_hash_table(&shared_table);
+}
+
+/*!
+ * @brief Tests lock free readers of a shard whose deleted markers force it to be rebuilt
+ *        at the same size while they read
+ * @return  None
+ */
+void churn_test()
+{
+    pthread_t writer_thread;
+    pthread_t readers[NUM_THREADS];
+
+    initialize_concurrent_hash_table(&shared_table, 1, CHURN_WINDOW, LOAD_FACTOR, HASH_FIBONACCI);
+
+    int table_size = shared_table.shards[0].current->table.table_size;
+
+    pthread_create(&writer_thread, NULL, &churn_writer, NULL);
+
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_create(&readers[i], NULL, &churn_reader, NULL);
+    }
+
+    pthread_join(writer_thread, NULL);
+
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_join(readers[i], NULL);
+    }
+
+    assert(concurrent_num_elements(&shared_table) == CHURN_WINDOW);
+
+    for (long key = 1; key <= CHURN_KEYS; key++)
+    {
+        void *expected = (key > CHURN_KEYS - CHURN_WINDOW) ? (void *)(key * 2) : NULL;
+
+        assert(concurrent_get(&shared_table, (void *)key) == expected);
+    }
+
+    // The window never outgrows the shard, so it was only ever rebuilt at the same size
+    assert(shared_table.shards[0].current->table.table_size == table_size);
+    // Rebuilds advanced the epoch. With the readers gone, the next puts free every table
+    // the rebuilds replaced, rather than keeping them until the table is freed
+    assert(shared_table.shards[0].epoch > 1);
+
+    for (int i = 0; i < 3; i++)
+    {
+        concurrent_put(&shared_table, (void *)(CHURN_KEYS + 1), (void *)1);
+    }
+
+    assert(shared_table.shards[0].retired == NULL);
+
+    free_concurrent_hash_table(&shared_table);
+}
+
+/*!
+ * @brief Tests lock free readers comparing string keys against slots which writers are
+ *        filling and clearing
+ * @return  None
+ */
+void string_churn_test()
+{
+    pthread_t writer_thread;
+    pthread_t readers[NUM_THREADS];
+
+    for (int i = 0; i < STRING_KEYS; i++)
+    {
+        sprintf(string_keys[i], "key%d", i);
+    }
+
+    atomic_init(&strings_added, 0);
+    initialize_concurrent_hash_table(&shared_table, 1, CHURN_WINDOW, LOAD_FACTOR, HASH_STRING);
+
+    pthread_create(&writer_thread, NULL, &string_churn_writer, NULL);
+
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_create(&readers[i], NULL, &string_churn_reader, NULL);
+    }
+
+    pthread_join(writer_thread, NULL);
+
+    for (int i = 0; i < NUM_THREADS; i++)
+    {
+        pthread_join(readers[i], NULL);
+    }
+
+    assert(concurrent_num_elements(&shared_table) == CHURN_WINDOW);
+
+    for (long i = 0; i < STRING_KEYS; i++)
+    {
+        void *expected = (i >= STRING_KEYS - CHURN_WINDOW) ? (void *)(i + 1) : NULL;
+
+        assert(concurrent_get(&shared_table, string_keys[i]) == expected);
+    }
+
+    free_concurrent_hash_table(&shared_table);
+}
+
+int main(void)
+{
+    init_test();
+    put_get_remove_test();
+    growth_test();
+    multithreaded_test();
+    churn_test();
+    string_churn_test();
+
+    printf("\nConcurrent hash table tests passed.\n\n");
+
+    return 0;
+}
@@ -0,0 +1,192 @@
+/**
+ ********************************************************************************
+ * @file    count_min_sketch_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the count_min_sketch.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_KEYS 100000
+#define EPSILON 0.001
+#define DELTA 0.01
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/sketches/count_min_sketch.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Returns the hash of an integer key
+ * @param key Key to hash
+ * @return A 64 bit hash of the key
+ */
+uint64_t key_hash(long key)
+{
+    return hash_fibonacci((void *)key, HASH_KEY_POINTER);
+}
+
+/*!
+ * @brief Returns the true count of a key in the skewed stream used by the tests
+ * @param key Key from 1 to NUM_KEYS
+ * @return Number of times the key occurs
+ */
+uint32_t true_count(long key)
+{
+    return (uint32_t)(NUM_KEYS / key);
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests the dimensions chosen for an error bound and confidence
+ * @return  None
+ */
+void sizing_test()
+{
+    count_min_sketch sketch;
+
+    // e / 0.001 is 2719 counters, rounded up to a power of two, and ln(100) rounds up to 5 rows
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+    assert(sketch.width == 4096 && sketch.depth == 5);
+    assert(count_min_sketch_bytes(&sketch) == 4096 * 5 * sizeof(uint32_t));
+    free_count_min_sketch(&sketch);
+    assert(sketch.counters == NULL);
+
+    // Rows are never narrower than a cache line, nor deeper than the limit
+    initialize_count_min_sketch_size(&sketch, 3, 100);
+    assert(sketch.width == 16 && sketch.depth == COUNT_MIN_MAX_DEPTH);
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests that estimates never fall below the true count and stay within the
+ *        error bound for nearly every key, on a skewed stream
+ * @return  None
+ */
+void error_bound_test()
+{
+    count_min_sketch sketch;
+    long outside_bound = 0;
+
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+
+    for (long key = 1; key <= NUM_KEYS; key++)
+    {
+        count_min_add(&sketch, key_hash(key), true_count(key));
+    }
+
+    double bound = EPSILON * (double)sketch.total;
+
+    for (long key = 1; key <= NUM_KEYS; key++)
+    {
+        uint32_t estimate = count_min_estimate(&sketch, key_hash(key));
+
+        assert(estimate >= true_count(key));
+        outside_bound += (estimate - true_count(key) > bound);
+    }
+
+    assert(outside_bound <= NUM_KEYS * DELTA);
+
+    // The most frequent keys are estimated closely
+    assert(count_min_estimate(&sketch, key_hash(1)) - true_count(1) <= bound);
+
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests that conservative update raises only the counters below the new
+ *        estimate, and returns the estimate after each addition
+ * @return  None
+ */
+void conservative_update_test()
+{
+    count_min_sketch sketch;
+    uint64_t sum = 0;
+
+    // Rows of a single cache line force keys to share counters
+    initialize_count_min_sketch_size(&sketch, 1, 4);
+
+    assert(count_min_add(&sketch, key_hash(1), 5) == 5);
+    assert(count_min_add(&sketch, key_hash(1), 3) == 8);
+    assert(count_min_estimate(&sketch, key_hash(1)) == 8);
+
+    for (long key = 2; key <= 100; key++)
+    {
+        count_min_add(&sketch, key_hash(key), 1);
+    }
+
+    // Counters hold at most the largest estimate, where plain updates would sum every count
+    for (int i = 0; i < sketch.width * sketch.depth; i++)
+    {
+        assert((sketch.counters)[i] <= sketch.total);
+        sum += (sketch.counters)[i];
+    }
+
+    assert(sum < sketch.total * sketch.depth);
+    assert(sketch.total == 107);
+
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests that counters stop at the largest count rather than wrapping
+ * @return  None
+ */
+void saturation_test()
+{
+    count_min_sketch sketch;
+
+    initialize_count_min_sketch_size(&sketch, 64, 2);
+
+    count_min_add(&sketch, key_hash(1), COUNT_MIN_MAX_COUNT - 5);
+    assert(count_min_add(&sketch, key_hash(1), 10) == COUNT_MIN_MAX_COUNT);
+    assert(count_min_estimate(&sketch, key_hash(1)) == COUNT_MIN_MAX_COUNT);
+
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests that clearing a sketch resets every estimate
+ * @return  None
+ */
+void clear_test()
+{
+    count_min_sketch sketch;
+
+    initialize_count_min_sketch(&sketch, 0.01, 0.01);
+
+    count_min_add(&sketch, key_hash(7), 3);
+    assert(count_min_estimate(&sketch, key_hash(7)) == 3);
+
+    count_min_clear(&sketch);
+
+    assert(count_min_estimate(&sketch, key_hash(7)) == 0);
+    assert(sketch.total == 0);
+
+    free_count_min_sketch(&sketch);
+}
+
+int main(void)
+{
+    sizing_test();
+    error_bound_test();
+    conservative_update_test();
+    saturation_test();
+    clear_test();
+
+    printf("\nCount-min sketch tests passed.\n\n");
+
+    return 0;
+}
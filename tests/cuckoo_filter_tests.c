@@ -0,0 +1,342 @@
+/**
+ ********************************************************************************
+ * @file    cuckoo_filter_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the cuckoo_filter.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.75
+#define NUM_KEYS 100000
+#define NUM_PROBES 200000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/filters/cuckoo_filter.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Returns the hash of an integer key
+ * @param key Key to hash
+ * @return A 64 bit hash of the key
+ */
+uint64_t key_hash(long key)
+{
+    return hash_fibonacci((void *)key, HASH_KEY_POINTER);
+}
+
+/*!
+ * @brief Measures the fraction of keys never added which a filter reports present
+ * @param filter Pointer to a cuckoo filter holding the keys 1 to NUM_KEYS
+ * @return The measured false positive rate
+ */
+double measure_false_positives(cuckoo_filter *filter)
+{
+    long false_positives = 0;
+
+    for (long i = NUM_KEYS + 1; i <= NUM_KEYS + NUM_PROBES; i++)
+    {
+        false_positives += cuckoo_filter_contains(filter, key_hash(i));
+    }
+
+    return (double)false_positives / NUM_PROBES;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests adding keys up to the expected count, with every key reported present
+ * @return  None
+ */
+void add_contains_test()
+{
+    cuckoo_filter filter;
+
+    initialize_cuckoo_filter(&filter, NUM_KEYS, 0.01);
+
+    assert(!cuckoo_filter_contains(&filter, key_hash(1)));
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(cuckoo_filter_add(&filter, key_hash(i)));
+    }
+
+    assert(filter.num_keys == NUM_KEYS);
+    assert(!filter.overflowed);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(cuckoo_filter_contains(&filter, key_hash(i)));
+    }
+
+    free_cuckoo_filter(&filter);
+    assert(filter.slots == NULL);
+}
+
+/*!
+ * @brief Tests removing keys, including a key added twice
+ * @return  None
+ */
+void remove_test()
+{
+    cuckoo_filter filter;
+
+    initialize_cuckoo_filter(&filter, NUM_KEYS, 0.001);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        cuckoo_filter_add(&filter, key_hash(i));
+    }
+
+    // Removing the odd keys leaves the even ones present
+    for (long i = 1; i <= NUM_KEYS; i += 2)
+    {
+        assert(cuckoo_filter_remove(&filter, key_hash(i)));
+    }
+
+    assert(filter.num_keys == NUM_KEYS / 2);
+
+    long still_present = 0;
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        if (i % 2 == 0)
+        {
+            assert(cuckoo_filter_contains(&filter, key_hash(i)));
+        }
+        else
+        {
+            still_present += cuckoo_filter_contains(&filter, key_hash(i));
+        }
+    }
+
+    // Removed keys are only reported present as false positives
+    assert(still_present < NUM_KEYS / 2 / 100);
+
+    // A key added twice must be removed twice
+    cuckoo_filter_add(&filter, key_hash(1));
+    cuckoo_filter_add(&filter, key_hash(1));
+    assert(cuckoo_filter_remove(&filter, key_hash(1)));
+    assert(cuckoo_filter_contains(&filter, key_hash(1)));
+    assert(cuckoo_filter_remove(&filter, key_hash(1)));
+
+    free_cuckoo_filter(&filter);
+}
+
+/*!
+ * @brief Tests fingerprint sizing from a false positive rate and from bits per key
+ * @return  None
+ */
+void sizing_test()
+{
+    cuckoo_filter filter;
+
+    // 2 buckets of 4 slots need 8 bits for 1 in 32, a single byte
+    initialize_cuckoo_filter(&filter, NUM_KEYS, 1.0 / 32);
+    assert(filter.fingerprint_bits == 8 && filter.fingerprint_bytes == 1);
+    assert(cuckoo_filter_bytes(&filter) == (size_t)filter.num_buckets * CUCKOO_FILTER_BUCKET_SLOTS);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        cuckoo_filter_add(&filter, key_hash(i));
+    }
+
+    assert(measure_false_positives(&filter) <= 1.0 / 32);
+    free_cuckoo_filter(&filter);
+
+    // Fingerprints of more than a byte are widened to use both bytes
+    initialize_cuckoo_filter(&filter, NUM_KEYS, 0.001);
+    assert(filter.fingerprint_bits == 16 && filter.fingerprint_bytes == 2);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        cuckoo_filter_add(&filter, key_hash(i));
+    }
+
+    assert(measure_false_positives(&filter) <= 0.001);
+    free_cuckoo_filter(&filter);
+
+    initialize_cuckoo_filter_bits(&filter, NUM_KEYS, 6);
+    assert(filter.fingerprint_bits == 5);
+    free_cuckoo_filter(&filter);
+}
+
+/*!
+ * @brief Tests that a filter given more keys than it holds reports them all present,
+ *        and is usable again once cleared
+ * @return  None
+ */
+void overflow_test()
+{
+    cuckoo_filter filter;
+    bool full = false;
+
+    initialize_cuckoo_filter(&filter, 100, 0.01);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        full = !cuckoo_filter_add(&filter, key_hash(i)) || full;
+    }
+
+    assert(full && filter.overflowed);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        assert(cuckoo_filter_contains(&filter, key_hash(i)));
+    }
+
+    cuckoo_filter_clear(&filter);
+
+    assert(!filter.overflowed && filter.num_keys == 0);
+    assert(!cuckoo_filter_contains(&filter, key_hash(1)));
+    assert(cuckoo_filter_add(&filter, key_hash(1)));
+    assert(cuckoo_filter_contains(&filter, key_hash(1)));
+
+    free_cuckoo_filter(&filter);
+}
+
+/*!
+ * @brief Tests a cuckoo filter attached to a hash table in every mode, which forgets keys
+ *        removed from the table and counts each key once however often it is put
+ * @return  None
+ */
+void hash_table_filter_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO, HASH_MULTIMAP};
+
+    for (int m = 0; m < 5; m++)
+    {
+        hash_table table;
+        cuckoo_filter filter;
+        int count;
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+        initialize_cuckoo_filter(&filter, NUM_KEYS, 0.001);
+
+        for (long i = 1; i <= NUM_KEYS / 2; i++)
+        {
+            put(&table, (void *)i, (void *)(i * 2));
+        }
+
+        set_hash_table_filter(&table, &filter, &cuckoo_filter_ops);
+
+        for (long i = NUM_KEYS / 2 + 1; i <= NUM_KEYS; i++)
+        {
+            put(&table, (void *)i, (void *)(i * 2));
+        }
+
+        // Updating a key, or adding a multimap value, does not add it again
+        if (modes[m] != HASH_CHAINING)
+        {
+            put(&table, (void *)1, (void *)2);
+        }
+
+        assert(filter.num_keys == NUM_KEYS);
+
+        for (long i = 1; i <= NUM_KEYS; i++)
+        {
+            assert(get(&table, (void *)i) == (void *)(i * 2));
+        }
+
+        for (long i = 1; i <= NUM_KEYS; i += 2)
+        {
+            remove_hash(&table, (void *)i);
+        }
+
+        // Removing an absent key leaves the filter alone
+        remove_hash(&table, (void *)(NUM_KEYS + 1));
+
+        assert(filter.num_keys == NUM_KEYS / 2);
+
+        for (long i = 1; i <= NUM_KEYS; i++)
+        {
+            assert(get(&table, (void *)i) == ((i % 2 == 0) ? (void *)(i * 2) : NULL));
+        }
+
+        assert(get_all(&table, (void *)1, &count) == NULL && count == 0);
+
+        // Detaching the filter leaves lookups working
+        set_hash_table_filter(&table, NULL, NULL);
+        assert(get(&table, (void *)2) == (void *)4);
+        assert(get(&table, (void *)3) == NULL);
+
+        free_hash_table(&table);
+        free_cuckoo_filter(&filter);
+    }
+}
+
+/*!
+ * @brief Tests that a bulk load adds each new key to an attached filter once, and leaves
+ *        out keys the table already held
+ * @return  None
+ */
+void hash_table_bulk_load_filter_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_MULTIMAP};
+    void **keys = (void **)malloc(NUM_KEYS * sizeof(void *));
+    void **values = (void **)malloc(NUM_KEYS * sizeof(void *));
+
+    // Each key is given twice
+    for (long i = 0; i < NUM_KEYS; i++)
+    {
+        keys[i] = (void *)(i % (NUM_KEYS / 2) + 1);
+        values[i] = (void *)(i + 1);
+    }
+
+    for (int m = 0; m < 3; m++)
+    {
+        hash_table table;
+        cuckoo_filter filter;
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+        // Chaining adds a fingerprint for each element, so repeated keys need room
+        initialize_cuckoo_filter(&filter, NUM_KEYS * 2, 0.001);
+        set_hash_table_filter(&table, &filter, &cuckoo_filter_ops);
+
+        put(&table, (void *)1, (void *)1);
+
+        hash_table_bulk_load(&table, keys, values, NUM_KEYS, 4);
+
+        // Chaining stores every put as an element of its own
+        assert(filter.num_keys == ((modes[m] == HASH_CHAINING) ? NUM_KEYS + 1 : NUM_KEYS / 2));
+
+        for (long i = 1; i <= NUM_KEYS / 2; i++)
+        {
+            assert(get(&table, (void *)i) != NULL);
+        }
+
+        free_hash_table(&table);
+        free_cuckoo_filter(&filter);
+    }
+
+    free(keys);
+    free(values);
+}
+
+int main(void)
+{
+    add_contains_test();
+    remove_test();
+    sizing_test();
+    overflow_test();
+
+    hash_table_filter_test();
+    hash_table_bulk_load_filter_test();
+
+    printf("\nCuckoo filter tests passed.\n\n");
+
+    return 0;
+}
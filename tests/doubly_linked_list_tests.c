@@ -478,11 +478,56 @@ void size_test()
     free_doubly_linked_list(&list);
 }
 
+/*!
+ * @brief Tests that node handles can be moved to the head and unlinked from any position
+ * @return  None
+ */
+void handle_test()
+{
+    doubly_linked_list list;
+
+    // Initialize the list
+    initialize_dl_list(&list);
+
+    doubly_linked_list_node *node1 = push_dl_node_to_head(&list, (void *)1);
+    doubly_linked_list_node *node2 = push_dl_node_to_head(&list, (void *)2);
+    doubly_linked_list_node *node3 = push_dl_node_to_head(&list, (void *)3);
+
+    // Checks the order is 3, 2, 1 and each handle holds its own value
+    assert(list.list_size == 3);
+    assert(list.head == node3 && list.tail == node1);
+    assert(node2->value == (void *)2);
+
+    // Moving the tail to the head gives the order 1, 3, 2
+    move_dl_node_to_head(&list, node1);
+    assert(list.head == node1 && list.tail == node2);
+    assert(node1->previous == NULL && node1->next == node3);
+    assert(node3->previous == node1 && node2->next == NULL);
+
+    // Moving the head to the head leaves the list unchanged
+    move_dl_node_to_head(&list, node1);
+    assert(list.head == node1);
+
+    // Unlinking the middle, tail and head in turn
+    assert(unlink_dl_node(&list, node3) == (void *)3);
+    assert(node1->next == node2 && node2->previous == node1);
+    assert(unlink_dl_node(&list, node2) == (void *)2);
+    assert(list.tail == node1 && node1->next == NULL);
+    assert(unlink_dl_node(&list, node1) == (void *)1);
+
+    // Checks the list is empty
+    assert(list.list_size == 0);
+    assert(list.head == NULL);
+    assert(list.tail == NULL);
+}
+
 /*!
  * @brief Runs the above tests
  */
 int main(void)
 {
+    handle_test();
+
     init_test();
     free_empty_test();
 
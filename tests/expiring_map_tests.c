@@ -0,0 +1,205 @@
+/**
+ ********************************************************************************
+ * @file    expiring_map_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the expiring_map.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define NUM_KEYS 100000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/expiring_map/expiring_map.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Struct recording the expiries seen by check_expiry
+ */
+typedef struct expiry_record
+{
+    // Map the expiries come from
+    expiring_map *map;
+    // Tick the map was at before the current advance
+    uint64_t previous_now;
+    // Number of expiries seen
+    int count;
+} expiry_record;
+
+/*!
+ * @brief Checks that an entry expires during the advance which passes its expiry tick.
+ *        Values hold the tick each key expires at
+ * @param key Key of the expired entry
+ * @param value Tick at which the entry was due
+ * @param context Pointer to an expiry_record
+ * @return None
+ */
+void check_expiry(void *key, void *value, void *context)
+{
+    expiry_record *record = (expiry_record *)context;
+    uint64_t due = (uint64_t)(uintptr_t)value;
+
+    assert(due > record->previous_now || record->previous_now == 0);
+    assert(due <= record->map->now);
+    record->count++;
+}
+
+/*!
+ * @brief Returns the next value of a xorshift pseudo random generator
+ * @param state Pointer to the generator state
+ * @return A pseudo random integer
+ */
+uint64_t next_random(uint64_t *state)
+{
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+
+    return *state;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests that entries are returned before their expiry and rejected at and after it
+ * @return  None
+ */
+void lazy_expiry_test()
+{
+    expiring_map map;
+
+    initialize_expiring_map(&map, NUM_ELEMS, HASH_STRING, 1000);
+
+    expiring_put(&map, "a", "A", 1000, 10);
+    expiring_put(&map, "b", "B", 1000, 20);
+
+    assert(expiring_get(&map, "a", 1009) == (void *)"A");
+    // Stale entries are rejected even though the wheel has not advanced
+    assert(expiring_get(&map, "a", 1010) == NULL);
+    assert(expiring_num_elements(&map) == 2);
+
+    // Advancing removes only the entry which is due
+    assert(expiring_advance(&map, 1015) == 1);
+    assert(expiring_num_elements(&map) == 1);
+    assert(expiring_get(&map, "b", 1015) == (void *)"B");
+
+    // Putting again replaces the value and pushes back the expiry
+    assert(expiring_put(&map, "b", "BB", 1015, 100) == (void *)"B");
+    assert(expiring_advance(&map, 1100) == 0);
+    assert(expiring_get(&map, "b", 1100) == (void *)"BB");
+    assert(expiring_advance(&map, 1115) == 1);
+    assert(expiring_get(&map, "b", 1115) == NULL);
+
+    // A time to live of 0 expires at the next advance
+    expiring_put(&map, "c", "C", 1115, 0);
+    assert(expiring_get(&map, "c", 1115) == NULL);
+    assert(expiring_advance(&map, 1116) == 1);
+
+    // Removed entries are not expired later
+    expiring_put(&map, "d", "D", 1116, 5);
+    assert(expiring_remove(&map, "d") == (void *)"D");
+    assert(expiring_remove(&map, "d") == NULL);
+    assert(expiring_advance(&map, 2000) == 0);
+    assert(expiring_num_elements(&map) == 0);
+
+    free_expiring_map(&map);
+}
+
+/*!
+ * @brief Tests that entries with times to live across every level of the wheel, and
+ *        beyond its range, expire in the advance which passes their expiry tick
+ * @return  None
+ */
+void wheel_levels_test()
+{
+    expiring_map map;
+    expiry_record record = {&map, 0, 0};
+    uint64_t state = 88172645463325252ULL;
+    uint64_t now = 5;
+
+    initialize_expiring_map(&map, NUM_ELEMS, HASH_FIBONACCI, now);
+    set_expiry_callback(&map, &check_expiry, &record);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        // Spread times to live over 1 to 2^30 ticks, past the 2^24 ticks the wheel spans
+        uint64_t ttl = (next_random(&state) & ((1ULL << (next_random(&state) % 31)) - 1)) + 1;
+
+        expiring_put(&map, (void *)i, (void *)(uintptr_t)(now + ttl), now, ttl);
+    }
+
+    while (record.count < NUM_KEYS)
+    {
+        uint64_t step = next_random(&state) % (1ULL << (next_random(&state) % 26));
+
+        record.previous_now = map.now;
+        now += step + 1;
+        expiring_advance(&map, now);
+
+        // Every entry still held is due after the current tick
+        assert(expiring_num_elements(&map) == NUM_KEYS - record.count);
+    }
+
+    assert(expiring_num_elements(&map) == 0);
+
+    free_expiring_map(&map);
+}
+
+/*!
+ * @brief Tests that keys replaced many times expire once, at their last expiry
+ * @return  None
+ */
+void replace_test()
+{
+    expiring_map map;
+    expiry_record record = {&map, 0, 0};
+
+    initialize_expiring_map(&map, NUM_ELEMS, HASH_FIBONACCI, 0);
+    set_expiry_callback(&map, &check_expiry, &record);
+
+    for (long round = 0; round < 100; round++)
+    {
+        for (long i = 1; i <= 1000; i++)
+        {
+            // Each time to live outlasts the single tick advanced before the key is put again
+            uint64_t ttl = (uint64_t)(i * 37 + round * 101) % 10000 + 2;
+
+            expiring_put(&map, (void *)i, (void *)(uintptr_t)(map.now + ttl), map.now, ttl);
+        }
+
+        record.previous_now = map.now;
+        expiring_advance(&map, map.now + 1);
+    }
+
+    record.previous_now = map.now;
+    expiring_advance(&map, map.now + 20000);
+
+    assert(record.count == 1000);
+    assert(expiring_num_elements(&map) == 0);
+
+    free_expiring_map(&map);
+}
+
+int main(void)
+{
+    lazy_expiry_test();
+    wheel_levels_test();
+    replace_test();
+
+    printf("\nExpiring map tests passed.\n\n");
+
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ ********************************************************************************
+ * @file    extendible_hash_table_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the extendible_hash_table.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define TEST_FILE "extendible_hash_table_test.bin"
+#define POOL_PAGES 4
+#define NUM_KEYS 20000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "../data_structures/extendible_hash_table/extendible_hash_table.h"
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests adding, updating, finding and removing elements
+ * @return  None
+ */
+void put_get_remove_test()
+{
+    extendible_hash_table table;
+    uint64_t key;
+    uint64_t value;
+
+    assert(create_extendible_hash_table(&table, TEST_FILE, sizeof(uint64_t), sizeof(uint64_t), POOL_PAGES));
+    assert(extendible_num_elements(&table) == 0);
+
+    key = 1;
+    value = 10;
+    assert(extendible_put(&table, &key, &value));
+    key = 2;
+    value = 20;
+    assert(extendible_put(&table, &key, &value));
+    assert(extendible_num_elements(&table) == 2);
+
+    key = 1;
+    assert(extendible_get(&table, &key, &value) && value == 10);
+    assert(extendible_get(&table, &key, NULL));
+
+    // Putting an existing key replaces its value
+    value = 11;
+    assert(extendible_put(&table, &key, &value));
+    value = 0;
+    assert(extendible_get(&table, &key, &value) && value == 11);
+    assert(extendible_num_elements(&table) == 2);
+
+    assert(extendible_remove(&table, &key));
+    assert(!extendible_remove(&table, &key));
+    assert(!extendible_get(&table, &key, &value));
+    assert(extendible_num_elements(&table) == 1);
+
+    key = 2;
+    assert(extendible_get(&table, &key, &value) && value == 20);
+
+    assert(close_extendible_hash_table(&table));
+    remove(TEST_FILE);
+}
+
+/*!
+ * @brief Tests that a table much larger than its buffer pool splits buckets as it grows
+ *        and reads at most one page per lookup
+ * @return  None
+ */
+void growth_test()
+{
+    extendible_hash_table table;
+
+    assert(create_extendible_hash_table(&table, TEST_FILE, sizeof(uint64_t), sizeof(uint64_t), POOL_PAGES));
+
+    for (uint64_t i = 0; i < NUM_KEYS; i++)
+    {
+        uint64_t value = i * 3;
+
+        assert(extendible_put(&table, &i, &value));
+    }
+
+    assert(extendible_num_elements(&table) == NUM_KEYS);
+    assert(table.counters.splits > 0);
+    assert(table.counters.doublings == table.header.global_depth);
+    // Each split adds exactly one page, so no page is ever copied
+    assert(table.header.num_pages == 1 + table.header.directory_pages + 1 + table.counters.splits);
+    // Pages were written back as they left the pool
+    assert(table.counters.page_writes > 0);
+
+    for (uint64_t i = 0; i < NUM_KEYS; i++)
+    {
+        unsigned long long reads = table.counters.page_reads;
+        uint64_t value;
+
+        assert(extendible_get(&table, &i, &value) && value == i * 3);
+        assert(table.counters.page_reads - reads <= 1);
+    }
+
+    // Every directory entry points at an allocated bucket page
+    for (uint64_t i = 0; i < ((uint64_t)1 << table.header.global_depth); i++)
+    {
+        assert((table.directory)[i] >= 1 && (table.directory)[i] < table.header.num_pages);
+    }
+
+    for (uint64_t i = 0; i < NUM_KEYS; i += 2)
+    {
+        assert(extendible_remove(&table, &i));
+    }
+
+    assert(extendible_num_elements(&table) == NUM_KEYS / 2);
+
+    for (uint64_t i = 0; i < NUM_KEYS; i++)
+    {
+        assert(extendible_get(&table, &i, NULL) == (i % 2 == 1));
+    }
+
+    assert(close_extendible_hash_table(&table));
+    remove(TEST_FILE);
+}
+
+/*!
+ * @brief Tests that elements are found after the table is closed and reopened, and that
+ *        the reopened table keeps growing
+ * @return  None
+ */
+void reopen_test()
+{
+    extendible_hash_table table;
+    char key[12];
+    int value;
+
+    assert(create_extendible_hash_table(&table, TEST_FILE, sizeof(key), sizeof(int), POOL_PAGES));
+
+    for (int i = 0; i < NUM_KEYS / 2; i++)
+    {
+        memset(key, 0, sizeof(key));
+        sprintf(key, "key%d", i);
+        value = i;
+        assert(extendible_put(&table, key, &value));
+    }
+
+    assert(close_extendible_hash_table(&table));
+
+    // Reopening reads only the header and directory
+    assert(open_extendible_hash_table(&table, TEST_FILE, POOL_PAGES));
+    assert(table.counters.page_reads == 0);
+    assert(extendible_num_elements(&table) == NUM_KEYS / 2);
+
+    for (int i = NUM_KEYS / 2; i < NUM_KEYS; i++)
+    {
+        memset(key, 0, sizeof(key));
+        sprintf(key, "key%d", i);
+        value = i;
+        assert(extendible_put(&table, key, &value));
+    }
+
+    assert(close_extendible_hash_table(&table));
+    assert(open_extendible_hash_table(&table, TEST_FILE, POOL_PAGES));
+    assert(extendible_num_elements(&table) == NUM_KEYS);
+
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        memset(key, 0, sizeof(key));
+        sprintf(key, "key%d", i);
+        assert(extendible_get(&table, key, &value) && value == i);
+    }
+
+    memset(key, 0, sizeof(key));
+    sprintf(key, "missing");
+    assert(!extendible_get(&table, key, &value));
+
+    assert(close_extendible_hash_table(&table));
+    remove(TEST_FILE);
+}
+
+/*!
+ * @brief Tests that a changed page which cannot be written back stays in the buffer pool
+ *        and fails the operation which needed its place, rather than being lost
+ * @return  None
+ */
+void write_failure_test()
+{
+    extendible_hash_table table;
+    uint64_t stored = 0;
+
+    assert(create_extendible_hash_table(&table, TEST_FILE, sizeof(uint64_t), sizeof(uint64_t), POOL_PAGES));
+
+    int writable_fd = table.fd;
+
+    // Writes through a read only descriptor fail, while reads still succeed
+    table.fd = open(TEST_FILE, O_RDONLY);
+
+    for (uint64_t i = 0; i < NUM_KEYS; i++)
+    {
+        uint64_t value = i * 3;
+
+        if (!extendible_put(&table, &i, &value))
+        {
+            break;
+        }
+
+        stored++;
+    }
+
+    assert(stored < NUM_KEYS);
+    assert(table.io_error);
+
+    close(table.fd);
+    table.fd = writable_fd;
+
+    // Once writes succeed again every element stored before the failure is found
+    for (uint64_t i = 0; i < stored; i++)
+    {
+        uint64_t value;
+
+        assert(extendible_get(&table, &i, &value) && value == i * 3);
+    }
+
+    assert(extendible_num_elements(&table) == (long)stored);
+
+    close_extendible_hash_table(&table);
+    remove(TEST_FILE);
+}
+
+/*!
+ * @brief Tests that records too large for a page and files which do not hold a table
+ *        are refused
+ * @return  None
+ */
+void invalid_test()
+{
+    extendible_hash_table table;
+    FILE *file;
+
+    assert(!create_extendible_hash_table(&table, TEST_FILE, 8, EXTENDIBLE_PAGE_SIZE / 2, POOL_PAGES));
+    assert(!create_extendible_hash_table(&table, TEST_FILE, 0, 8, POOL_PAGES));
+
+    remove(TEST_FILE);
+    assert(!open_extendible_hash_table(&table, TEST_FILE, POOL_PAGES));
+
+    file = fopen(TEST_FILE, "wb");
+    fprintf(file, "This is not an extendible hash table file, but it is long enough to hold a header.");
+    fclose(file);
+
+    assert(!open_extendible_hash_table(&table, TEST_FILE, POOL_PAGES));
+    assert(table.fd == -1);
+
+    remove(TEST_FILE);
+}
+
+int main(void)
+{
+    put_get_remove_test();
+    growth_test();
+    reopen_test();
+    write_failure_test();
+    invalid_test();
+
+    printf("\nExtendible hash table tests passed.\n\n");
+
+    return 0;
+}
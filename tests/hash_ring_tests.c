@@ -0,0 +1,213 @@
+/**
+ ********************************************************************************
+ * @file    hash_ring_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the hash_ring.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_SHARDS 10
+#define NUM_KEYS 100000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/hash_ring/hash_ring.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Finds the shard of a key by scanning every point, to check the binary search
+ * @param ring Pointer to a hash ring with at least one shard
+ * @param hash 64 bit hash of the key
+ * @return Shard of the first point at or after the key, wrapping to the first point
+ */
+int scan_lookup(hash_ring *ring, uint64_t hash)
+{
+    uint64_t position = hash_mix(hash);
+
+    for (size_t i = 0; i < ring->num_points; i++)
+    {
+        if ((ring->positions)[i] >= position)
+        {
+            return (ring->shards)[i];
+        }
+    }
+
+    return (ring->shards)[0];
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests adding and removing shards and that lookups match a scan of the ring
+ * @return  None
+ */
+void add_remove_test()
+{
+    hash_ring ring;
+
+    initialize_hash_ring(&ring, 0);
+    assert(ring.virtual_nodes == HASH_RING_DEFAULT_VIRTUAL_NODES);
+    assert(hash_ring_lookup(&ring, 42) == HASH_RING_NO_SHARD);
+
+    for (int shard = 0; shard < NUM_SHARDS; shard++)
+    {
+        assert(hash_ring_add_shard(&ring, shard));
+    }
+
+    assert(!hash_ring_add_shard(&ring, 3));
+    assert(!hash_ring_add_shard(&ring, -1));
+    assert(hash_ring_num_shards(&ring) == NUM_SHARDS);
+    assert(ring.num_points == (size_t)(NUM_SHARDS * HASH_RING_DEFAULT_VIRTUAL_NODES));
+
+    for (size_t i = 1; i < ring.num_points; i++)
+    {
+        assert((ring.positions)[i - 1] <= (ring.positions)[i]);
+    }
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        assert(hash_ring_lookup(&ring, key) == scan_lookup(&ring, key));
+    }
+
+    assert(hash_ring_remove_shard(&ring, 3));
+    assert(!hash_ring_remove_shard(&ring, 3));
+    assert(hash_ring_num_shards(&ring) == NUM_SHARDS - 1);
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        assert(hash_ring_lookup(&ring, key) != 3);
+    }
+
+    for (int shard = 0; shard < NUM_SHARDS; shard++)
+    {
+        hash_ring_remove_shard(&ring, shard);
+    }
+
+    assert(hash_ring_lookup(&ring, 42) == HASH_RING_NO_SHARD);
+
+    free_hash_ring(&ring);
+}
+
+/*!
+ * @brief Tests that keys are spread evenly and that adding or removing a shard only moves
+ *        the keys it gains or loses
+ * @return  None
+ */
+void key_movement_test()
+{
+    hash_ring ring;
+    int *before = (int *)malloc(NUM_KEYS * sizeof(int));
+    int counts[NUM_SHARDS + 1] = {0};
+    int moved = 0;
+
+    initialize_hash_ring(&ring, HASH_RING_DEFAULT_VIRTUAL_NODES);
+
+    for (int shard = 0; shard < NUM_SHARDS; shard++)
+    {
+        hash_ring_add_shard(&ring, shard);
+    }
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        before[key] = hash_ring_lookup(&ring, key);
+        counts[before[key]]++;
+    }
+
+    // Every shard holds its tenth of the keys to within a third
+    for (int shard = 0; shard < NUM_SHARDS; shard++)
+    {
+        assert(counts[shard] > NUM_KEYS / NUM_SHARDS * 2 / 3 && counts[shard] < NUM_KEYS / NUM_SHARDS * 4 / 3);
+    }
+
+    // A new shard only takes keys, about one in NUM_SHARDS + 1
+    hash_ring_add_shard(&ring, NUM_SHARDS);
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        int shard = hash_ring_lookup(&ring, key);
+
+        if (shard != before[key])
+        {
+            assert(shard == NUM_SHARDS);
+            moved++;
+        }
+    }
+
+    assert(moved > NUM_KEYS / (NUM_SHARDS + 1) / 2 && moved < NUM_KEYS / (NUM_SHARDS + 1) * 2);
+
+    // Removing it returns every key to where it was
+    hash_ring_remove_shard(&ring, NUM_SHARDS);
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        assert(hash_ring_lookup(&ring, key) == before[key]);
+    }
+
+    // Removing another shard only moves that shard's keys
+    hash_ring_remove_shard(&ring, 0);
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        assert(before[key] == 0 || hash_ring_lookup(&ring, key) == before[key]);
+    }
+
+    free_hash_ring(&ring);
+    free(before);
+}
+
+/*!
+ * @brief Tests that jump hashing spreads keys evenly and only moves keys to a new last shard
+ * @return  None
+ */
+void jump_hash_test()
+{
+    int counts[NUM_SHARDS] = {0};
+    int moved = 0;
+
+    assert(jump_hash(12345, 1) == 0);
+
+    for (uint64_t key = 0; key < NUM_KEYS; key++)
+    {
+        int shard = jump_hash(key, NUM_SHARDS);
+        int grown = jump_hash(key, NUM_SHARDS + 1);
+
+        assert(shard >= 0 && shard < NUM_SHARDS);
+        counts[shard]++;
+
+        if (grown != shard)
+        {
+            assert(grown == NUM_SHARDS);
+            moved++;
+        }
+    }
+
+    for (int shard = 0; shard < NUM_SHARDS; shard++)
+    {
+        assert(counts[shard] > NUM_KEYS / NUM_SHARDS * 9 / 10 && counts[shard] < NUM_KEYS / NUM_SHARDS * 11 / 10);
+    }
+
+    assert(moved > NUM_KEYS / (NUM_SHARDS + 1) * 9 / 10 && moved < NUM_KEYS / (NUM_SHARDS + 1) * 11 / 10);
+}
+
+int main(void)
+{
+    add_remove_test();
+    key_movement_test();
+    jump_hash_test();
+
+    printf("\nHash ring tests passed.\n\n");
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+/**
+ ********************************************************************************
+ * @file    hash_set_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the hash_set.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.75
+#define NUM_KEYS 100000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/hash_set/hash_set.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Adds a visited key to a running total
+ * @param key Key being visited
+ * @param context Pointer to the running total
+ * @return None
+ */
+void sum_keys(void *key, void *context)
+{
+    *(long *)context += (long)key;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests adding, finding and removing keys, including growth past the initial size
+ * @return  None
+ */
+void add_contains_remove_test()
+{
+    hash_set set;
+
+    initialize_hash_set(&set, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_add(&set, (void *)i));
+    }
+
+    assert(set.num_elements == NUM_KEYS);
+    assert(!set_add(&set, (void *)1));
+    assert(set.num_elements == NUM_KEYS);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&set, (void *)i));
+    }
+
+    assert(!set_contains(&set, (void *)(NUM_KEYS + 1)));
+
+    // Remove the odd keys
+    for (long i = 1; i <= NUM_KEYS; i += 2)
+    {
+        assert(set_remove(&set, (void *)i));
+    }
+
+    assert(!set_remove(&set, (void *)1));
+    assert(set.num_elements == NUM_KEYS / 2);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&set, (void *)i) == (i % 2 == 0));
+    }
+
+    long total = 0;
+    hash_set_for_each(&set, &sum_keys, &total);
+    assert(total == (long)(NUM_KEYS / 2) * (NUM_KEYS / 2 + 1));
+
+    free_hash_set(&set);
+}
+
+/*!
+ * @brief Tests that repeated adds and removes reuse deleted slots without growing
+ * @return  None
+ */
+void churn_test()
+{
+    hash_set set;
+
+    initialize_hash_set(&set, 64, LOAD_FACTOR, HASH_DIVISION);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_add(&set, (void *)i));
+
+        if (i > 32)
+        {
+            assert(set_remove(&set, (void *)(i - 32)));
+        }
+    }
+
+    assert(set.num_elements == 32);
+    assert(set.capacity == 64);
+
+    for (long i = NUM_KEYS - 31; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&set, (void *)i));
+    }
+
+    free_hash_set(&set);
+}
+
+/*!
+ * @brief Tests that string keys are compared by content
+ * @return  None
+ */
+void string_key_test()
+{
+    hash_set set;
+    char key[] = "Test2";
+
+    initialize_hash_set(&set, NUM_ELEMS, LOAD_FACTOR, HASH_STRING);
+
+    assert(set_add(&set, "Test1"));
+    assert(set_add(&set, "Test2"));
+    assert(!set_add(&set, key));
+    assert(set_contains(&set, key));
+    assert(!set_contains(&set, "Test3"));
+    assert(set_remove(&set, key));
+    assert(!set_contains(&set, "Test2"));
+
+    free_hash_set(&set);
+}
+
+/*!
+ * @brief Tests union, intersection and difference against sets of multiples
+ * @return  None
+ */
+void set_operations_test()
+{
+    hash_set twos;
+    hash_set threes;
+    hash_set result;
+
+    initialize_hash_set(&twos, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+    initialize_hash_set(&threes, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        if (i % 2 == 0)
+        {
+            set_add(&twos, (void *)i);
+        }
+
+        if (i % 3 == 0)
+        {
+            set_add(&threes, (void *)i);
+        }
+    }
+
+    // Union of multiples of two and three
+    initialize_hash_set(&result, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+    set_union(&result, &twos);
+    set_union(&result, &threes);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&result, (void *)i) == (i % 2 == 0 || i % 3 == 0));
+    }
+
+    assert(result.num_elements == NUM_KEYS / 2 + NUM_KEYS / 3 - NUM_KEYS / 6);
+
+    // Intersection leaves the multiples of six
+    set_intersect(&result, &threes);
+    set_intersect(&result, &twos);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&result, (void *)i) == (i % 6 == 0));
+    }
+
+    assert(result.num_elements == NUM_KEYS / 6);
+    free_hash_set(&result);
+
+    // Difference walking the larger set
+    initialize_hash_set(&result, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+    set_union(&result, &twos);
+    set_difference(&result, &threes);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&result, (void *)i) == (i % 2 == 0 && i % 3 != 0));
+    }
+
+    // Difference walking the smaller set
+    set_difference(&threes, &result);
+    assert(threes.num_elements == NUM_KEYS / 3);
+    set_difference(&twos, &result);
+    assert(twos.num_elements == NUM_KEYS / 6);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        assert(set_contains(&twos, (void *)i) == (i % 6 == 0));
+    }
+
+    free_hash_set(&result);
+    free_hash_set(&twos);
+    free_hash_set(&threes);
+}
+
+/*!
+ * @brief Tests that operations with an empty set leave the expected contents
+ * @return  None
+ */
+void empty_set_operations_test()
+{
+    hash_set set;
+    hash_set empty;
+
+    initialize_hash_set(&set, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+    initialize_hash_set(&empty, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    for (long i = 1; i <= 100; i++)
+    {
+        set_add(&set, (void *)i);
+    }
+
+    set_union(&set, &empty);
+    assert(set.num_elements == 100);
+    set_difference(&set, &empty);
+    assert(set.num_elements == 100);
+    set_union(&empty, &set);
+    assert(empty.num_elements == 100);
+
+    set_difference(&empty, &set);
+    assert(empty.num_elements == 0);
+    set_intersect(&set, &empty);
+    assert(set.num_elements == 0);
+    assert(!set_contains(&set, (void *)1));
+
+    free_hash_set(&set);
+    free_hash_set(&empty);
+}
+
+int main(void)
+{
+    add_contains_remove_test();
+    churn_test();
+    string_key_test();
+    set_operations_test();
+    empty_set_operations_test();
+
+    printf("\nHash set tests passed.\n\n");
+
+    return 0;
+}
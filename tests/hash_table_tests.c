@@ -20,6 +20,152 @@
 #include <assert.h>
 #include "../data_structures/hash_table/hash_table.h"
 
+/************************************
+ * TYPEDEFS
+ ************************************/
+
+/*!
+ * @brief Composite key used to test user defined hash and equality functions.
+ */
+typedef struct
+{
+    int region;
+    int id;
+} composite_key;
+
+/*!
+ * @brief Fixed size value stored by value in HASH_INLINE tests.
+ */
+typedef struct
+{
+    long count;
+    double total;
+} inline_record;
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Hashes a composite key by its fields
+ * @param key Pointer to a composite key
+ * @param key_length Size of the composite key
+ * @return A 64 bit hash of the key
+ */
+uint64_t composite_hash(const void *key, size_t key_length)
+{
+    const composite_key *composite = (const composite_key *)key;
+
+    return hash_fibonacci((void *)(uintptr_t)(((uint64_t)composite->region << 32) | (uint32_t)composite->id), 0);
+}
+
+/*!
+ * @brief Compares two composite keys field by field
+ * @param key_a First composite key
+ * @param key_b Second composite key
+ * @param key_length Size of the composite key
+ * @return True if the keys are equal
+ */
+bool composite_equal(const void *key_a, const void *key_b, size_t key_length)
+{
+    const composite_key *a = (const composite_key *)key_a;
+    const composite_key *b = (const composite_key *)key_b;
+
+    return a->region == b->region && a->id == b->id;
+}
+
+/*!
+ * @brief Hashes integer keys so that keys within the same hundred collide
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return The key divided by 100
+ */
+uint64_t hundreds_hash(const void *key, size_t key_length)
+{
+    return (uint64_t)(uintptr_t)key / 100;
+}
+
+/*!
+ * @brief Hashes integer keys so that keys below 1000 all collide
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return The key divided by 1000
+ */
+uint64_t thousands_hash(const void *key, size_t key_length)
+{
+    return (uint64_t)(uintptr_t)key / 1000;
+}
+
+/*!
+ * @brief Adds each visited value to a running sum
+ * @param key Key of the visited element
+ * @param value Value of the visited element
+ * @param context Pointer to the running sum
+ * @return None
+ */
+void sum_values(void *key, void *value, void *context)
+{
+    *(long *)context += (long)value;
+}
+
+/*!
+ * @brief Counts visits to each key, for keys small enough to index an array
+ * @param key Key of the visited element
+ * @param value Value of the visited element
+ * @param context Array of visit counts indexed by key
+ * @return None
+ */
+void count_visits(void *key, void *value, void *context)
+{
+    ((int *)context)[(long)key]++;
+}
+
+/*!
+ * @brief Counts visits to each inline key and checks the value stored with it
+ * @param key Pointer to the visited 8 byte key
+ * @param value Pointer to the visited inline_record
+ * @param context Array of visit counts indexed by key
+ * @return None
+ */
+void count_inline_visits(void *key, void *value, void *context)
+{
+    uint64_t k = *(uint64_t *)key;
+
+    assert(((inline_record *)value)->count == (long)k * 2);
+    ((int *)context)[k]++;
+}
+
+/*!
+ * @brief Reads the aggregated value of a group, which inline tables hold in their bytes
+ * @param table Pointer to a hash table filled by aggregate_batch()
+ * @param key Integer key of the group
+ * @param found Set to true if the group is present
+ * @return The group's value, or 0 if the group is not present
+ */
+int64_t group_value(hash_table *table, uint64_t key, bool *found)
+{
+    int64_t value = 0;
+
+    if (table->mode == HASH_INLINE)
+    {
+        void *stored = get(table, &key);
+
+        *found = stored != NULL;
+
+        if (stored != NULL)
+        {
+            memcpy(&value, stored, sizeof(int64_t));
+        }
+
+        return value;
+    }
+
+    value = (intptr_t)get(table, (void *)key);
+    *found = value != 0;
+
+    return value;
+}
+
 /************************************
  * TESTS
  ************************************/
@@ -44,6 +190,15 @@ void init_test()
     }
 
     free_hash_table(&table);
+
+    // An unknown hash function selection falls back to the division method
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, 99);
+    assert(table.key_hash == &hash_pointer);
+
+    put(&table, (void *)3, (void *)30);
+    assert(get(&table, (void *)3) == (void *)30);
+
+    free_hash_table(&table);
 }
 
 /*!
@@ -274,22 +429,1901 @@ void percent_occupied_test()
     free_hash_table(&table);
 }
 
-int main(void)
+/*!
+ * @brief Tests initialization of a hash table in open addressing (swiss) mode
+ * @return  None
+ */
+void swiss_init_test()
 {
-    init_test();
-    free_empty_test();
+    hash_table table;
 
-    put_single_element_test();
-    put_multiple_elements_test();
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, 0, HASH_SWISS);
 
-    remove_hash_test();
-    remove_multiple_hashes_test();
+    // Capacity is rounded up to a power of two of at least one group
+    assert(table.table_size == HASH_GROUP_WIDTH);
+    assert(table.num_elements == 0);
 
-    hash_to_same_location_test();
-    hash_to_same_location_remove_test();
-    hash_to_same_location_remove_one_test();
+    for (int i = 0; i < table.table_size + HASH_GROUP_WIDTH; i++)
+    {
+        assert((table.control)[i] == 0x80);
+    }
 
-    percent_occupied_test();
+    free_hash_table(&table);
+
+    assert(table.control == NULL);
+    assert(table.slots == NULL);
+}
+
+/*!
+ * @brief Tests adding, retrieving and removing elements in swiss mode
+ * @return  None
+ */
+void swiss_put_get_remove_test()
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, 0, HASH_SWISS);
+
+    put(&table, "Test1", 1);
+    put(&table, "Test2", 2);
+    put(&table, "Test3", 3);
+
+    assert(table.num_elements == 3);
+    assert(get(&table, "Test1") == 1);
+    assert(get(&table, "Test2") == 2);
+    assert(get(&table, "Test3") == 3);
+    assert(get(&table, "Test4") == NULL);
+
+    remove_hash(&table, "Test2");
+
+    assert(table.num_elements == 2);
+    assert(get(&table, "Test1") == 1);
+    assert(get(&table, "Test2") == NULL);
+    assert(get(&table, "Test3") == 3);
+
+    // Removing a key which is not present leaves the table unchanged
+    remove_hash(&table, "Test2");
+    assert(table.num_elements == 2);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that keys colliding under the division method are stored in separate slots in swiss mode
+ * @return  None
+ */
+void swiss_hash_to_same_location_test()
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, 0, HASH_SWISS);
+
+    put(&table, 12, "Test1");
+    put(&table, 2, "Test2");
+
+    // Each key occupies its own slot
+    assert(table.num_elements == 2);
+    assert(get(&table, 12) == "Test1");
+    assert(get(&table, 2) == "Test2");
+
+    // Putting an existing key replaces its value
+    put(&table, 12, "Test3");
+    assert(table.num_elements == 2);
+    assert(get(&table, 12) == "Test3");
+
+    remove_hash(&table, 12);
+    assert(get(&table, 12) == NULL);
+    assert(get(&table, 2) == "Test2");
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a swiss table grows and keeps all elements once the load factor is exceeded
+ * @return  None
+ */
+void swiss_resize_test()
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, 0, HASH_SWISS);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        put(&table, i, i * 10);
+    }
+
+    assert(table.num_elements == 1000);
+    assert(table.table_size >= 2000);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        assert(get(&table, i) == i * 10);
+    }
+
+    // Remove every other key, leaving deleted markers behind
+    for (long i = 1; i <= 1000; i += 2)
+    {
+        remove_hash(&table, i);
+    }
+
+    assert(table.num_elements == 500);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        assert(get(&table, i) == ((i % 2 == 0) ? i * 10 : 0));
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that string keys are matched by content rather than by pointer
+ * @return  None
+ */
+void string_keys_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS};
+
+    for (int m = 0; m < 2; m++)
+    {
+        hash_table table;
+        char session_id[16];
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING, modes[m]);
+
+        put(&table, "session-1", 1);
+        put(&table, "session-2", 2);
+
+        // A separately built copy of the key finds the same element
+        strcpy(session_id, "session-1");
+        assert(get(&table, session_id) == 1);
+
+        strcpy(session_id, "session-2");
+        assert(get(&table, session_id) == 2);
+
+        strcpy(session_id, "session-3");
+        assert(get(&table, session_id) == NULL);
+
+        strcpy(session_id, "session-1");
+        remove_hash(&table, session_id);
+        assert(get(&table, "session-1") == NULL);
+        assert(get(&table, "session-2") == 2);
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests user defined hash and equality functions on struct keys
+ * @return  None
+ */
+void custom_key_functions_test()
+{
+    hash_table table;
+    composite_key keys[100];
+
+    initialize_hash_table_keys(&table, NUM_ELEMS, LOAD_FACTOR, HASH_CHAINING, sizeof(composite_key),
+                               &composite_hash, &composite_equal);
+
+    for (int i = 0; i < 100; i++)
+    {
+        keys[i].region = i % 4;
+        keys[i].id = i;
+        put(&table, &keys[i], i + 1);
+    }
+
+    for (int i = 0; i < 100; i++)
+    {
+        composite_key lookup = {i % 4, i};
+
+        assert(get(&table, &lookup) == i + 1);
+    }
+
+    composite_key missing = {1, 2};
+    assert(get(&table, &missing) == NULL);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests fixed length byte keys compared with the built in byte equality
+ * @return  None
+ */
+void byte_keys_test()
+{
+    hash_table table;
+    unsigned char key_a[6] = {1, 2, 3, 4, 5, 6};
+    unsigned char key_b[6] = {1, 2, 3, 4, 5, 7};
+    unsigned char lookup[6] = {1, 2, 3, 4, 5, 6};
+
+    initialize_hash_table_keys(&table, NUM_ELEMS, LOAD_FACTOR, HASH_SWISS, sizeof(key_a), &hash_bytes, NULL);
+
+    put(&table, key_a, 1);
+    put(&table, key_b, 2);
+
+    assert(get(&table, lookup) == 1);
+    lookup[5] = 7;
+    assert(get(&table, lookup) == 2);
+    lookup[5] = 8;
+    assert(get(&table, lookup) == NULL);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that chained nodes cache the full hash of their key
+ * @return  None
+ */
+void cached_hash_test()
+{
+    hash_table table;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION);
+
+    put(&table, 12, "Test1");
+    put(&table, 2, "Test2");
+
+    assert(((table.array)[2]).hash == 12);
+    assert((((table.array)[2]).next)->hash == 2);
+    assert((((table.array)[2]).next)->previous == &((table.array)[2]));
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests the Fibonacci hash selection on sequential integer keys, including a resize
+ * @return  None
+ */
+void fibonacci_hash_test()
+{
+    hash_table table;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    for (long i = 1; i <= 200; i++)
+    {
+        put(&table, i, i + 1);
+    }
+
+    for (long i = 1; i <= 200; i++)
+    {
+        assert(get(&table, i) == i + 1);
+    }
+
+    assert(get(&table, 201) == NULL);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that the byte hash depends on the full content and length of a key
+ * @return  None
+ */
+void hash_bytes_test()
+{
+    char long_key[100];
+
+    memset(long_key, 'a', sizeof(long_key));
+
+    assert(hash_bytes("abc", HASH_KEY_STRING) == hash_bytes("abc", 3));
+    assert(hash_bytes("abc", 3) != hash_bytes("abd", 3));
+    assert(hash_bytes("abc", 2) != hash_bytes("abc", 3));
+    assert(hash_bytes("", 0) != hash_bytes("a", 1));
+
+    // Keys longer than 48 bytes take the multi lane path
+    uint64_t long_hash = hash_bytes(long_key, sizeof(long_key));
+    long_key[70] = 'b';
+    assert(hash_bytes(long_key, sizeof(long_key)) != long_hash);
+}
+
+/*!
+ * @brief Tests that resize() migrates every element in one call when incremental resizing is disabled
+ * @return  None
+ */
+void resize_test()
+{
+    hash_table table;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION);
+
+    put(&table, 12, "Test1");
+    put(&table, 2, "Test2");
+    put(&table, 3, "Test3");
+
+    resize(&table);
+
+    assert(table.table_size == NUM_ELEMS * 2);
+    assert(is_rehashing(&table) == false);
+    assert(rehash_progress(&table) == 100);
+
+    // 12 and 2 no longer collide in a table of size 20
+    assert(table.num_elements == 3);
+    assert(get(&table, 12) == "Test1");
+    assert(get(&table, 2) == "Test2");
+    assert(get(&table, 3) == "Test3");
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that an incremental resize keeps every element reachable while it is in progress
+ * @return  None
+ */
+void incremental_resize_test()
+{
+    hash_table table;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION);
+    set_incremental_resize(&table, 1);
+
+    put(&table, 12, "Test1");
+    put(&table, 2, "Test2");
+    put(&table, 3, "Test3");
+
+    resize(&table);
+
+    // Only the larger array has been allocated so far
+    assert(is_rehashing(&table) == true);
+    assert(table.table_size == NUM_ELEMS * 2);
+    assert(rehash_progress(&table) == 0);
+
+    // Each lookup migrates one old position
+    assert(get(&table, 12) == "Test1");
+    assert(rehash_progress(&table) == 10);
+    assert(get(&table, 2) == "Test2");
+    assert(get(&table, 3) == "Test3");
+
+    // Elements whose old position has been migrated go to the new array
+    put(&table, 22, "Test4");
+    remove_hash(&table, 3);
+    assert(get(&table, 22) == "Test4");
+    assert(get(&table, 3) == NULL);
+
+    rehash_positions(&table, NUM_ELEMS);
+
+    assert(is_rehashing(&table) == false);
+    assert(table.old_array == NULL);
+    assert(get(&table, 12) == "Test1");
+    assert(get(&table, 2) == "Test2");
+    assert(get(&table, 22) == "Test4");
+
+    // 12 at position 12, 2 and 22 at position 2
+    assert(table.num_elements == 2);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests many incremental resizes driven only by put
+ * @return  None
+ */
+void incremental_resize_many_test()
+{
+    hash_table table;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+    set_incremental_resize(&table, 4);
+
+    for (long i = 1; i <= 5000; i++)
+    {
+        put(&table, i, i * 3);
+
+        // Elements stay reachable at every point of a migration, including one just added
+        // whose old position has not been migrated yet
+        assert(get(&table, i / 2 + 1) == (i / 2 + 1) * 3);
+        assert(get(&table, i) == i * 3);
+    }
+
+    for (long i = 1; i <= 5000; i++)
+    {
+        assert(get(&table, i) == i * 3);
+    }
+
+    // Freeing part way through a migration releases both arrays
+    resize(&table);
+    assert(is_rehashing(&table) == true);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests visiting every element in each mode, including part way through an incremental resize
+ * @return  None
+ */
+void for_each_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS};
+
+    for (int m = 0; m < 2; m++)
+    {
+        hash_table table;
+        long sum = 0;
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION, modes[m]);
+        set_incremental_resize(&table, 1);
+
+        // Keys 12 and 2 collide in chaining mode
+        for (long i = 1; i <= 12; i++)
+        {
+            put(&table, i, i);
+        }
+
+        hash_table_for_each(&table, &sum_values, &sum);
+        assert(sum == 78);
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests that clearing deleted markers at the same capacity keeps the swiss arrays in place
+ * @return  None
+ */
+void swiss_same_size_rehash_test()
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, 64, 0.875, HASH_DIVISION, HASH_SWISS);
+
+    unsigned char *control = table.control;
+    hash_slot *slots = table.slots;
+
+    // Repeatedly adding and removing keys fills the table with deleted markers
+    for (long i = 1; i <= 1000; i++)
+    {
+        put(&table, i, i);
+
+        if (i > 8)
+        {
+            remove_hash(&table, i - 8);
+        }
+    }
+
+    assert(table.table_size == 64);
+    assert(table.control == control);
+    assert(table.slots == slots);
+    assert(table.num_elements == 8);
+
+    for (long i = 993; i <= 1000; i++)
+    {
+        assert(get(&table, i) == i);
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that batched puts and lookups match single element operations in each mode
+ * @return  None
+ */
+void get_many_put_many_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS};
+
+    for (int m = 0; m < 2; m++)
+    {
+        hash_table table;
+        void *keys[300];
+        void *values[300];
+        void *results[300];
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+        set_incremental_resize(&table, 2);
+
+        // The first 200 keys are added as a batch, spanning several windows and resizes
+        for (long i = 0; i < 300; i++)
+        {
+            keys[i] = (void *)(i + 1);
+            values[i] = (void *)(i * 7);
+        }
+
+        put_many(&table, keys, values, 200);
+
+        // The last 100 keys are misses
+        get_many(&table, keys, 300, results);
+
+        for (int i = 0; i < 300; i++)
+        {
+            assert(results[i] == ((i < 200) ? values[i] : NULL));
+            assert(results[i] == get(&table, keys[i]));
+        }
+
+        // An empty batch leaves the table unchanged
+        get_many(&table, keys, 0, results);
+        put_many(&table, keys, values, 0);
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests that chained nodes are carved out of slabs and reused after removal
+ * @return  None
+ */
+void slab_allocation_test()
+{
+    hash_table table;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION);
+
+    assert(table.slabs == NULL);
+
+    // Both keys collide at position 2, so the second is chained
+    put(&table, 12, "Test1");
+    put(&table, 2, "Test2");
+
+    hash_node *chained = ((table.array)[2]).next;
+
+    assert(table.slabs != NULL);
+    assert(chained == &((table.slabs)->nodes[0]));
+    assert(table.slab_used == 1);
+
+    // The removed node goes to the free list and is handed out again by the next collision
+    remove_hash(&table, 2);
+    assert(table.free_nodes == chained);
+
+    put(&table, 22, "Test3");
+    assert(((table.array)[2]).next == chained);
+    assert(table.free_nodes == NULL);
+    assert(table.slab_used == 1);
+
+    free_hash_table(&table);
+
+    assert(table.slabs == NULL);
+    assert(table.free_nodes == NULL);
+}
+
+/*!
+ * @brief Tests that slabs grow once the first one is used up
+ * @return  None
+ */
+void slab_growth_test()
+{
+    hash_table table;
+
+    // A load factor above 1 keeps the single position table from resizing
+    initialize_hash_table(&table, 1, 2, HASH_DIVISION);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        put(&table, i, i);
+    }
+
+    int num_slabs = 0;
+
+    for (hash_node_slab *slab = table.slabs; slab != NULL; slab = slab->next)
+    {
+        num_slabs++;
+    }
+
+    // 999 chained nodes need slabs of 32, 64, 128, 256, 512 and 1024 nodes
+    assert(num_slabs == 6);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        assert(get(&table, i) == i);
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests adding, getting and removing elements in Robin Hood mode
+ * @return  None
+ */
+void robin_hood_put_get_remove_test()
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING, HASH_ROBIN_HOOD);
+
+    assert(table.mode == HASH_ROBIN_HOOD);
+    assert(table.table_size == HASH_GROUP_WIDTH);
+
+    put(&table, "Test1", 1);
+    put(&table, "Test2", 2);
+    put(&table, "Test3", 3);
+
+    assert(table.num_elements == 3);
+    assert(get(&table, "Test1") == 1);
+    assert(get(&table, "Test2") == 2);
+    assert(get(&table, "Test3") == 3);
+    assert(get(&table, "Test4") == NULL);
+
+    // Putting an existing key replaces its value
+    put(&table, "Test1", 4);
+    assert(table.num_elements == 3);
+    assert(get(&table, "Test1") == 4);
+
+    remove_hash(&table, "Test2");
+    remove_hash(&table, "Test2");
+
+    assert(table.num_elements == 2);
+    assert(get(&table, "Test2") == NULL);
+    assert(get(&table, "Test3") == 3);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that removal in Robin Hood mode shifts displaced elements back towards their home slot
+ * @return  None
+ */
+void robin_hood_backward_shift_test()
+{
+    hash_table table;
+    float mean;
+    int longest;
+
+    initialize_hash_table_keys(&table, NUM_ELEMS, LOAD_FACTOR, HASH_ROBIN_HOOD, HASH_KEY_POINTER, &hundreds_hash, NULL);
+
+    // All three keys share a home slot, so they sit at distances 0, 1 and 2
+    put(&table, 1, "Test1");
+    put(&table, 2, "Test2");
+    put(&table, 3, "Test3");
+
+    probe_length_stats(&table, &mean, &longest);
+    assert(longest == 2);
+    assert(mean == 1);
+
+    remove_hash(&table, 1);
+
+    // The remaining keys move up one slot and no deleted marker is left
+    probe_length_stats(&table, &mean, &longest);
+    assert(longest == 1);
+    assert(table.num_deleted == 0);
+    assert(get(&table, 1) == NULL);
+    assert(get(&table, 2) == "Test2");
+    assert(get(&table, 3) == "Test3");
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that keys with equal hashes pushed past the largest recorded distance are
+ *        still found and removed, without growing the table past its load factor
+ * @return  None
+ */
+void robin_hood_equal_hash_test()
+{
+    hash_table table;
+    float mean;
+    int longest;
+
+    initialize_hash_table_keys(&table, NUM_ELEMS, 0.9, HASH_ROBIN_HOOD, HASH_KEY_POINTER, &thousands_hash, NULL);
+
+    // Keys 1000 to 1009 share another home, which the colliding run flows past
+    for (long i = 1000; i < 1010; i++)
+    {
+        put(&table, i, i);
+    }
+
+    for (long i = 1; i <= 600; i++)
+    {
+        put(&table, i, i);
+    }
+
+    assert(table.num_elements == 610);
+    assert(table.table_size == 1024);
+
+    probe_length_stats(&table, &mean, &longest);
+    assert(longest >= 599);
+
+    for (long i = 1; i <= 600; i += 2)
+    {
+        remove_hash(&table, i);
+    }
+
+    for (long i = 1; i <= 600; i++)
+    {
+        assert(get(&table, i) == ((i % 2 == 0) ? i : 0));
+    }
+
+    for (long i = 1000; i < 1010; i++)
+    {
+        assert(get(&table, i) == i);
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a Robin Hood table runs at a high load factor with short probes
+ * @return  None
+ */
+void robin_hood_high_load_test()
+{
+    hash_table table;
+    float mean;
+    int longest;
+
+    initialize_hash_table_mode(&table, 1024, 0.95, HASH_FIBONACCI, HASH_ROBIN_HOOD);
+
+    // 972 elements fit below the load factor, so the table does not grow
+    for (long i = 1; i <= 972; i++)
+    {
+        put(&table, i, i * 10);
+    }
+
+    assert(table.table_size == 1024);
+    assert(table.num_elements == 972);
+
+    probe_length_stats(&table, &mean, &longest);
+    assert(mean < 10);
+
+    for (long i = 1; i <= 972; i += 2)
+    {
+        remove_hash(&table, i);
+    }
+
+    assert(table.num_elements == 486);
+
+    for (long i = 1; i <= 972; i++)
+    {
+        assert(get(&table, i) == ((i % 2 == 0) ? i * 10 : 0));
+    }
+
+    // The next element over the load factor doubles the table
+    for (long i = 1; i <= 1000; i++)
+    {
+        put(&table, i, i);
+    }
+
+    assert(table.table_size == 2048);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        assert(get(&table, i) == i);
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests adding, getting and removing elements in cuckoo mode
+ * @return  None
+ */
+void cuckoo_put_get_remove_test()
+{
+    hash_table table;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING, HASH_CUCKOO);
+
+    assert(table.mode == HASH_CUCKOO);
+    assert(table.table_size == HASH_GROUP_WIDTH);
+
+    // Buckets start on a cache line boundary
+    assert((uintptr_t)table.slots % 64 == 0);
+
+    put(&table, "Test1", 1);
+    put(&table, "Test2", 2);
+    put(&table, "Test3", 3);
+    put(&table, "Test1", 4);
+
+    assert(table.num_elements == 3);
+    assert(get(&table, "Test1") == 4);
+    assert(get(&table, "Test2") == 2);
+    assert(get(&table, "Test3") == 3);
+    assert(get(&table, "Test4") == NULL);
+
+    remove_hash(&table, "Test2");
+    remove_hash(&table, "Test2");
+
+    assert(table.num_elements == 2);
+    assert(get(&table, "Test2") == NULL);
+    assert(get(&table, "Test3") == 3);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a cuckoo table fills to a high load factor by moving elements between their buckets
+ * @return  None
+ */
+void cuckoo_high_load_test()
+{
+    hash_table table;
+    float mean;
+    int longest;
+
+    initialize_hash_table_mode(&table, 4096, 0.95, HASH_FIBONACCI, HASH_CUCKOO);
+
+    for (long i = 1; i <= 3891; i++)
+    {
+        put(&table, i, i * 10);
+    }
+
+    assert(table.num_elements == 3891);
+    assert(table.num_stashed == 0);
+
+    // Every element is in one of its two buckets
+    probe_length_stats(&table, &mean, &longest);
+    assert(longest <= 1);
+
+    for (long i = 1; i <= 3891; i++)
+    {
+        assert(get(&table, i) == i * 10);
+    }
+
+    for (long i = 1; i <= 3891; i += 2)
+    {
+        remove_hash(&table, i);
+    }
+
+    for (long i = 1; i <= 3891; i++)
+    {
+        assert(get(&table, i) == ((i % 2 == 0) ? i * 10 : 0));
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that keys with equal hashes beyond the capacity of their buckets are stashed in cuckoo mode
+ * @return  None
+ */
+void cuckoo_stash_test()
+{
+    hash_table table;
+    long sum = 0;
+
+    initialize_hash_table_keys(&table, 64, LOAD_FACTOR, HASH_CUCKOO, HASH_KEY_POINTER, &hundreds_hash, NULL);
+
+    // Ten keys share both buckets, which hold eight
+    for (long i = 1; i <= 10; i++)
+    {
+        put(&table, i, i);
+    }
+
+    assert(table.num_elements == 10);
+    assert(table.num_stashed == 2);
+    assert(table.table_size == 64);
+
+    for (long i = 1; i <= 10; i++)
+    {
+        assert(get(&table, i) == i);
+    }
+
+    hash_table_for_each(&table, &sum_values, &sum);
+    assert(sum == 55);
+
+    remove_hash(&table, 10);
+    remove_hash(&table, 1);
+
+    assert(table.num_elements == 8);
+    assert(get(&table, 10) == NULL);
+    assert(get(&table, 9) == 9);
+
+    // The stash holds one cache line, after which keys with the same hash are refused
+    // rather than growing a table which no size would help
+    for (long i = 11; i <= 14; i++)
+    {
+        assert(put(&table, i, i));
+    }
+
+    assert(table.num_stashed == 4);
+    assert(!put(&table, 15, 15));
+    assert(put(&table, 14, 140));
+    assert(table.num_elements == 12);
+    assert(table.table_size == 64);
+    assert(get(&table, 15) == NULL);
+    assert(get(&table, 14) == 140);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests the probe length histogram, memory use and counters reported by hash_table_stats
+ * @return  None
+ */
+void hash_table_stats_test()
+{
+    hash_table table;
+    hash_table_statistics stats;
+
+    // A load factor above 1 keeps the table from resizing
+    initialize_hash_table_keys(&table, NUM_ELEMS, 2, HASH_CHAINING, HASH_KEY_POINTER, &hundreds_hash, NULL);
+
+    // Keys 1, 2 and 3 are chained at the same position, 105 is alone
+    put(&table, 1, "Test1");
+    put(&table, 2, "Test2");
+    put(&table, 3, "Test3");
+    put(&table, 105, "Test4");
+
+    assert(get(&table, 3) == "Test3");
+    assert(get(&table, 4) == NULL);
+
+    hash_table_stats(&table, &stats);
+
+    assert(stats.probe_histogram[0] == 2);
+    assert(stats.probe_histogram[1] == 1);
+    assert(stats.probe_histogram[2] == 1);
+    assert(stats.longest_probe == 2);
+    assert(stats.mean_probe == 0.75);
+    assert(stats.bucket_bytes == NUM_ELEMS * sizeof(hash_node));
+    assert(stats.node_bytes == sizeof(hash_node_slab) + 32 * sizeof(hash_node));
+
+#ifdef HASH_TABLE_STATS
+    // Both lookups compare against every key in the chain
+    assert(stats.successful_lookups == 1);
+    assert(stats.failed_lookups == 1);
+    assert(stats.successful_comparisons == 3);
+    assert(stats.failed_comparisons == 3);
+    assert(stats.num_resizes == 0);
+
+    resize(&table);
+    hash_table_stats(&table, &stats);
+
+    assert(stats.num_resizes == 1);
+    assert(stats.resize_ns > 0);
+#else
+    assert(stats.successful_lookups == 0);
+    assert(stats.num_resizes == 0);
+#endif
+
+    free_hash_table(&table);
+
+    initialize_hash_table_mode(&table, 16, LOAD_FACTOR, HASH_FIBONACCI, HASH_SWISS);
+    put(&table, 1, "Test1");
+    hash_table_stats(&table, &stats);
+
+    // Sixteen slots, their control bytes and the mirrored first group
+    assert(stats.bucket_bytes == 16 * sizeof(hash_slot) + 32);
+    assert(stats.node_bytes == 0);
+    assert(stats.probe_histogram[0] == 1);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a scan in small batches visits every element once in every mode
+ * @return  None
+ */
+void scan_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO};
+
+    for (int m = 0; m < 4; m++)
+    {
+        hash_table table;
+        int visits[1001] = {0};
+        uint64_t cursor = 0;
+        int batches = 0;
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+
+        for (long i = 1; i <= 1000; i++)
+        {
+            put(&table, (void *)i, (void *)i);
+        }
+
+        do
+        {
+            cursor = hash_table_scan(&table, cursor, 10, &count_visits, visits);
+            batches++;
+        } while (cursor != 0);
+
+        for (long i = 1; i <= 1000; i++)
+        {
+            assert(visits[i] == 1);
+        }
+
+        // Batches end once 10 elements are visited, so the scan takes many calls
+        assert(batches > 10);
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests that a chaining scan visits every original element exactly once while the
+ *        table grows between calls, with and without incremental resizing, from a table
+ *        size which is not a power of two
+ * @return  None
+ */
+void scan_growth_test()
+{
+    int steps[] = {0, 1, 64};
+
+    for (int s = 0; s < 3; s++)
+    {
+        hash_table table;
+        static int visits[200001];
+        uint64_t cursor = 0;
+        long next_key = 1001;
+
+        memset(visits, 0, sizeof(visits));
+        initialize_hash_table(&table, 12, 0.75, HASH_FIBONACCI);
+        set_incremental_resize(&table, steps[s]);
+
+        for (long i = 1; i <= 1000; i++)
+        {
+            put(&table, (void *)i, (void *)i);
+        }
+
+        // Elements are added between every batch, growing the table many times over
+        do
+        {
+            cursor = hash_table_scan(&table, cursor, 5, &count_visits, visits);
+
+            for (int i = 0; i < 200 && next_key <= 200000; i++, next_key++)
+            {
+                put(&table, (void *)next_key, (void *)next_key);
+            }
+        } while (cursor != 0);
+
+        assert(table.table_size >= 12 * 1024);
+
+        for (long i = 1; i <= 1000; i++)
+        {
+            assert(visits[i] == 1);
+        }
+
+        // Elements added during the scan are visited at most once
+        for (long i = 1001; i < next_key; i++)
+        {
+            assert(visits[i] <= 1);
+        }
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests that a Swiss or Robin Hood scan visits every original element exactly once
+ *        while elements are added and removed between calls, growing and rebuilding the table
+ * @return  None
+ */
+void open_scan_growth_test()
+{
+    hash_table_mode modes[] = {HASH_SWISS, HASH_ROBIN_HOOD};
+
+    for (int m = 0; m < 2; m++)
+    {
+        hash_table table;
+        static int visits[200001];
+        uint64_t cursor = 0;
+        long next_key = 1001;
+
+        memset(visits, 0, sizeof(visits));
+        initialize_hash_table_mode(&table, 16, 0.875, HASH_FIBONACCI, modes[m]);
+
+        for (long i = 1; i <= 1000; i++)
+        {
+            put(&table, (void *)i, (void *)i);
+        }
+
+        // Every other added element is removed again, leaving deleted markers in Swiss
+        // mode and shifting elements back in Robin Hood mode
+        do
+        {
+            cursor = hash_table_scan(&table, cursor, 5, &count_visits, visits);
+
+            for (int i = 0; i < 200 && next_key <= 200000; i++, next_key++)
+            {
+                put(&table, (void *)next_key, (void *)next_key);
+
+                if (next_key % 2 == 0)
+                {
+                    remove_hash(&table, (void *)(next_key - 1));
+                }
+            }
+        } while (cursor != 0);
+
+        assert(table.table_size >= 1024 * 16);
+
+        for (long i = 1; i <= 1000; i++)
+        {
+            assert(visits[i] == 1);
+        }
+
+        for (long i = 1001; i < next_key; i++)
+        {
+            assert(visits[i] <= 1);
+        }
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests that every value appended for a key is returned in order by get_all,
+ *        and that put and get work on the same values
+ * @return  None
+ */
+void multimap_append_get_all_test()
+{
+    hash_table table;
+    int count;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION, HASH_MULTIMAP);
+
+    assert(get_all(&table, (void *)1, &count) == NULL);
+    assert(count == 0);
+
+    // Enough values to grow the key's array several times
+    for (long i = 1; i <= 100; i++)
+    {
+        append(&table, (void *)1, (void *)i);
+    }
+
+    put(&table, (void *)1, (void *)101);
+    // Key 11 shares a position with key 1
+    append(&table, (void *)11, (void *)7);
+
+    void **values = get_all(&table, (void *)1, &count);
+
+    assert(count == 101);
+
+    for (long i = 0; i < count; i++)
+    {
+        assert(values[i] == (void *)(i + 1));
+    }
+
+    assert(get(&table, (void *)1) == (void *)1);
+    assert(get(&table, (void *)11) == (void *)7);
+    assert(get_all(&table, (void *)11, &count) != NULL && count == 1);
+
+    remove_hash(&table, (void *)1);
+
+    assert(get_all(&table, (void *)1, &count) == NULL && count == 0);
+    assert(get(&table, (void *)11) == (void *)7);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests removal of single values from a multimap key, including duplicates
+ *        and the key's last value
+ * @return  None
+ */
+void multimap_remove_value_test()
+{
+    hash_table table;
+    int count;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION, HASH_MULTIMAP);
+
+    append(&table, (void *)3, (void *)10);
+    append(&table, (void *)3, (void *)20);
+    append(&table, (void *)3, (void *)10);
+    append(&table, (void *)3, (void *)30);
+
+    assert(!remove_value(&table, (void *)3, (void *)40));
+    assert(!remove_value(&table, (void *)4, (void *)10));
+
+    // Only the first occurrence is removed, and the rest keep their order
+    assert(remove_value(&table, (void *)3, (void *)10));
+
+    void **values = get_all(&table, (void *)3, &count);
+
+    assert(count == 3);
+    assert(values[0] == (void *)20 && values[1] == (void *)10 && values[2] == (void *)30);
+
+    assert(remove_value(&table, (void *)3, (void *)30));
+    assert(remove_value(&table, (void *)3, (void *)20));
+    assert(remove_value(&table, (void *)3, (void *)10));
+
+    // The key goes with its last value
+    assert(get_all(&table, (void *)3, &count) == NULL);
+    assert(table.num_elements == 0);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a multimap keeps every key's values through incremental resizing,
+ *        and that for_each, scan and put_many see each value
+ * @return  None
+ */
+void multimap_resize_test()
+{
+    hash_table table;
+    void *keys[1000];
+    void *batch_values[1000];
+    long sum = 0;
+    uint64_t cursor = 0;
+    int count;
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, HASH_MULTIMAP);
+    set_incremental_resize(&table, 4);
+
+    // Three values for each of 1000 keys, the last added as a batch
+    for (long i = 0; i < 1000; i++)
+    {
+        append(&table, (void *)(i + 1), (void *)1);
+        append(&table, (void *)(i + 1), (void *)2);
+        keys[i] = (void *)(i + 1);
+        batch_values[i] = (void *)3;
+    }
+
+    put_many(&table, keys, batch_values, 1000);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        void **values = get_all(&table, (void *)i, &count);
+
+        assert(count == 3);
+        assert(values[0] == (void *)1 && values[1] == (void *)2 && values[2] == (void *)3);
+    }
+
+    hash_table_for_each(&table, &sum_values, &sum);
+    assert(sum == 6000);
+
+    sum = 0;
+
+    do
+    {
+        cursor = hash_table_scan(&table, cursor, 10, &sum_values, &sum);
+    } while (cursor != 0);
+
+    assert(sum == 6000);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests get_all and remove_value on tables holding one value per key
+ * @return  None
+ */
+void multimap_single_value_modes_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO};
+
+    for (int m = 0; m < 4; m++)
+    {
+        hash_table table;
+        int count;
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION, modes[m]);
+
+        append(&table, (void *)5, (void *)50);
+
+        void **values = get_all(&table, (void *)5, &count);
+
+        assert(count == 1 && values[0] == (void *)50);
+
+        // A value the key does not hold leaves the key in place
+        assert(!remove_value(&table, (void *)5, (void *)60));
+        assert(remove_value(&table, (void *)5, (void *)50));
+        assert(get(&table, (void *)5) == NULL);
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests that putting a key twice replaces its value, and that removing it leaves
+ *        nothing behind, the same way in every open addressing mode
+ * @return  None
+ */
+void put_update_modes_test()
+{
+    hash_table_mode modes[] = {HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO, HASH_INLINE};
+
+    for (int m = 0; m < 4; m++)
+    {
+        hash_table table;
+
+        if (modes[m] == HASH_INLINE)
+        {
+            initialize_hash_table_inline(&table, NUM_ELEMS, LOAD_FACTOR, sizeof(uint64_t), sizeof(uint64_t));
+        }
+        else
+        {
+            initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_DIVISION, modes[m]);
+        }
+
+        for (uint64_t key = 2; key <= 22; key += 10)
+        {
+            for (uint64_t value = 1; value <= 2; value++)
+            {
+                uint64_t stored = key * 100 + value;
+
+                if (modes[m] == HASH_INLINE)
+                {
+                    put(&table, &key, &stored);
+                }
+                else
+                {
+                    put(&table, (void *)key, (void *)stored);
+                }
+            }
+        }
+
+        for (uint64_t key = 2; key <= 22; key += 10)
+        {
+            void *lookup = (modes[m] == HASH_INLINE) ? (void *)&key : (void *)key;
+            void *value = get(&table, lookup);
+
+            assert(value != NULL);
+            assert(((modes[m] == HASH_INLINE) ? *(uint64_t *)value : (uint64_t)value) == key * 100 + 2);
+
+            // Removing the key removes it entirely, rather than uncovering an older value
+            remove_hash(&table, lookup);
+            assert(get(&table, lookup) == NULL);
+        }
+
+        assert(table.num_elements == 0);
+
+        free_hash_table(&table);
+    }
+}
+
+/*!
+ * @brief Tests copying 8 byte keys and 16 byte values into a HASH_INLINE table
+ * @return  None
+ */
+void inline_put_get_remove_test()
+{
+    hash_table table;
+    uint64_t key = 42;
+    inline_record record = {7, 1.5};
+
+    initialize_hash_table_inline(&table, NUM_ELEMS, LOAD_FACTOR, sizeof(uint64_t), sizeof(inline_record));
+
+    assert(table.mode == HASH_INLINE);
+    assert(table.table_size == HASH_GROUP_WIDTH);
+    assert(table.entry_size == 24);
+
+    put(&table, &key, &record);
+
+    // The table holds its own copy, so the caller's key and value can be reused
+    key = 43;
+    record.count = 8;
+
+    uint64_t lookup_key = 42;
+    inline_record *stored = (inline_record *)get(&table, &lookup_key);
+
+    assert(stored != NULL && stored->count == 7 && stored->total == 1.5);
+    assert(get(&table, &key) == NULL);
+
+    // Updating a key overwrites the value in place
+    put(&table, &lookup_key, &record);
+    assert(table.num_elements == 1);
+    assert(((inline_record *)get(&table, &lookup_key))->count == 8);
+
+    remove_hash(&table, &lookup_key);
+    assert(table.num_elements == 0);
+    assert(get(&table, &lookup_key) == NULL);
+
+    free_hash_table(&table);
+    assert(table.entries == NULL);
+}
+
+/*!
+ * @brief Tests growth, deleted markers and iteration of a HASH_INLINE table
+ * @return  None
+ */
+void inline_resize_test()
+{
+    hash_table table;
+    int visits[20001] = {0};
+    uint64_t cursor = 0;
+
+    initialize_hash_table_inline(&table, NUM_ELEMS, 0.875, sizeof(uint64_t), sizeof(inline_record));
+
+    for (uint64_t i = 1; i <= 20000; i++)
+    {
+        inline_record record = {(long)i * 2, (double)i};
+
+        put(&table, &i, &record);
+    }
+
+    assert(table.num_elements == 20000);
+
+    for (uint64_t i = 1; i <= 20000; i++)
+    {
+        inline_record *stored = (inline_record *)get(&table, &i);
+
+        assert(stored != NULL && stored->count == (long)i * 2 && stored->total == (double)i);
+    }
+
+    // Removing and re-adding fills the table with deleted markers, which rebuilds drop
+    for (int round = 0; round < 4; round++)
+    {
+        for (uint64_t i = 1; i <= 20000; i += 2)
+        {
+            remove_hash(&table, &i);
+        }
+
+        for (uint64_t i = 1; i <= 20000; i += 2)
+        {
+            inline_record record = {(long)i * 2, (double)i};
+
+            put(&table, &i, &record);
+        }
+    }
+
+    assert(table.num_elements == 20000);
+
+    hash_table_for_each(&table, &count_inline_visits, visits);
+
+    // A scan started afresh visits every key a second time
+    do
+    {
+        cursor = hash_table_scan(&table, cursor, 100, &count_inline_visits, visits);
+    } while (cursor != 0);
+
+    for (int i = 1; i <= 20000; i++)
+    {
+        assert(visits[i] == 2);
+    }
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests HASH_INLINE keys of 4 bytes with no value and of 8 bytes compared by
+ *        their bytes, along with the batch and multimap functions
+ * @return  None
+ */
+void inline_key_sizes_test()
+{
+    hash_table set;
+    hash_table table;
+    int count;
+
+    // A set of 32 bit integers stores keys only
+    initialize_hash_table_inline(&set, NUM_ELEMS, LOAD_FACTOR, sizeof(uint32_t), 0);
+    assert(set.entry_size == 8);
+
+    for (uint32_t i = 0; i < 1000; i += 3)
+    {
+        put(&set, &i, NULL);
+    }
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        assert((get(&set, &i) != NULL) == (i % 3 == 0));
+    }
+
+    free_hash_table(&set);
+
+    // Composite keys are compared with memcmp, and a NULL value stores zero bytes
+    initialize_hash_table_inline(&table, NUM_ELEMS, LOAD_FACTOR, sizeof(composite_key), sizeof(char));
+
+    composite_key keys[3] = {{1, 2}, {2, 1}, {1, 3}};
+    composite_key absent = {3, 3};
+    char values[3] = {'a', 'b', 'c'};
+    void *key_pointers[4] = {&keys[0], &keys[1], &keys[2], &absent};
+    void *value_pointers[3] = {&values[0], &values[1], NULL};
+    void *found[4];
+
+    put_many(&table, key_pointers, value_pointers, 3);
+    get_many(&table, key_pointers, 4, found);
+
+    assert(*(char *)found[0] == 'a' && *(char *)found[1] == 'b' && *(char *)found[2] == 0);
+    assert(found[3] == NULL);
+
+    // The single value stored for a key is returned as its bytes
+    char *value = (char *)get_all(&table, &keys[1], &count);
+
+    assert(count == 1 && *value == 'b');
+
+    // Values are compared by their bytes rather than by pointer
+    char other = 'a';
+    char same = 'b';
+
+    assert(!remove_value(&table, &keys[1], &other));
+    assert(remove_value(&table, &keys[1], &same));
+    assert(get(&table, &keys[1]) == NULL);
+    assert(table.num_elements == 2);
+
+    free_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a bulk load gives the same contents as adding each element with put,
+ *        including duplicate keys and keys already in the table, in every mode
+ * @return  None
+ */
+void bulk_load_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO, HASH_MULTIMAP};
+    int n = 100000;
+    void **keys = (void **)malloc(n * sizeof(void *));
+    void **values = (void **)malloc(n * sizeof(void *));
+
+    // Every key after the first 60000 repeats an earlier one
+    for (long i = 0; i < n; i++)
+    {
+        keys[i] = (void *)(i % 60000 + 1);
+        values[i] = (void *)(i + 1);
+    }
+
+    for (int m = 0; m < 5; m++)
+    {
+        for (int threads = 1; threads <= 8; threads *= 8)
+        {
+            hash_table expected;
+            hash_table table;
+            long expected_sum = 0;
+            long sum = 0;
+
+            initialize_hash_table_mode(&expected, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+            initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+
+            // Half the tables already hold keys the bulk load updates
+            for (long i = 1; i <= 1000 * (threads == 8); i++)
+            {
+                put(&expected, (void *)(i * 100), (void *)i);
+                put(&table, (void *)(i * 100), (void *)i);
+            }
+
+            for (int i = 0; i < n; i++)
+            {
+                put(&expected, keys[i], values[i]);
+            }
+
+            hash_table_bulk_load(&table, keys, values, n, threads);
+
+            // Chaining tables count occupied positions, which depend on the size they grew to
+            if (modes[m] != HASH_CHAINING && modes[m] != HASH_MULTIMAP)
+            {
+                assert(table.num_elements == expected.num_elements);
+            }
+
+            for (long i = 1; i <= 100000; i++)
+            {
+                int count;
+                int expected_count;
+                void **all = get_all(&table, (void *)i, &count);
+                void **expected_all = get_all(&expected, (void *)i, &expected_count);
+
+                assert(get(&table, (void *)i) == get(&expected, (void *)i));
+                assert(count == expected_count);
+
+                // Multimap values keep the order they were given in
+                for (int j = 0; j < count; j++)
+                {
+                    assert(all[j] == expected_all[j]);
+                }
+            }
+
+            hash_table_for_each(&expected, &sum_values, &expected_sum);
+            hash_table_for_each(&table, &sum_values, &sum);
+            assert(sum == expected_sum);
+
+            // The table stays usable for further puts and removals
+            put(&table, (void *)200001, (void *)5);
+            remove_hash(&table, (void *)1);
+            assert(get(&table, (void *)200001) == (void *)5);
+            assert(get(&table, (void *)2) == get(&expected, (void *)2));
+
+            free_hash_table(&expected);
+            free_hash_table(&table);
+        }
+    }
+
+    free(keys);
+    free(values);
+}
+
+/*!
+ * @brief Tests bulk loading a HASH_INLINE table, whose keys and values are copied from
+ *        the arrays given, both into an empty table and one holding elements
+ * @return  None
+ */
+void inline_bulk_load_test()
+{
+    hash_table table;
+    int n = 50000;
+    int visits[50001] = {0};
+    uint64_t *key_bytes = (uint64_t *)malloc(n * sizeof(uint64_t));
+    inline_record *records = (inline_record *)malloc(n * sizeof(inline_record));
+    void **keys = (void **)malloc(n * sizeof(void *));
+    void **values = (void **)malloc(n * sizeof(void *));
+
+    for (int i = 0; i < n; i++)
+    {
+        key_bytes[i] = (uint64_t)(i + 1);
+        records[i].count = (long)(i + 1) * 2;
+        records[i].total = (double)(i + 1);
+        keys[i] = &(key_bytes[i]);
+        values[i] = &(records[i]);
+    }
+
+    initialize_hash_table_inline(&table, NUM_ELEMS, 0.875, sizeof(uint64_t), sizeof(inline_record));
+
+    // The first half is loaded into the empty table, the second alongside it
+    hash_table_bulk_load(&table, keys, values, n / 2, 4);
+    hash_table_bulk_load(&table, keys + n / 2, values + n / 2, n / 2, 4);
+
+    // Reloading keys replaces their values
+    records[0].total = -1.0;
+    hash_table_bulk_load(&table, keys, values, 1, 4);
+
+    assert(table.num_elements == n);
+
+    for (uint64_t i = 1; i <= (uint64_t)n; i++)
+    {
+        inline_record *stored = (inline_record *)get(&table, &i);
+
+        assert(stored != NULL && stored->count == (long)i * 2);
+        assert(stored->total == ((i == 1) ? -1.0 : (double)i));
+    }
+
+    hash_table_for_each(&table, &count_inline_visits, visits);
+
+    for (int i = 1; i <= n; i++)
+    {
+        assert(visits[i] == 1);
+    }
+
+    free_hash_table(&table);
+    free(key_bytes);
+    free(records);
+    free(keys);
+    free(values);
+}
+
+/*!
+ * @brief Tests resizing with several workers in the chaining and open addressing modes,
+ *        with every element found afterwards and chained nodes reused
+ * @return  None
+ */
+void parallel_resize_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_MULTIMAP};
+
+    for (int m = 0; m < 3; m++)
+    {
+        hash_table table;
+        int *visits = (int *)calloc(200001, sizeof(int));
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+        set_resize_threads(&table, 8);
+        assert(table.resize_threads == 8);
+
+        for (long i = 1; i <= 200000; i++)
+        {
+            put(&table, (void *)i, (void *)(i * 3));
+        }
+
+        for (long i = 1; i <= 200000; i++)
+        {
+            assert(get(&table, (void *)i) == (void *)(i * 3));
+        }
+
+        hash_table_for_each(&table, &count_visits, visits);
+
+        for (int i = 1; i <= 200000; i++)
+        {
+            assert(visits[i] == 1);
+        }
+
+        // Removed elements' nodes are reused by the keys added after them
+        for (long i = 1; i <= 200000; i += 2)
+        {
+            remove_hash(&table, (void *)i);
+        }
+
+        for (long i = 200001; i <= 300000; i++)
+        {
+            put(&table, (void *)i, (void *)(i * 3));
+        }
+
+        for (long i = 1; i <= 300000; i++)
+        {
+            assert(get(&table, (void *)i) == ((i % 2 == 1 && i <= 200000) ? NULL : (void *)(i * 3)));
+        }
+
+        // A count below one resizes in the calling thread
+        set_resize_threads(&table, 0);
+        assert(table.resize_threads == 1);
+
+        free_hash_table(&table);
+        free(visits);
+    }
+}
+
+/*!
+ * @brief Tests aggregating batches of rows with every operation in every mode, directly
+ *        and split across workers, against sums, minimums, maximums and counts computed
+ *        row by row
+ * @return  None
+ */
+void aggregate_batch_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO, HASH_MULTIMAP, HASH_INLINE};
+    hash_aggregate_op ops[] = {HASH_AGGREGATE_SUM, HASH_AGGREGATE_MIN, HASH_AGGREGATE_MAX, HASH_AGGREGATE_COUNT};
+    int n = 100000;
+    int num_groups = 3000;
+    uint64_t *key_bytes = (uint64_t *)malloc(n * sizeof(uint64_t));
+    void **keys = (void **)malloc(n * sizeof(void *));
+    void **inline_keys = (void **)malloc(n * sizeof(void *));
+    int64_t *deltas = (int64_t *)malloc(n * sizeof(int64_t));
+    int64_t *expected = (int64_t *)malloc((num_groups + 1) * sizeof(int64_t));
+
+    // Deltas are never 0, so a group's value is never mistaken for an absent group
+    for (int i = 0; i < n; i++)
+    {
+        key_bytes[i] = (uint64_t)((long)i * 7 % num_groups + 1);
+        keys[i] = (void *)key_bytes[i];
+        inline_keys[i] = &(key_bytes[i]);
+        deltas[i] = (i % 2 == 0) ? (int64_t)(i % 997 + 1) : -(int64_t)(i % 991 + 1);
+    }
+
+    for (int o = 0; o < 4; o++)
+    {
+        for (int g = 1; g <= num_groups; g++)
+        {
+            expected[g] = 0;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            int64_t *value = &(expected[key_bytes[i]]);
+            bool first = i < num_groups;
+
+            // The first num_groups rows hold every group once
+            *value = (first && ops[o] != HASH_AGGREGATE_COUNT) ? deltas[i]
+                     : (ops[o] == HASH_AGGREGATE_SUM)           ? *value + deltas[i]
+                     : (ops[o] == HASH_AGGREGATE_MIN)           ? ((deltas[i] < *value) ? deltas[i] : *value)
+                     : (ops[o] == HASH_AGGREGATE_MAX)           ? ((deltas[i] > *value) ? deltas[i] : *value)
+                                                                : *value + 1;
+        }
+
+        for (int m = 0; m < 6; m++)
+        {
+            for (int threads = 1; threads <= 4; threads *= 4)
+            {
+                hash_table table;
+                void **batch = (modes[m] == HASH_INLINE) ? inline_keys : keys;
+                bool found;
+
+                if (modes[m] == HASH_INLINE)
+                {
+                    initialize_hash_table_inline(&table, NUM_ELEMS, 0.875, sizeof(uint64_t), sizeof(int64_t));
+                }
+                else
+                {
+                    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+                }
+
+                // The second half of the rows updates groups the first half added
+                aggregate_batch_partitioned(&table, batch, deltas, n / 2, ops[o], threads);
+                aggregate_batch_partitioned(&table, batch + n / 2, deltas + n / 2, n / 2, ops[o], threads);
+
+                for (uint64_t g = 1; g <= (uint64_t)num_groups; g++)
+                {
+                    assert(group_value(&table, g, &found) == expected[g] && found);
+                }
+
+                // Chained tables count occupied positions rather than groups
+                assert(modes[m] == HASH_CHAINING || modes[m] == HASH_MULTIMAP || table.num_elements == num_groups);
+
+                group_value(&table, num_groups + 1, &found);
+                assert(!found);
+
+                free_hash_table(&table);
+            }
+        }
+    }
+
+    free(key_bytes);
+    free(keys);
+    free(inline_keys);
+    free(deltas);
+    free(expected);
+}
+
+/*!
+ * @brief Tests aggregating into groups put before the batch, and into groups removed and
+ *        added again, with and without deltas
+ * @return  None
+ */
+void aggregate_existing_groups_test()
+{
+    hash_table_mode modes[] = {HASH_CHAINING, HASH_SWISS, HASH_ROBIN_HOOD, HASH_CUCKOO, HASH_MULTIMAP};
+    void *keys[] = {(void *)1, (void *)2, (void *)1, (void *)3};
+    int64_t deltas[] = {10, 20, 30, 40};
+
+    for (int m = 0; m < 5; m++)
+    {
+        hash_table table;
+        int count;
+
+        initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, modes[m]);
+
+        put(&table, (void *)1, (void *)5);
+        aggregate_batch(&table, keys, deltas, 4, HASH_AGGREGATE_SUM);
+
+        assert(get(&table, (void *)1) == (void *)45);
+        assert(get(&table, (void *)2) == (void *)20);
+        assert(get(&table, (void *)3) == (void *)40);
+
+        // A removed group starts again from its next row
+        remove_hash(&table, (void *)1);
+        aggregate_batch(&table, keys, NULL, 4, HASH_AGGREGATE_SUM);
+
+        assert(get(&table, (void *)1) == (void *)2);
+        assert(get(&table, (void *)2) == (void *)21);
+
+        // A multimap group's value is its key's only value
+        if (modes[m] == HASH_MULTIMAP)
+        {
+            get_all(&table, (void *)1, &count);
+            assert(count == 1);
+        }
+
+        free_hash_table(&table);
+    }
+}
+
+int main(void)
+{
+    init_test();
+    free_empty_test();
+
+    put_single_element_test();
+    put_multiple_elements_test();
+
+    remove_hash_test();
+    remove_multiple_hashes_test();
+
+    hash_to_same_location_test();
+    hash_to_same_location_remove_test();
+    hash_to_same_location_remove_one_test();
+
+    percent_occupied_test();
+
+    swiss_init_test();
+    swiss_put_get_remove_test();
+    swiss_hash_to_same_location_test();
+    swiss_resize_test();
+
+    string_keys_test();
+    custom_key_functions_test();
+    byte_keys_test();
+    cached_hash_test();
+    fibonacci_hash_test();
+    hash_bytes_test();
+
+    resize_test();
+    incremental_resize_test();
+    incremental_resize_many_test();
+
+    for_each_test();
+    scan_test();
+    scan_growth_test();
+    open_scan_growth_test();
+    swiss_same_size_rehash_test();
+
+    get_many_put_many_test();
+
+    slab_allocation_test();
+    slab_growth_test();
+
+    robin_hood_put_get_remove_test();
+    robin_hood_backward_shift_test();
+    robin_hood_high_load_test();
+    robin_hood_equal_hash_test();
+
+    cuckoo_put_get_remove_test();
+    cuckoo_high_load_test();
+    cuckoo_stash_test();
+
+    hash_table_stats_test();
+
+    multimap_append_get_all_test();
+    multimap_remove_value_test();
+    multimap_resize_test();
+    multimap_single_value_modes_test();
+    put_update_modes_test();
+
+    inline_put_get_remove_test();
+    inline_resize_test();
+    inline_key_sizes_test();
+
+    bulk_load_test();
+    inline_bulk_load_test();
+    parallel_resize_test();
+
+    aggregate_batch_test();
+    aggregate_existing_groups_test();
 
     printf("\nHash table tests passed.\n\n");
 
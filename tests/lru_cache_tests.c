@@ -0,0 +1,167 @@
+/**
+ ********************************************************************************
+ * @file    lru_cache_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the lru_cache.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ENTRIES 100
+#define NUM_KEYS 100000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/lru_cache/lru_cache.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Records the key of an evicted entry and frees its value
+ * @param key Key of the evicted entry
+ * @param value Value of the evicted entry, allocated by the test
+ * @param context Pointer to the last evicted key
+ * @return None
+ */
+void record_eviction(void *key, void *value, void *context)
+{
+    *(long *)context = (long)key;
+    free(value);
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests that the least recently used entry is evicted once the entry limit is reached
+ * @return  None
+ */
+void entry_capacity_test()
+{
+    lru_cache cache;
+
+    initialize_lru_cache(&cache, 3, 0, HASH_FIBONACCI);
+
+    lru_put(&cache, (void *)1, (void *)10, 1);
+    lru_put(&cache, (void *)2, (void *)20, 1);
+    lru_put(&cache, (void *)3, (void *)30, 1);
+
+    // Using key 1 leaves key 2 as the least recently used
+    assert(lru_get(&cache, (void *)1) == (void *)10);
+    lru_put(&cache, (void *)4, (void *)40, 1);
+
+    assert(lru_num_elements(&cache) == 3);
+    assert(lru_get(&cache, (void *)2) == NULL);
+    assert(lru_get(&cache, (void *)1) == (void *)10);
+    assert(lru_get(&cache, (void *)3) == (void *)30);
+    assert(lru_get(&cache, (void *)4) == (void *)40);
+
+    // Touching key 1 without a lookup protects it from the next eviction
+    assert(lru_touch(&cache, (void *)1));
+    assert(!lru_touch(&cache, (void *)2));
+    lru_put(&cache, (void *)5, (void *)50, 1);
+    assert(lru_get(&cache, (void *)3) == NULL);
+    assert(lru_get(&cache, (void *)1) == (void *)10);
+
+    assert(cache.counters.hits == 5);
+    assert(cache.counters.misses == 2);
+    assert(cache.counters.evictions == 2);
+
+    free_lru_cache(&cache);
+}
+
+/*!
+ * @brief Tests that entries are evicted by total size and that the newest entry is kept
+ * @return  None
+ */
+void byte_capacity_test()
+{
+    lru_cache cache;
+
+    initialize_lru_cache(&cache, 0, 100, HASH_STRING);
+
+    lru_put(&cache, "a", "A", 40);
+    lru_put(&cache, "b", "B", 40);
+    assert(cache.used_bytes == 80);
+
+    // Adding 30 bytes pushes out the oldest entry
+    lru_put(&cache, "c", "C", 30);
+    assert(lru_get(&cache, "a") == NULL);
+    assert(cache.used_bytes == 70);
+
+    // Growing an entry in place evicts the others
+    assert(lru_put(&cache, "c", "CC", 90) == (void *)"C");
+    assert(lru_num_elements(&cache) == 1);
+    assert(cache.used_bytes == 90);
+
+    // An entry larger than the capacity is still kept on its own
+    lru_put(&cache, "d", "D", 500);
+    assert(lru_num_elements(&cache) == 1);
+    assert(lru_get(&cache, "d") == (void *)"D");
+
+    free_lru_cache(&cache);
+}
+
+/*!
+ * @brief Tests that the eviction function receives every evicted entry and not removed ones
+ * @return  None
+ */
+void eviction_callback_test()
+{
+    lru_cache cache;
+    long last_evicted = 0;
+
+    initialize_lru_cache(&cache, NUM_ENTRIES, 0, HASH_FIBONACCI);
+    set_lru_eviction_callback(&cache, &record_eviction, &last_evicted);
+
+    for (long i = 1; i <= NUM_KEYS; i++)
+    {
+        lru_put(&cache, (void *)i, malloc(8), 8);
+
+        if (i > NUM_ENTRIES)
+        {
+            assert(last_evicted == i - NUM_ENTRIES);
+        }
+    }
+
+    assert(cache.counters.evictions == NUM_KEYS - NUM_ENTRIES);
+
+    // Removed entries are handed back rather than passed to the eviction function
+    void *value = lru_remove(&cache, (void *)NUM_KEYS);
+    assert(value != NULL);
+    free(value);
+    assert(lru_remove(&cache, (void *)NUM_KEYS) == NULL);
+
+    // Evicting by hand drains the rest in order of use
+    for (long i = NUM_KEYS - NUM_ENTRIES + 1; i < NUM_KEYS; i++)
+    {
+        assert(lru_evict(&cache));
+        assert(last_evicted == i);
+    }
+
+    assert(!lru_evict(&cache));
+    assert(lru_num_elements(&cache) == 0);
+    assert(cache.used_bytes == 0);
+
+    free_lru_cache(&cache);
+}
+
+int main(void)
+{
+    entry_capacity_test();
+    byte_capacity_test();
+    eviction_callback_test();
+
+    printf("\nLRU cache tests passed.\n\n");
+
+    return 0;
+}
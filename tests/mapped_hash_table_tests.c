@@ -0,0 +1,173 @@
+/**
+ ********************************************************************************
+ * @file    mapped_hash_table_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the mapped_hash_table.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define TEST_FILE "mapped_hash_table_test.bin"
+#define NUM_ELEMS 10
+#define NUM_KEYS 5000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/mapped_hash_table/mapped_hash_table.h"
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests creating a table file and adding, updating and removing elements
+ * @return  None
+ */
+void put_get_remove_test()
+{
+    mapped_hash_table table;
+    size_t length;
+
+    assert(create_mapped_hash_table(&table, TEST_FILE, NUM_ELEMS));
+    assert(mapped_num_elements(&table) == 0);
+
+    assert(mapped_put(&table, "Key1", 4, "Value1", 6));
+    assert(mapped_put(&table, "Key2", 4, "Value2", 6));
+
+    assert(mapped_num_elements(&table) == 2);
+    assert(memcmp(mapped_get(&table, "Key1", 4, &length), "Value1", 6) == 0);
+    assert(length == 6);
+    assert(mapped_get(&table, "Key3", 4, NULL) == NULL);
+
+    // An update appends a new entry, leaving the old one as garbage
+    assert(mapped_put(&table, "Key1", 4, "Longer value", 12));
+    assert(mapped_num_elements(&table) == 2);
+    assert(memcmp(mapped_get(&table, "Key1", 4, &length), "Longer value", 12) == 0);
+    assert(length == 12);
+    assert(((mapped_header *)table.base)->garbage_bytes == 24);
+
+    assert(mapped_remove(&table, "Key2", 4));
+    assert(!mapped_remove(&table, "Key2", 4));
+    assert(mapped_num_elements(&table) == 1);
+    assert(mapped_get(&table, "Key2", 4, NULL) == NULL);
+
+    assert(mapped_checkpoint(&table));
+    close_mapped_hash_table(&table);
+
+    assert(table.base == NULL);
+    remove(TEST_FILE);
+}
+
+/*!
+ * @brief Tests that a table grows past its initial size and is found intact after reopening
+ * @return  None
+ */
+void reopen_test()
+{
+    mapped_hash_table table;
+    char key[16];
+
+    assert(create_mapped_hash_table(&table, TEST_FILE, NUM_ELEMS));
+
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        int value = i * 10;
+
+        sprintf(key, "key%d", i);
+        assert(mapped_put(&table, key, strlen(key), &value, sizeof(int)));
+    }
+
+    // Every other key is removed, shifting later slots back
+    for (int i = 0; i < NUM_KEYS; i += 2)
+    {
+        sprintf(key, "key%d", i);
+        assert(mapped_remove(&table, key, strlen(key)));
+    }
+
+    assert(((mapped_header *)table.base)->capacity >= NUM_KEYS);
+    assert(mapped_checkpoint(&table));
+    close_mapped_hash_table(&table);
+
+    assert(open_mapped_hash_table(&table, TEST_FILE, false));
+    assert(mapped_num_elements(&table) == NUM_KEYS / 2);
+
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        const int *value;
+
+        sprintf(key, "key%d", i);
+        value = (const int *)mapped_get(&table, key, strlen(key), NULL);
+
+        if (i % 2 == 0)
+        {
+            assert(value == NULL);
+        }
+        else
+        {
+            assert(value != NULL && *value == i * 10);
+        }
+    }
+
+    // A table opened read only refuses changes
+    assert(!mapped_put(&table, "New", 3, "Value", 5));
+    assert(!mapped_remove(&table, "key1", 4));
+    assert(!mapped_checkpoint(&table));
+
+    close_mapped_hash_table(&table);
+    remove(TEST_FILE);
+}
+
+/*!
+ * @brief Tests that files which do not hold a table are not opened
+ * @return  None
+ */
+void invalid_file_test()
+{
+    mapped_hash_table table;
+    FILE *file;
+
+    assert(!open_mapped_hash_table(&table, TEST_FILE, false));
+
+    file = fopen(TEST_FILE, "wb");
+    fprintf(file, "This is not a hash table file, but it is long enough to hold a header.");
+    fclose(file);
+
+    assert(!open_mapped_hash_table(&table, TEST_FILE, true));
+    assert(table.base == NULL);
+
+    // A header whose slot array is not a power of two or runs past the end of the file
+    // is refused rather than probed
+    assert(create_mapped_hash_table(&table, TEST_FILE, NUM_ELEMS));
+    ((mapped_header *)table.base)->capacity = 3;
+    close_mapped_hash_table(&table);
+    assert(!open_mapped_hash_table(&table, TEST_FILE, false));
+
+    assert(create_mapped_hash_table(&table, TEST_FILE, NUM_ELEMS));
+    ((mapped_header *)table.base)->capacity *= 2;
+    close_mapped_hash_table(&table);
+    assert(!open_mapped_hash_table(&table, TEST_FILE, false));
+
+    assert(create_mapped_hash_table(&table, TEST_FILE, NUM_ELEMS));
+    ((mapped_header *)table.base)->slots_offset = UINT64_MAX - 7;
+    close_mapped_hash_table(&table);
+    assert(!open_mapped_hash_table(&table, TEST_FILE, false));
+
+    remove(TEST_FILE);
+}
+
+int main(void)
+{
+    put_get_remove_test();
+    reopen_test();
+    invalid_file_test();
+
+    printf("\nMapped hash table tests passed.\n\n");
+
+    return 0;
+}
@@ -0,0 +1,195 @@
+/**
+ ********************************************************************************
+ * @file    perfect_hash_table_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the perfect_hash_table.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.5
+#define NUM_KEYS 100000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/perfect_hash_table/perfect_hash_table.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+/*!
+ * @brief Hashes integer keys so that keys within the same hundred collide
+ * @param key Key to hash
+ * @param key_length Unused
+ * @return The key divided by 100
+ */
+uint64_t hundreds_hash(const void *key, size_t key_length)
+{
+    return (uint64_t)(uintptr_t)key / 100;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests that an empty key set builds a table on which every lookup misses
+ * @return  None
+ */
+void empty_build_test()
+{
+    perfect_hash_table perfect;
+
+    assert(build_perfect_hash_table_arrays(&perfect, NULL, NULL, 0, HASH_KEY_POINTER, &hash_pointer, NULL));
+    assert(perfect.num_elements == 0);
+    assert(perfect_get(&perfect, (void *)1) == NULL);
+
+    free_perfect_hash_table(&perfect);
+}
+
+/*!
+ * @brief Tests that every key of a large array build is found in its own slot
+ * @return  None
+ */
+void array_build_test()
+{
+    perfect_hash_table perfect;
+    void **keys = (void **)malloc(NUM_KEYS * sizeof(void *));
+    void **values = (void **)malloc(NUM_KEYS * sizeof(void *));
+
+    for (long i = 0; i < NUM_KEYS; i++)
+    {
+        keys[i] = (void *)(i + 1);
+        values[i] = (void *)(i * 10);
+    }
+
+    assert(build_perfect_hash_table_arrays(&perfect, keys, values, NUM_KEYS, HASH_KEY_POINTER, &hash_fibonacci, NULL));
+
+    // There is exactly one slot for each key, and none is empty
+    assert(perfect.num_elements == NUM_KEYS);
+
+    for (int i = 0; i < NUM_KEYS; i++)
+    {
+        assert((perfect.slots)[i].key != NULL);
+    }
+
+    for (long i = 0; i < NUM_KEYS; i++)
+    {
+        assert(perfect_get(&perfect, (void *)(i + 1)) == (void *)(i * 10));
+    }
+
+    // Keys outside the set land on a slot holding another key
+    assert(perfect_get(&perfect, (void *)(NUM_KEYS + 1)) == NULL);
+    assert(perfect_get(&perfect, (void *)(NUM_KEYS * 7)) == NULL);
+
+    free_perfect_hash_table(&perfect);
+    free(keys);
+    free(values);
+
+    assert(perfect.slots == NULL);
+}
+
+/*!
+ * @brief Tests that a repeated key keeps its first value
+ * @return  None
+ */
+void repeated_key_test()
+{
+    perfect_hash_table perfect;
+    char first[] = "Test1";
+    char repeat[] = "Test1";
+    void *keys[] = {first, "Test2", repeat};
+    void *values[] = {(void *)1, (void *)2, (void *)3};
+
+    assert(build_perfect_hash_table_arrays(&perfect, keys, values, 3, HASH_KEY_STRING, &hash_bytes, NULL));
+
+    assert(perfect.num_elements == 2);
+    assert(perfect_get(&perfect, "Test1") == (void *)1);
+    assert(perfect_get(&perfect, "Test2") == (void *)2);
+    assert(perfect_get(&perfect, "Test3") == NULL);
+
+    free_perfect_hash_table(&perfect);
+}
+
+/*!
+ * @brief Tests that different keys with equal hashes are reported as a failed build
+ * @return  None
+ */
+void colliding_keys_test()
+{
+    perfect_hash_table perfect;
+    void *keys[] = {(void *)1, (void *)2};
+    void *values[] = {(void *)1, (void *)2};
+
+    assert(!build_perfect_hash_table_arrays(&perfect, keys, values, 2, HASH_KEY_POINTER, &hundreds_hash, NULL));
+    assert(perfect.slots == NULL);
+    assert(perfect.num_elements == 0);
+}
+
+/*!
+ * @brief Tests building from chaining and open addressing hash tables
+ * @return  None
+ */
+void table_build_test()
+{
+    hash_table table;
+    perfect_hash_table perfect;
+
+    initialize_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING);
+
+    put(&table, "Test1", (void *)1);
+    put(&table, "Test2", (void *)2);
+    put(&table, "Test3", (void *)3);
+
+    assert(build_perfect_hash_table(&perfect, &table));
+
+    // String keys are matched by content
+    char key[] = "Test2";
+
+    assert(perfect.num_elements == 3);
+    assert(perfect_get(&perfect, "Test1") == (void *)1);
+    assert(perfect_get(&perfect, key) == (void *)2);
+    assert(perfect_get(&perfect, "Test4") == NULL);
+
+    free_perfect_hash_table(&perfect);
+    free_hash_table(&table);
+
+    initialize_hash_table_mode(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI, HASH_SWISS);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        put(&table, (void *)i, (void *)(i * 2));
+    }
+
+    assert(build_perfect_hash_table(&perfect, &table));
+    assert(perfect.num_elements == 1000);
+
+    for (long i = 1; i <= 1000; i++)
+    {
+        assert(perfect_get(&perfect, (void *)i) == (void *)(i * 2));
+    }
+
+    free_perfect_hash_table(&perfect);
+    free_hash_table(&table);
+}
+
+int main(void)
+{
+    empty_build_test();
+    array_build_test();
+    repeated_key_test();
+    colliding_keys_test();
+    table_build_test();
+
+    printf("\nPerfect hash table tests passed.\n\n");
+
+    return 0;
+}
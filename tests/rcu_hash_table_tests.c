@@ -0,0 +1,253 @@
+/**
+ ********************************************************************************
+ * @file    rcu_hash_table_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the rcu_hash_table.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define NUM_ELEMS 10
+#define LOAD_FACTOR 0.75
+#define NUM_READERS 4
+#define NUM_STABLE_KEYS 1000
+#define NUM_WRITES 200000
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/rcu_hash_table/rcu_hash_table.h"
+
+/************************************
+ * HELPERS
+ ************************************/
+
+// Table shared by the threads of the multithreaded test
+rcu_hash_table shared_table;
+// Set by the writer once it has finished
+atomic_bool writer_done;
+
+/*!
+ * @brief Adds and removes a churning range of keys above the stable keys, growing the
+ *        table several times
+ * @param argument Unused
+ * @return NULL
+ */
+void *writer(void *argument)
+{
+    for (long i = 0; i < NUM_WRITES; i++)
+    {
+        long key = NUM_STABLE_KEYS + 1 + i;
+
+        rcu_put(&shared_table, (void *)key, (void *)(key * 2));
+
+        // Keeps a sliding window of churning keys in the table
+        if (i >= 5000)
+        {
+            rcu_remove(&shared_table, (void *)(key - 5000));
+        }
+
+        // Updates the stable keys in place, between their two valid values
+        if (i % 100 == 0)
+        {
+            long stable = i / 100 % NUM_STABLE_KEYS + 1;
+
+            rcu_put(&shared_table, (void *)stable, (void *)(stable * 2 + (i / 100 / NUM_STABLE_KEYS) % 2));
+        }
+    }
+
+    atomic_store(&writer_done, true);
+
+    return NULL;
+}
+
+/*!
+ * @brief Reads while the writer runs. Stable keys are always present and churning keys
+ *        are either missing or map to their value
+ * @param argument Unused
+ * @return NULL
+ */
+void *reader(void *argument)
+{
+    rcu_reader *handle = rcu_register_reader(&shared_table);
+    unsigned long state = (unsigned long)(uintptr_t)handle | 1;
+
+    assert(handle != NULL);
+
+    while (!atomic_load(&writer_done))
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+
+        long stable = (long)((state >> 33) % NUM_STABLE_KEYS) + 1;
+        long value = (long)rcu_get(&shared_table, handle, (void *)stable);
+
+        assert(value == stable * 2 || value == stable * 2 + 1);
+
+        long churning = NUM_STABLE_KEYS + 1 + (long)((state >> 17) % NUM_WRITES);
+        void *churning_value = rcu_get(&shared_table, handle, (void *)churning);
+
+        assert(churning_value == NULL || churning_value == (void *)(churning * 2));
+    }
+
+    rcu_unregister_reader(handle);
+
+    return NULL;
+}
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests putting, updating, getting and removing from a single thread
+ * @return  None
+ */
+void put_get_remove_test()
+{
+    rcu_hash_table table;
+
+    initialize_rcu_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_STRING);
+
+    rcu_reader *reader = rcu_register_reader(&table);
+
+    rcu_put(&table, "Test1", (void *)1);
+    rcu_put(&table, "Test2", (void *)2);
+    rcu_put(&table, "Test1", (void *)3);
+
+    assert(rcu_num_elements(&table) == 2);
+    assert(rcu_get(&table, reader, "Test1") == (void *)3);
+    assert(rcu_get(&table, reader, "Test2") == (void *)2);
+    assert(rcu_get(&table, reader, "Test3") == NULL);
+
+    rcu_remove(&table, "Test1");
+    rcu_remove(&table, "Test3");
+
+    assert(rcu_num_elements(&table) == 1);
+    assert(rcu_get(&table, reader, "Test1") == NULL);
+
+    rcu_unregister_reader(reader);
+    free_rcu_hash_table(&table);
+}
+
+/*!
+ * @brief Tests growth, and that retired nodes and arrays are reclaimed with no reader active
+ * @return  None
+ */
+void growth_reclaim_test()
+{
+    rcu_hash_table table;
+
+    initialize_rcu_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    rcu_reader *reader = rcu_register_reader(&table);
+
+    for (long i = 1; i <= 100000; i++)
+    {
+        rcu_put(&table, (void *)i, (void *)(i * 2));
+    }
+
+    for (long i = 1; i <= 100000; i += 2)
+    {
+        rcu_remove(&table, (void *)i);
+    }
+
+    for (long i = 1; i <= 100000; i++)
+    {
+        assert(rcu_get(&table, reader, (void *)i) == ((i % 2 == 0) ? (void *)(i * 2) : NULL));
+    }
+
+    // Two epochs pass with no reader inside a read, after which nothing is held back
+    rcu_reclaim(&table);
+    rcu_reclaim(&table);
+    assert(table.num_retired == 0);
+
+    rcu_unregister_reader(reader);
+    free_rcu_hash_table(&table);
+}
+
+/*!
+ * @brief Tests that a reader inside a read holds back reclamation of what it may see
+ * @return  None
+ */
+void reader_blocks_reclaim_test()
+{
+    rcu_hash_table table;
+
+    initialize_rcu_hash_table(&table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+
+    rcu_reader *reader = rcu_register_reader(&table);
+
+    rcu_put(&table, (void *)1, (void *)1);
+    rcu_remove(&table, (void *)1);
+
+    // Simulates a reader which entered a read before the remove, at the current epoch
+    atomic_store(&reader->state, (atomic_load(&table.epoch) << 1) | 1);
+
+    for (int i = 0; i < 4; i++)
+    {
+        rcu_reclaim(&table);
+    }
+
+    assert(table.num_retired == 1);
+
+    // Once the read ends the node is freed
+    atomic_store(&reader->state, 0);
+    rcu_reclaim(&table);
+    rcu_reclaim(&table);
+    assert(table.num_retired == 0);
+
+    rcu_unregister_reader(reader);
+    free_rcu_hash_table(&table);
+}
+
+/*!
+ * @brief Tests lock free readers against a writer that grows, updates and removes
+ * @return  None
+ */
+void multithreaded_test()
+{
+    pthread_t writer_thread;
+    pthread_t readers[NUM_READERS];
+
+    initialize_rcu_hash_table(&shared_table, NUM_ELEMS, LOAD_FACTOR, HASH_FIBONACCI);
+    atomic_init(&writer_done, false);
+
+    for (long key = 1; key <= NUM_STABLE_KEYS; key++)
+    {
+        rcu_put(&shared_table, (void *)key, (void *)(key * 2));
+    }
+
+    for (int i = 0; i < NUM_READERS; i++)
+    {
+        pthread_create(&readers[i], NULL, &reader, NULL);
+    }
+
+    pthread_create(&writer_thread, NULL, &writer, NULL);
+    pthread_join(writer_thread, NULL);
+
+    for (int i = 0; i < NUM_READERS; i++)
+    {
+        pthread_join(readers[i], NULL);
+    }
+
+    assert(rcu_num_elements(&shared_table) == NUM_STABLE_KEYS + 5000);
+
+    free_rcu_hash_table(&shared_table);
+}
+
+int main(void)
+{
+    put_get_remove_test();
+    growth_reclaim_test();
+    reader_blocks_reclaim_test();
+    multithreaded_test();
+
+    printf("\nRCU hash table tests passed.\n\n");
+
+    return 0;
+}
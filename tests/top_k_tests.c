@@ -0,0 +1,172 @@
+/**
+ ********************************************************************************
+ * @file    top_k_tests.c
+ * @author  Kai Gehry
+ * @date    2026-10-18
+ *
+ * @brief   Test the operations defined in the top_k.c file.
+ ********************************************************************************
+ */
+
+/************************************
+ * DEFINES
+ ************************************/
+#define K 10
+#define NUM_KEYS 1000
+#define EPSILON 0.001
+#define DELTA 0.01
+
+/************************************
+ * INCLUDES
+ ************************************/
+#include <assert.h>
+#include "../data_structures/sketches/top_k.h"
+
+/************************************
+ * TESTS
+ ************************************/
+
+/*!
+ * @brief Tests initialization of a top-k tracker
+ * @return  None
+ */
+void init_test()
+{
+    count_min_sketch sketch;
+    top_k tracker;
+    void *keys[K];
+
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+    initialize_top_k(&tracker, K, &sketch, HASH_FIBONACCI);
+
+    assert(tracker.k == K && tracker.size == 0);
+    assert(tracker.sketch == &sketch);
+    assert(top_k_items(&tracker, keys, NULL) == 0);
+
+    free_top_k(&tracker);
+    assert(tracker.items == NULL);
+
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests that the most frequent keys of an interleaved skewed stream are found,
+ *        in order, where key i occurs NUM_KEYS / i times
+ * @return  None
+ */
+void skewed_stream_test()
+{
+    count_min_sketch sketch;
+    top_k tracker;
+    void *keys[K];
+    uint32_t counts[K];
+
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+    initialize_top_k(&tracker, K, &sketch, HASH_FIBONACCI);
+
+    // Occurrences are spread out, so every key competes for a place throughout
+    for (long round = 1; round <= NUM_KEYS; round++)
+    {
+        for (long key = 1; key <= NUM_KEYS / round; key++)
+        {
+            top_k_add(&tracker, (void *)key, 1);
+        }
+    }
+
+    assert(top_k_items(&tracker, keys, counts) == K);
+
+    for (long i = 0; i < K; i++)
+    {
+        assert(keys[i] == (void *)(i + 1));
+        assert(counts[i] >= NUM_KEYS / (i + 1));
+        assert(counts[i] == top_k_estimate(&tracker, keys[i]));
+    }
+
+    // Untracked keys are still estimated by the sketch
+    assert(top_k_estimate(&tracker, (void *)(long)(K + 1)) >= NUM_KEYS / (K + 1));
+
+    free_top_k(&tracker);
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests that a few hot keys are kept among many keys seen once, with the
+ *        tracked keys never exceeding k
+ * @return  None
+ */
+void bounded_memory_test()
+{
+    count_min_sketch sketch;
+    top_k tracker;
+    void *keys[K];
+    bool found[4] = {false};
+
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+    initialize_top_k(&tracker, K, &sketch, HASH_FIBONACCI);
+
+    for (long i = 1; i <= 100000; i++)
+    {
+        // Keys 1 to 4 are hot, the rest occur once each
+        top_k_add(&tracker, (void *)(i % 4 + 1), 1);
+        top_k_add(&tracker, (void *)(i + 1000), 1);
+
+        assert(tracker.size <= K && tracker.table.num_elements == tracker.size);
+    }
+
+    assert(top_k_items(&tracker, keys, NULL) == K);
+
+    for (int i = 0; i < 4; i++)
+    {
+        assert((long)keys[i] >= 1 && (long)keys[i] <= 4);
+        found[(long)keys[i] - 1] = true;
+    }
+
+    assert(found[0] && found[1] && found[2] && found[3]);
+
+    free_top_k(&tracker);
+    free_count_min_sketch(&sketch);
+}
+
+/*!
+ * @brief Tests string keys, and weighted additions
+ * @return  None
+ */
+void string_keys_test()
+{
+    count_min_sketch sketch;
+    top_k tracker;
+    char *words[] = {"apple", "banana", "cherry", "date"};
+    void *keys[2];
+    uint32_t counts[2];
+    char copy[] = "cherry";
+
+    initialize_count_min_sketch(&sketch, EPSILON, DELTA);
+    initialize_top_k(&tracker, 2, &sketch, HASH_STRING);
+
+    top_k_add(&tracker, words[0], 5);
+    top_k_add(&tracker, words[1], 1);
+    top_k_add(&tracker, words[2], 20);
+    top_k_add(&tracker, words[3], 2);
+
+    // A key equal by content adds to the same count
+    top_k_add(&tracker, copy, 1);
+
+    assert(top_k_items(&tracker, keys, counts) == 2);
+    assert(strcmp((char *)keys[0], "cherry") == 0 && counts[0] == 21);
+    assert(strcmp((char *)keys[1], "apple") == 0 && counts[1] == 5);
+
+    free_top_k(&tracker);
+    free_count_min_sketch(&sketch);
+}
+
+int main(void)
+{
+    init_test();
+    skewed_stream_test();
+    bounded_memory_test();
+    string_keys_test();
+
+    printf("\nTop-k tests passed.\n\n");
+
+    return 0;
+}